@@ -10,11 +10,15 @@
  * size, as the compiler will align objects.
  * SBN headers are MsgSz + MsgType + ProcessorID
  * SBN subscription messages are MsgID + QoS
+ * SBN subscription range messages are MsgID + LastMsgID + QoS
  */
 
 #define SBN_PACKED_HDR_SZ (sizeof(SBN_MsgSz_t) + sizeof(SBN_MsgType_t) + sizeof(CFE_ProcessorID_t))
 #define SBN_PACKED_SUB_SZ \
     (SBN_PACKED_HDR_SZ + sizeof(SBN_SubCnt_t) + (sizeof(CFE_SB_MsgId_t) + sizeof(CFE_SB_Qos_t)) * SBN_MAX_SUBS_PER_PEER)
+#define SBN_PACKED_SUBRANGE_SZ                                  \
+    (SBN_PACKED_HDR_SZ + SBN_IDENT_LEN + sizeof(SBN_SubCnt_t) + \
+     (sizeof(CFE_SB_MsgId_t) * 2 + sizeof(CFE_SB_Qos_t)) * SBN_MAX_SUBS_PER_PEER)
 #define SBN_MAX_PACKED_MSG_SZ (SBN_PACKED_HDR_SZ + CFE_MISSION_SB_MAX_SB_MSG_SIZE)
 
 /**
@@ -47,6 +51,26 @@ void SBN_PackMsg(void *SBNMsgBuf, SBN_MsgSz_t MsgSz, SBN_MsgType_t MsgType, CFE_
 bool SBN_UnpackMsg(void *SBNBuf, SBN_MsgSz_t *MsgSzPtr, SBN_MsgType_t *MsgTypePtr, CFE_ProcessorID_t *ProcessorIDPtr,
                    void *Msg);
 
+/**
+ * @brief Used by SBN and modules to borrow a buffer of SBN_MAX_PACKED_MSG_SZ
+ * bytes from a preallocated pool, rather than placing one on the stack. The
+ * buffer is not cleared.
+ *
+ * @return The buffer, or NULL if all buffers in the pool are in use.
+ *
+ * @sa SBN_PutBuf
+ */
+void *SBN_GetBuf(void);
+
+/**
+ * @brief Returns a buffer borrowed with SBN_GetBuf() to the pool.
+ *
+ * @param Buf[in] The buffer (NULL is ignored.)
+ *
+ * @sa SBN_GetBuf
+ */
+void SBN_PutBuf(void *Buf);
+
 /**
  * Filters modify messages in place, doing such things as byte swapping, packing/unpacking, etc.
  *
@@ -121,7 +145,36 @@ typedef struct
 typedef struct SBN_IfOps_s        SBN_IfOps_t;
 typedef struct SBN_NetInterface_s SBN_NetInterface_t;
 
+/**
+ * @brief The latest message read for a conflated message ID, Pending until
+ * it is sent. Buf is word aligned, as it is read as an SB message.
+ */
+typedef struct
+{
+    CFE_SB_MsgId_t MsgID;
+    bool           Pending;
+    uint32         Buf[(SBN_CONFLATE_MSG_SZ + 3) / 4];
+} SBN_Conflate_t;
+
+/**
+ * @brief An app or relay message from the shared pipe or a bridge, held in a
+ * pool buffer (see SBN_GetBuf()) until the peer grants credit.
+ */
 typedef struct
+{
+    void *        Buf;
+    SBN_MsgSz_t   MsgSz;
+    SBN_MsgType_t MsgType;
+} SBN_HeldMsg_t;
+
+/**
+ * The peer's state is grouped by who writes it: read-mostly identity and
+ * negotiated state first, then the state written by the send path, then the
+ * state written by the receive path, then the cold subscription table. A
+ * cache line of padding between groups keeps a send task and a receive task
+ * for the same peer from writing to the same cache line.
+ */
+typedef struct SBN_PeerInterface_s
 {
     /** @brief The processor ID of this peer (MUST match the ProcessorID.) */
     CFE_ProcessorID_t ProcessorID;
@@ -132,11 +185,18 @@ typedef struct
     /** @brief A convenience pointer to the net that this peer belongs to. */
     SBN_NetInterface_t *Net;
 
+    /** @brief This peer's slot in SBN.Peers, kept for as long as the peer is loaded. */
+    SBN_PeerIdx_t Slot;
+
     SBN_Task_Flag_t TaskFlags;
 
+    /** @brief How to create the peer's send and receive tasks (SBN_Peer_Entry_t SendTask, RecvTask.) */
+    SBN_TaskConf_t SendTask, RecvTask;
+
     /**
      * @brief The ID of the task created to pend on the pipe and send messages
-     * to the net as soon as they are read. 0 if there is no send task.
+     * to the net as soon as they are read (with SBN_SEND_WORKERS, the send
+     * worker serving this peer.) 0 if there is no send task.
      */
     OS_TaskID_t SendTaskID;
 
@@ -150,10 +210,17 @@ typedef struct
     CFE_SB_PipeId_t Pipe;
 
     /**
-     * @brief A local table of subscriptions the peer has requested.
-     * Includes one extra entry for a null termination.
+     * @brief The pipe ID used to read high priority messages destined for the
+     * peer, always drained before Pipe.
+     */
+    CFE_SB_PipeId_t HiPipe;
+
+    /**
+     * @brief The pipe the peer's conflated message ID's are subscribed on,
+     * drained into Conflate whenever the peer's pipes are read. 0 if the peer
+     * has none.
      */
-    SBN_Subs_t Subs[SBN_MAX_SUBS_PER_PEER + 1];
+    CFE_SB_PipeId_t ConflatePipe;
 
     /**
      * @brief Filters alter message headers/bodies before sending to a peer or after
@@ -162,13 +229,153 @@ typedef struct
     SBN_FilterInterface_t *Filters[SBN_MAX_FILTERS];
     SBN_ModuleIdx_t        FilterCnt;
 
-    OS_time_t   LastSend, LastRecv;
-    SBN_HKTlm_t SendCnt, RecvCnt, SendErrCnt, RecvErrCnt, SubCnt;
+    /**
+     * @brief The SBN_FEAT_* features both this CPU and the peer support,
+     * negotiated when the peer connects. 0 until the peer's SBN_PROTO_MSG
+     * is received, or if the peer predates SBN_PROTO_VER_CAPS.
+     */
+    uint32 Features;
+
+    /**
+     * @brief The largest SBN message (including the SBN header) to send to
+     * this peer in one frame, the smaller of the net's MTU and the peer's
+     * advertised limit. 0 if unlimited.
+     */
+    uint32 MTU;
+
+    /** @brief The most SB messages to put in one frame to this peer (1 when not batching.) */
+    uint16 MaxBatch;
+
+    /** @brief The number of reliable delivery lanes both ends support. */
+    uint8 RelLanes;
 
     bool Connected;
 
+    uint8 SendPad[SBN_CACHE_LINE_SZ];
+
+    /* written by the send task/worker or, for polled peers, the main task */
+
+    /** @brief Odd while LastSend and SendCnt are being updated, see SBN_SnapshotPeer(). */
+    uint32      SendSeq;
+    OS_time_t   LastSend;
+    SBN_HKTlm_t SendCnt, SendErrCnt;
+
+    /** @brief Identifies the next fragmented message sent to this peer. */
+    uint16 NextFragID;
+
+    /**
+     * @brief The app messages sent to the peer, counted against the credit it
+     * grants (see SBN_CREDITS.) Stalled is set while sending from the peer's
+     * pipes is held for want of credit, since StallStart; StallCnt and
+     * StallMS are how often and for how long in all, CreditDropCnt the
+     * messages dropped for want of credit when no more could be held.
+     */
+    uint32      CreditSent;
+    bool        Stalled;
+    OS_time_t   StallStart;
+    uint32      StallMS;
+    SBN_HKTlm_t StallCnt, CreditDropCnt;
+
+    /**
+     * @brief The messages from the shared pipe or a bridge held for want of
+     * credit, HeldCnt of them from Held[HeldFirst] on, oldest first (see
+     * SBN_HoldMsg().) Guarded by SBN.HeldMutex.
+     */
+    SBN_HeldMsg_t Held[SBN_CREDIT_HOLD_DEPTH];
+    uint8         HeldFirst, HeldCnt;
+
+    /**
+     * @brief The latest message read for each of the first ConflateCnt
+     * entries, one per conflated message ID; ConflateNext is the entry to
+     * look at first for the next one to send. ConflatedCnt is the messages
+     * replaced by a newer copy (or too large to keep while sending is held)
+     * before they were sent.
+     */
+    SBN_Conflate_t Conflate[SBN_MAX_CONFLATE_PER_PEER];
+    uint8          ConflateCnt, ConflateNext;
+    SBN_HKTlm_t    ConflatedCnt;
+
+    /** @brief The messages read for this peer but dropped as older than their time-to-live, see SBN_MsgExpired(). */
+    SBN_HKTlm_t ExpiredCnt;
+
+    uint8 RecvPad[SBN_CACHE_LINE_SZ];
+
+    /* written by the receive task/worker or, for polled nets, the main task */
+
+    /** @brief Odd while LastRecv and RecvCnt are being updated, see SBN_SnapshotPeer(). */
+    uint32      RecvSeq;
+    OS_time_t   LastRecv;
+    SBN_HKTlm_t RecvCnt, RecvErrCnt;
+
+    /** @brief Messages from this peer dropped because they could not be reassembled from fragments. */
+    SBN_HKTlm_t ReasmErrCnt;
+
+    /**
+     * @brief The smoothed interval between messages from this peer and its
+     * mean deviation, in microseconds, over the last ArrivalCnt intervals (at
+     * most SBN_FD_MIN_SAMPLES), see SBN_PeerTimedOut().
+     */
+    uint32 ArrivalMeanUS, ArrivalDevUS;
+    uint16 ArrivalCnt;
+
+    /**
+     * @brief CreditSent may run up to CreditLimit, set when the peer grants
+     * credit. CreditRecvCnt is the app messages received from the peer,
+     * CreditGrantedCnt what it was when the peer was last granted credit.
+     */
+    uint32 CreditLimit, CreditRecvCnt, CreditGrantedCnt;
+
+    uint8 ColdPad[SBN_CACHE_LINE_SZ];
+
+    /* written by the main task */
+
+    /** @brief The next peer in the same SBN_GetPeer() hash bucket. */
+    struct SBN_PeerInterface_s *HashNext;
+
+    /** @brief The next peer due in the same slot of the poll wheel. */
+    struct SBN_PeerInterface_s *PollNext;
+
+    /** @brief How long to wait before polling the peer again, see SBN_SchedulePoll(). */
+    uint32 PollDelayMS;
+
+    /**
+     * @brief The peers with this ProcessorID on the other nets, when bonded
+     * (see SBN_LinkBonds().) BondFirst is the path on the lowest numbered net,
+     * BondNext the path on the next net, both NULL if the peer has no others.
+     */
+    struct SBN_PeerInterface_s *BondFirst, *BondNext;
+
+    /** @brief CreditRecvCnt as SBN_CheckCredits() last saw it, and since when. */
+    uint32    CreditCheckedCnt;
+    OS_time_t CreditCheckedTime;
+
     /** @brief generic blob of bytes for the module-specific data. */
     uint8 ModulePvt[128];
+
+    SBN_HKTlm_t SubCnt;
+
+    /** @brief The most subscriptions this peer may have, Subs has one more entry. */
+    uint16 MaxSubs;
+
+    /**
+     * @brief The entries allocated at Subs, at least MaxSubs + 1. A reload
+     * may load a peer with up to SubSlots - 1 subscriptions into this entry.
+     */
+    uint16 SubSlots;
+
+    /**
+     * @brief Set on an entry of the net's Peers that holds no peer: one left
+     * by a peer a reload removed, or a spare for peers a reload adds (see
+     * SBN_SPARE_PEERS_PER_NET.) Loops over a net's peers skip these.
+     */
+    bool Unused;
+
+    /**
+     * @brief A local table of subscriptions the peer has requested, allocated
+     * when the configuration is loaded. Includes one extra entry for a null
+     * termination.
+     */
+    SBN_Subs_t *Subs;
 } SBN_PeerInterface_t;
 
 /**
@@ -191,6 +398,76 @@ SBN_Status_t SBN_SendLocalSubsToPeer(SBN_PeerInterface_t *Peer);
  */
 SBN_PeerInterface_t *SBN_GetPeer(SBN_NetInterface_t *Net, CFE_ProcessorID_t ProcessorID);
 
+/**
+ * @brief Used by modules that receive messages for all peers on a medium (see
+ * SendToNet) to drop app messages from the medium this CPU did not subscribe
+ * to. Messages sent to this CPU alone are left to the receive filters. May be
+ * called from a receive task.
+ *
+ * @param Net[in] The net the message was received on.
+ * @param MsgID[in] The message ID of the app message.
+ *
+ * @return true if local apps, or (for a bridge) peers on other nets,
+ *         subscribed to the message ID.
+ */
+bool SBN_Subscribed(SBN_NetInterface_t *Net, CFE_SB_MsgId_t MsgID);
+
+/**
+ * @brief Puts off the next PollPeer call for the peer, only to be called from
+ * PollPeer. A peer whose module does not call this is polled again on the next
+ * wakeup.
+ *
+ * @param Peer[in] The peer being polled.
+ * @param DelayMS[in] How long until the peer needs polling again, at most the
+ *        span of the poll wheel (see SBN_POLL_WHEEL_SLOTS.)
+ */
+void SBN_SchedulePoll(SBN_PeerInterface_t *Peer, uint32 DelayMS);
+
+/**
+ * @brief Whether a connected peer is due a heartbeat, nothing having been
+ * sent to it for the net's HeartbeatMS.
+ *
+ * @param Peer[in] The peer being polled.
+ *
+ * @return true if the module should send the peer a heartbeat.
+ */
+bool SBN_HeartbeatDue(SBN_PeerInterface_t *Peer);
+
+/**
+ * @brief The failure detector. A peer is taken to have failed when it has
+ * been silent for the net's TimeoutMS or, once the intervals between its
+ * messages are known, for SBN_FD_THRESHOLD mean deviations past the mean
+ * interval, though never for less than SBN_FD_MIN_HEARTBEATS heartbeats. So
+ * a steady link fails over in a few heartbeats while a jittery one is given
+ * longer.
+ *
+ * @param Peer[in] The connected peer being polled.
+ *
+ * @return true if the module should disconnect the peer.
+ */
+bool SBN_PeerTimedOut(SBN_PeerInterface_t *Peer);
+
+/**
+ * @brief How long a module can leave a connected peer between polls and still
+ * keep to the net's HeartbeatMS and TimeoutMS, at most a second.
+ *
+ * @param Peer[in] The peer being polled.
+ *
+ * @return The delay to pass to SBN_SchedulePoll(), in milliseconds.
+ */
+uint32 SBN_LivenessPollMS(SBN_PeerInterface_t *Peer);
+
+/**
+ * @brief Milliseconds from one local time to another, negative if Now is
+ * before Then.
+ *
+ * @param Then[in] The earlier time.
+ * @param Now[in] The later time.
+ *
+ * @return The milliseconds elapsed.
+ */
+int32 SBN_ElapsedMS(OS_time_t *Then, OS_time_t *Now);
+
 struct SBN_NetInterface_s
 {
     bool Configured;
@@ -199,11 +476,30 @@ struct SBN_NetInterface_s
 
     SBN_Task_Flag_t TaskFlags;
 
+    /** @brief How to create the net's receive task (this CPU's SBN_Peer_Entry_t RecvTask.) */
+    SBN_TaskConf_t RecvTask;
+
+    /**
+     * @brief The largest SBN message (including the SBN header) this net can
+     * send in one frame, larger app messages are fragmented. 0 if unlimited.
+     */
+    uint16 MTU;
+
+    /**
+     * @brief How long (in milliseconds) a peer may go without a message
+     * before it is sent a heartbeat (0 for no heartbeats), and the longest it
+     * may be silent before it is taken to have failed (0 for never.) From the
+     * configuration table, or set to the module's defaults by LoadNet.
+     */
+    uint32 HeartbeatMS, TimeoutMS;
+
     /* For some network topologies, this application only needs one connection
      * to communicate to peers. These tasks are used for those networks. ID's
      * are 0 if there is no task.
      */
-    OS_TaskID_t  SendTaskID;
+    OS_TaskID_t SendTaskID;
+
+    /** @brief Serializes the sends to the net's peers from their send tasks and the main task, see SBN_SendNetMsg(). */
     OS_MutexID_t SendMutex;
 
     OS_TaskID_t RecvTaskID;
@@ -212,7 +508,17 @@ struct SBN_NetInterface_s
 
     SBN_PeerIdx_t PeerCnt;
 
-    SBN_PeerInterface_t Peers[SBN_MAX_PEER_CNT];
+    /**
+     * @brief The PeerCnt peers on this net, in PeerSlots entries allocated
+     * when the configuration is loaded. A reload adds and removes peers in
+     * place, so entries before PeerCnt may be Unused.
+     */
+    SBN_PeerInterface_t *Peers;
+
+    SBN_PeerIdx_t PeerSlots;
+
+    /** @brief The net's peers chained by SBN_PEER_HASH() of their ProcessorID, see SBN_GetPeer(). */
+    SBN_PeerInterface_t *PeerHash[SBN_PEER_HASH_SZ];
 
     /**
      * @brief Filters alter message headers/bodies before sending to a peer or after
@@ -306,7 +612,9 @@ struct SBN_IfOps_s
      * @param MsgSz[in] The size of the SBN message payload.
      * @param Payload[in] The SBN message payload.
      *
-     * @return SBN_SUCCESS when message successfully sent, otherwise SBN_ERROR.
+     * @return SBN_SUCCESS when message successfully sent, SBN_IF_EMPTY when the
+     *         module dropped it for lack of room to queue it (counted as a send
+     *         error, but the peer is still served), otherwise SBN_ERROR.
      */
     SBN_Status_t (*Send)(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Payload);
 
@@ -369,6 +677,27 @@ struct SBN_IfOps_s
      * @sa LoadNet, LoadPeer, UnloadNet
      */
     SBN_Status_t (*UnloadPeer)(SBN_PeerInterface_t *Peer);
+
+    /**
+     * Sends a message once to all the peers on the net, for nets whose peers
+     * share a medium (a UDP multicast group, for instance.) Optional, NULL if
+     * the module cannot. SBN uses it for app messages that more than one peer
+     * on the net subscribed to, peers should drop what they receive from the
+     * medium that they did not subscribe to (see SBN_Subscribed().) SBN only
+     * sends this way from the shared pipe, so only when built with
+     * SBN_SHARED_PIPE, and only when every connected peer on the net that
+     * subscribed is fed from the shared pipe.
+     *
+     * @param Net[in] The net to send to.
+     * @param MsgType[in] The SBN message type.
+     * @param MsgSz[in] The size of the SBN message payload.
+     * @param Payload[in] The SBN message payload.
+     *
+     * @return SBN_SUCCESS when the message is sent,
+     *         SBN_NOT_IMPLEMENTED if the net cannot take this message that
+     *         way (SBN then sends it to each peer), otherwise SBN_ERROR.
+     */
+    SBN_Status_t (*SendToNet)(SBN_NetInterface_t *Net, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Payload);
 };
 
 /**
@@ -31,10 +31,28 @@
     (CFE_SB_TLM_HDR_SIZE + sizeof(uint8) + sizeof(SBN_NetIdx_t) + sizeof(SBN_PeerIdx_t) + sizeof(SBN_SubCnt_t) + \
      SBN_MAX_SUBS_PER_PEER * sizeof(CFE_SB_MsgId_t))
 
-/** @brief CC, SubCnt, ProcessorID, LastSend, LastRecv, SendCnt, RecvCnt, SendErrCnt, RecvErrCnt */
+#ifdef SBN_CREDITS
+/** @brief StallCnt, StallMS, CreditDropCnt, at the end of SBN_HKPEER_LEN */
+#define SBN_HKCREDIT_LEN (sizeof(SBN_HKTlm_t) * 2 + sizeof(uint32))
+#else
+#define SBN_HKCREDIT_LEN 0
+#endif /* SBN_CREDITS */
+
+/**
+ * @brief CC, SubCnt, ProcessorID, LastSend, LastRecv, SendCnt, RecvCnt, SendErrCnt, RecvErrCnt, ReasmErrCnt,
+ * ConflatedCnt, ExpiredCnt, then SBN_HKCREDIT_LEN
+ */
 #define SBN_HKPEER_LEN                                                                                                \
     (CFE_SB_TLM_HDR_SIZE + sizeof(uint8) + sizeof(SBN_SubCnt_t) + sizeof(CFE_ProcessorID_t) + sizeof(OS_time_t) * 2 + \
-     sizeof(SBN_HKTlm_t) * 4)
+     sizeof(SBN_HKTlm_t) * 7 + SBN_HKCREDIT_LEN)
+
+/** @brief CC, MsgID, MsgCnt, Bytes[SBN_MID_STATS_TOP], the second half of SBN_HKPEERMIDS_LEN */
+#define SBN_HKMIDS_LEN (sizeof(uint16) + SBN_MID_STATS_TOP * (sizeof(CFE_SB_MsgId_t) + sizeof(uint32) * 2))
+
+/** @brief CC, NetIdx, PeerIdx, ProcessorID, IntervalMS, send then receive SBN_HKMIDS_LEN */
+#define SBN_HKPEERMIDS_LEN                                                                                    \
+    (CFE_SB_TLM_HDR_SIZE + sizeof(uint8) + sizeof(uint16) * 2 + sizeof(CFE_ProcessorID_t) + sizeof(uint32) + \
+     SBN_HKMIDS_LEN * 2)
 
 /** @brief CC, ProtocolID, PeerCnt */
 #define SBN_HKNET_LEN (CFE_SB_TLM_HDR_SIZE + sizeof(uint8) + sizeof(SBN_ModuleIdx_t) + sizeof(SBN_PeerIdx_t))
@@ -10,6 +10,7 @@
 #define SBN_HK_MYSUBS_CC     14
 #define SBN_HK_RESET_CC      15
 #define SBN_HK_RESET_PEER_CC 16
+#define SBN_HK_PEERMIDS_CC   17
 
 #define SBN_SCH_WAKEUP_CC 100
 #define SBN_TBL_CC        110
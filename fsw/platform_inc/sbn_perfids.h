@@ -1,9 +1,59 @@
 #ifndef _sbn_perfids_h_
 #define _sbn_perfids_h_
 
-#define SBN_PERF_MIN_ID  1
-#define SBN_PERF_SEND_ID SBN_PERF_MIN_ID
-#define SBN_PERF_RECV_ID SBN_PERF_MIN_ID + 1
-#define SBN_PERF_MAX_ID  SBN_PERF_MIN_ID + 100
+#define SBN_PERF_MIN_ID 1
+
+/** @brief A whole wakeup of the main task. */
+#define SBN_PERF_RECV_ID (SBN_PERF_MIN_ID + 1)
+
+/** @brief Processing local subscription changes. */
+#define SBN_PERF_SUBS_ID (SBN_PERF_MIN_ID + 2)
+
+/** @brief Unpacking an SBN message, nested in the receive of whichever task unpacks it. */
+#define SBN_PERF_UNPACK_ID (SBN_PERF_MIN_ID + 3)
+
+/**
+ * Pipeline stages. Each has an ID of its own, used by the main task for the
+ * shared pipe and by peers beyond the per-peer ranges below, and an ID in the
+ * range of each peer (see SBN_PERF_PEER_ID), so each send and receive task
+ * logs under its own ID's.
+ */
+#define SBN_PERF_SEND_ID       (SBN_PERF_MIN_ID + 4)  /**< @brief module Send */
+#define SBN_PERF_NETRECV_ID    (SBN_PERF_MIN_ID + 5)  /**< @brief module RecvFromPeer/RecvFromNet */
+#define SBN_PERF_RECVFILTER_ID (SBN_PERF_MIN_ID + 6)  /**< @brief incoming filter chain */
+#define SBN_PERF_PASSMSG_ID    (SBN_PERF_MIN_ID + 7)  /**< @brief CFE_SB_PassMsg */
+#define SBN_PERF_PIPE_ID       (SBN_PERF_MIN_ID + 8)  /**< @brief draining the peer pipes */
+#define SBN_PERF_SENDFILTER_ID (SBN_PERF_MIN_ID + 9)  /**< @brief outgoing filter chain */
+#define SBN_PERF_POLL_ID       (SBN_PERF_MIN_ID + 10) /**< @brief module PollPeer (heartbeats, connecting) */
+
+#define SBN_PERF_STAGE_MIN_ID SBN_PERF_SEND_ID
+#define SBN_PERF_STAGE_CNT    7
+
+/** @brief Receiving from each net whose module uses RecvFromNet, one ID per net. */
+#define SBN_PERF_NET_MIN_ID (SBN_PERF_MIN_ID + 11)
+#define SBN_PERF_NET_ID(NetIdx) \
+    ((NetIdx) < SBN_MAX_NETS ? SBN_PERF_NET_MIN_ID + (NetIdx) : SBN_PERF_NETRECV_ID)
+
+/**
+ * @brief Each peer slot in SBN.Peers has a range of one ID per stage, for as
+ * many of the SBN_MAX_PEER_CNT slots as fit below SBN_PERF_MAX_ID (10 with
+ * the defaults.) The slots past SBN_PERF_PEER_CNT log under the stage's own
+ * ID, so a capture lumps their time in with the shared pipe's and each other's;
+ * raise SBN_PERF_MAX_ID (no further than CFE_MISSION_ES_PERF_MAX_IDS) to give
+ * every slot its own range.
+ */
+#define SBN_PERF_PEER_MIN_ID  (SBN_PERF_NET_MIN_ID + SBN_MAX_NETS)
+#define SBN_PERF_PEER_FIT_CNT ((SBN_PERF_MAX_ID - SBN_PERF_PEER_MIN_ID) / SBN_PERF_STAGE_CNT)
+#define SBN_PERF_PEER_CNT     (SBN_MAX_PEER_CNT < SBN_PERF_PEER_FIT_CNT ? SBN_MAX_PEER_CNT : SBN_PERF_PEER_FIT_CNT)
+#define SBN_PERF_PEER_ID(PeerIdx, StageID)                                                                \
+    ((PeerIdx) < SBN_PERF_PEER_CNT ? SBN_PERF_PEER_MIN_ID + (PeerIdx) * SBN_PERF_STAGE_CNT + (StageID) - \
+                                         SBN_PERF_STAGE_MIN_ID                                            \
+                                   : (StageID))
+
+#define SBN_PERF_MAX_ID (SBN_PERF_MIN_ID + 100)
+
+#if defined(CFE_MISSION_ES_PERF_MAX_IDS) && SBN_PERF_MAX_ID > CFE_MISSION_ES_PERF_MAX_IDS
+#error "SBN_PERF_MAX_ID is beyond CFE_MISSION_ES_PERF_MAX_IDS"
+#endif
 
 #endif /* _sbn_perfids_h_ */
@@ -23,12 +23,26 @@
 #ifndef _sbn_platform_cfg_h
 #define _sbn_platform_cfg_h
 
-/** @brief Maximum number of networks allowed. */
+/**
+ * @brief Maximum number of networks allowed. This many nets are allocated
+ * when the configuration table is loaded, so that a reload can add nets.
+ */
 #define SBN_MAX_NETS 16
 
-/** @brief Maximum number of subscriptions allowed per peer allowed. */
+/**
+ * @brief Maximum number of subscriptions allowed per peer allowed. Each peer's
+ * subscription table is allocated with the MaxSubs in its configuration table
+ * entry, this is the default and upper limit of that.
+ */
 #define SBN_MAX_SUBS_PER_PEER 256
 
+/**
+ * @brief The most message ID's one range subscription from a peer can cover.
+ * SB routes each message ID separately, so each message ID in a range still
+ * takes a route, even though the range is one entry in the peer's table.
+ */
+#define SBN_MAX_SUB_RANGE 256
+
 /** @brief Maximum number of incoming and outgoing message filters. */
 #define SBN_MAX_FILTERS 16
 
@@ -56,6 +70,32 @@
  */
 #define SBN_POLL_TIME 5
 
+/**
+ * @brief Peers are polled from a timer wheel of this many slots, each
+ * SBN_POLL_WHEEL_TICK milliseconds, so a wakeup only polls the peers that are
+ * due rather than every peer. A module can put off polling a peer for up to
+ * SBN_POLL_WHEEL_SLOTS - 1 ticks, see SBN_SchedulePoll().
+ */
+#define SBN_POLL_WHEEL_SLOTS 64
+
+/** @brief Milliseconds per slot of the poll wheel, must divide 1000. */
+#define SBN_POLL_WHEEL_TICK 50
+
+/**
+ * @brief Number of buckets (a power of two) in each net's table SBN_GetPeer()
+ * finds peers in, should be at least the number of peers on a net.
+ */
+#define SBN_PEER_HASH_SZ 64
+
+/**
+ * @brief Entries allocated for each net beyond the peers its configuration
+ * table entries load, each with room for SBN_MAX_SUBS_PER_PEER
+ * subscriptions, so a table reload can add peers to the net in place. A
+ * reload adding more peers than there are spare and unused entries reloads
+ * the net.
+ */
+#define SBN_SPARE_PEERS_PER_NET 2
+
 /**
  * @brief For each peer, a pipe is created to receive messages that the peer has
  * subscribed to. The pipe should be deep enough to handle all messages that
@@ -69,6 +109,296 @@
  */
 #define SBN_DEFAULT_MSG_LIM 8
 
+/**
+ * @brief Each peer also has a high priority pipe for message ID's the peer
+ * subscribed to with a QoS priority of CFE_SB_QosPriority_HIGH. This pipe is
+ * always drained before the (low priority) peer pipe.
+ */
+#define SBN_PEER_HI_PIPE_DEPTH 16
+
+/**
+ * @brief The maximum number of messages that will be queued for a particular
+ * high priority message ID for a particular peer.
+ */
+#define SBN_HI_MSG_LIM 4
+
+/**
+ * @brief When its pipes are empty, a send task waits this long (in
+ * milliseconds) for a message before checking whether its peer is still
+ * connected.
+ */
+#define SBN_SEND_TASK_PEND_TIME 20
+
+/**
+ * @brief A send task waiting on empty pipes pends on the high priority pipe
+ * for this long (in milliseconds) at a time, checking the low priority and
+ * conflated pipes in between, so this bounds how long a message on those
+ * waits for an idle task. Shorter costs more wakeups; no shorter than the OS
+ * clock tick.
+ */
+#define SBN_SEND_TASK_POLL_TIME 5
+
+/**
+ * @brief How many times a housekeeping request tries for a consistent copy of
+ * a peer's counters while a send or receive task is updating them, sleeping a
+ * tick between tries, before reporting the copy it has.
+ */
+#define SBN_HK_SNAPSHOT_TRIES 4
+
+/**
+ * @brief If defined, the messages and bytes sent to and received from each
+ * peer are also counted per message ID, and SBN_HK_PEERMIDS_CC reports the
+ * message ID's with the most traffic to and from a peer.
+ */
+/* #define SBN_MID_STATS */
+
+/**
+ * @brief The number of message ID's (a power of two) counted for each peer in
+ * each direction, traffic for message ID's beyond this is not counted.
+ */
+#define SBN_MID_STATS_SZ 32
+
+/** @brief The number of message ID's SBN_HK_PEERMIDS_CC reports in each direction. */
+#define SBN_MID_STATS_TOP 8
+
+/**
+ * @brief The most message ID's a peer's configuration table entry can conflate
+ * (see SBN_Peer_Entry_t ConflateMIDs.) Each takes a slot of
+ * SBN_CONFLATE_MSG_SZ bytes in the peer.
+ */
+#define SBN_MAX_CONFLATE_PER_PEER 4
+
+/**
+ * @brief The largest conflated message a peer keeps the latest of, larger
+ * messages with a conflated message ID are sent as they are read.
+ */
+#define SBN_CONFLATE_MSG_SZ 512
+
+/**
+ * @brief The most message ID's the configuration table can give a time-to-live
+ * (see SBN_ConfTbl_t TTLs.) Each message read for a peer is looked up in them,
+ * so keep the table short.
+ */
+#define SBN_MAX_TTL_MIDS 16
+
+/**
+ * @brief The cache line size of the target, in bytes. State in each peer that
+ * is written by different tasks is kept at least this far apart.
+ */
+#define SBN_CACHE_LINE_SZ 64
+
+/**
+ * @brief If defined, peers with SBN_TASK_SEND do not each get their own send
+ * task. Instead this many send workers are created at startup and the peers
+ * are spread across them, so the number of tasks does not grow with the
+ * number of peers.
+ */
+/* #define SBN_SEND_WORKERS 2 */
+
+/**
+ * @brief A send worker sends at most this many messages to one peer before
+ * moving on to its next peer.
+ */
+#define SBN_SEND_WORKER_BATCH 8
+
+/**
+ * @brief If defined, peers that are polled (no SBN_TASK_SEND) do not get their
+ * own pipe. Instead SBN subscribes once per message ID on a single shared
+ * pipe and fans each message out to the subscribed peers itself, so SB only
+ * enqueues one copy of a message no matter how many peers want it.
+ */
+/* #define SBN_SHARED_PIPE */
+
+/**
+ * @brief Depth of the shared fan-out pipe, should be deep enough to handle
+ * all messages, for all polled peers, that will queue between wakeups.
+ */
+#define SBN_SHARED_PIPE_DEPTH 128
+
+/**
+ * @brief Depth of the shared fan-out pipe for high priority message ID's.
+ */
+#define SBN_SHARED_HI_PIPE_DEPTH 32
+
+/**
+ * @brief The maximum number of distinct message ID's that polled peers can
+ * be subscribed to when using the shared fan-out pipe.
+ */
+#define SBN_MAX_SHARED_SUBS 512
+
+/**
+ * @brief If defined, nets that are polled (no SBN_TASK_RECV) are received
+ * from by this many worker tasks rather than by the main task, net N being
+ * assigned to worker N % SBN_RECV_WORKERS. Workers put app messages on the
+ * software bus themselves and queue everything else (subscriptions, protocol)
+ * for the main task.
+ */
+/* #define SBN_RECV_WORKERS 2 */
+
+/**
+ * @brief How long (in milliseconds) a receive worker sleeps when none of its
+ * nets had any messages.
+ */
+#define SBN_RECV_WORKER_DELAY 10
+
+/**
+ * @brief Depth of the queue receive workers hand control messages to the main
+ * task on, should be deep enough for the control messages from all peers that
+ * arrive between wakeups.
+ */
+#define SBN_CTRL_QUEUE_DEPTH 32
+
+/**
+ * @brief If defined, send and receive tasks (and workers) pin themselves to
+ * the cores their SBN_TaskConf_t CoreMask gives, so SBN I/O can be kept off
+ * the cores running control loops. OSAL has no affinity call, so this uses
+ * pthread_setaffinity_np() and needs a POSIX OSAL on Linux.
+ */
+/* #define SBN_TASK_AFFINITY */
+
+/**
+ * @brief The number of message buffers (each SBN_MAX_PACKED_MSG_SZ bytes) in
+ * the pool that receive tasks, receive workers, the main task and protocol
+ * modules borrow from, if the configuration table's BufCnt is 0. Each receive
+ * task and worker holds one for as long as it runs, and a module may borrow
+ * one more while it receives or sends.
+ */
+#define SBN_BUF_POOL_CNT 16
+
+/**
+ * @brief The maximum number of fragments a single SB message can be split into
+ * when it does not fit in the MTU of a net.
+ */
+#define SBN_MAX_FRAGS 64
+
+/**
+ * @brief The number of SB messages, across all peers, that can be in the
+ * process of being reassembled from fragments at one time, if the
+ * configuration table's ReasmBufCnt is 0.
+ */
+#define SBN_MAX_REASM_BUFS 4
+
+/**
+ * @brief If not all fragments of a message have been received this long (in
+ * milliseconds) after the first, the partial message is dropped.
+ */
+#define SBN_REASM_TIMEOUT 2000
+
+/**
+ * @brief If defined, SBN bridges its nets: the subscriptions of peers on one
+ * net are passed on to the peers on the other nets, and app messages received
+ * from a peer are relayed to the peers on the other nets that subscribed.
+ */
+/* #define SBN_BRIDGE */
+
+/** @brief A relayed message is not relayed again after this many bridges. */
+#define SBN_BRIDGE_MAX_HOPS 4
+
+/**
+ * @brief Number of entries (a power of two) in the table a bridge (or bond)
+ * drops messages it has already received with, one entry per origin and message ID.
+ */
+#define SBN_DEDUP_SZ 64
+
+/**
+ * @brief If defined, peers that both define it pace the app messages they
+ * send each other with credit. A receiver grants a peer SBN_CREDIT_WINDOW
+ * messages at a time, and grants them again each time it has taken half as
+ * many, so when a receiver falls behind its sender holds messages in the
+ * peer's pipes (where SB drops the excess at the pipe's limits) rather than
+ * sending them on to be lost at the receiver.
+ */
+/* #define SBN_CREDITS */
+
+/** @brief The number of app messages a receiver grants a peer at a time. */
+#define SBN_CREDIT_WINDOW 32
+
+/**
+ * @brief A receiver that has received no app messages from a peer for this
+ * long (in milliseconds) grants it credit again, in case a grant, or the
+ * messages that would have earned one, were lost.
+ */
+#define SBN_CREDIT_REGRANT_TIME 1000
+
+/**
+ * @brief The most app messages from the shared pipe or a bridge, which have
+ * no pipe of the peer's to leave them in, held for a peer out of credit.
+ * Each takes a buffer from the pool (see SBN_BUF_POOL_CNT), and no more than
+ * half the pool is held for all peers together.
+ */
+#define SBN_CREDIT_HOLD_DEPTH 4
+
+/**
+ * @brief The failure detector's suspicion of a silent peer grows with how
+ * many mean deviations the silence runs past the mean interval between the
+ * peer's messages; at SBN_FD_THRESHOLD deviations the peer has failed. See
+ * SBN_PeerTimedOut().
+ */
+#define SBN_FD_THRESHOLD 4
+
+/**
+ * @brief However regular a peer's messages, it is not taken to have failed
+ * until it has been silent for this many of the net's heartbeat intervals.
+ */
+#define SBN_FD_MIN_HEARTBEATS 2
+
+/**
+ * @brief The intervals between a peer's messages the failure detector waits
+ * for (after connecting) before it goes by them, until then only the net's
+ * TimeoutMS applies.
+ */
+#define SBN_FD_MIN_SAMPLES 8
+
+/**
+ * @brief If defined, the peers with the same ProcessorID on different nets
+ * are bonded, as paths to one CPU. Each app message is sent over one path,
+ * the connected path on the lowest numbered net, so that when a path fails
+ * the next takes over; what arrives over more than one path is dropped by its
+ * CCSDS sequence count. See SBN_BondSends().
+ */
+/* #define SBN_BONDING */
+
+/**
+ * @brief App messages of at least this many bytes are spread over all the
+ * connected paths of a bond, by message ID (so each message ID keeps its
+ * order.) 0 sends every message over the preferred path.
+ */
+#define SBN_BOND_STRIPE_SZ 1024
+
+/* bridges and bonds both drop the app messages they receive more than once */
+#if defined(SBN_BRIDGE) || defined(SBN_BONDING)
+#define SBN_DEDUP
+#endif /* SBN_BRIDGE || SBN_BONDING */
+
+/**
+ * @brief The SBN_FEAT_* features this CPU advertises to peers when they
+ * connect. Only advertise features this build implements.
+ */
+#ifdef SBN_BRIDGE
+#define SBN_BRIDGE_FEATURES SBN_FEAT_RELAY
+#else
+#define SBN_BRIDGE_FEATURES 0
+#endif /* SBN_BRIDGE */
+
+#ifdef SBN_CREDITS
+#define SBN_CREDIT_FEATURES SBN_FEAT_CREDIT
+#else
+#define SBN_CREDIT_FEATURES 0
+#endif /* SBN_CREDITS */
+
+#define SBN_LOCAL_FEATURES (SBN_FEAT_FRAG | SBN_FEAT_SUBRANGE | SBN_BRIDGE_FEATURES | SBN_CREDIT_FEATURES)
+
+/**
+ * @brief The most SB messages this CPU will accept in one frame, advertised
+ * to peers (1 means no batching.)
+ */
+#define SBN_MAX_BATCH_MSGS 1
+
+/**
+ * @brief The number of reliable delivery lanes this CPU advertises to peers.
+ */
+#define SBN_MAX_REL_LANES 0
+
 /**
  * @brief The maximum number of subscription messages that will be queued
  * between wakeups.
@@ -97,7 +427,13 @@
 /** @brief Maximum number of protocol modules. */
 #define SBN_MAX_MOD_CNT 8
 
-/** @brief Maximum number of peers. */
+/**
+ * @brief Maximum number of entries in the configuration table (the peers on
+ * all nets plus an entry for this CPU on each net.) Peers, and their slots,
+ * are allocated for the entries a loaded table has, so raising this grows
+ * only the table. The TCP module's connections are bounded separately, by
+ * the OS_FdSet its select waits on (OS_MAX_NUM_OPEN_FILES.)
+ */
 #define SBN_MAX_PEER_CNT 16
 
 /**
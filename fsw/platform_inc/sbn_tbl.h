@@ -52,8 +52,53 @@ typedef struct
      *         TaskFlags setting.
      */
     SBN_Task_Flag_t TaskFlags;
+
+    /** @brief How to create this peer's send task and receive task, if TaskFlags asks for them. For the entry
+     *         describing this CPU, RecvTask is for the net's receive task and SendTask is ignored.
+     */
+    SBN_TaskConf_t SendTask, RecvTask;
+
+    /** @brief For the entry describing this CPU, the largest SBN message (header included) the net can carry in
+     *         one frame; larger SB messages are fragmented. 0 means no fragmentation. Ignored for other peers.
+     */
+    uint16 MTU;
+
+    /** @brief The most subscriptions to accept from this peer, at most SBN_MAX_SUBS_PER_PEER. 0 means
+     *         SBN_MAX_SUBS_PER_PEER. Ignored for the entry describing this CPU.
+     */
+    uint16 MaxSubs;
+
+    /** @brief For the entry describing this CPU, how long (in milliseconds) the net leaves a peer without a
+     *         message before sending it a heartbeat. 0 means the protocol module's default. Ignored for other
+     *         peers, which should use the same value as this CPU.
+     */
+    uint16 HeartbeatMS;
+
+    /** @brief For the entry describing this CPU, the longest (in milliseconds) a peer on the net may be silent
+     *         before it is taken to have failed; the failure detector may decide sooner (see
+     *         SBN_PeerTimedOut().) 0 means the protocol module's default. Ignored for other peers.
+     */
+    uint16 TimeoutMS;
+
+    /** @brief Message ID's of state-type telemetry for which only the latest message is kept for this peer
+     *         and sent when the link has room, rather than queueing every copy (see SBN_NextConflated().)
+     *         Unused entries are 0. Ignored for the entry describing this CPU.
+     */
+    CFE_SB_MsgId_t ConflateMIDs[SBN_MAX_CONFLATE_PER_PEER];
 } SBN_Peer_Entry_t;
 
+typedef struct
+{
+    /** @brief The message ID. */
+    CFE_SB_MsgId_t MsgID;
+
+    /** @brief How long (in milliseconds) after the time in its secondary header a message with this ID is
+     *         still worth sending; older messages are dropped rather than sent (see SBN_MsgExpired().) 0 means
+     *         it never expires.
+     */
+    uint32 TTLMS;
+} SBN_TTL_Entry_t;
+
 typedef struct
 {
     SBN_Module_Entry_t ProtocolModules[SBN_MAX_MOD_CNT];
@@ -62,6 +107,23 @@ typedef struct
     SBN_ModuleIdx_t    FilterCnt;
     SBN_Peer_Entry_t   Peers[SBN_MAX_PEER_CNT];
     SBN_PeerIdx_t      PeerCnt;
+    SBN_TTL_Entry_t    TTLs[SBN_MAX_TTL_MIDS];
+    uint16             TTLCnt;
+
+    /** @brief How to create the send and receive workers (SBN_SEND_WORKERS, SBN_RECV_WORKERS), applied at
+     *         startup only.
+     */
+    SBN_TaskConf_t SendWorkers, RecvWorkers;
+
+    /** @brief The number of message buffers in the pool (see SBN_GetBuf()), applied at startup only. 0 means
+     *         SBN_BUF_POOL_CNT.
+     */
+    uint16 BufCnt;
+
+    /** @brief The number of SB messages, across all peers, that can be reassembled from fragments at one time,
+     *         applied at startup only. 0 means SBN_MAX_REASM_BUFS.
+     */
+    uint16 ReasmBufCnt;
 } SBN_ConfTbl_t;
 
 #endif /* _sbn_tbl_h_ */
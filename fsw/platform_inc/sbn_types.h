@@ -64,11 +64,16 @@ typedef enum
  */
 typedef enum
 {
-    SBN_NO_MSG    = 0x00, /**< @brief no payload */
-    SBN_SUB_MSG   = 0x01, /**< @brief payload is subs */
-    SBN_UNSUB_MSG = 0x02, /**< @brief payload is unsubs */
-    SBN_APP_MSG   = 0x03, /**< @brief payload is SB msg */
-    SBN_PROTO_MSG = 0x04, /**< @brief payload is SBN proto */
+    SBN_NO_MSG         = 0x00, /**< @brief no payload */
+    SBN_SUB_MSG        = 0x01, /**< @brief payload is subs */
+    SBN_UNSUB_MSG      = 0x02, /**< @brief payload is unsubs */
+    SBN_APP_MSG        = 0x03, /**< @brief payload is SB msg */
+    SBN_PROTO_MSG      = 0x04, /**< @brief payload is SBN proto */
+    SBN_FRAG_MSG       = 0x05, /**< @brief payload is a fragment of an SB msg */
+    SBN_SUBRANGE_MSG   = 0x06, /**< @brief payload is subs to ranges of MIDs */
+    SBN_UNSUBRANGE_MSG = 0x07, /**< @brief payload is unsubs from ranges of MIDs */
+    SBN_RELAY_MSG      = 0x08, /**< @brief payload is an SB msg relayed by a bridge */
+    SBN_CREDIT_MSG     = 0x09, /**< @brief payload is a grant of credit to send app msgs */
 } SBN_MsgTypeEnum_t;
 
 /**
@@ -80,16 +85,60 @@ typedef enum
 /** @brief Id is always the same len, plus \0 */
 #define SBN_IDENT_LEN 48
 
-#define SBN_PROTO_VER 11
+#define SBN_PROTO_VER 12
+
+/**
+ * @brief The first protocol version whose SBN_PROTO_MSG carries capabilities
+ * after the version byte; earlier peers send the version byte only.
+ */
+#define SBN_PROTO_VER_CAPS 12
+
+/**
+ * Feature bits exchanged in the SBN_PROTO_MSG when peers connect, the
+ * features used with a peer are those both ends advertise.
+ */
+typedef enum
+{
+    SBN_FEAT_FRAG      = 0x01, /**< @brief can reassemble SBN_FRAG_MSG fragments */
+    SBN_FEAT_BATCH     = 0x02, /**< @brief can unpack several SB msgs from one frame */
+    SBN_FEAT_COMPRESS  = 0x04, /**< @brief can decompress payloads */
+    SBN_FEAT_RELIABLE  = 0x08, /**< @brief supports reliable delivery lanes */
+    SBN_FEAT_TIMESTAMP = 0x10, /**< @brief SBN headers carry a send timestamp */
+    SBN_FEAT_LEN32     = 0x20, /**< @brief SBN headers carry a 32-bit length */
+    SBN_FEAT_SUBRANGE  = 0x40, /**< @brief takes SBN_SUBRANGE_MSG and SBN_UNSUBRANGE_MSG */
+    SBN_FEAT_RELAY     = 0x80,  /**< @brief takes SBN_RELAY_MSG */
+    SBN_FEAT_CREDIT    = 0x100, /**< @brief paces app msgs with SBN_CREDIT_MSG grants */
+} SBN_FeatureEnum_t;
 
 /* used in local and peer subscription tables */
 typedef struct
 {
     uint32         InUseCtr;
     CFE_SB_MsgId_t MsgID;
+    /**
+     * @brief In a peer's table, the last message ID of the range MsgID starts
+     * (MsgID itself for a single message ID.) Not used in the local table.
+     */
+    CFE_SB_MsgId_t LastMsgID;
     CFE_SB_Qos_t   QoS;
 } SBN_Subs_t;
 
+/* how to create a send or receive task, from the configuration table */
+typedef struct
+{
+    /** @brief The priority passed to CFE_ES_CreateChildTask(), 0 being the highest. */
+    uint8 Priority;
+
+    /** @brief The stack size in bytes, 0 for CFE_PLATFORM_ES_DEFAULT_STACK_SIZE plus the task's own data. */
+    uint32 StackSz;
+
+    /**
+     * @brief The cores the task may run on, bit N for core N, 0 for any core.
+     * Only applied with SBN_TASK_AFFINITY.
+     */
+    uint32 CoreMask;
+} SBN_TaskConf_t;
+
 /* most/all scalars should be typedef'd for readability and type checking */
 typedef int16             SBN_MsgSz_t; /* needs to support < 0 for errs */
 typedef uint8             SBN_MsgType_t;
@@ -115,6 +164,9 @@ typedef int32             CFE_Status_t;
 typedef int16             SBN_SubCnt_t;
 typedef uint16            SBN_HKTlm_t;
 
+/** @brief The largest message size an SBN_MsgSz_t can hold. */
+#define SBN_MSGSZ_MAX 0x7FFF
+
 #define EVSSendInfo(E, ...) CFE_EVS_SendEvent((E), CFE_EVS_EventType_INFORMATION, __VA_ARGS__)
 #define EVSSendDbg(E, ...)  CFE_EVS_SendEvent((E), CFE_EVS_EventType_DEBUG, __VA_ARGS__)
 #define EVSSendErr(E, ...)  CFE_EVS_SendEvent((E), CFE_EVS_EventType_ERROR, __VA_ARGS__)
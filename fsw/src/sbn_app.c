@@ -23,6 +23,7 @@
  ** Include Files
  */
 #include <fcntl.h>
+#include <stdlib.h>
 
 #include "sbn_pack.h"
 #include "sbn_app.h"
@@ -36,6 +37,7 @@
 SBN_App_t SBN;
 
 #include <string.h>
+#include <stddef.h>
 #include "sbn_app.h"
 
 static SBN_Status_t UnloadModules(void)
@@ -73,6 +75,232 @@ static SBN_Status_t UnloadModules(void)
     return SBN_SUCCESS;
 } /* end UnloadModules() */
 
+/**
+ * Claims a peer's send or receive sequence for writing, waiting out any
+ * other writer. The sequence is odd while the fields are being written, so
+ * SBN_SnapshotPeer() can tell when its copy is torn.
+ *
+ * @param SeqPtr The sequence of the side to write.
+ * @return The (even) sequence before the write, for EndStamp().
+ */
+static uint32 BeginStamp(uint32 *SeqPtr)
+{
+    uint32 Seq = __atomic_load_n(SeqPtr, __ATOMIC_RELAXED);
+
+    while ((Seq & 1) != 0 || !__atomic_compare_exchange_n(SeqPtr, &Seq, Seq + 1, false, __ATOMIC_ACQUIRE,
+                                                          __ATOMIC_RELAXED))
+    {
+        if ((Seq & 1) != 0)
+        {
+            OS_TaskDelay(1);
+            Seq = __atomic_load_n(SeqPtr, __ATOMIC_RELAXED);
+        } /* end if */
+    }     /* end while */
+
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    return Seq;
+} /* end BeginStamp() */
+
+/**
+ * Releases a sequence claimed by BeginStamp(), publishing the write.
+ */
+static void EndStamp(uint32 *SeqPtr, uint32 Seq)
+{
+    __atomic_store_n(SeqPtr, Seq + 2, __ATOMIC_RELEASE);
+} /* end EndStamp() */
+
+/**
+ * Updates a peer's last send or receive time (and counter, if any).
+ */
+static void Stamp(uint32 *SeqPtr, OS_time_t *TimePtr, SBN_HKTlm_t *CntPtr)
+{
+    OS_time_t Now;
+    uint32    Seq = 0;
+
+    OS_GetLocalTime(&Now);
+
+    Seq = BeginStamp(SeqPtr);
+
+    SBN_HK_SET(TimePtr->seconds, Now.seconds);
+    SBN_HK_SET(TimePtr->microsecs, Now.microsecs);
+
+    if (CntPtr != NULL)
+    {
+        SBN_HK_INC(*CntPtr);
+    } /* end if */
+
+    EndStamp(SeqPtr, Seq);
+} /* end Stamp() */
+
+/**
+ * Clears a peer's last send or receive time and counter.
+ */
+static void ClearStamp(uint32 *SeqPtr, OS_time_t *TimePtr, SBN_HKTlm_t *CntPtr)
+{
+    uint32 Seq = BeginStamp(SeqPtr);
+
+    SBN_HK_SET(TimePtr->seconds, 0);
+    SBN_HK_SET(TimePtr->microsecs, 0);
+    SBN_HK_SET(*CntPtr, 0);
+
+    EndStamp(SeqPtr, Seq);
+} /* end ClearStamp() */
+
+/**
+ * Resets a peer's last send and receive times and counts while the send and
+ * receive tasks may be stamping them, so a snapshot never sees a half reset.
+ *
+ * @param Peer The peer to reset.
+ */
+void SBN_ResetStamps(SBN_PeerInterface_t *Peer)
+{
+    ClearStamp(&Peer->SendSeq, &Peer->LastSend, &Peer->SendCnt);
+    ClearStamp(&Peer->RecvSeq, &Peer->LastRecv, &Peer->RecvCnt);
+} /* end SBN_ResetStamps() */
+
+/**
+ * Milliseconds from one local time to another, negative if Now is before
+ * Then.
+ *
+ * @param Then The earlier time.
+ * @param Now The later time.
+ * @return The milliseconds elapsed.
+ */
+int32 SBN_ElapsedMS(OS_time_t *Then, OS_time_t *Now)
+{
+    return (int32)(Now->seconds - Then->seconds) * 1000 + ((int32)Now->microsecs - (int32)Then->microsecs) / 1000;
+} /* end SBN_ElapsedMS() */
+
+/**
+ * Records a message sent to the peer, called from the peer's send side.
+ *
+ * @param Peer The peer the message was sent to.
+ */
+static void StampSend(SBN_PeerInterface_t *Peer)
+{
+    Stamp(&Peer->SendSeq, &Peer->LastSend, &Peer->SendCnt);
+} /* end StampSend() */
+
+/**
+ * Records a message received from the peer, and the interval since the last
+ * one for the failure detector, called from the receive side.
+ *
+ * @param Peer The peer the message was received from.
+ */
+static void StampRecv(SBN_PeerInterface_t *Peer)
+{
+    /* only this side writes LastRecv */
+    OS_time_t Prev = Peer->LastRecv;
+
+    Stamp(&Peer->RecvSeq, &Peer->LastRecv, &Peer->RecvCnt);
+
+    SBN_RecordArrival(Peer, &Prev, &Peer->LastRecv);
+} /* end StampRecv() */
+
+#ifdef SBN_MID_STATS
+/**
+ * Counts an SB message sent to or received from a peer against its message
+ * ID, claiming a free entry for a new ID. Only the side that owns the table
+ * writes it, so the main task sees an entry's MsgID before it sees InUse.
+ *
+ * @param Tbl The peer's send or receive table.
+ * @param Msg The SB message.
+ * @param MsgSz The size of the message.
+ */
+static void CountMid(SBN_MidStats_t *Tbl, void *Msg, SBN_MsgSz_t MsgSz)
+{
+    CFE_SB_MsgId_t MsgID = CFE_SB_GetMsgId((CFE_SB_MsgPtr_t)Msg);
+    uint32         Idx   = SBN_MID_HASH(MsgID);
+    int            Probe = 0;
+
+    for (Probe = 0; Probe < SBN_MID_STATS_SZ; Probe++, Idx = (Idx + 1) & (SBN_MID_STATS_SZ - 1))
+    {
+        SBN_MidStats_t *Mid = &Tbl[Idx];
+
+        if (!Mid->InUse)
+        {
+            Mid->MsgID = MsgID;
+            __atomic_store_n(&Mid->InUse, true, __ATOMIC_RELEASE);
+        }
+        else if (Mid->MsgID != MsgID)
+        {
+            continue;
+        } /* end if */
+
+        SBN_HK_SET(Mid->MsgCnt, Mid->MsgCnt + 1);
+        SBN_HK_SET(Mid->Bytes, Mid->Bytes + MsgSz);
+        return;
+    } /* end for */
+
+    /* table full, this message ID is not counted */
+} /* end CountMid() */
+#endif /* SBN_MID_STATS */
+
+/**
+ * Copies one side's time and counter, returns false if the writer was part
+ * way through updating them.
+ */
+static bool CopySide(uint32 *SeqPtr, OS_time_t *TimePtr, SBN_HKTlm_t *CntPtr, OS_time_t *TimeCopy,
+                     SBN_HKTlm_t *CntCopy)
+{
+    uint32 Seq = __atomic_load_n(SeqPtr, __ATOMIC_ACQUIRE);
+
+    TimeCopy->seconds   = SBN_HK_GET(TimePtr->seconds);
+    TimeCopy->microsecs = SBN_HK_GET(TimePtr->microsecs);
+    *CntCopy            = SBN_HK_GET(*CntPtr);
+
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    return (Seq & 1) == 0 && __atomic_load_n(SeqPtr, __ATOMIC_RELAXED) == Seq;
+} /* end CopySide() */
+
+/**
+ * Takes a copy of a peer's HK counters for telemetry without stopping the
+ * tasks that update them. The last send time and count, and the last receive
+ * time and count, are each consistent with one another unless a writer stays
+ * part way through an update for all SBN_HK_SNAPSHOT_TRIES tries.
+ *
+ * @param Peer The peer to copy the counters of.
+ * @param Stats The copy.
+ * @return true if the copy is consistent.
+ */
+bool SBN_SnapshotPeer(SBN_PeerInterface_t *Peer, SBN_PeerStats_t *Stats)
+{
+    bool SendOK = false, RecvOK = false;
+    int  Try    = 0;
+
+    for (Try = 0; Try < SBN_HK_SNAPSHOT_TRIES; Try++)
+    {
+        if (Try > 0)
+        {
+            /* let a preempted writer finish its update */
+            OS_TaskDelay(1);
+        } /* end if */
+
+        if (!SendOK)
+        {
+            SendOK = CopySide(&Peer->SendSeq, &Peer->LastSend, &Peer->SendCnt, &Stats->LastSend, &Stats->SendCnt);
+        } /* end if */
+
+        if (!RecvOK)
+        {
+            RecvOK = CopySide(&Peer->RecvSeq, &Peer->LastRecv, &Peer->RecvCnt, &Stats->LastRecv, &Stats->RecvCnt);
+        } /* end if */
+
+        if (SendOK && RecvOK)
+        {
+            break;
+        } /* end if */
+    }     /* end for */
+
+    Stats->SendErrCnt  = SBN_HK_GET(Peer->SendErrCnt);
+    Stats->RecvErrCnt  = SBN_HK_GET(Peer->RecvErrCnt);
+    Stats->ReasmErrCnt = SBN_HK_GET(Peer->ReasmErrCnt);
+
+    return SendOK && RecvOK;
+} /* end SBN_SnapshotPeer() */
+
 /**
  * \brief Packs a CCSDS message with an SBN message header.
  * \note Ensures the SBN fields (CPU ID, MsgSz) and CCSDS message headers
@@ -117,27 +345,30 @@ void SBN_PackMsg(void *SBNBuf, SBN_MsgSz_t MsgSz, SBN_MsgType_t MsgType, CFE_Pro
 bool SBN_UnpackMsg(void *SBNBuf, SBN_MsgSz_t *MsgSzPtr, SBN_MsgType_t *MsgTypePtr, CFE_ProcessorID_t *ProcessorIDPtr,
                    void *Msg)
 {
-    uint8  t = 0;
+    uint8  t     = 0;
+    bool   Valid = true;
     Pack_t Pack;
+
+    CFE_ES_PerfLogEntry(SBN_PERF_UNPACK_ID);
+
     Pack_Init(&Pack, SBNBuf, SBN_MAX_PACKED_MSG_SZ, false);
     Unpack_Int16(&Pack, MsgSzPtr);
     Unpack_UInt8(&Pack, &t);
     *MsgTypePtr = t;
     Unpack_UInt32(&Pack, ProcessorIDPtr);
 
-    if (!*MsgSzPtr)
-    {
-        return true;
-    } /* end if */
-
     if (*MsgSzPtr < 0 || *MsgSzPtr > CFE_MISSION_SB_MAX_SB_MSG_SIZE)
     {
-        return false;
+        Valid = false;
+    }
+    else if (*MsgSzPtr)
+    {
+        Unpack_Data(&Pack, Msg, *MsgSzPtr);
     } /* end if */
 
-    Unpack_Data(&Pack, Msg, *MsgSzPtr);
+    CFE_ES_PerfLogExit(SBN_PERF_UNPACK_ID);
 
-    return true;
+    return Valid;
 } /* end SBN_UnpackMsg */
 
 /* Use a struct for all local variables in the task so we can specify exactly
@@ -155,7 +386,7 @@ typedef struct
     CFE_ProcessorID_t    ProcessorID;
     SBN_MsgType_t        MsgType;
     SBN_MsgSz_t          MsgSz;
-    uint8                Msg[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
+    uint8 *              Msg; /* from the buffer pool, held while the task runs */
 } RecvPeerTaskData_t;
 
 void SBN_RecvPeerTask(void)
@@ -199,9 +430,21 @@ void SBN_RecvPeerTask(void)
         return;
     } /* end if */
 
+    SBN_PinTask(&D.Peer->RecvTask);
+
+    D.Msg = SBN_GetBuf();
+    if (!D.Msg)
+    {
+        EVSSendErr(SBN_PEERTASK_EID, "no buffer for receive task (ProcessorID=%d)", (int)D.Peer->ProcessorID);
+        D.Peer->RecvTaskID = 0;
+        return;
+    } /* end if */
+
     while (1)
     {
-        D.Status = D.Net->IfOps->RecvFromPeer(D.Net, D.Peer, &D.MsgType, &D.MsgSz, &D.ProcessorID, &D.Msg);
+        CFE_ES_PerfLogEntry(SBN_PEER_PERF_ID(D.Peer, SBN_PERF_NETRECV_ID));
+        D.Status = D.Net->IfOps->RecvFromPeer(D.Net, D.Peer, &D.MsgType, &D.MsgSz, &D.ProcessorID, D.Msg);
+        CFE_ES_PerfLogExit(SBN_PEER_PERF_ID(D.Peer, SBN_PERF_NETRECV_ID));
 
         if (D.Status == SBN_IF_EMPTY)
         {
@@ -210,12 +453,13 @@ void SBN_RecvPeerTask(void)
 
         if (D.Status == SBN_SUCCESS)
         {
-            OS_GetLocalTime(&D.Peer->LastRecv);
+            StampRecv(D.Peer);
 
-            D.Status = SBN_ProcessNetMsg(D.Net, D.MsgType, D.ProcessorID, D.MsgSz, &D.Msg);
+            D.Status = SBN_ProcessNetMsg(D.Net, D.MsgType, D.ProcessorID, D.MsgSz, D.Msg);
 
             if (D.Status != SBN_SUCCESS)
             {
+                SBN_PutBuf(D.Msg);
                 D.Peer->RecvTaskID = 0;
                 return;
             } /* end if */
@@ -223,7 +467,8 @@ void SBN_RecvPeerTask(void)
         else
         {
             EVSSendErr(SBN_PEER_EID, "recv error (%d)", D.Status);
-            D.Peer->RecvErrCnt++;
+            SBN_PutBuf(D.Msg);
+            SBN_HK_INC(D.Peer->RecvErrCnt);
             D.Peer->RecvTaskID = 0;
             return;
         } /* end if */
@@ -240,7 +485,7 @@ typedef struct
     CFE_ProcessorID_t    ProcessorID;
     SBN_MsgType_t        MsgType;
     SBN_MsgSz_t          MsgSz;
-    uint8                Msg[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
+    uint8 *              Msg; /* from the buffer pool, held while the task runs */
 } RecvNetTaskData_t;
 
 void SBN_RecvNetTask(void)
@@ -270,11 +515,22 @@ void SBN_RecvNetTask(void)
         return;
     } /* end if */
 
+    SBN_PinTask(&D.Net->RecvTask);
+
+    D.Msg = SBN_GetBuf();
+    if (!D.Msg)
+    {
+        EVSSendErr(SBN_PEERTASK_EID, "no buffer for receive task (net #%d)", (int)D.NetIdx);
+        return;
+    } /* end if */
+
     while (1)
     {
         SBN_Status_t Status = SBN_SUCCESS;
 
-        Status = D.Net->IfOps->RecvFromNet(D.Net, &D.MsgType, &D.MsgSz, &D.ProcessorID, &D.Msg);
+        CFE_ES_PerfLogEntry(SBN_PERF_NET_ID(D.NetIdx));
+        Status = D.Net->IfOps->RecvFromNet(D.Net, &D.MsgType, &D.MsgSz, &D.ProcessorID, D.Msg);
+        CFE_ES_PerfLogExit(SBN_PERF_NET_ID(D.NetIdx));
 
         if (Status == SBN_IF_EMPTY)
         {
@@ -283,168 +539,470 @@ void SBN_RecvNetTask(void)
 
         if (Status != SBN_SUCCESS)
         {
-            return;
+            break;
         } /* end if */
 
         D.Peer = SBN_GetPeer(D.Net, D.ProcessorID);
         if (!D.Peer)
         {
             EVSSendErr(SBN_PEERTASK_EID, "unknown peer (ProcessorID=%d)", D.ProcessorID);
-            return;
+            break;
         } /* end if */
 
-        OS_GetLocalTime(&D.Peer->LastRecv);
+        StampRecv(D.Peer);
 
-        D.Status = SBN_ProcessNetMsg(D.Net, D.MsgType, D.ProcessorID, D.MsgSz, &D.Msg);
+        D.Status = SBN_ProcessNetMsg(D.Net, D.MsgType, D.ProcessorID, D.MsgSz, D.Msg);
 
         if (D.Status != SBN_SUCCESS)
         {
-            return;
+            break;
         } /* end if */
     }     /* end while */
+
+    SBN_PutBuf(D.Msg);
 } /* end SBN_RecvNetTask() */
 
 /**
- * Checks all interfaces for messages from peers.
- * Receive messages from the specified peer, injecting them onto the local
+ * Processes a message received from a net. When called from a receive
+ * worker, only app messages (and their fragments) are processed in place,
+ * everything else is control traffic and is handed to the main task.
+ *
+ * @param[in] Net The net the message was received on.
+ * @param[in] NetIdx The index of the net.
+ * @param[in] MsgType The SBN message type.
+ * @param[in] ProcessorID The sender.
+ * @param[in] MsgSz The size of the payload.
+ * @param[in] Msg The payload.
+ * @param[in] Handoff True when called from a receive worker.
+ *
+ * @return The status of processing, or of queueing, the message.
+ */
+static SBN_Status_t DispatchNetMsg(SBN_NetInterface_t *Net, SBN_NetIdx_t NetIdx, SBN_MsgType_t MsgType,
+                                   CFE_ProcessorID_t ProcessorID, SBN_MsgSz_t MsgSz, uint8 *Msg, bool Handoff)
+{
+#ifdef SBN_RECV_WORKERS
+    if (Handoff && MsgType != SBN_APP_MSG && MsgType != SBN_FRAG_MSG && MsgType != SBN_RELAY_MSG)
+    {
+        SBN_CtrlMsg_t CtrlMsg;
+        int32         Status = OS_SUCCESS;
+
+        if (MsgSz < 0 || MsgSz > SBN_MAX_CTRL_MSG_SZ)
+        {
+            EVSSendErr(SBN_PEERTASK_EID, "control message too large (MsgType=%d MsgSz=%d)", (int)MsgType, (int)MsgSz);
+            return SBN_ERROR;
+        } /* end if */
+
+        CtrlMsg.NetIdx      = NetIdx;
+        CtrlMsg.ProcessorID = ProcessorID;
+        CtrlMsg.MsgType     = MsgType;
+        CtrlMsg.MsgSz       = MsgSz;
+        memcpy(CtrlMsg.Msg, Msg, MsgSz);
+
+        Status = OS_QueuePut(SBN.CtrlQueue, &CtrlMsg, offsetof(SBN_CtrlMsg_t, Msg) + MsgSz, 0);
+        if (Status != OS_SUCCESS)
+        {
+            EVSSendErr(SBN_PEERTASK_EID, "unable to queue control message (Status=%d)", (int)Status);
+            return SBN_ERROR;
+        } /* end if */
+
+        return SBN_SUCCESS;
+    }  /* end if */
+#endif /* SBN_RECV_WORKERS */
+
+    return SBN_ProcessNetMsg(Net, MsgType, ProcessorID, MsgSz, Msg);
+} /* end DispatchNetMsg() */
+
+/**
+ * Receives messages from a polled net, injecting them onto the local
  * software bus.
+ *
+ * @param[in] Net The net to receive from.
+ * @param[in] NetIdx The index of the net.
+ * @param[in] Msg A buffer from SBN_GetBuf(), not cleared between messages.
+ * @param[in] Handoff True when called from a receive worker.
+ *
+ * @return The number of messages received.
  */
-SBN_Status_t SBN_RecvNetMsgs(void)
+static int RecvNet(SBN_NetInterface_t *Net, SBN_NetIdx_t NetIdx, uint8 *Msg, bool Handoff)
 {
     SBN_Status_t SBN_Status = 0;
-    uint8        Msg[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
+    int          RecvCnt    = 0;
 
-    SBN_NetIdx_t NetIdx = 0;
-    for (NetIdx = 0; NetIdx < SBN.NetCnt; NetIdx++)
+    if (Net->IfOps->RecvFromNet)
     {
-        SBN_NetInterface_t *Net = &SBN.Nets[NetIdx];
-        SBN_MsgType_t       MsgType;
-        SBN_MsgSz_t         MsgSz;
-        CFE_ProcessorID_t   ProcessorID;
+        SBN_MsgType_t     MsgType;
+        SBN_MsgSz_t       MsgSz;
+        CFE_ProcessorID_t ProcessorID;
 
-        if (Net->TaskFlags & SBN_TASK_RECV)
+        int MsgCnt = 0;
+        // TODO: make configurable
+        for (MsgCnt = 0; MsgCnt < 100; MsgCnt++) /* read at most 100 messages from the net */
         {
-            continue; /* separate task handles receiving from a net */
-        }             /* end if */
+            CFE_ES_PerfLogEntry(SBN_PERF_NET_ID(NetIdx));
+            SBN_Status = Net->IfOps->RecvFromNet(Net, &MsgType, &MsgSz, &ProcessorID, Msg);
+            CFE_ES_PerfLogExit(SBN_PERF_NET_ID(NetIdx));
+
+            if (SBN_Status == SBN_IF_EMPTY)
+            {
+                break; /* no (more) messages for this net, continue to next net */
+            }          /* end if */
+
+            RecvCnt++;
 
-        if (Net->IfOps->RecvFromNet)
+            /* for UDP, the message received may not be from the peer
+             * expected.
+             */
+            SBN_PeerInterface_t *Peer = SBN_GetPeer(Net, ProcessorID);
+
+            if (!Peer)
+            {
+                EVSSendInfo(SBN_PEERTASK_EID, "unknown peer (ProcessorID=%d)", ProcessorID);
+                /* may be a misconfiguration on my part...? continue processing msgs... */
+                continue;
+            } /* end if */
+
+            StampRecv(Peer);
+            DispatchNetMsg(Net, NetIdx, MsgType, ProcessorID, MsgSz, Msg, Handoff); /* ignore errors */
+        }                                                                           /* end for */
+    }
+    else if (Net->IfOps->RecvFromPeer)
+    {
+        SBN_PeerIdx_t PeerIdx = 0;
+        for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
         {
+            SBN_PeerInterface_t *Peer = &Net->Peers[PeerIdx];
+
+            if (Peer->Unused)
+            {
+                continue;
+            } /* end if */
+
             int MsgCnt = 0;
             // TODO: make configurable
-            for (MsgCnt = 0; MsgCnt < 100; MsgCnt++) /* read at most 100 messages from the net */
+            for (MsgCnt = 0; MsgCnt < 100; MsgCnt++) /* read at most 100 messages from peer */
             {
-                memset(Msg, 0, sizeof(Msg));
+                CFE_ProcessorID_t ProcessorID = 0;
+                SBN_MsgType_t     MsgType     = 0;
+                SBN_MsgSz_t       MsgSz       = 0;
 
-                SBN_Status = Net->IfOps->RecvFromNet(Net, &MsgType, &MsgSz, &ProcessorID, Msg);
+                CFE_ES_PerfLogEntry(SBN_PEER_PERF_ID(Peer, SBN_PERF_NETRECV_ID));
+                SBN_Status = Net->IfOps->RecvFromPeer(Net, Peer, &MsgType, &MsgSz, &ProcessorID, Msg);
+                CFE_ES_PerfLogExit(SBN_PEER_PERF_ID(Peer, SBN_PERF_NETRECV_ID));
 
                 if (SBN_Status == SBN_IF_EMPTY)
                 {
-                    break; /* no (more) messages for this net, continue to next net */
+                    break; /* no (more) messages for this peer, continue to next peer */
                 }          /* end if */
 
-                /* for UDP, the message received may not be from the peer
-                 * expected.
-                 */
-                SBN_PeerInterface_t *Peer = SBN_GetPeer(Net, ProcessorID);
+                RecvCnt++;
 
-                if (!Peer)
-                {
-                    EVSSendInfo(SBN_PEERTASK_EID, "unknown peer (ProcessorID=%d)", ProcessorID);
-                    /* may be a misconfiguration on my part...? continue processing msgs... */
-                    continue;
-                } /* end if */
+                StampRecv(Peer);
 
-                OS_GetLocalTime(&Peer->LastRecv);
-                SBN_ProcessNetMsg(Net, MsgType, ProcessorID, MsgSz, Msg); /* ignore errors */
-            }                                                             /* end for */
-        }
-        else if (Net->IfOps->RecvFromPeer)
-        {
-            SBN_PeerIdx_t PeerIdx = 0;
-            for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
-            {
-                SBN_PeerInterface_t *Peer = &Net->Peers[PeerIdx];
+                SBN_Status = DispatchNetMsg(Net, NetIdx, MsgType, ProcessorID, MsgSz, Msg, Handoff);
 
-                int MsgCnt = 0;
-                // TODO: make configurable
-                for (MsgCnt = 0; MsgCnt < 100; MsgCnt++) /* read at most 100 messages from peer */
+                if (SBN_Status != SBN_SUCCESS)
                 {
-                    CFE_ProcessorID_t ProcessorID = 0;
-                    SBN_MsgType_t     MsgType     = 0;
-                    SBN_MsgSz_t       MsgSz       = 0;
+                    break; /* continue to next peer */
+                }          /* end if */
+            }              /* end for */
+        }                  /* end for */
+    }
+    else
+    {
+        EVSSendErr(SBN_PEER_EID, "neither RecvFromPeer nor RecvFromNet defined for net #%d", NetIdx);
 
-                    memset(Msg, 0, sizeof(Msg));
+        /* meanwhile, continue to next net... */
+    } /* end if */
 
-                    SBN_Status = Net->IfOps->RecvFromPeer(Net, Peer, &MsgType, &MsgSz, &ProcessorID, Msg);
+    return RecvCnt;
+} /* end RecvNet() */
 
-                    if (SBN_Status == SBN_IF_EMPTY)
-                    {
-                        break; /* no (more) messages for this peer, continue to next peer */
-                    }          /* end if */
+#ifdef SBN_RECV_WORKERS
+typedef struct
+{
+    int                 WorkerIdx;
+    OS_TaskID_t         TaskID;
+    SBN_NetIdx_t        NetIdx;
+    SBN_NetInterface_t *Net;
+    int                 RecvCnt;
+    uint8 *             Msg; /* from the buffer pool, held while the worker runs */
+} RecvWorkerData_t;
 
-                    OS_GetLocalTime(&Peer->LastRecv);
+/**
+ * A receive worker polls the nets assigned to it (every SBN_RECV_WORKERS'th
+ * polled net), injecting app messages onto the software bus itself and
+ * handing control messages to the main task. Sleeps for
+ * SBN_RECV_WORKER_DELAY milliseconds when none of its nets had traffic.
+ */
+void SBN_RecvWorkerTask(void)
+{
+    RecvWorkerData_t D;
+    memset(&D, 0, sizeof(D));
+    if (CFE_ES_RegisterChildTask() != CFE_SUCCESS)
+    {
+        EVSSendErr(SBN_PEERTASK_EID, "unable to register child task");
+        return;
+    } /* end if */
 
-                    SBN_Status = SBN_ProcessNetMsg(Net, MsgType, ProcessorID, MsgSz, Msg);
+    D.TaskID = OS_TaskGetId();
 
-                    if (SBN_Status != SBN_SUCCESS)
-                    {
-                        break; /* continue to next peer */
-                    }          /* end if */
-                }              /* end for */
-            }                  /* end for */
-        }
-        else
+    for (D.WorkerIdx = 0; D.WorkerIdx < SBN_RECV_WORKERS; D.WorkerIdx++)
+    {
+        if (SBN.RecvWorkerIDs[D.WorkerIdx] == D.TaskID)
         {
-            EVSSendErr(SBN_PEER_EID, "neither RecvFromPeer nor RecvFromNet defined for net #%d", NetIdx);
-
-            /* meanwhile, continue to next net... */
+            break;
         } /* end if */
     }     /* end for */
 
-    return SBN_SUCCESS;
-} /* end SBN_RecvNetMsgs */
+    if (D.WorkerIdx == SBN_RECV_WORKERS)
+    {
+        EVSSendErr(SBN_PEERTASK_EID, "unable to connect task to receive worker");
+        return;
+    } /* end if */
+
+    SBN_PinTask(&SBN.Conf->RecvWorkers);
+
+    D.Msg = SBN_GetBuf();
+    if (!D.Msg)
+    {
+        EVSSendErr(SBN_PEERTASK_EID, "no buffer for receive worker %d", D.WorkerIdx);
+        return;
+    } /* end if */
+
+    while (1)
+    {
+        D.RecvCnt = 0;
+
+        /* a reload holds this while it changes the nets */
+        OS_MutSemTake(SBN.RecvWorkerMutexes[D.WorkerIdx]);
+
+        for (D.NetIdx = D.WorkerIdx; D.NetIdx < SBN.NetCnt; D.NetIdx += SBN_RECV_WORKERS)
+        {
+            D.Net = &SBN.Nets[D.NetIdx];
+
+            if (!D.Net->Configured || (D.Net->TaskFlags & SBN_TASK_RECV))
+            {
+                continue; /* separate task handles receiving from a net */
+            }             /* end if */
+
+            D.RecvCnt += RecvNet(D.Net, D.NetIdx, D.Msg, true);
+        } /* end for */
+
+        OS_MutSemGive(SBN.RecvWorkerMutexes[D.WorkerIdx]);
+
+        if (D.RecvCnt == 0)
+        {
+            OS_TaskDelay(SBN_RECV_WORKER_DELAY);
+        } /* end if */
+    }     /* end while */
+} /* end SBN_RecvWorkerTask() */
 
 /**
- * Sends a message to a peer using the module's SendNetMsg.
- *
- * @param MsgType SBN type of the message
- * @param MsgSz Size of the message
- * @param Msg Message to send
- * @param Peer The peer to send the message to.
- * @return Number of characters sent on success, -1 on error.
+ * Creates the receive workers and the queue they hand control messages to
+ * the main task on.
  *
+ * @return SBN_SUCCESS on success, SBN_ERROR otherwise.
  */
-SBN_Status_t SBN_SendNetMsg(SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Msg, SBN_PeerInterface_t *Peer)
+static SBN_Status_t CreateRecvWorkers(void)
 {
-    SBN_NetInterface_t *Net        = Peer->Net;
-    SBN_Status_t        SBN_Status = SBN_SUCCESS;
+    CFE_Status_t CFE_Status = CFE_SUCCESS;
+    int          WorkerIdx  = 0;
+    char         WorkerName[OS_MAX_API_NAME];
 
-    if (Peer->SendTaskID)
+    if (OS_QueueCreate(&SBN.CtrlQueue, "sbn_ctrl_queue", SBN_CTRL_QUEUE_DEPTH, sizeof(SBN_CtrlMsg_t), 0) !=
+        OS_SUCCESS)
+    {
+        EVSSendErr(SBN_INIT_EID, "error creating control queue for receive workers");
+        return SBN_ERROR;
+    } /* end if */
+
+    for (WorkerIdx = 0; WorkerIdx < SBN_RECV_WORKERS; WorkerIdx++)
     {
-        if (OS_MutSemTake(SBN.SendMutex) != OS_SUCCESS)
+        snprintf(WorkerName, sizeof(WorkerName), "sbn_rw_mutex_%d", WorkerIdx);
+        if (OS_MutSemCreate(&SBN.RecvWorkerMutexes[WorkerIdx], WorkerName, 0) != OS_SUCCESS)
         {
-            EVSSendErr(SBN_PEER_EID, "unable to take mutex");
+            EVSSendErr(SBN_INIT_EID, "error creating mutex for receive worker %d", WorkerIdx);
             return SBN_ERROR;
         } /* end if */
-    }     /* end if */
 
-    SBN_Status = Net->IfOps->Send(Peer, MsgType, MsgSz, Msg);
+        snprintf(WorkerName, sizeof(WorkerName), "sbn_rw_%d", WorkerIdx);
+        CFE_Status = SBN_CreateTask(&(SBN.RecvWorkerIDs[WorkerIdx]), WorkerName,
+                                    (CFE_ES_ChildTaskMainFuncPtr_t)&SBN_RecvWorkerTask, &SBN.Conf->RecvWorkers,
+                                    sizeof(RecvWorkerData_t));
 
-    if (SBN_Status != SBN_SUCCESS)
-    {
-        Peer->SendErrCnt++;
+        if (CFE_Status != CFE_SUCCESS)
+        {
+            EVSSendErr(SBN_INIT_EID, "error creating receive worker %d", WorkerIdx);
+            return SBN_ERROR;
+        } /* end if */
+    }     /* end for */
+
+    return SBN_SUCCESS;
+} /* end CreateRecvWorkers() */
+#endif /* SBN_RECV_WORKERS */
+
+/**
+ * Checks all interfaces for messages from peers.
+ * Receive messages from the specified peer, injecting them onto the local
+ * software bus. With receive workers, the workers do that and this only
+ * processes the control messages they have handed over.
+ */
+SBN_Status_t SBN_RecvNetMsgs(void)
+{
+#ifdef SBN_RECV_WORKERS
+    SBN_CtrlMsg_t CtrlMsg;
+    uint32        CopiedSz = 0;
+    int           MsgCnt   = 0;
+
+    for (MsgCnt = 0; MsgCnt < SBN_CTRL_QUEUE_DEPTH; MsgCnt++)
+    {
+        if (OS_QueueGet(SBN.CtrlQueue, &CtrlMsg, sizeof(CtrlMsg), &CopiedSz, OS_CHECK) != OS_SUCCESS)
+        {
+            break; /* no (more) control messages */
+        }          /* end if */
+
+        SBN_ProcessNetMsg(&SBN.Nets[CtrlMsg.NetIdx], CtrlMsg.MsgType, CtrlMsg.ProcessorID, CtrlMsg.MsgSz,
+                          CtrlMsg.Msg); /* ignore errors */
+    }                                   /* end for */
+#else  /* !SBN_RECV_WORKERS */
+    uint8 *Msg = SBN_GetBuf();
+
+    if (!Msg)
+    {
+        EVSSendErr(SBN_PEER_EID, "no buffer to receive into");
+        return SBN_ERROR;
+    } /* end if */
+
+    SBN_NetIdx_t NetIdx = 0;
+    for (NetIdx = 0; NetIdx < SBN.NetCnt; NetIdx++)
+    {
+        SBN_NetInterface_t *Net = &SBN.Nets[NetIdx];
+
+        if (Net->TaskFlags & SBN_TASK_RECV)
+        {
+            continue; /* separate task handles receiving from a net */
+        }             /* end if */
+
+        RecvNet(Net, NetIdx, Msg, false);
+    } /* end for */
+
+    SBN_PutBuf(Msg);
+#endif /* SBN_RECV_WORKERS */
+
+    return SBN_SUCCESS;
+} /* end SBN_RecvNetMsgs */
+
+/**
+ * Sends a message to a peer using the module's SendNetMsg. An app message for
+ * a peer out of credit, or with messages already held, is held until the peer
+ * grants credit (see SBN_HoldMsg().)
+ *
+ * @param MsgType SBN type of the message
+ * @param MsgSz Size of the message
+ * @param Msg Message to send
+ * @param Peer The peer to send the message to.
+ * @return Number of characters sent on success, -1 on error.
+ *
+ */
+SBN_Status_t SBN_SendNetMsg(SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Msg, SBN_PeerInterface_t *Peer)
+{
+#ifdef SBN_BONDING
+    if ((MsgType == SBN_APP_MSG || MsgType == SBN_RELAY_MSG) && !SBN_BondSends(Peer, MsgSz, Msg))
+    {
+        /* another path of the bond sends it */
+        return SBN_IF_EMPTY;
+    } /* end if */
+#endif /* SBN_BONDING */
+
+#ifdef SBN_CREDITS
+    if ((MsgType == SBN_APP_MSG || MsgType == SBN_RELAY_MSG) && (Peer->HeldCnt != 0 || !SBN_HasCredit(Peer)))
+    {
+        /* from the shared pipe or a bridge, which have no pipe of the peer's to leave it in */
+        return SBN_HoldMsg(Peer, MsgType, MsgSz, Msg);
+    } /* end if */
+#endif /* SBN_CREDITS */
+
+    return SBN_SendNetMsgNow(MsgType, MsgSz, Msg, Peer);
+} /* end SBN_SendNetMsg */
+
+/**
+ * Sends a message to a peer whether or not the peer has credit for it, see
+ * SBN_SendNetMsg().
+ *
+ * @param MsgType SBN type of the message
+ * @param MsgSz Size of the message
+ * @param Msg Message to send
+ * @param Peer The peer to send the message to.
+ * @return SBN_SUCCESS on success, otherwise the error status of the send.
+ */
+SBN_Status_t SBN_SendNetMsgNow(SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Msg, SBN_PeerInterface_t *Peer)
+{
+    SBN_NetInterface_t *Net        = Peer->Net;
+    SBN_Status_t        SBN_Status = SBN_SUCCESS;
+
+#ifdef SBN_CREDITS
+    bool Credited = MsgType == SBN_APP_MSG || MsgType == SBN_RELAY_MSG;
+#endif /* SBN_CREDITS */
+
+#ifdef SBN_MID_STATS
+    if (MsgType == SBN_APP_MSG && SBN.MidStats != NULL)
+    {
+        /* counted as offered to the peer, whether or not it is fragmented */
+        CountMid(SBN.MidStats[Peer->Slot].Send, Msg, MsgSz);
+    } /* end if */
+#endif /* SBN_MID_STATS */
+
+    if (SBN_NEEDS_FRAG(Peer, MsgType, MsgSz))
+    {
+        SBN_Status = SBN_SendFragmented(MsgSz, Msg, Peer);
+
+#ifdef SBN_CREDITS
+        if (SBN_Status == SBN_SUCCESS)
+        {
+            SBN_UseCredit(Peer);
+        } /* end if */
+#endif /* SBN_CREDITS */
+
+        return SBN_Status;
+    } /* end if */
+
+    if (Peer->SendTaskID)
+    {
+        if (OS_MutSemTake(Net->SendMutex) != OS_SUCCESS)
+        {
+            EVSSendErr(SBN_PEER_EID, "unable to take mutex");
+            return SBN_ERROR;
+        } /* end if */
+    }     /* end if */
+
+    CFE_ES_PerfLogEntry(SBN_PEER_PERF_ID(Peer, SBN_PERF_SEND_ID));
+    SBN_Status = Net->IfOps->Send(Peer, MsgType, MsgSz, Msg);
+    CFE_ES_PerfLogExit(SBN_PEER_PERF_ID(Peer, SBN_PERF_SEND_ID));
+
+    if (SBN_Status != SBN_SUCCESS)
+    {
+        SBN_HK_INC(Peer->SendErrCnt);
+
+        if (Peer->SendTaskID)
+        {
+            OS_MutSemGive(Net->SendMutex);
+        } /* end if */
 
         return SBN_Status;
     } /* end if */
 
-    /* for clients that need a poll or heartbeat, update time even when failing */
-    OS_GetLocalTime(&Peer->LastSend);
+    StampSend(Peer);
 
-    Peer->SendCnt++;
+#ifdef SBN_CREDITS
+    if (Credited)
+    {
+        SBN_UseCredit(Peer);
+    } /* end if */
+#endif /* SBN_CREDITS */
 
     if (Peer->SendTaskID)
     {
-        if (OS_MutSemGive(SBN.SendMutex) != OS_SUCCESS)
+        if (OS_MutSemGive(Net->SendMutex) != OS_SUCCESS)
         {
             EVSSendErr(SBN_PEER_EID, "unable to give mutex");
             return SBN_ERROR;
@@ -452,7 +1010,7 @@ SBN_Status_t SBN_SendNetMsg(SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Msg,
     }     /* end if */
 
     return SBN_SUCCESS;
-} /* end SBN_SendNetMsg */
+} /* end SBN_SendNetMsgNow */
 
 typedef struct
 {
@@ -466,6 +1024,152 @@ typedef struct
     SBN_PeerInterface_t *Peer;
 } SendTaskData_t;
 
+/**
+ * \brief Run a message through the outgoing filters of a peer.
+ *
+ * @param[in] Peer The peer the message is destined for.
+ * @param[in,out] SBMsgPtr The message, filters may modify it in place.
+ * @param[in,out] Filter_Context The filter context, the peer fields are set here.
+ *
+ * @return SBN_SUCCESS if the message should be sent, SBN_IF_EMPTY if a filter
+ *         rejected it, otherwise the error status of the failing filter.
+ */
+SBN_Status_t SBN_FilterSendMsg(SBN_PeerInterface_t *Peer, CFE_SB_MsgPtr_t SBMsgPtr, SBN_Filter_Ctx_t *Filter_Context)
+{
+    SBN_ModuleIdx_t FilterIdx  = 0;
+    SBN_Status_t    SBN_Status = SBN_SUCCESS;
+
+    Filter_Context->PeerProcessorID  = Peer->ProcessorID;
+    Filter_Context->PeerSpacecraftID = Peer->SpacecraftID;
+
+    CFE_ES_PerfLogEntry(SBN_PEER_PERF_ID(Peer, SBN_PERF_SENDFILTER_ID));
+
+    for (FilterIdx = 0; FilterIdx < Peer->FilterCnt; FilterIdx++)
+    {
+        if (Peer->Filters[FilterIdx]->FilterSend == NULL)
+        {
+            continue;
+        } /* end if */
+
+        SBN_Status = (Peer->Filters[FilterIdx]->FilterSend)(SBMsgPtr, Filter_Context);
+
+        if (SBN_Status != SBN_SUCCESS)
+        {
+            /* SBN_IF_EMPTY means the filter requests not sending this msg */
+            break;
+        } /* end if */
+    }     /* end for */
+
+    CFE_ES_PerfLogExit(SBN_PEER_PERF_ID(Peer, SBN_PERF_SENDFILTER_ID));
+
+    return SBN_Status;
+} /* end SBN_FilterSendMsg() */
+
+/**
+ * \brief Read the next message from a peer's pipes, high priority pipe first,
+ * then the latest conflated messages (see SBN_NextConflated()), then the low
+ * priority pipe.
+ *
+ * @param[out] SBMsgPtrPtr The message read.
+ * @param[in] Peer The peer whose pipes to read.
+ * @param[in] TimeOut CFE_SB_POLL, or how long to wait if the pipes are empty,
+ *            pending on the high priority pipe for SBN_SEND_TASK_POLL_TIME at
+ *            a time and checking the others in between.
+ *
+ * @return CFE_SUCCESS if a message was read, otherwise the CFE_SB_RcvMsg()
+ *         status.
+ */
+static CFE_Status_t ReadPeerPipes(CFE_SB_MsgPtr_t *SBMsgPtrPtr, SBN_PeerInterface_t *Peer, int32 TimeOut)
+{
+    CFE_Status_t CFE_Status = CFE_SUCCESS;
+    int32        Left       = TimeOut, Slice = 0;
+
+    while (1)
+    {
+        CFE_ES_PerfLogEntry(SBN_PEER_PERF_ID(Peer, SBN_PERF_PIPE_ID));
+
+        CFE_Status = CFE_SB_RcvMsg(SBMsgPtrPtr, Peer->HiPipe, CFE_SB_POLL);
+
+        if (CFE_Status == CFE_SB_NO_MESSAGE)
+        {
+            /* at most one waiting per conflated message ID, so these cannot starve the low priority pipe */
+            CFE_Status = SBN_NextConflated(SBMsgPtrPtr, Peer);
+        } /* end if */
+
+        if (CFE_Status == CFE_SB_NO_MESSAGE)
+        {
+            CFE_Status = CFE_SB_RcvMsg(SBMsgPtrPtr, Peer->Pipe, CFE_SB_POLL);
+        } /* end if */
+
+        CFE_ES_PerfLogExit(SBN_PEER_PERF_ID(Peer, SBN_PERF_PIPE_ID));
+
+        if (CFE_Status != CFE_SB_NO_MESSAGE || TimeOut == CFE_SB_POLL)
+        {
+            return CFE_Status;
+        } /* end if */
+
+        if (Left <= 0)
+        {
+            return CFE_SB_TIME_OUT;
+        } /* end if */
+
+        /* not logged, the task is idle while it pends; only a slice at a
+         * time, as SB cannot wake it for the other pipes */
+        Slice = Left < SBN_SEND_TASK_POLL_TIME ? Left : SBN_SEND_TASK_POLL_TIME;
+        Left -= Slice;
+
+        CFE_Status = CFE_SB_RcvMsg(SBMsgPtrPtr, Peer->HiPipe, Slice);
+
+        if (CFE_Status != CFE_SB_TIME_OUT)
+        {
+            return CFE_Status;
+        } /* end if */
+    }     /* end while */
+} /* end ReadPeerPipes() */
+
+/**
+ * \brief Read the next message destined for a peer (see ReadPeerPipes()),
+ * unless the peer is out of credit, dropping those older than their message
+ * ID's time-to-live (see SBN_MsgExpired().)
+ *
+ * @param[out] SBMsgPtrPtr The message read.
+ * @param[in] Peer The peer whose pipes to read.
+ * @param[in] TimeOut CFE_SB_POLL, or how long to pend on the high priority
+ *            pipe if both pipes are empty.
+ *
+ * @return CFE_SUCCESS if a message was read, otherwise the CFE_SB_RcvMsg()
+ *         status.
+ */
+static CFE_Status_t RcvPeerMsg(CFE_SB_MsgPtr_t *SBMsgPtrPtr, SBN_PeerInterface_t *Peer, int32 TimeOut)
+{
+    CFE_Status_t CFE_Status = CFE_SUCCESS;
+
+#ifdef SBN_CREDITS
+    if (SBN_HoldForCredit(Peer))
+    {
+        /* leave the messages in the pipes until the peer grants credit,
+         * all but the latest of each conflated message ID */
+        SBN_DrainConflated(Peer);
+
+        if (TimeOut == CFE_SB_POLL)
+        {
+            return CFE_SB_NO_MESSAGE;
+        } /* end if */
+
+        OS_TaskDelay(TimeOut);
+        return CFE_SB_TIME_OUT;
+    } /* end if */
+#endif /* SBN_CREDITS */
+
+    while ((CFE_Status = ReadPeerPipes(SBMsgPtrPtr, Peer, TimeOut)) == CFE_SUCCESS && SBN_MsgExpired(*SBMsgPtrPtr))
+    {
+        /* queued too long to be worth sending, make way for what is still current */
+        SBN_HK_INC(Peer->ExpiredCnt);
+    } /* end while */
+
+    return CFE_Status;
+} /* end RcvPeerMsg() */
+
 /**
  * \brief When a peer is connected, a task is created to listen to the relevant
  * pipe for messages to send to that peer.
@@ -474,6 +1178,7 @@ void SBN_SendTask(void)
 {
     SendTaskData_t   D;
     SBN_Filter_Ctx_t Filter_Context;
+    CFE_Status_t     CFE_Status = CFE_SUCCESS;
 
     Filter_Context.MyProcessorID  = CFE_PSP_GetProcessorId();
     Filter_Context.MySpacecraftID = CFE_PSP_GetSpacecraftId();
@@ -512,51 +1217,43 @@ void SBN_SendTask(void)
         return;
     } /* end if */
 
+    SBN_PinTask(&D.Peer->SendTask);
+
     while (1)
     {
-        SBN_ModuleIdx_t FilterIdx = 0;
-
         if (!D.Peer->Connected)
         {
             OS_TaskDelay(SBN_MAIN_LOOP_DELAY);
             continue;
         } /* end if */
 
-        if (CFE_SB_RcvMsg(&D.SBMsgPtr, D.Peer->Pipe, CFE_SB_PEND_FOREVER) != CFE_SUCCESS)
+        CFE_Status = RcvPeerMsg(&D.SBMsgPtr, D.Peer, SBN_SEND_TASK_PEND_TIME);
+
+        if (CFE_Status == CFE_SB_TIME_OUT)
         {
-            break;
+            continue;
         } /* end if */
 
-        Filter_Context.PeerProcessorID  = D.Peer->ProcessorID;
-        Filter_Context.PeerSpacecraftID = D.Peer->SpacecraftID;
-
-        for (FilterIdx = 0; FilterIdx < D.Peer->FilterCnt; FilterIdx++)
+        if (CFE_Status != CFE_SUCCESS)
         {
-            if (D.Peer->Filters[FilterIdx]->FilterSend == NULL)
-            {
-                continue;
-            } /* end if */
-
-            D.Status = (D.Peer->Filters[FilterIdx]->FilterSend)(D.SBMsgPtr, &Filter_Context);
-            if (D.Status == SBN_IF_EMPTY) /* filter requests not sending this msg, see below for loop */
-            {
-                break;
-            } /* end if */
+            break;
+        } /* end if */
 
-            if (D.Status != SBN_SUCCESS)
-            {
-                /* mark peer as not having a task so that sending will create a new one */
-                D.Peer->SendTaskID = 0;
-                return;
-            } /* end if */
-        }     /* end for */
+        D.Status = SBN_FilterSendMsg(D.Peer, D.SBMsgPtr, &Filter_Context);
 
-        if (FilterIdx < D.Peer->FilterCnt)
+        if (D.Status == SBN_IF_EMPTY)
         {
-            /* one of the above filters suggested rejecting this message */
+            /* one of the filters suggested rejecting this message */
             continue;
         } /* end if */
 
+        if (D.Status != SBN_SUCCESS)
+        {
+            /* mark peer as not having a task so that sending will create a new one */
+            D.Peer->SendTaskID = 0;
+            return;
+        } /* end if */
+
         D.Status = SBN_SendNetMsg(SBN_APP_MSG, CFE_SB_GetTotalMsgLength(D.SBMsgPtr), D.SBMsgPtr, D.Peer);
 
         if (D.Status == SBN_ERROR)
@@ -568,596 +1265,2248 @@ void SBN_SendTask(void)
     }     /* end while */
 } /* end SBN_SendTask() */
 
+#ifdef SBN_SEND_WORKERS
+typedef struct
+{
+    int                  WorkerIdx;
+    OS_TaskID_t          TaskID;
+    uint16               PeerIdx, Rotor;
+    int                  SentCnt, BatchCnt;
+    uint32               Gen;
+    CFE_SB_PipeId_t      PendPipe;
+    CFE_SB_MsgPtr_t      SBMsgPtr;
+    SBN_PeerInterface_t *Peer;
+} SendWorkerData_t;
+
 /**
- * Iterate through all peers, examining the pipe to see if there are messages
- * I need to send to that peer.
+ * \brief Filter a message and send it to a peer, dropping it if a filter
+ * rejects it or the send fails (the peer's error counters record that).
  */
-static SBN_Status_t CheckPeerPipes(void)
+static void SendWorkerMsg(SBN_PeerInterface_t *Peer, CFE_SB_MsgPtr_t SBMsgPtr, SBN_Filter_Ctx_t *Filter_Context)
 {
-    CFE_Status_t     CFE_Status;
-    int              ReceivedFlag = 0, iter = 0;
-    CFE_SB_MsgPtr_t  SBMsgPtr = 0;
-    SBN_Filter_Ctx_t Filter_Context;
+    if (SBN_FilterSendMsg(Peer, SBMsgPtr, Filter_Context) != SBN_SUCCESS)
+    {
+        return;
+    } /* end if */
 
-    Filter_Context.MyProcessorID  = CFE_PSP_GetProcessorId();
-    Filter_Context.MySpacecraftID = CFE_PSP_GetSpacecraftId();
+    SBN_SendNetMsg(SBN_APP_MSG, CFE_SB_GetTotalMsgLength(SBMsgPtr), SBMsgPtr, Peer); /* ignore errors */
+} /* end SendWorkerMsg() */
 
-    /**
-     * \note This processes one message per peer, then start again until no
-     * peers have pending messages. At max only process SBN_MAX_MSG_PER_WAKEUP
-     * per peer per wakeup otherwise I will starve other processing.
-     */
-    for (iter = 0; iter < SBN_MAX_MSG_PER_WAKEUP; iter++)
+/**
+ * \brief One pass of a send worker over its peers: drain up to
+ * SBN_SEND_WORKER_BATCH messages from each, or if all were empty pick the
+ * next connected peer to pend on, see SendWorkerPend().
+ *
+ * @return false if nothing was sent and the worker has no connected peer to
+ *         pend on.
+ */
+static bool SendWorkerPass(SendWorkerData_t *D, SBN_Filter_Ctx_t *Filter_Context)
+{
+    D->SentCnt = 0;
+
+    for (D->PeerIdx = 0; D->PeerIdx < SBN.SendWorkerPeerCnt[D->WorkerIdx]; D->PeerIdx++)
     {
-        ReceivedFlag = 0;
+        D->Peer = SBN.SendWorkerPeers[D->WorkerIdx][D->PeerIdx];
 
-        SBN_NetIdx_t NetIdx = 0;
-        for (NetIdx = 0; NetIdx < SBN.NetCnt; NetIdx++)
+        if (!D->Peer->Connected)
         {
-            SBN_NetInterface_t *Net = &SBN.Nets[NetIdx];
+            continue;
+        } /* end if */
 
-            SBN_PeerIdx_t PeerIdx = 0;
-            for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
+        for (D->BatchCnt = 0; D->BatchCnt < SBN_SEND_WORKER_BATCH; D->BatchCnt++)
+        {
+            if (RcvPeerMsg(&D->SBMsgPtr, D->Peer, CFE_SB_POLL) != CFE_SUCCESS)
             {
-                SBN_ModuleIdx_t      FilterIdx = 0;
-                SBN_PeerInterface_t *Peer      = &Net->Peers[PeerIdx];
-
-                if (Peer->Connected == 0)
-                {
-                    continue;
-                } /* end if */
-
-                if (Peer->TaskFlags & SBN_TASK_SEND)
-                {
-                    if (!Peer->SendTaskID)
-                    {
-                        /* TODO: logic/controls to prevent hammering? */
-                        char SendTaskName[32];
+                break;
+            } /* end if */
 
-                        snprintf(SendTaskName, 32, "sendT_%d_%d", NetIdx, Peer->ProcessorID);
-                        CFE_Status = CFE_ES_CreateChildTask(
-                            &(Peer->SendTaskID), SendTaskName, (CFE_ES_ChildTaskMainFuncPtr_t)&SBN_SendTask, NULL,
-                            CFE_PLATFORM_ES_DEFAULT_STACK_SIZE + 2 * sizeof(SendTaskData_t), 0, 0);
+            SendWorkerMsg(D->Peer, D->SBMsgPtr, Filter_Context);
+            D->SentCnt++;
+        } /* end for */
+    }     /* end for */
 
-                        if (CFE_Status != CFE_SUCCESS)
-                        {
-                            EVSSendErr(SBN_PEER_EID, "error creating send task for %d", Peer->ProcessorID);
-                            return SBN_ERROR;
-                        } /* end if */
-                    }     /* end if */
+    if (D->SentCnt != 0)
+    {
+        return true;
+    } /* end if */
 
-                    continue;
-                } /* end if */
+    /* all pipes empty, pend on the next connected peer in turn */
+    for (D->PeerIdx = 0; D->PeerIdx < SBN.SendWorkerPeerCnt[D->WorkerIdx]; D->PeerIdx++)
+    {
+        D->Rotor = (D->Rotor + 1) % SBN.SendWorkerPeerCnt[D->WorkerIdx];
+        D->Peer  = SBN.SendWorkerPeers[D->WorkerIdx][D->Rotor];
+
+        if (D->Peer->Connected
+#ifdef SBN_CREDITS
+            && !SBN_HoldForCredit(D->Peer)
+#endif /* SBN_CREDITS */
+        )
+        {
+            break;
+        } /* end if */
+    }     /* end for */
 
-                /* if peer data is not in use, go to next peer */
-                if (CFE_SB_RcvMsg(&SBMsgPtr, Peer->Pipe, CFE_SB_POLL) != CFE_SUCCESS)
-                {
-                    continue;
-                } /* end if */
+    if (D->PeerIdx == SBN.SendWorkerPeerCnt[D->WorkerIdx])
+    {
+        return false;
+    } /* end if */
 
-                ReceivedFlag = 1;
+    D->Gen      = SBN.SendWorkerGen;
+    D->PendPipe = D->Peer->HiPipe;
 
-                Filter_Context.PeerProcessorID  = Peer->ProcessorID;
-                Filter_Context.PeerSpacecraftID = Peer->SpacecraftID;
+    return true;
+} /* end SendWorkerPass() */
 
-                for (FilterIdx = 0; FilterIdx < Peer->FilterCnt; FilterIdx++)
-                {
-                    SBN_Status_t SBN_Status;
+/**
+ * \brief Pend on the high priority pipe SendWorkerPass() picked for
+ * SBN_SEND_TASK_POLL_TIME, without the worker's mutex so that a reload need
+ * not wait it out. The message is sent only if the peers have not been
+ * reassigned in the meantime, as the peer may be gone.
+ */
+static void SendWorkerPend(SendWorkerData_t *D, SBN_Filter_Ctx_t *Filter_Context)
+{
+    if (CFE_SB_RcvMsg(&D->SBMsgPtr, D->PendPipe, SBN_SEND_TASK_POLL_TIME) != CFE_SUCCESS)
+    {
+        return;
+    } /* end if */
 
-                    if (Peer->Filters[FilterIdx]->FilterSend == NULL)
-                    {
-                        continue;
-                    } /* end if */
+    OS_MutSemTake(SBN.SendWorkerMutexes[D->WorkerIdx]);
 
-                    SBN_Status = (Peer->Filters[FilterIdx]->FilterSend)(SBMsgPtr, &Filter_Context);
+    if (D->Gen == SBN.SendWorkerGen && D->Peer->Connected)
+    {
+        if (SBN_MsgExpired(D->SBMsgPtr))
+        {
+            SBN_HK_INC(D->Peer->ExpiredCnt);
+        }
+        else
+        {
+            SendWorkerMsg(D->Peer, D->SBMsgPtr, Filter_Context);
+        } /* end if */
+    }     /* end if */
 
-                    if (SBN_Status == SBN_IF_EMPTY) /* filter requests not sending this msg, see below for loop */
-                    {
-                        break;
-                    } /* end if */
+    OS_MutSemGive(SBN.SendWorkerMutexes[D->WorkerIdx]);
+} /* end SendWorkerPend() */
 
-                    if (SBN_Status != SBN_SUCCESS)
-                    {
-                        /* something fatal happened, exit */
-                        return SBN_Status;
-                    } /* end if */
-                }     /* end for */
+/**
+ * \brief A send worker serves the SBN_TASK_SEND peers assigned to it,
+ * draining up to SBN_SEND_WORKER_BATCH messages from each peer's pipes in
+ * turn. SB cannot pend on several pipes at once, so when all of them are
+ * empty the worker pends on one peer's high priority pipe, a different peer
+ * each time, for SBN_SEND_TASK_POLL_TIME.
+ */
+void SBN_SendWorkerTask(void)
+{
+    SendWorkerData_t D;
+    SBN_Filter_Ctx_t Filter_Context;
+    bool             Busy = false;
 
-                if (FilterIdx < Peer->FilterCnt)
-                {
-                    /* one of the above filters suggested rejecting this message */
-                    continue;
-                } /* end if */
+    Filter_Context.MyProcessorID  = CFE_PSP_GetProcessorId();
+    Filter_Context.MySpacecraftID = CFE_PSP_GetSpacecraftId();
 
-                SBN_SendNetMsg(SBN_APP_MSG, CFE_SB_GetTotalMsgLength(SBMsgPtr), SBMsgPtr, Peer);
-            } /* end for */
-        }     /* end for */
+    memset(&D, 0, sizeof(D));
+
+    if (CFE_ES_RegisterChildTask() != CFE_SUCCESS)
+    {
+        EVSSendErr(SBN_PEERTASK_EID, "unable to register child task");
+        return;
+    } /* end if */
+
+    D.TaskID = OS_TaskGetId();
 
-        if (!ReceivedFlag)
+    for (D.WorkerIdx = 0; D.WorkerIdx < SBN_SEND_WORKERS; D.WorkerIdx++)
+    {
+        if (SBN.SendWorkerIDs[D.WorkerIdx] == D.TaskID)
         {
             break;
         } /* end if */
     }     /* end for */
-    return SBN_SUCCESS;
-} /* end CheckPeerPipes */
+
+    if (D.WorkerIdx == SBN_SEND_WORKERS)
+    {
+        EVSSendErr(SBN_PEERTASK_EID, "unable to connect task to send worker");
+        return;
+    } /* end if */
+
+    SBN_PinTask(&SBN.Conf->SendWorkers);
+
+    while (1)
+    {
+        /* a reload holds this while it changes the peers */
+        OS_MutSemTake(SBN.SendWorkerMutexes[D.WorkerIdx]);
+        Busy = SendWorkerPass(&D, &Filter_Context);
+        OS_MutSemGive(SBN.SendWorkerMutexes[D.WorkerIdx]);
+
+        if (!Busy)
+        {
+            OS_TaskDelay(SBN_SEND_TASK_PEND_TIME); /* no connected peers it can send to */
+        }
+        else if (D.SentCnt == 0)
+        {
+            SendWorkerPend(&D, &Filter_Context);
+        } /* end if */
+    }     /* end while */
+} /* end SBN_SendWorkerTask() */
 
 /**
- * Iterate through all peers, calling the poll interface if no messages have
- * been sent in the last SBN_POLL_TIME seconds.
+ * \brief Spread the SBN_TASK_SEND peers across the send workers. Called
+ * whenever the peers or the workers change.
  */
-static SBN_Status_t PeerPoll(void)
+static void AssignSendWorkers(void)
 {
-    CFE_Status_t CFE_Status;
-    SBN_NetIdx_t NetIdx = 0;
+    SBN_NetIdx_t  NetIdx    = 0;
+    SBN_PeerIdx_t PeerIdx   = 0;
+    int           WorkerIdx = 0, PeerCnt = 0;
+
+    memset(SBN.SendWorkerPeerCnt, 0, sizeof(SBN.SendWorkerPeerCnt));
+    SBN.SendWorkerGen++;
+
     for (NetIdx = 0; NetIdx < SBN.NetCnt; NetIdx++)
     {
         SBN_NetInterface_t *Net = &SBN.Nets[NetIdx];
 
-        if (Net->IfOps->RecvFromNet && Net->TaskFlags & SBN_TASK_RECV)
+        for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
         {
-            if (!Net->RecvTaskID)
-            {
-                /* TODO: add logic/controls to prevent hammering */
-                char RecvTaskName[32];
-                snprintf(RecvTaskName, OS_MAX_API_NAME, "sbn_rs_%d", NetIdx);
-                CFE_Status = CFE_ES_CreateChildTask(
-                    &(Net->RecvTaskID), RecvTaskName, (CFE_ES_ChildTaskMainFuncPtr_t)&SBN_RecvNetTask, NULL,
-                    CFE_PLATFORM_ES_DEFAULT_STACK_SIZE + 2 * sizeof(RecvNetTaskData_t), 0, 0);
+            SBN_PeerInterface_t *Peer = &Net->Peers[PeerIdx];
 
-                if (CFE_Status != CFE_SUCCESS)
-                {
-                    EVSSendErr(SBN_PEER_EID, "error creating task for net %d", NetIdx);
-                    return SBN_ERROR;
-                } /* end if */
-            }     /* end if */
-        }
-        else
-        {
-            SBN_PeerIdx_t PeerIdx = 0;
-            for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
+            if (!(Peer->TaskFlags & SBN_TASK_SEND))
             {
-                SBN_PeerInterface_t *Peer = &Net->Peers[PeerIdx];
+                continue;
+            } /* end if */
 
-                if (Net->IfOps->RecvFromPeer && Peer->TaskFlags & SBN_TASK_RECV)
-                {
-                    if (!Peer->RecvTaskID)
-                    {
-                        /* TODO: add logic/controls to prevent hammering */
-                        char RecvTaskName[32];
-                        snprintf(RecvTaskName, OS_MAX_API_NAME, "sbn_recv_%d", PeerIdx);
-                        CFE_Status = CFE_ES_CreateChildTask(
-                            &(Peer->RecvTaskID), RecvTaskName, (CFE_ES_ChildTaskMainFuncPtr_t)&SBN_RecvPeerTask, NULL,
-                            CFE_PLATFORM_ES_DEFAULT_STACK_SIZE + 2 * sizeof(RecvPeerTaskData_t), 0, 0);
-                        /* TODO: more accurate stack size required */
-
-                        if (CFE_Status != CFE_SUCCESS)
-                        {
-                            EVSSendErr(SBN_PEER_EID, "error creating task for %d", Peer->ProcessorID);
-                            return SBN_ERROR;
-                        } /* end if */
-                    }     /* end if */
-                }
-                else
-                {
-                    Net->IfOps->PollPeer(Peer);
-                } /* end if */
-            }     /* end for */
-        }         /* end if */
-    }             /* end for */
+            WorkerIdx = PeerCnt++ % SBN_SEND_WORKERS;
 
-    return SBN_SUCCESS;
-} /* end PeerPoll */
+            /* SBN_SendNetMsg() serializes sends when the peer has a send task */
+            Peer->SendTaskID = SBN.SendWorkerIDs[WorkerIdx];
+
+            SBN.SendWorkerPeers[WorkerIdx][SBN.SendWorkerPeerCnt[WorkerIdx]++] = Peer;
+        } /* end for */
+    }     /* end for */
+} /* end AssignSendWorkers() */
 
 /**
- * Loops through all hosts and peers, initializing all.
+ * \brief Create the send workers and assign the peers to them.
  *
- * @return SBN_SUCCESS if interface is initialized successfully
- *         SBN_ERROR otherwise
+ * @return SBN_SUCCESS on success, SBN_ERROR otherwise.
  */
-static SBN_Status_t InitInterfaces(void)
+static SBN_Status_t CreateSendWorkers(void)
 {
-    if (SBN.NetCnt < 1)
-    {
-        EVSSendErr(SBN_PEER_EID, "no networks configured");
-
-        return SBN_ERROR;
-    } /* end if */
+    CFE_Status_t CFE_Status = CFE_SUCCESS;
+    int          WorkerIdx  = 0;
+    char         WorkerName[OS_MAX_API_NAME];
 
-    SBN_NetIdx_t NetIdx = 0;
-    for (NetIdx = 0; NetIdx < SBN.NetCnt; NetIdx++)
+    for (WorkerIdx = 0; WorkerIdx < SBN_SEND_WORKERS; WorkerIdx++)
     {
-        SBN_NetInterface_t *Net = &SBN.Nets[NetIdx];
-
-        if (!Net->Configured)
+        snprintf(WorkerName, sizeof(WorkerName), "sbn_sw_mutex_%d", WorkerIdx);
+        if (OS_MutSemCreate(&SBN.SendWorkerMutexes[WorkerIdx], WorkerName, 0) != OS_SUCCESS)
         {
-            EVSSendErr(SBN_PEER_EID, "network #%d not configured", NetIdx);
+            EVSSendErr(SBN_INIT_EID, "error creating mutex for send worker %d", WorkerIdx);
+            return SBN_ERROR;
+        } /* end if */
 
+        snprintf(WorkerName, sizeof(WorkerName), "sbn_sw_%d", WorkerIdx);
+        CFE_Status = SBN_CreateTask(&(SBN.SendWorkerIDs[WorkerIdx]), WorkerName,
+                                    (CFE_ES_ChildTaskMainFuncPtr_t)&SBN_SendWorkerTask, &SBN.Conf->SendWorkers,
+                                    sizeof(SendWorkerData_t));
+
+        if (CFE_Status != CFE_SUCCESS)
+        {
+            EVSSendErr(SBN_INIT_EID, "error creating send worker %d", WorkerIdx);
             return SBN_ERROR;
         } /* end if */
+    }     /* end for */
 
-        Net->IfOps->InitNet(Net);
+    AssignSendWorkers();
+
+    return SBN_SUCCESS;
+} /* end CreateSendWorkers() */
+#endif /* SBN_SEND_WORKERS */
+
+/**
+ * Iterate through all peers, examining the pipe to see if there are messages
+ * I need to send to that peer.
+ */
+static SBN_Status_t CheckPeerPipes(void)
+{
+    CFE_Status_t     CFE_Status;
+    SBN_Status_t     SBN_Status = SBN_SUCCESS;
+    SBN_PeerIdx_t    ReadyCnt = 0, ReadyIdx = 0, StillReady = 0;
+    int              iter     = 0;
+    CFE_SB_MsgPtr_t  SBMsgPtr = 0;
+    SBN_Filter_Ctx_t Filter_Context;
+
+    Filter_Context.MyProcessorID  = CFE_PSP_GetProcessorId();
+    Filter_Context.MySpacecraftID = CFE_PSP_GetSpacecraftId();
+
+    /* every connected peer whose pipe this task drains starts out ready */
+    SBN_NetIdx_t NetIdx = 0;
+    for (NetIdx = 0; NetIdx < SBN.NetCnt; NetIdx++)
+    {
+        SBN_NetInterface_t *Net = &SBN.Nets[NetIdx];
 
         SBN_PeerIdx_t PeerIdx = 0;
         for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
         {
             SBN_PeerInterface_t *Peer = &Net->Peers[PeerIdx];
 
-            Net->IfOps->InitPeer(Peer);
+            if (Peer->Connected == 0)
+            {
+                continue;
+            } /* end if */
+
+#ifdef SBN_SHARED_PIPE
+            if (SBN_USES_SHARED_PIPE(Peer))
+            {
+                /* fed from the shared pipe, see SBN_CheckSharedPipe() */
+                continue;
+            } /* end if */
+#endif /* SBN_SHARED_PIPE */
+
+#ifdef SBN_SEND_WORKERS
+            if (Peer->TaskFlags & SBN_TASK_SEND)
+            {
+                /* served by a send worker, see SBN_SendWorkerTask() */
+                continue;
+            } /* end if */
+#endif /* SBN_SEND_WORKERS */
+
+            if (Peer->TaskFlags & SBN_TASK_SEND)
+            {
+                if (!Peer->SendTaskID)
+                {
+                    /* TODO: logic/controls to prevent hammering? */
+                    char SendTaskName[32];
+
+                    snprintf(SendTaskName, 32, "sendT_%d_%d", NetIdx, Peer->ProcessorID);
+                    CFE_Status = SBN_CreateTask(&(Peer->SendTaskID), SendTaskName,
+                                                (CFE_ES_ChildTaskMainFuncPtr_t)&SBN_SendTask, &Peer->SendTask,
+                                                sizeof(SendTaskData_t));
+
+                    if (CFE_Status != CFE_SUCCESS)
+                    {
+                        EVSSendErr(SBN_PEER_EID, "error creating send task for %d", Peer->ProcessorID);
+                        return SBN_ERROR;
+                    } /* end if */
+                }     /* end if */
+
+                continue;
+            } /* end if */
+
+            SBN.ReadyPeers[ReadyCnt++] = Peer;
         } /* end for */
     }     /* end for */
 
-    EVSSendInfo(SBN_INIT_EID, "configured, %d nets", SBN.NetCnt);
-
-    for (NetIdx = 0; NetIdx < SBN.NetCnt; NetIdx++)
+    /**
+     * \note This processes one message per ready peer, then starts again
+     * with the peers that had one, until no peers have pending messages. A
+     * peer whose pipe is empty drops off the ready list for this wakeup, so
+     * later passes only visit the busy peers. At max only process
+     * SBN_MAX_MSG_PER_WAKEUP per peer per wakeup otherwise I will starve
+     * other processing.
+     */
+    for (iter = 0; iter < SBN_MAX_MSG_PER_WAKEUP && ReadyCnt > 0; iter++)
     {
-        EVSSendInfo(SBN_INIT_EID, "net %d has %d peers", NetIdx, SBN.Nets[NetIdx].PeerCnt);
+        StillReady = 0;
+
+        for (ReadyIdx = 0; ReadyIdx < ReadyCnt; ReadyIdx++)
+        {
+            SBN_PeerInterface_t *Peer = SBN.ReadyPeers[ReadyIdx];
+
+            if (RcvPeerMsg(&SBMsgPtr, Peer, CFE_SB_POLL) != CFE_SUCCESS)
+            {
+                continue;
+            } /* end if */
+
+            SBN.ReadyPeers[StillReady++] = Peer;
+
+            SBN_Status = SBN_FilterSendMsg(Peer, SBMsgPtr, &Filter_Context);
+
+            if (SBN_Status == SBN_IF_EMPTY)
+            {
+                /* one of the filters suggested rejecting this message */
+                continue;
+            } /* end if */
+
+            if (SBN_Status != SBN_SUCCESS)
+            {
+                /* something fatal happened, exit */
+                return SBN_Status;
+            } /* end if */
+
+            SBN_SendNetMsg(SBN_APP_MSG, CFE_SB_GetTotalMsgLength(SBMsgPtr), SBMsgPtr, Peer);
+        } /* end for */
+
+        ReadyCnt = StillReady;
     } /* end for */
 
     return SBN_SUCCESS;
-} /* end InitInterfaces */
+} /* end CheckPeerPipes */
 
+#ifdef SBN_SHARED_PIPE
 /**
- * This function waits for the scheduler (SCH) to wake this code up, so that
- * nothing transpires until the cFE is fully operational.
- *
- * @param[in] iTimeOut The time to wait for the scheduler to notify this code.
- * @return CFE_SUCCESS on success, otherwise an error value.
+ * \brief Is the peer one whose copy of a message from the shared pipe can go
+ * out in a single send to its net (see SendToNet)? Only when the peer's net
+ * can do that, the peer has no send filters to change its copy and takes the
+ * message without fragmenting (and, if bonded, is the path that sends it.)
  */
-static SBN_Status_t WaitForWakeup(int32 iTimeOut)
+static bool SharesNetSend(SBN_SharedSub_t *Sub, int PeerBit, SBN_MsgSz_t MsgSz, CFE_SB_MsgPtr_t SBMsgPtr)
 {
-    CFE_Status_t    CFE_Status = CFE_SUCCESS;
-    CFE_SB_MsgPtr_t Msg        = 0;
+    SBN_PeerInterface_t *Peer = SBN.Peers[PeerBit];
+
+    return (Sub->PeerMask[PeerBit / 32] & (1U << (PeerBit % 32))) && Peer != NULL && Peer->Connected &&
+           Peer->Net->IfOps->SendToNet != NULL && Peer->FilterCnt == 0 && !SBN_NEEDS_FRAG(Peer, SBN_APP_MSG, MsgSz)
+#ifdef SBN_CREDITS
+           && Peer->HeldCnt == 0 && SBN_HasCredit(Peer)
+#endif /* SBN_CREDITS */
+#ifdef SBN_BONDING
+           && SBN_BondSends(Peer, MsgSz, SBMsgPtr)
+#endif /* SBN_BONDING */
+        ;
+} /* end SharesNetSend() */
 
-    /* Wait for WakeUp messages from scheduler */
-    CFE_Status = CFE_SB_RcvMsg(&Msg, SBN.CmdPipe, iTimeOut);
+/**
+ * \brief How many connected peers on the net subscribed to a message ID,
+ * whether they are sent to from the shared pipe or from pipes of their own?
+ * All of them receive what is sent to the net.
+ */
+static SBN_PeerIdx_t NetSubCnt(SBN_NetInterface_t *Net, CFE_SB_MsgId_t MsgID)
+{
+    SBN_PeerIdx_t SubCnt = 0, PeerIdx = 0;
 
-    switch (CFE_Status)
+    for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
     {
-        case CFE_SB_NO_MESSAGE:
-        case CFE_SB_TIME_OUT:
-            break;
-        case CFE_SUCCESS:
-            SBN_HandleCommand(Msg);
-            break;
-        default:
-            return SBN_ERROR;
-    } /* end switch */
+        SBN_PeerInterface_t *Peer = &Net->Peers[PeerIdx];
 
-    /* For sbn, we still want to perform cyclic processing
-    ** if the WaitForWakeup time out
-    ** cyclic processing at timeout rate
-    */
-    CFE_ES_PerfLogEntry(SBN_PERF_RECV_ID);
+        if (Peer->Connected && SBN_PeerSubscribed(Peer, MsgID))
+        {
+            SubCnt++;
+        } /* end if */
+    }     /* end for */
 
-    SBN_RecvNetMsgs();
+    return SubCnt;
+} /* end NetSubCnt() */
 
-    SBN_CheckSubscriptionPipe();
+/**
+ * \brief Send a message from the shared pipe once to each net where two or
+ * more peers are subscribed to it and all of them can share the send, rather
+ * than once per peer. Every connected peer on the net gets the net's send, so
+ * if any subscribed peer cannot take it (it has filters, needs fragments, is
+ * out of credit, its bond sends over another path, or it has a send task and
+ * pipe of its own), all of that net's peers are sent to one by one instead.
+ *
+ * @param[in] Sub The shared subscription the message was received for.
+ * @param[in] SBMsgPtr The message.
+ * @param[out] SentMask The peers the message has been sent to.
+ */
+static void SendToNets(SBN_SharedSub_t *Sub, CFE_SB_MsgPtr_t SBMsgPtr, uint32 *SentMask)
+{
+    SBN_MsgSz_t    MsgSz = CFE_SB_GetTotalMsgLength(SBMsgPtr);
+    CFE_SB_MsgId_t MsgID = CFE_SB_GetMsgId(SBMsgPtr);
+    SBN_PeerIdx_t  NetPeerCnt[SBN_MAX_NETS];
+    bool           NetSent[SBN_MAX_NETS];
+    uint32 *       ShareMask = SBN.ShareMask;
+    int            PeerBit   = 0, NetIdx = 0;
+
+    memset(NetPeerCnt, 0, sizeof(NetPeerCnt));
+    memset(NetSent, 0, sizeof(NetSent));
+    memset(ShareMask, 0, SBN.PeerMaskWords * sizeof(*ShareMask));
+
+    for (PeerBit = 0; PeerBit < SBN.PeerSlots; PeerBit++)
+    {
+        SBN_PeerInterface_t *Peer = SBN.Peers[PeerBit];
 
-    CheckPeerPipes();
+        if (SharesNetSend(Sub, PeerBit, MsgSz, SBMsgPtr))
+        {
+            NetPeerCnt[Peer->Net - SBN.Nets]++;
+            ShareMask[PeerBit / 32] |= 1U << (PeerBit % 32);
+        } /* end if */
+    }     /* end for */
 
-    PeerPoll();
+    for (NetIdx = 0; NetIdx < SBN.NetCnt; NetIdx++)
+    {
+        SBN_NetInterface_t *Net = &SBN.Nets[NetIdx];
 
-    CFE_ES_PerfLogExit(SBN_PERF_RECV_ID);
+        if (NetPeerCnt[NetIdx] < 2 || NetPeerCnt[NetIdx] != NetSubCnt(Net, MsgID))
+        {
+            continue;
+        } /* end if */
 
-    return SBN_SUCCESS;
-} /* end WaitForWakeup */
+        CFE_ES_PerfLogEntry(SBN_PERF_SEND_ID);
+        NetSent[NetIdx] = Net->IfOps->SendToNet(Net, SBN_APP_MSG, MsgSz, SBMsgPtr) == SBN_SUCCESS;
+        CFE_ES_PerfLogExit(SBN_PERF_SEND_ID);
+    } /* end for */
+
+    for (PeerBit = 0; PeerBit < SBN.PeerSlots; PeerBit++)
+    {
+        SBN_PeerInterface_t *Peer = SBN.Peers[PeerBit];
+
+        if (!(ShareMask[PeerBit / 32] & (1U << (PeerBit % 32))) || !NetSent[Peer->Net - SBN.Nets])
+        {
+            continue;
+        } /* end if */
+
+#ifdef SBN_MID_STATS
+        if (SBN.MidStats != NULL)
+        {
+            CountMid(SBN.MidStats[Peer->Slot].Send, SBMsgPtr, MsgSz);
+        } /* end if */
+#endif /* SBN_MID_STATS */
+
+        StampSend(Peer);
+#ifdef SBN_CREDITS
+        SBN_UseCredit(Peer);
+#endif /* SBN_CREDITS */
+        SentMask[PeerBit / 32] |= 1U << (PeerBit % 32);
+    } /* end for */
+} /* end SendToNets() */
 
 /**
- * Waits for either a response to the "get subscriptions" message from SB, OR
- * an event message that says SB has finished initializing. The latter message
- * means that SB was not started at the time SBN sent the "get subscriptions"
- * message, so that message will need to be sent again.
+ * Count a message from the shared pipe older than its time-to-live as dropped
+ * for each connected peer subscribed to it.
  *
- * @return SBN_SUCCESS or SBN_ERROR
+ * @param[in] Sub The message ID's subscription.
  */
-static SBN_Status_t WaitForSBStartup(void)
+static void CountExpired(SBN_SharedSub_t *Sub)
 {
-    CFE_EVS_LongEventTlm_t *EvsTlm    = NULL;
-    CFE_SB_MsgPtr_t         SBMsgPtr  = 0;
-    uint8                   counter   = 0;
-    CFE_SB_PipeId_t         EventPipe = 0;
-    CFE_Status_t            Status    = SBN_SUCCESS;
+    int PeerBit = 0;
 
-    /* Create event message pipe */
-    Status = CFE_SB_CreatePipe(&EventPipe, 20, "SBNEventPipe");
-    if (Status != CFE_SUCCESS)
+    for (PeerBit = 0; PeerBit < SBN.PeerSlots; PeerBit++)
     {
-        EVSSendErr(SBN_INIT_EID, "failed to create event pipe (%d)", (int)Status);
-        return SBN_ERROR;
+        SBN_PeerInterface_t *Peer = SBN.Peers[PeerBit];
+
+        if ((Sub->PeerMask[PeerBit / 32] & (1U << (PeerBit % 32))) && Peer != NULL && Peer->Connected)
+        {
+            SBN_HK_INC(Peer->ExpiredCnt);
+        } /* end if */
+    }     /* end for */
+} /* end CountExpired() */
+
+/**
+ * Drain the shared pipe, sending each message to every connected peer that
+ * has subscribed to its message ID, once to a net for the peers that can
+ * share a send.
+ */
+SBN_Status_t SBN_CheckSharedPipe(void)
+{
+    /* filters modify the message in place so each peer gets its own copy, taken from the pool when first needed */
+    void *           FilterBuf  = NULL;
+    SBN_Status_t     SBN_Status = SBN_SUCCESS;
+    CFE_SB_MsgPtr_t  SBMsgPtr   = 0;
+    CFE_SB_MsgId_t   MsgID      = 0;
+    SBN_SharedSub_t *Sub        = NULL;
+    uint32 *         SentMask   = SBN.SentMask;
+    SBN_Filter_Ctx_t Filter_Context;
+    int              MsgCnt = 0, PeerBit = 0;
+
+    Filter_Context.MyProcessorID  = CFE_PSP_GetProcessorId();
+    Filter_Context.MySpacecraftID = CFE_PSP_GetSpacecraftId();
+
+    for (MsgCnt = 0; MsgCnt < SBN_SHARED_PIPE_DEPTH + SBN_SHARED_HI_PIPE_DEPTH; MsgCnt++)
+    {
+        CFE_ES_PerfLogEntry(SBN_PERF_PIPE_ID);
+
+        /* high priority lane first */
+        if (CFE_SB_RcvMsg(&SBMsgPtr, SBN.SharedHiPipe, CFE_SB_POLL) != CFE_SUCCESS &&
+            CFE_SB_RcvMsg(&SBMsgPtr, SBN.SharedPipe, CFE_SB_POLL) != CFE_SUCCESS)
+        {
+            CFE_ES_PerfLogExit(SBN_PERF_PIPE_ID);
+            break;
+        } /* end if */
+
+        CFE_ES_PerfLogExit(SBN_PERF_PIPE_ID);
+
+        MsgID = CFE_SB_GetMsgId(SBMsgPtr);
+        if (MsgID > CFE_PLATFORM_SB_HIGHEST_VALID_MSGID || !SBN.SharedSubIdx[MsgID])
+        {
+            /* peers unsubscribed while the message was queued */
+            continue;
+        } /* end if */
+
+        Sub = &SBN.SharedSubs[SBN.SharedSubIdx[MsgID] - 1];
+
+        if (SBN_MsgExpired(SBMsgPtr))
+        {
+            /* queued too long to be worth sending to any of them */
+            CountExpired(Sub);
+            continue;
+        } /* end if */
+
+        memset(SentMask, 0, SBN.PeerMaskWords * sizeof(*SentMask));
+        if (Sub->PeerCnt > 1)
+        {
+            SendToNets(Sub, SBMsgPtr, SentMask);
+        } /* end if */
+
+        for (PeerBit = 0; PeerBit < SBN.PeerSlots; PeerBit++)
+        {
+            SBN_PeerInterface_t *Peer    = NULL;
+            CFE_SB_MsgPtr_t      SendPtr = SBMsgPtr;
+
+            if (!Sub->PeerMask[PeerBit / 32])
+            {
+                /* skip the rest of an empty word */
+                PeerBit |= 31;
+                continue;
+            } /* end if */
+
+            if (!(Sub->PeerMask[PeerBit / 32] & ~SentMask[PeerBit / 32] & (1U << (PeerBit % 32))))
+            {
+                continue;
+            } /* end if */
+
+            Peer = SBN.Peers[PeerBit];
+
+            if (Peer == NULL || !Peer->Connected)
+            {
+                continue;
+            } /* end if */
+
+            if (Peer->FilterCnt)
+            {
+                if (FilterBuf == NULL && (FilterBuf = SBN_GetBuf()) == NULL)
+                {
+                    /* the pool is empty, so the filters have no copy to work on */
+                    continue;
+                } /* end if */
+
+                memcpy(FilterBuf, SBMsgPtr, CFE_SB_GetTotalMsgLength(SBMsgPtr));
+                SendPtr = (CFE_SB_MsgPtr_t)FilterBuf;
+            } /* end if */
+
+            SBN_Status = SBN_FilterSendMsg(Peer, SendPtr, &Filter_Context);
+
+            if (SBN_Status == SBN_IF_EMPTY)
+            {
+                /* one of the filters suggested rejecting this message */
+                continue;
+            } /* end if */
+
+            if (SBN_Status != SBN_SUCCESS)
+            {
+                /* something fatal happened, exit */
+                SBN_PutBuf(FilterBuf);
+                return SBN_Status;
+            } /* end if */
+
+            SBN_SendNetMsg(SBN_APP_MSG, CFE_SB_GetTotalMsgLength(SendPtr), SendPtr, Peer);
+        } /* end for */
+    }     /* end for */
+
+    SBN_PutBuf(FilterBuf);
+
+    return SBN_SUCCESS;
+} /* end SBN_CheckSharedPipe */
+#endif /* SBN_SHARED_PIPE */
+
+/**
+ * Puts the peer on the poll wheel, due Peer->PollDelayMS after tick Now (at
+ * least the next tick, at most one turn of the wheel.)
+ */
+static void SchedulePeerPoll(SBN_PeerInterface_t *Peer, uint32 Now)
+{
+    uint32 Ticks = (Peer->PollDelayMS + SBN_POLL_WHEEL_TICK - 1) / SBN_POLL_WHEEL_TICK;
+    uint32 Slot  = 0;
+
+    if (Ticks < 1)
+    {
+        Ticks = 1;
     } /* end if */
 
-    /* Subscribe to event messages temporarily to be notified when SB is done
-     * initializing
-     */
-    Status = CFE_SB_Subscribe(CFE_EVS_LONG_EVENT_MSG_MID, EventPipe);
-    if (Status != CFE_SUCCESS)
+    if (Ticks > SBN_POLL_WHEEL_SLOTS - 1)
     {
-        EVSSendErr(SBN_INIT_EID, "failed to subscribe to event pipe (%d)", (int)Status);
+        Ticks = SBN_POLL_WHEEL_SLOTS - 1;
+    } /* end if */
+
+    Slot = (Now + Ticks) % SBN_POLL_WHEEL_SLOTS;
+
+    Peer->PollNext      = SBN.PollWheel[Slot];
+    SBN.PollWheel[Slot] = Peer;
+} /* end SchedulePeerPoll() */
+
+/**
+ * Polls a peer that came due on the poll wheel (or creates its receive task)
+ * and puts it back on the wheel.
+ */
+static SBN_Status_t PollDuePeer(SBN_PeerInterface_t *Peer, uint32 Now)
+{
+    CFE_Status_t        CFE_Status;
+    SBN_NetInterface_t *Net = Peer->Net;
+
+    if (Net->IfOps->RecvFromNet && Net->TaskFlags & SBN_TASK_RECV)
+    {
+        /* the net's receive task serves its peers, the peer is not polled */
+        return SBN_SUCCESS;
+    } /* end if */
+
+    Peer->PollDelayMS = 0;
+
+    if (Net->IfOps->RecvFromPeer && Peer->TaskFlags & SBN_TASK_RECV)
+    {
+        /* check on the receive task about once a second */
+        Peer->PollDelayMS = 1000;
+
+        if (!Peer->RecvTaskID)
+        {
+            /* TODO: add logic/controls to prevent hammering */
+            char RecvTaskName[32];
+            snprintf(RecvTaskName, OS_MAX_API_NAME, "sbn_recv_%d", (int)(Peer - Net->Peers));
+            CFE_Status = SBN_CreateTask(&(Peer->RecvTaskID), RecvTaskName,
+                                        (CFE_ES_ChildTaskMainFuncPtr_t)&SBN_RecvPeerTask, &Peer->RecvTask,
+                                        sizeof(RecvPeerTaskData_t));
+
+            if (CFE_Status != CFE_SUCCESS)
+            {
+                EVSSendErr(SBN_PEER_EID, "error creating task for %d", Peer->ProcessorID);
+                SchedulePeerPoll(Peer, Now);
+                return SBN_ERROR;
+            } /* end if */
+        }     /* end if */
+    }
+    else
+    {
+        CFE_ES_PerfLogEntry(SBN_PEER_PERF_ID(Peer, SBN_PERF_POLL_ID));
+        Net->IfOps->PollPeer(Peer);
+        CFE_ES_PerfLogExit(SBN_PEER_PERF_ID(Peer, SBN_PERF_POLL_ID));
+    } /* end if */
+
+    SchedulePeerPoll(Peer, Now);
+
+    return SBN_SUCCESS;
+} /* end PollDuePeer() */
+
+/**
+ * Creates the receive tasks of nets that need them, then polls the peers
+ * that are due on the poll wheel. Modules put off polling peers that need no
+ * attention with SBN_SchedulePoll(), so a wakeup does not visit every peer.
+ */
+static SBN_Status_t PeerPoll(void)
+{
+    CFE_Status_t         CFE_Status;
+    SBN_NetIdx_t         NetIdx = 0;
+    SBN_PeerInterface_t *Peer = NULL, *Next = NULL, *Due = NULL;
+    OS_time_t            CurrentTime;
+    uint32               Now = 0, Slot = 0;
+
+    for (NetIdx = 0; NetIdx < SBN.NetCnt; NetIdx++)
+    {
+        SBN_NetInterface_t *Net = &SBN.Nets[NetIdx];
+
+        if (Net->IfOps->RecvFromNet && Net->TaskFlags & SBN_TASK_RECV)
+        {
+            if (!Net->RecvTaskID)
+            {
+                /* TODO: add logic/controls to prevent hammering */
+                char RecvTaskName[32];
+                snprintf(RecvTaskName, OS_MAX_API_NAME, "sbn_rs_%d", NetIdx);
+                CFE_Status = SBN_CreateTask(&(Net->RecvTaskID), RecvTaskName,
+                                            (CFE_ES_ChildTaskMainFuncPtr_t)&SBN_RecvNetTask, &Net->RecvTask,
+                                            sizeof(RecvNetTaskData_t));
+
+                if (CFE_Status != CFE_SUCCESS)
+                {
+                    EVSSendErr(SBN_PEER_EID, "error creating task for net %d", NetIdx);
+                    return SBN_ERROR;
+                } /* end if */
+            }     /* end if */
+        }         /* end if */
+    }             /* end for */
+
+    OS_GetLocalTime(&CurrentTime);
+    Now = SBN_POLL_TICK(&CurrentTime);
+
+    if ((int32)(Now - SBN.PollTick) >= SBN_POLL_WHEEL_SLOTS)
+    {
+        /* late by a turn of the wheel or more, every slot is due once */
+        SBN.PollTick = Now - SBN_POLL_WHEEL_SLOTS + 1;
+    } /* end if */
+
+    /* take every peer due since the last wakeup off the wheel before polling */
+    while ((int32)(Now - SBN.PollTick) >= 0)
+    {
+        Slot = SBN.PollTick++ % SBN_POLL_WHEEL_SLOTS;
+
+        for (Peer = SBN.PollWheel[Slot]; Peer != NULL; Peer = Next)
+        {
+            Next           = Peer->PollNext;
+            Peer->PollNext = Due;
+            Due            = Peer;
+        } /* end for */
+
+        SBN.PollWheel[Slot] = NULL;
+    } /* end while */
+
+    for (Peer = Due; Peer != NULL; Peer = Next)
+    {
+        Next = Peer->PollNext;
+
+        if (PollDuePeer(Peer, Now) != SBN_SUCCESS)
+        {
+            /* put the rest back to be polled on the next wakeup */
+            for (Peer = Next; Peer != NULL; Peer = Next)
+            {
+                Next = Peer->PollNext;
+                SchedulePeerPoll(Peer, Now);
+            } /* end for */
+
+            return SBN_ERROR;
+        } /* end if */
+    }     /* end for */
+
+    return SBN_SUCCESS;
+} /* end PeerPoll */
+
+/**
+ * Loops through all hosts and peers, initializing all.
+ *
+ * @return SBN_SUCCESS if interface is initialized successfully
+ *         SBN_ERROR otherwise
+ */
+static SBN_Status_t InitInterfaces(void)
+{
+    if (SBN.NetCnt < 1)
+    {
+        EVSSendErr(SBN_PEER_EID, "no networks configured");
+
         return SBN_ERROR;
     } /* end if */
 
-    while (1)
+    SBN_NetIdx_t NetIdx = 0;
+    for (NetIdx = 0; NetIdx < SBN.NetCnt; NetIdx++)
     {
-        /* Check for subscription message from SB */
-        if (SBN_CheckSubscriptionPipe() == SBN_SUCCESS)
+        SBN_NetInterface_t *Net = &SBN.Nets[NetIdx];
+
+        if (!Net->Configured)
         {
-            /* SBN does not need to re-send request messages to SB */
+            EVSSendErr(SBN_PEER_EID, "network #%d not configured", NetIdx);
+
+            return SBN_ERROR;
+        } /* end if */
+
+        Net->IfOps->InitNet(Net);
+
+        SBN_PeerIdx_t PeerIdx = 0;
+        for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
+        {
+            SBN_PeerInterface_t *Peer = &Net->Peers[PeerIdx];
+
+            Net->IfOps->InitPeer(Peer);
+        } /* end for */
+    }     /* end for */
+
+    EVSSendInfo(SBN_INIT_EID, "configured, %d nets", SBN.NetCnt);
+
+    for (NetIdx = 0; NetIdx < SBN.NetCnt; NetIdx++)
+    {
+        EVSSendInfo(SBN_INIT_EID, "net %d has %d peers", NetIdx, SBN.Nets[NetIdx].PeerCnt);
+    } /* end for */
+
+    return SBN_SUCCESS;
+} /* end InitInterfaces */
+
+/**
+ * This function waits for the scheduler (SCH) to wake this code up, so that
+ * nothing transpires until the cFE is fully operational.
+ *
+ * @param[in] iTimeOut The time to wait for the scheduler to notify this code.
+ * @return CFE_SUCCESS on success, otherwise an error value.
+ */
+static SBN_Status_t WaitForWakeup(int32 iTimeOut)
+{
+    CFE_Status_t    CFE_Status = CFE_SUCCESS;
+    CFE_SB_MsgPtr_t Msg        = 0;
+
+    /* Wait for WakeUp messages from scheduler */
+    CFE_Status = CFE_SB_RcvMsg(&Msg, SBN.CmdPipe, iTimeOut);
+
+    switch (CFE_Status)
+    {
+        case CFE_SB_NO_MESSAGE:
+        case CFE_SB_TIME_OUT:
             break;
-        }
-        else if (counter % 100 == 0)
+        case CFE_SUCCESS:
+            SBN_HandleCommand(Msg);
+            break;
+        default:
+            return SBN_ERROR;
+    } /* end switch */
+
+    /* For sbn, we still want to perform cyclic processing
+    ** if the WaitForWakeup time out
+    ** cyclic processing at timeout rate
+    */
+    CFE_ES_PerfLogEntry(SBN_PERF_RECV_ID);
+
+    SBN_RecvNetMsgs();
+
+    CFE_ES_PerfLogEntry(SBN_PERF_SUBS_ID);
+    SBN_CheckSubscriptionPipe();
+    CFE_ES_PerfLogExit(SBN_PERF_SUBS_ID);
+
+    CheckPeerPipes();
+
+#ifdef SBN_SHARED_PIPE
+    SBN_CheckSharedPipe();
+#endif /* SBN_SHARED_PIPE */
+
+    PeerPoll();
+
+    SBN_CheckReasmTimeouts();
+
+#ifdef SBN_CREDITS
+    SBN_CheckCredits();
+#endif /* SBN_CREDITS */
+
+    CFE_ES_PerfLogExit(SBN_PERF_RECV_ID);
+
+    return SBN_SUCCESS;
+} /* end WaitForWakeup */
+
+/**
+ * Waits for either a response to the "get subscriptions" message from SB, OR
+ * an event message that says SB has finished initializing. The latter message
+ * means that SB was not started at the time SBN sent the "get subscriptions"
+ * message, so that message will need to be sent again.
+ *
+ * @return SBN_SUCCESS or SBN_ERROR
+ */
+static SBN_Status_t WaitForSBStartup(void)
+{
+    CFE_EVS_LongEventTlm_t *EvsTlm    = NULL;
+    CFE_SB_MsgPtr_t         SBMsgPtr  = 0;
+    uint8                   counter   = 0;
+    CFE_SB_PipeId_t         EventPipe = 0;
+    CFE_Status_t            Status    = SBN_SUCCESS;
+
+    /* Create event message pipe */
+    Status = CFE_SB_CreatePipe(&EventPipe, 20, "SBNEventPipe");
+    if (Status != CFE_SUCCESS)
+    {
+        EVSSendErr(SBN_INIT_EID, "failed to create event pipe (%d)", (int)Status);
+        return SBN_ERROR;
+    } /* end if */
+
+    /* Subscribe to event messages temporarily to be notified when SB is done
+     * initializing
+     */
+    Status = CFE_SB_Subscribe(CFE_EVS_LONG_EVENT_MSG_MID, EventPipe);
+    if (Status != CFE_SUCCESS)
+    {
+        EVSSendErr(SBN_INIT_EID, "failed to subscribe to event pipe (%d)", (int)Status);
+        return SBN_ERROR;
+    } /* end if */
+
+    while (1)
+    {
+        /* Check for subscription message from SB */
+        if (SBN_CheckSubscriptionPipe() == SBN_SUCCESS)
+        {
+            /* SBN does not need to re-send request messages to SB */
+            break;
+        }
+        else if (counter % 100 == 0)
+        {
+            /* Send subscription request messages again. This may cause the SB
+             * to respond to duplicate requests but that should be okay
+             */
+            SBN_SendSubsRequests();
+        } /* end if */
+
+        /* Check for event message from SB */
+        if (CFE_SB_RcvMsg(&SBMsgPtr, EventPipe, 100) == CFE_SUCCESS)
+        {
+            if (CFE_SB_GetMsgId(SBMsgPtr) == CFE_EVS_LONG_EVENT_MSG_MID)
+            {
+                EvsTlm = (CFE_EVS_LongEventTlm_t *)SBMsgPtr;
+
+                /* If it's an event message from SB, make sure it's the init
+                 * message
+                 */
+                if (strcmp(EvsTlm->Payload.PacketID.AppName, "CFE_SB") == 0 &&
+                    EvsTlm->Payload.PacketID.EventID == CFE_SB_INIT_EID)
+                {
+                    break;
+                } /* end if */
+            }     /* end if */
+        }         /* end if */
+
+        counter++;
+    } /* end while */
+
+    /* Unsubscribe from event messages */
+    if (CFE_SB_Unsubscribe(CFE_EVS_LONG_EVENT_MSG_MID, EventPipe) != CFE_SUCCESS)
+    {
+        EVSSendErr(SBN_INIT_EID, "unable to unsubscribe from event messages");
+        return SBN_ERROR;
+    } /* end if */
+
+    if (CFE_SB_DeletePipe(EventPipe) != CFE_SUCCESS)
+    {
+        EVSSendErr(SBN_INIT_EID, "unable to delete event pipe");
+        return SBN_ERROR;
+    } /* end if */
+
+    /* SBN needs to re-send request messages */
+    return SBN_SUCCESS;
+} /* end WaitForSBStartup */
+
+static cpuaddr LoadConf_Module(SBN_Module_Entry_t *e, CFE_ES_ModuleID_t *ModuleIDPtr)
+{
+    cpuaddr StructAddr;
+
+    EVSSendInfo(SBN_TBL_EID, "linking symbol (%s)", e->LibSymbol);
+    if (OS_SymbolLookup(&StructAddr, e->LibSymbol) != OS_SUCCESS) /* try loading it if it's not already loaded */
+    {
+        if (e->LibFileName[0] == '\0')
+        {
+            EVSSendErr(SBN_TBL_EID, "invalid module (Name=%s)", e->Name);
+            return 0;
+        }
+
+        EVSSendInfo(SBN_TBL_EID, "loading module (Name=%s, File=%s)", e->Name, e->LibFileName);
+        if (OS_ModuleLoad(ModuleIDPtr, e->Name, e->LibFileName) != OS_SUCCESS)
+        {
+            EVSSendErr(SBN_TBL_EID, "invalid module file (Name=%s LibFileName=%s)", e->Name, e->LibFileName);
+            return 0;
+        } /* end if */
+
+        EVSSendInfo(SBN_TBL_EID, "trying symbol again (%s)", e->LibSymbol);
+        if (OS_SymbolLookup(&StructAddr, e->LibSymbol) != OS_SUCCESS)
+        {
+            EVSSendErr(SBN_TBL_EID, "invalid symbol (Name=%s LibSymbol=%s)", e->Name, e->LibSymbol);
+            return 0;
+        }
+    } /* end if */
+
+    return StructAddr;
+} /* end LoadConf_Module */
+
+/**
+ * Load the filters from the table.
+ * @param FilterModules[in] - The filter module entries in the table.
+ * @param FilterModuleCnt[in] - The number of entries in FilterModules.
+ * @param ModuleNames[in] - The array of filters this peer/net wishes to use.
+ * @param FilterFns[out] - The function pointers for the filters requested.
+ * @return The number of entries in FilterFns.
+ */
+static SBN_ModuleIdx_t LoadConf_Filters(SBN_Module_Entry_t *FilterModules, SBN_ModuleIdx_t FilterModuleCnt,
+                                        SBN_FilterInterface_t **ConfFilters,
+                                        char ModuleNames[SBN_MAX_FILTERS_PER_PEER][SBN_MAX_MOD_NAME_LEN],
+                                        SBN_FilterInterface_t **Filters)
+{
+    int             i         = 0;
+    SBN_ModuleIdx_t FilterCnt = 0;
+
+    memset(FilterModules, 0, sizeof(*FilterModules) * FilterCnt);
+
+    for (i = 0; *ModuleNames[i] && i < SBN_MAX_FILTERS_PER_PEER; i++)
+    {
+        SBN_ModuleIdx_t FilterIdx = 0;
+        for (FilterIdx = 0; FilterIdx < FilterModuleCnt; FilterIdx++)
+        {
+            if (strcmp(ModuleNames[i], FilterModules[FilterIdx].Name) == 0)
+            {
+                break;
+            } /* end if */
+        }     /* end for */
+
+        if (FilterIdx == FilterModuleCnt)
+        {
+            EVSSendErr(SBN_TBL_EID, "Invalid filter name: %s", ModuleNames[i]);
+            continue;
+        } /* end if */
+
+        Filters[FilterCnt++] = ConfFilters[FilterIdx];
+    } /* end for */
+
+    return FilterCnt;
+} /* end LoadConf_Filters() */
+
+/**
+ * Chains a peer into its net's SBN_GetPeer() hash table and puts it on the
+ * poll wheel, due at the next wakeup. The net's tasks may be looking peers up
+ * while a reload adds the peer, so it is published once it is chained.
+ */
+static void IndexPeer(SBN_PeerInterface_t *Peer)
+{
+    SBN_PeerInterface_t **Bucket = &Peer->Net->PeerHash[SBN_PEER_HASH(Peer->ProcessorID)];
+    uint32                Slot   = SBN.PollTick % SBN_POLL_WHEEL_SLOTS;
+
+    Peer->HashNext = *Bucket;
+    __atomic_store_n(Bucket, Peer, __ATOMIC_RELEASE);
+
+    Peer->PollDelayMS   = 0;
+    Peer->PollNext      = SBN.PollWheel[Slot];
+    SBN.PollWheel[Slot] = Peer;
+} /* end IndexPeer() */
+
+/**
+ * Takes a peer out of the SBN_GetPeer() hash table and off the poll wheel,
+ * before it is unloaded.
+ */
+static void UnindexPeer(SBN_PeerInterface_t *Peer)
+{
+    SBN_PeerInterface_t **Link = &Peer->Net->PeerHash[SBN_PEER_HASH(Peer->ProcessorID)];
+    uint32                Slot = 0;
+
+    for (; *Link != NULL; Link = &(*Link)->HashNext)
+    {
+        if (*Link == Peer)
+        {
+            *Link = Peer->HashNext;
+            break;
+        } /* end if */
+    }     /* end for */
+
+    for (Slot = 0; Slot < SBN_POLL_WHEEL_SLOTS; Slot++)
+    {
+        for (Link = &SBN.PollWheel[Slot]; *Link != NULL; Link = &(*Link)->PollNext)
+        {
+            if (*Link == Peer)
+            {
+                *Link = Peer->PollNext;
+                return;
+            } /* end if */
+        }     /* end for */
+    }         /* end for */
+} /* end UnindexPeer() */
+
+/**
+ * Gives a newly loaded peer the lowest free slot in SBN.Peers. There are
+ * never more peers than entries in the configuration table, and a reload of a
+ * table with more entries than SBN.PeerSlots reloads everything, so there is
+ * always a free slot.
+ */
+static void AllocPeerSlot(SBN_PeerInterface_t *Peer)
+{
+    SBN_PeerIdx_t Slot = 0;
+
+    while (Slot < SBN.PeerSlots - 1 && SBN.Peers[Slot] != NULL)
+    {
+        Slot++;
+    } /* end while */
+
+    SBN.Peers[Slot] = Peer;
+    Peer->Slot      = Slot;
+    SBN.PeerCnt++;
+
+#ifdef SBN_MID_STATS
+    memset(&SBN.MidStats[Slot], 0, sizeof(SBN.MidStats[Slot]));
+    OS_GetLocalTime(&SBN.MidStats[Slot].Since);
+#endif /* SBN_MID_STATS */
+} /* end AllocPeerSlot() */
+
+/** Frees the slot of a peer being unloaded. */
+static void FreePeerSlot(SBN_PeerInterface_t *Peer)
+{
+    SBN.Peers[Peer->Slot] = NULL;
+    SBN.PeerCnt--;
+} /* end FreePeerSlot() */
+
+/**
+ * Deletes the send and receive tasks of a peer being unloaded. The net's send
+ * mutex is held so that the send task is not deleted in the middle of a send.
+ */
+static void DeletePeerTasks(SBN_PeerInterface_t *Peer)
+{
+    OS_MutSemTake(Peer->Net->SendMutex);
+
+    if (Peer->RecvTaskID)
+    {
+        CFE_ES_DeleteChildTask(Peer->RecvTaskID);
+        Peer->RecvTaskID = 0;
+    } /* end if */
+
+#ifndef SBN_SEND_WORKERS
+    /* with send workers, SendTaskID is the shared worker */
+    if (Peer->SendTaskID)
+    {
+        CFE_ES_DeleteChildTask(Peer->SendTaskID);
+        Peer->SendTaskID = 0;
+    } /* end if */
+#endif /* !SBN_SEND_WORKERS */
+
+    OS_MutSemGive(Peer->Net->SendMutex);
+} /* end DeletePeerTasks() */
+
+/**
+ * Releases the nets, each net's peers and the peer slots, allocated when the
+ * configuration was loaded. Tasks serving the peers and nets are deleted
+ * first, as they reference the tables.
+ */
+static void FreeTables(void)
+{
+    SBN_NetIdx_t  NetIdx  = 0;
+    SBN_PeerIdx_t PeerIdx = 0;
+
+    for (NetIdx = 0; NetIdx < SBN.NetCnt; NetIdx++)
+    {
+        SBN_NetInterface_t *Net = &SBN.Nets[NetIdx];
+
+        if (Net->RecvTaskID)
+        {
+            CFE_ES_DeleteChildTask(Net->RecvTaskID);
+        } /* end if */
+
+        for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
+        {
+            DeletePeerTasks(&Net->Peers[PeerIdx]);
+        } /* end for */
+
+        OS_MutSemDelete(Net->SendMutex);
+        free(Net->Peers);
+    } /* end for */
+
+#ifdef SBN_SEND_WORKERS
+    memset(SBN.SendWorkerPeerCnt, 0, sizeof(SBN.SendWorkerPeerCnt));
+    SBN.SendWorkerGen++;
+
+    /* one allocation, shared out among the workers */
+    free(SBN.SendWorkerPeers[0]);
+    memset(SBN.SendWorkerPeers, 0, sizeof(SBN.SendWorkerPeers));
+#endif /* SBN_SEND_WORKERS */
+
+    SBN.NetCnt  = 0;
+    SBN.PeerCnt = 0;
+
+#ifdef SBN_MID_STATS
+    free(SBN.MidStats);
+    SBN.MidStats = NULL;
+#endif /* SBN_MID_STATS */
+
+#ifdef SBN_SHARED_PIPE
+    free(SBN.SharedMasks);
+    SBN.SharedMasks   = NULL;
+    SBN.SentMask      = NULL;
+    SBN.ShareMask     = NULL;
+    SBN.PeerMaskWords = 0;
+#endif /* SBN_SHARED_PIPE */
+
+    free(SBN.Nets);
+    SBN.Nets     = NULL;
+    SBN.NetSlots = 0;
+
+    free(SBN.Peers);
+    free(SBN.ReadyPeers);
+    SBN.Peers      = NULL;
+    SBN.ReadyPeers = NULL;
+    SBN.PeerSlots  = 0;
+
+    memset(SBN.PollWheel, 0, sizeof(SBN.PollWheel));
+} /* end FreeTables() */
+
+/**
+ * Finds the protocol module a configuration table entry names.
+ *
+ * @return The index of the module in the table, TblPtr->ProtocolCnt if none.
+ */
+static SBN_ModuleIdx_t FindProtocol(SBN_ConfTbl_t *TblPtr, const char *ProtocolName)
+{
+    SBN_ModuleIdx_t ModuleIdx = 0;
+
+    for (ModuleIdx = 0; ModuleIdx < TblPtr->ProtocolCnt; ModuleIdx++)
+    {
+        if (strcmp(TblPtr->ProtocolModules[ModuleIdx].Name, ProtocolName) == 0)
+        {
+            break;
+        } /* end if */
+    }     /* end for */
+
+    return ModuleIdx;
+} /* end FindProtocol() */
+
+/**
+ * Checks a configuration table before any of it is applied, so that a bad
+ * table, loaded or reloaded, changes nothing.
+ *
+ * @param TblPtr The configuration table.
+ * @param MyProcessorID The ProcessorID of this CPU.
+ * @param MySpacecraftID The SpacecraftID of this CPU.
+ * @param NetCntPtr[out] The number of nets the table configures.
+ * @return SBN_SUCCESS or SBN_ERROR if the table is invalid.
+ */
+static SBN_Status_t CheckConf(SBN_ConfTbl_t *TblPtr, CFE_ProcessorID_t MyProcessorID,
+                              CFE_SpacecraftID_t MySpacecraftID, SBN_NetIdx_t *NetCntPtr)
+{
+    SBN_PeerIdx_t PeerIdx = 0;
+
+    *NetCntPtr = 0;
+
+    if (TblPtr->PeerCnt > SBN_MAX_PEER_CNT)
+    {
+        EVSSendCrit(SBN_TBL_EID, "too many peers");
+        return SBN_ERROR;
+    } /* end if */
+
+    if (TblPtr->TTLCnt > SBN_MAX_TTL_MIDS)
+    {
+        EVSSendCrit(SBN_TBL_EID, "too many TTLs");
+        return SBN_ERROR;
+    } /* end if */
+
+    for (PeerIdx = 0; PeerIdx < TblPtr->PeerCnt; PeerIdx++)
+    {
+        SBN_Peer_Entry_t *e = &TblPtr->Peers[PeerIdx];
+
+        if (e->NetNum < 0 || e->NetNum >= SBN_MAX_NETS)
+        {
+            EVSSendCrit(SBN_TBL_EID, "too many networks");
+            return SBN_ERROR;
+        } /* end if */
+
+        if (e->NetNum + 1 > *NetCntPtr)
+        {
+            *NetCntPtr = e->NetNum + 1;
+        } /* end if */
+
+        if (FindProtocol(TblPtr, e->ProtocolName) == TblPtr->ProtocolCnt)
+        {
+            EVSSendCrit(SBN_TBL_EID, "invalid module name %s", e->ProtocolName);
+            return SBN_ERROR;
+        } /* end if */
+
+        if (e->ProcessorID == MyProcessorID && e->SpacecraftID == MySpacecraftID)
+        {
+            if (e->MTU != 0 && e->MTU <= SBN_PACKED_HDR_SZ + SBN_PACKED_FRAG_HDR_SZ)
+            {
+                EVSSendCrit(SBN_TBL_EID, "MTU %d too small for net %d", (int)e->MTU, (int)e->NetNum);
+                return SBN_ERROR;
+            } /* end if */
+
+            if (e->HeartbeatMS != 0 && e->TimeoutMS != 0 && e->TimeoutMS < e->HeartbeatMS * SBN_FD_MIN_HEARTBEATS)
+            {
+                EVSSendCrit(SBN_TBL_EID, "TimeoutMS %d shorter than %d heartbeats for net %d", (int)e->TimeoutMS,
+                            SBN_FD_MIN_HEARTBEATS, (int)e->NetNum);
+                return SBN_ERROR;
+            } /* end if */
+
+            continue; /* this CPU's entry for the net, not a peer */
+        }             /* end if */
+
+        if (e->MaxSubs > SBN_MAX_SUBS_PER_PEER)
+        {
+            EVSSendCrit(SBN_TBL_EID, "MaxSubs %d too large for CPU %d", (int)e->MaxSubs, (int)e->ProcessorID);
+            return SBN_ERROR;
+        } /* end if */
+    }     /* end for */
+
+    return SBN_SUCCESS;
+} /* end CheckConf() */
+
+/**
+ * Allocates the nets, as many as the configuration table configures (at
+ * least one), and the peer slots. Each net allocates its own peers, see
+ * LoadConf_Net().
+ *
+ * @param NetCnt The number of nets the configuration table configures.
+ * @param PeerSlots The number of peer slots, at least the entries in the table.
+ * @return SBN_SUCCESS or SBN_ERROR if out of memory.
+ */
+static SBN_Status_t AllocTables(SBN_NetIdx_t NetCnt, SBN_PeerIdx_t PeerSlots)
+{
+#ifdef SBN_SEND_WORKERS
+    int WorkerIdx = 0, WorkerPeerCnt = 0;
+#endif /* SBN_SEND_WORKERS */
+
+    FreeTables();
+
+    SBN.NetSlots = NetCnt > 0 ? NetCnt : 1;
+
+    SBN.Nets = calloc(SBN.NetSlots, sizeof(*SBN.Nets));
+    if (SBN.Nets == NULL)
+    {
+        EVSSendCrit(SBN_TBL_EID, "unable to allocate %d nets", (int)SBN.NetSlots);
+        SBN.NetSlots = 0;
+        return SBN_ERROR;
+    } /* end if */
+
+    SBN.PeerSlots  = PeerSlots > 0 ? PeerSlots : 1;
+    SBN.Peers      = calloc(SBN.PeerSlots, sizeof(*SBN.Peers));
+    SBN.ReadyPeers = calloc(SBN.PeerSlots, sizeof(*SBN.ReadyPeers));
+    if (SBN.Peers == NULL || SBN.ReadyPeers == NULL)
+    {
+        EVSSendCrit(SBN_TBL_EID, "unable to allocate %d peer slots", (int)SBN.PeerSlots);
+        FreeTables();
+        return SBN_ERROR;
+    } /* end if */
+
+#ifdef SBN_SEND_WORKERS
+    /* AssignSendWorkers() deals the peers out in turn */
+    WorkerPeerCnt          = (SBN.PeerSlots + SBN_SEND_WORKERS - 1) / SBN_SEND_WORKERS;
+    SBN.SendWorkerPeers[0] = calloc(SBN_SEND_WORKERS * WorkerPeerCnt, sizeof(*SBN.SendWorkerPeers[0]));
+    if (SBN.SendWorkerPeers[0] == NULL)
+    {
+        EVSSendCrit(SBN_TBL_EID, "unable to allocate send worker peers for %d peers", (int)SBN.PeerSlots);
+        FreeTables();
+        return SBN_ERROR;
+    } /* end if */
+
+    for (WorkerIdx = 1; WorkerIdx < SBN_SEND_WORKERS; WorkerIdx++)
+    {
+        SBN.SendWorkerPeers[WorkerIdx] = SBN.SendWorkerPeers[0] + WorkerIdx * WorkerPeerCnt;
+    } /* end for */
+#endif /* SBN_SEND_WORKERS */
+
+#ifdef SBN_SHARED_PIPE
+    SBN.PeerMaskWords = (SBN.PeerSlots + 31) / 32;
+    SBN.SharedMasks   = calloc((SBN_MAX_SHARED_SUBS + 2) * SBN.PeerMaskWords, sizeof(*SBN.SharedMasks));
+    if (SBN.SharedMasks == NULL)
+    {
+        EVSSendCrit(SBN_TBL_EID, "unable to allocate shared pipe masks for %d peers", (int)SBN.PeerSlots);
+        FreeTables();
+        return SBN_ERROR;
+    } /* end if */
+
+    SBN.SentMask  = &SBN.SharedMasks[SBN_MAX_SHARED_SUBS * SBN.PeerMaskWords];
+    SBN.ShareMask = SBN.SentMask + SBN.PeerMaskWords;
+#endif /* SBN_SHARED_PIPE */
+
+#ifdef SBN_MID_STATS
+    SBN.MidStats = calloc(SBN.PeerSlots, sizeof(*SBN.MidStats));
+    if (SBN.MidStats == NULL)
+    {
+        EVSSendCrit(SBN_TBL_EID, "unable to allocate message ID counters for %d peers", (int)SBN.PeerSlots);
+        FreeTables();
+        return SBN_ERROR;
+    } /* end if */
+#endif /* SBN_MID_STATS */
+
+    SBN.NetCnt = NetCnt;
+
+    return SBN_SUCCESS;
+} /* end AllocTables() */
+
+/** The most subscriptions the peer of a configuration table entry may have. */
+static uint16 EntryMaxSubs(SBN_Peer_Entry_t *e)
+{
+    return e->MaxSubs ? e->MaxSubs : SBN_MAX_SUBS_PER_PEER;
+} /* end EntryMaxSubs() */
+
+/**
+ * Clears an entry of a net's peers, keeping the subscription table it was
+ * given by LoadConf_Net().
+ */
+static void ClearPeer(SBN_PeerInterface_t *Peer)
+{
+    SBN_NetInterface_t *Net      = Peer->Net;
+    SBN_Subs_t *        Subs     = Peer->Subs;
+    uint16              SubSlots = Peer->SubSlots;
+
+    memset(Peer, 0, sizeof(*Peer));
+    Peer->Net      = Net;
+    Peer->Subs     = Subs;
+    Peer->SubSlots = SubSlots;
+} /* end ClearPeer() */
+
+/**
+ * Loads a peer from its configuration table entry, into an entry of its net
+ * with room for its subscriptions, keeping the slot it was given.
+ *
+ * @param TblPtr The configuration table.
+ * @param e The peer's entry in the table.
+ * @param Peer The peer to load.
+ */
+static void LoadConf_Peer(SBN_ConfTbl_t *TblPtr, SBN_Peer_Entry_t *e, SBN_PeerInterface_t *Peer)
+{
+    SBN_PeerIdx_t Slot = Peer->Slot;
+
+    ClearPeer(Peer);
+    Peer->Slot         = Slot;
+    Peer->MaxSubs      = EntryMaxSubs(e);
+    Peer->ProcessorID  = e->ProcessorID;
+    Peer->SpacecraftID = e->SpacecraftID;
+
+    Peer->FilterCnt = LoadConf_Filters(TblPtr->FilterModules, TblPtr->FilterCnt, SBN.Filters, e->Filters, Peer->Filters);
+
+    SBN_LoadConflate(Peer, e->ConflateMIDs);
+
+    SBN.IfOps[FindProtocol(TblPtr, e->ProtocolName)]->LoadPeer(Peer, (const char *)e->Address);
+
+    Peer->TaskFlags = e->TaskFlags;
+    Peer->SendTask  = e->SendTask;
+    Peer->RecvTask  = e->RecvTask;
+} /* end LoadConf_Peer() */
+
+/**
+ * Loads a net and its peers from the configuration table. The net's peers and
+ * their subscription tables are allocated together, for the net alone, so
+ * loading or unloading a net does not move the peers of other nets. The net
+ * has SBN_SPARE_PEERS_PER_NET Unused entries more, for peers a reload adds.
+ *
+ * @param TblPtr The configuration table, already checked by CheckConf().
+ * @param NetIdx The net to load, zeroed.
+ * @param MyProcessorID The ProcessorID of this CPU.
+ * @param MySpacecraftID The SpacecraftID of this CPU.
+ * @return SBN_SUCCESS or SBN_ERROR if out of memory.
+ */
+static SBN_Status_t LoadConf_Net(SBN_ConfTbl_t *TblPtr, SBN_NetIdx_t NetIdx, CFE_ProcessorID_t MyProcessorID,
+                                 CFE_SpacecraftID_t MySpacecraftID)
+{
+    static int          MutexCnt = 0;
+    SBN_NetInterface_t *Net      = &SBN.Nets[NetIdx];
+    SBN_Subs_t *        Subs     = NULL;
+    SBN_PeerIdx_t       PeerIdx  = 0, PeerCnt = SBN_SPARE_PEERS_PER_NET;
+    uint32              SubsCnt  = SBN_SPARE_PEERS_PER_NET * (SBN_MAX_SUBS_PER_PEER + 1);
+    char                MutexName[OS_MAX_API_NAME];
+
+    /* numbered apart from the mutex of the net this one replaces, which a reload deletes first */
+    snprintf(MutexName, sizeof(MutexName), "sbn_send_%d", MutexCnt++);
+    if (OS_MutSemCreate(&Net->SendMutex, MutexName, 0) != OS_SUCCESS)
+    {
+        EVSSendCrit(SBN_TBL_EID, "unable to create send mutex for net %d", (int)NetIdx);
+        return SBN_ERROR;
+    } /* end if */
+
+    for (PeerIdx = 0; PeerIdx < TblPtr->PeerCnt; PeerIdx++)
+    {
+        SBN_Peer_Entry_t *e = &TblPtr->Peers[PeerIdx];
+
+        if (e->NetNum != NetIdx || (e->ProcessorID == MyProcessorID && e->SpacecraftID == MySpacecraftID))
+        {
+            continue;
+        } /* end if */
+
+        PeerCnt++;
+
+        /* one extra, like SBN.Subs, for the copy when a subscription is removed */
+        SubsCnt += EntryMaxSubs(e) + 1;
+    } /* end for */
+
+    if (PeerCnt > 0)
+    {
+        Net->Peers = calloc(1, PeerCnt * sizeof(*Net->Peers) + SubsCnt * sizeof(*Subs));
+        if (Net->Peers == NULL)
+        {
+            EVSSendCrit(SBN_TBL_EID, "unable to allocate %d peers for net %d", (int)PeerCnt, (int)NetIdx);
+            return SBN_ERROR;
+        } /* end if */
+
+        Subs           = (SBN_Subs_t *)(void *)&Net->Peers[PeerCnt];
+        Net->PeerSlots = PeerCnt;
+    } /* end if */
+
+    for (PeerIdx = 0; PeerIdx < TblPtr->PeerCnt; PeerIdx++)
+    {
+        SBN_Peer_Entry_t *e = &TblPtr->Peers[PeerIdx];
+
+        if (e->NetNum != NetIdx)
+        {
+            continue;
+        } /* end if */
+
+        if (e->ProcessorID == MyProcessorID && e->SpacecraftID == MySpacecraftID)
+        {
+            Net->Configured  = true;
+            Net->ProtocolIdx = FindProtocol(TblPtr, e->ProtocolName);
+            Net->IfOps       = SBN.IfOps[Net->ProtocolIdx];
+
+            /* the module replaces 0's with its defaults */
+            Net->HeartbeatMS = e->HeartbeatMS;
+            Net->TimeoutMS   = e->TimeoutMS;
+
+            Net->IfOps->LoadNet(Net, (const char *)e->Address);
+
+            Net->FilterCnt =
+                LoadConf_Filters(TblPtr->FilterModules, TblPtr->FilterCnt, SBN.Filters, e->Filters, Net->Filters);
+
+            Net->TaskFlags = e->TaskFlags;
+            Net->RecvTask  = e->RecvTask;
+            Net->MTU       = e->MTU;
+        }
+        else
+        {
+            SBN_PeerInterface_t *Peer = &Net->Peers[Net->PeerCnt++];
+
+            Peer->Net      = Net;
+            Peer->SubSlots = EntryMaxSubs(e) + 1;
+            Peer->Subs     = Subs;
+            Subs += Peer->SubSlots;
+
+            AllocPeerSlot(Peer);
+
+            LoadConf_Peer(TblPtr, e, Peer);
+        } /* end if */
+    }     /* end for */
+
+    for (PeerIdx = Net->PeerCnt; PeerIdx < Net->PeerSlots; PeerIdx++)
+    {
+        SBN_PeerInterface_t *Peer = &Net->Peers[PeerIdx];
+
+        Peer->Net      = Net;
+        Peer->SubSlots = SBN_MAX_SUBS_PER_PEER + 1;
+        Peer->Subs     = Subs;
+        Peer->Unused   = true;
+        Subs += Peer->SubSlots;
+    } /* end for */
+
+    return SBN_SUCCESS;
+} /* end LoadConf_Net() */
+
+/**
+ * Loads and initializes the protocol and filter modules the configuration
+ * table lists.
+ *
+ * @return SBN_SUCCESS or SBN_ERROR if a module fails to load or initialize.
+ */
+static SBN_Status_t LoadConf_Modules(SBN_ConfTbl_t *TblPtr)
+{
+    SBN_ModuleIdx_t ModuleIdx = 0;
+
+    memset(SBN.Filters, 0, sizeof(SBN.Filters));
+
+    /* load protocol modules */
+    for (ModuleIdx = 0; ModuleIdx < TblPtr->ProtocolCnt; ModuleIdx++)
+    {
+        CFE_ES_ModuleID_t ModuleID = 0;
+
+        SBN_IfOps_t *Ops = (SBN_IfOps_t *)LoadConf_Module(&TblPtr->ProtocolModules[ModuleIdx], &ModuleID);
+
+        if (Ops == NULL)
+        {
+            /* LoadConf_Module already generated an event */
+            return SBN_ERROR;
+        } /* end if */
+
+        EVSSendInfo(SBN_TBL_EID, "calling init fn");
+        if (Ops->InitModule(SBN_PROTOCOL_VERSION, TblPtr->ProtocolModules[ModuleIdx].BaseEID) != CFE_SUCCESS)
+        {
+            EVSSendErr(SBN_TBL_EID, "error in protocol init");
+            return SBN_ERROR;
+        } /* end if */
+
+        SBN.IfOps[ModuleIdx]           = Ops;
+        SBN.ProtocolModules[ModuleIdx] = ModuleID;
+    } /* end for */
+
+    /* load filter modules */
+    for (ModuleIdx = 0; ModuleIdx < TblPtr->FilterCnt; ModuleIdx++)
+    {
+        CFE_ES_ModuleID_t ModuleID = 0;
+
+        SBN.Filters[ModuleIdx] =
+            (SBN_FilterInterface_t *)LoadConf_Module(&TblPtr->FilterModules[ModuleIdx], &ModuleID);
+
+        if (SBN.Filters[ModuleIdx] == NULL)
+        {
+            /* LoadConf_Module already generated an event */
+            return SBN_ERROR;
+        } /* end if */
+
+        if (SBN.Filters[ModuleIdx]->InitModule(SBN_FILTER_VERSION, TblPtr->FilterModules[ModuleIdx].BaseEID) !=
+            CFE_SUCCESS)
+        {
+            EVSSendErr(SBN_TBL_EID, "error in filter init");
+            return SBN_ERROR;
+        } /* end if */
+
+        SBN.FilterModules[ModuleIdx] = ModuleID;
+    } /* end for */
+
+    return SBN_SUCCESS;
+} /* end LoadConf_Modules() */
+
+/**
+ * Loads the modules, nets and peers of a configuration table, and remembers
+ * the table for later reloads to compare against.
+ */
+/**
+ * The peer slots to allocate for a configuration table: one per entry, and
+ * one per spare entry of its nets, so that a reload adding peers need not
+ * reload everything. No table has more than SBN_MAX_PEER_CNT entries, so no
+ * more slots are ever needed.
+ *
+ * @param TblPtr The configuration table.
+ * @param NetCnt The number of nets the table configures.
+ * @return The number of peer slots.
+ */
+static SBN_PeerIdx_t CountPeerSlots(SBN_ConfTbl_t *TblPtr, SBN_NetIdx_t NetCnt)
+{
+    uint32 PeerSlots = TblPtr->PeerCnt + NetCnt * SBN_SPARE_PEERS_PER_NET;
+
+    return PeerSlots < SBN_MAX_PEER_CNT ? PeerSlots : SBN_MAX_PEER_CNT;
+} /* end CountPeerSlots() */
+
+static SBN_Status_t LoadConf_Tbl(SBN_ConfTbl_t *TblPtr)
+{
+    SBN_NetIdx_t       NetIdx         = 0, NetCnt = 0;
+    CFE_ProcessorID_t  MyProcessorID  = CFE_PSP_GetProcessorId();
+    CFE_SpacecraftID_t MySpacecraftID = CFE_PSP_GetSpacecraftId();
+
+    if (LoadConf_Modules(TblPtr) != SBN_SUCCESS)
+    {
+        /* LoadConf_Modules already generated an event */
+        return SBN_ERROR;
+    } /* end if */
+
+    if (CheckConf(TblPtr, MyProcessorID, MySpacecraftID, &NetCnt) != SBN_SUCCESS ||
+        AllocTables(NetCnt, CountPeerSlots(TblPtr, NetCnt)) != SBN_SUCCESS)
+    {
+        /* CheckConf or AllocTables already generated an event */
+        return SBN_ERROR;
+    } /* end if */
+
+    for (NetIdx = 0; NetIdx < NetCnt; NetIdx++)
+    {
+        if (LoadConf_Net(TblPtr, NetIdx, MyProcessorID, MySpacecraftID) != SBN_SUCCESS)
+        {
+            /* LoadConf_Net already generated an event */
+            return SBN_ERROR;
+        } /* end if */
+    }     /* end for */
+
+    SBN_IndexPeers();
+
+#ifdef SBN_BONDING
+    SBN_LinkBonds();
+#endif /* SBN_BONDING */
+
+#ifdef SBN_SEND_WORKERS
+    AssignSendWorkers();
+#endif /* SBN_SEND_WORKERS */
+
+    SBN.Conf = TblPtr;
+
+    return SBN_SUCCESS;
+} /* end LoadConf_Tbl() */
+
+static SBN_Status_t LoadConf(void)
+{
+    SBN_ConfTbl_t *TblPtr = NULL;
+
+    if (CFE_TBL_GetAddress((void **)&TblPtr, SBN.ConfTblHandle) != CFE_TBL_INFO_UPDATED)
+    {
+        EVSSendErr(SBN_TBL_EID, "unable to get conf table address");
+        CFE_TBL_Unregister(SBN.ConfTblHandle);
+        return SBN_ERROR;
+    } /* end if */
+
+    if (LoadConf_Tbl(TblPtr) != SBN_SUCCESS)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    /* address only needed at load time, release */
+    if (CFE_TBL_ReleaseAddress(SBN.ConfTblHandle) != CFE_SUCCESS)
+    {
+        EVSSendCrit(SBN_TBL_EID, "unable to release address of conf tbl");
+        return SBN_ERROR;
+    } /* end if */
+
+    /* ...but we keep the handle so we can be notified of updates */
+    return SBN_SUCCESS;
+} /* end LoadConf() */
+
+/**
+ * Unloads one peer whose configuration table entry changed, leaving the rest
+ * of its net as it is. The peer keeps its place in the net to be loaded again
+ * by LoadConf_Peer().
+ */
+static SBN_Status_t UnloadConf_Peer(SBN_PeerInterface_t *Peer)
+{
+    SBN_Status_t Status = SBN_SUCCESS;
+
+    /* the tasks use the module's state for the peer, stop them before it is freed */
+    DeletePeerTasks(Peer);
+
+    if (Peer->Net->IfOps->UnloadPeer != NULL && (Status = Peer->Net->IfOps->UnloadPeer(Peer)) != SBN_SUCCESS)
+    {
+        EVSSendCrit(SBN_TBL_EID, "unable to unload peer %d", (int)Peer->ProcessorID);
+        return Status;
+    } /* end if */
+
+    if (Peer->Connected)
+    {
+        SBN_Disconnected(Peer);
+    } /* end if */
+
+    UnindexPeer(Peer);
+    SBN_DropReasm(Peer);
+
+    return SBN_SUCCESS;
+} /* end UnloadConf_Peer() */
+
+/**
+ * Unloads a net and its peers, deleting the tasks serving them, and frees the
+ * net's peers. The net is left zeroed, to be loaded again by LoadConf_Net().
+ */
+static SBN_Status_t UnloadConf_Net(SBN_NetIdx_t NetIdx)
+{
+    SBN_NetInterface_t *Net     = &SBN.Nets[NetIdx];
+    SBN_PeerIdx_t       PeerIdx = 0;
+    SBN_Status_t        Status  = SBN_SUCCESS;
+
+    /* the tasks use the module's state for the net and its peers, stop them before it is freed */
+    if (Net->RecvTaskID)
+    {
+        CFE_ES_DeleteChildTask(Net->RecvTaskID);
+        Net->RecvTaskID = 0;
+    } /* end if */
+
+    for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
+    {
+        DeletePeerTasks(&Net->Peers[PeerIdx]);
+    } /* end for */
+
+    if (Net->Configured && (Status = Net->IfOps->UnloadNet(Net)) != SBN_SUCCESS)
+    {
+        EVSSendCrit(SBN_TBL_EID, "unable to unload network %d", (int)NetIdx);
+        return Status;
+    } /* end if */
+
+    for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
+    {
+        SBN_PeerInterface_t *Peer = &Net->Peers[PeerIdx];
+
+        if (Peer->Unused)
+        {
+            /* removed by a reload, and unloaded then */
+            continue;
+        } /* end if */
+
+        if (Peer->Connected)
+        {
+            SBN_Disconnected(Peer);
+        } /* end if */
+
+        UnindexPeer(Peer);
+        SBN_DropReasm(Peer);
+        FreePeerSlot(Peer);
+    } /* end for */
+
+    OS_MutSemDelete(Net->SendMutex);
+    free(Net->Peers);
+    memset(Net, 0, sizeof(*Net));
+
+    return SBN_SUCCESS;
+} /* end UnloadConf_Net() */
+
+static uint32 UnloadConf(void)
+{
+    uint32 Status;
+
+    SBN_NetIdx_t NetIdx = 0;
+    for (NetIdx = 0; NetIdx < SBN.NetCnt; NetIdx++)
+    {
+        if ((Status = UnloadConf_Net(NetIdx)) != SBN_SUCCESS)
+        {
+            return Status;
+        } /* end if */
+    }     /* end for */
+
+    FreeTables();
+
+    return UnloadModules();
+} /* end UnloadConf() */
+
+/** True if two module entries load the same module the same way. */
+static bool SameModule(SBN_Module_Entry_t *o, SBN_Module_Entry_t *n)
+{
+    return strncmp(o->Name, n->Name, sizeof(o->Name)) == 0 &&
+           strncmp(o->LibFileName, n->LibFileName, sizeof(o->LibFileName)) == 0 &&
+           strncmp(o->LibSymbol, n->LibSymbol, sizeof(o->LibSymbol)) == 0 && o->BaseEID == n->BaseEID;
+} /* end SameModule() */
+
+/** True if the two tables list the same protocol and filter modules. */
+static bool SameModules(SBN_ConfTbl_t *Old, SBN_ConfTbl_t *New)
+{
+    SBN_ModuleIdx_t ModuleIdx = 0;
+
+    if (Old->ProtocolCnt != New->ProtocolCnt || Old->FilterCnt != New->FilterCnt)
+    {
+        return false;
+    } /* end if */
+
+    for (ModuleIdx = 0; ModuleIdx < New->ProtocolCnt; ModuleIdx++)
+    {
+        if (!SameModule(&Old->ProtocolModules[ModuleIdx], &New->ProtocolModules[ModuleIdx]))
+        {
+            return false;
+        } /* end if */
+    }     /* end for */
+
+    for (ModuleIdx = 0; ModuleIdx < New->FilterCnt; ModuleIdx++)
+    {
+        if (!SameModule(&Old->FilterModules[ModuleIdx], &New->FilterModules[ModuleIdx]))
+        {
+            return false;
+        } /* end if */
+    }     /* end for */
+
+    return true;
+} /* end SameModules() */
+
+/** Finds the entry in a table for a CPU on a net, NULL if none. */
+static SBN_Peer_Entry_t *FindEntry(SBN_ConfTbl_t *TblPtr, SBN_NetIdx_t NetNum, CFE_ProcessorID_t ProcessorID,
+                                   CFE_SpacecraftID_t SpacecraftID)
+{
+    SBN_PeerIdx_t PeerIdx = 0;
+
+    for (PeerIdx = 0; PeerIdx < TblPtr->PeerCnt; PeerIdx++)
+    {
+        SBN_Peer_Entry_t *f = &TblPtr->Peers[PeerIdx];
+
+        if (f->NetNum == NetNum && f->ProcessorID == ProcessorID && f->SpacecraftID == SpacecraftID)
         {
-            /* Send subscription request messages again. This may cause the SB
-             * to respond to duplicate requests but that should be okay
-             */
-            SBN_SendSubsRequests();
+            return f;
         } /* end if */
+    }     /* end for */
 
-        /* Check for event message from SB */
-        if (CFE_SB_RcvMsg(&SBMsgPtr, EventPipe, 100) == CFE_SUCCESS)
+    return NULL;
+} /* end FindEntry() */
+
+/** True if two entries create their tasks alike. */
+static bool SameTask(SBN_TaskConf_t *o, SBN_TaskConf_t *n)
+{
+    return o->Priority == n->Priority && o->StackSz == n->StackSz && o->CoreMask == n->CoreMask;
+} /* end SameTask() */
+
+/** True if the entries differ in anything that needs the peer (or net) reloaded. */
+static bool EntryChanged(SBN_Peer_Entry_t *o, SBN_Peer_Entry_t *n)
+{
+    return strncmp(o->ProtocolName, n->ProtocolName, sizeof(o->ProtocolName)) != 0 ||
+           strncmp((const char *)o->Address, (const char *)n->Address, sizeof(o->Address)) != 0 ||
+           o->TaskFlags != n->TaskFlags || memcmp(o->ConflateMIDs, n->ConflateMIDs, sizeof(o->ConflateMIDs)) != 0 ||
+           !SameTask(&o->SendTask, &n->SendTask) || !SameTask(&o->RecvTask, &n->RecvTask);
+} /* end EntryChanged() */
+
+/** True if the entries name different filters. */
+static bool FiltersChanged(SBN_Peer_Entry_t *o, SBN_Peer_Entry_t *n)
+{
+    int i = 0;
+
+    for (i = 0; i < SBN_MAX_FILTERS_PER_PEER; i++)
+    {
+        if (strncmp(o->Filters[i], n->Filters[i], sizeof(o->Filters[i])) != 0)
         {
-            if (CFE_SB_GetMsgId(SBMsgPtr) == CFE_EVS_LONG_EVENT_MSG_MID)
-            {
-                EvsTlm = (CFE_EVS_LongEventTlm_t *)SBMsgPtr;
+            return true;
+        } /* end if */
+    }     /* end for */
 
-                /* If it's an event message from SB, make sure it's the init
-                 * message
-                 */
-                if (strcmp(EvsTlm->Payload.PacketID.AppName, "CFE_SB") == 0 &&
-                    EvsTlm->Payload.PacketID.EventID == CFE_SB_INIT_EID)
-                {
-                    break;
-                } /* end if */
-            }     /* end if */
-        }         /* end if */
+    return false;
+} /* end FiltersChanged() */
 
-        counter++;
-    } /* end while */
+/**
+ * True if a net must be reloaded: this CPU's entry for it was added, removed
+ * or changed (other than its filters.) Peers added to or removed from the net
+ * are loaded and unloaded in place, see AddPeer() and RemovePeer().
+ */
+static bool NetChanged(SBN_ConfTbl_t *Old, SBN_ConfTbl_t *New, SBN_NetIdx_t NetIdx, CFE_ProcessorID_t MyProcessorID,
+                       CFE_SpacecraftID_t MySpacecraftID)
+{
+    SBN_Peer_Entry_t *o = FindEntry(Old, NetIdx, MyProcessorID, MySpacecraftID);
+    SBN_Peer_Entry_t *n = FindEntry(New, NetIdx, MyProcessorID, MySpacecraftID);
 
-    /* Unsubscribe from event messages */
-    if (CFE_SB_Unsubscribe(CFE_EVS_LONG_EVENT_MSG_MID, EventPipe) != CFE_SUCCESS)
+    if (o == NULL || n == NULL)
     {
-        EVSSendErr(SBN_INIT_EID, "unable to unsubscribe from event messages");
-        return SBN_ERROR;
+        return o != n;
     } /* end if */
 
-    if (CFE_SB_DeletePipe(EventPipe) != CFE_SUCCESS)
+    return EntryChanged(o, n) || o->MTU != n->MTU || o->HeartbeatMS != n->HeartbeatMS || o->TimeoutMS != n->TimeoutMS;
+} /* end NetChanged() */
+
+/**
+ * Unloads a peer a reload removed from its net, leaving the net's other peers
+ * as they are. Its entry is left Unused, for a peer added later.
+ */
+static SBN_Status_t RemovePeer(SBN_PeerInterface_t *Peer)
+{
+    SBN_NetInterface_t *Net    = Peer->Net;
+    SBN_Status_t        Status = SBN_SUCCESS;
+
+    if ((Status = UnloadConf_Peer(Peer)) != SBN_SUCCESS)
     {
-        EVSSendErr(SBN_INIT_EID, "unable to delete event pipe");
-        return SBN_ERROR;
+        return Status;
     } /* end if */
 
-    /* SBN needs to re-send request messages */
+    FreePeerSlot(Peer);
+    ClearPeer(Peer);
+    Peer->Unused = true;
+
+    /* Unused entries at the end are spares again */
+    while (Net->PeerCnt > 0 && Net->Peers[Net->PeerCnt - 1].Unused)
+    {
+        Net->PeerCnt--;
+    } /* end while */
+
     return SBN_SUCCESS;
-} /* end WaitForSBStartup */
+} /* end RemovePeer() */
 
-static cpuaddr LoadConf_Module(SBN_Module_Entry_t *e, CFE_ES_ModuleID_t *ModuleIDPtr)
+/**
+ * Loads a peer a reload added to its net into an Unused entry of the net with
+ * room for its subscriptions, leaving the net's other peers as they are.
+ *
+ * @param TblPtr The reloaded configuration table.
+ * @param e The peer's entry in the table.
+ * @return false if the net has no such entry, and must be reloaded.
+ */
+static bool AddPeer(SBN_ConfTbl_t *TblPtr, SBN_Peer_Entry_t *e)
 {
-    cpuaddr StructAddr;
+    SBN_NetInterface_t * Net     = &SBN.Nets[e->NetNum];
+    SBN_PeerInterface_t *Peer    = NULL;
+    SBN_PeerIdx_t        PeerIdx = 0;
 
-    EVSSendInfo(SBN_TBL_EID, "linking symbol (%s)", e->LibSymbol);
-    if (OS_SymbolLookup(&StructAddr, e->LibSymbol) != OS_SUCCESS) /* try loading it if it's not already loaded */
+    for (PeerIdx = 0; PeerIdx < Net->PeerSlots; PeerIdx++)
     {
-        if (e->LibFileName[0] == '\0')
-        {
-            EVSSendErr(SBN_TBL_EID, "invalid module (Name=%s)", e->Name);
-            return 0;
-        }
+        Peer = &Net->Peers[PeerIdx];
 
-        EVSSendInfo(SBN_TBL_EID, "loading module (Name=%s, File=%s)", e->Name, e->LibFileName);
-        if (OS_ModuleLoad(ModuleIDPtr, e->Name, e->LibFileName) != OS_SUCCESS)
+        if (Peer->Unused && Peer->SubSlots > EntryMaxSubs(e))
         {
-            EVSSendErr(SBN_TBL_EID, "invalid module file (Name=%s LibFileName=%s)", e->Name, e->LibFileName);
-            return 0;
+            break;
         } /* end if */
+    }     /* end for */
 
-        EVSSendInfo(SBN_TBL_EID, "trying symbol again (%s)", e->LibSymbol);
-        if (OS_SymbolLookup(&StructAddr, e->LibSymbol) != OS_SUCCESS)
-        {
-            EVSSendErr(SBN_TBL_EID, "invalid symbol (Name=%s LibSymbol=%s)", e->Name, e->LibSymbol);
-            return 0;
-        }
+    if (PeerIdx == Net->PeerSlots)
+    {
+        return false;
     } /* end if */
 
-    return StructAddr;
-} /* end LoadConf_Module */
+    AllocPeerSlot(Peer);
+    LoadConf_Peer(TblPtr, e, Peer);
+    IndexPeer(Peer);
+
+    if (PeerIdx >= Net->PeerCnt)
+    {
+        /* the entries before it are loaded or Unused, publish them to the net's tasks once the peer is loaded */
+        __atomic_store_n(&Net->PeerCnt, PeerIdx + 1, __ATOMIC_RELEASE);
+    } /* end if */
+
+    if (Net->Configured)
+    {
+        Net->IfOps->InitPeer(Peer);
+    } /* end if */
+
+    return true;
+} /* end AddPeer() */
 
 /**
- * Load the filters from the table.
- * @param FilterModules[in] - The filter module entries in the table.
- * @param FilterModuleCnt[in] - The number of entries in FilterModules.
- * @param ModuleNames[in] - The array of filters this peer/net wishes to use.
- * @param FilterFns[out] - The function pointers for the filters requested.
- * @return The number of entries in FilterFns.
+ * Unloads everything and loads a reloaded configuration table from scratch.
+ *
+ * @param TblPtr The reloaded configuration table.
+ * @return SBN_SUCCESS or SBN_ERROR.
  */
-static SBN_ModuleIdx_t LoadConf_Filters(SBN_Module_Entry_t *FilterModules, SBN_ModuleIdx_t FilterModuleCnt,
-                                        SBN_FilterInterface_t **ConfFilters,
-                                        char ModuleNames[SBN_MAX_FILTERS_PER_PEER][SBN_MAX_MOD_NAME_LEN],
-                                        SBN_FilterInterface_t **Filters)
+static SBN_Status_t ReloadAll(SBN_ConfTbl_t *TblPtr)
 {
-    int             i         = 0;
-    SBN_ModuleIdx_t FilterCnt = 0;
-
-    memset(FilterModules, 0, sizeof(*FilterModules) * FilterCnt);
+    SBN_Status_t Status = SBN_SUCCESS;
 
-    for (i = 0; *ModuleNames[i] && i < SBN_MAX_FILTERS_PER_PEER; i++)
+    if ((Status = UnloadConf()) != SBN_SUCCESS || (Status = LoadConf_Tbl(TblPtr)) != SBN_SUCCESS)
     {
-        SBN_ModuleIdx_t FilterIdx = 0;
-        for (FilterIdx = 0; FilterIdx < FilterModuleCnt; FilterIdx++)
-        {
-            if (strcmp(ModuleNames[i], FilterModules[FilterIdx].Name) == 0)
-            {
-                break;
-            } /* end if */
-        }     /* end for */
-
-        if (FilterIdx == FilterModuleCnt)
-        {
-            EVSSendErr(SBN_TBL_EID, "Invalid filter name: %s", ModuleNames[i]);
-            continue;
-        } /* end if */
-
-        Filters[FilterCnt++] = ConfFilters[FilterIdx];
-    } /* end for */
+        return Status;
+    } /* end if */
 
-    return FilterCnt;
-} /* end LoadConf_Filters() */
+    return InitInterfaces();
+} /* end ReloadAll() */
 
-static SBN_Status_t LoadConf(void)
+/**
+ * Applies a reloaded configuration table, touching only what differs from the
+ * table last applied (SBN.Conf.) Changed, added and removed nets are reloaded
+ * whole; peers are added, removed or, when their entry changed, reloaded in
+ * place; changed filters are reassigned without reloading anything. All other
+ * peers keep their connections, pipes, tasks and subscriptions. A net that
+ * has no Unused entry with room for a peer added or given more MaxSubs is
+ * reloaded whole. A change to the modules, or more nets or entries than
+ * were allocated for at the last full load, reloads everything.
+ *
+ * @param TblPtr The reloaded configuration table.
+ * @return SBN_SUCCESS or SBN_ERROR.
+ */
+static SBN_Status_t ReloadConf(SBN_ConfTbl_t *TblPtr)
 {
-    SBN_ConfTbl_t *        TblPtr    = NULL;
-    SBN_ModuleIdx_t        ModuleIdx = 0;
-    SBN_PeerIdx_t          PeerIdx   = 0;
-    SBN_FilterInterface_t *Filters[SBN_MAX_MOD_CNT];
+    SBN_ConfTbl_t *    Old            = SBN.Conf;
+    bool               Reload[SBN_MAX_NETS];
+    SBN_NetIdx_t       NetIdx         = 0, NetCnt = 0;
+    SBN_PeerIdx_t      PeerIdx        = 0;
+    int                NetReloadCnt   = 0, PeerReloadCnt = 0;
+    SBN_Status_t       Status         = SBN_SUCCESS;
+    CFE_ProcessorID_t  MyProcessorID  = CFE_PSP_GetProcessorId();
+    CFE_SpacecraftID_t MySpacecraftID = CFE_PSP_GetSpacecraftId();
+
+    if (Old == NULL || !SameModules(Old, TblPtr))
+    {
+        EVSSendInfo(SBN_TBL_EID, "modules changed, reloading all nets");
 
-    memset(Filters, 0, sizeof(Filters));
+        return ReloadAll(TblPtr);
+    } /* end if */
 
-    if (CFE_TBL_GetAddress((void **)&TblPtr, SBN.ConfTblHandle) != CFE_TBL_INFO_UPDATED)
+    if (CheckConf(TblPtr, MyProcessorID, MySpacecraftID, &NetCnt) != SBN_SUCCESS)
     {
-        EVSSendErr(SBN_TBL_EID, "unable to get conf table address");
-        CFE_TBL_Unregister(SBN.ConfTblHandle);
+        /* CheckConf already generated an event */
         return SBN_ERROR;
     } /* end if */
 
-    /* load protocol modules */
-    for (ModuleIdx = 0; ModuleIdx < TblPtr->ProtocolCnt; ModuleIdx++)
+    if (NetCnt > SBN.NetSlots)
     {
-        CFE_ES_ModuleID_t ModuleID = 0;
+        EVSSendInfo(SBN_TBL_EID, "nets added, reloading all nets");
 
-        SBN_IfOps_t *Ops = (SBN_IfOps_t *)LoadConf_Module(&TblPtr->ProtocolModules[ModuleIdx], &ModuleID);
+        return ReloadAll(TblPtr);
+    } /* end if */
 
-        if (Ops == NULL)
+    if (TblPtr->PeerCnt > SBN.PeerSlots)
+    {
+        EVSSendInfo(SBN_TBL_EID, "peers added, reloading all nets");
+
+        return ReloadAll(TblPtr);
+    } /* end if */
+
+    /* unload changed and removed nets first, freeing slots for the peers added */
+    for (NetIdx = 0; NetIdx < SBN.NetSlots && Status == SBN_SUCCESS; NetIdx++)
+    {
+        Reload[NetIdx] = NetChanged(Old, TblPtr, NetIdx, MyProcessorID, MySpacecraftID);
+
+        if (Reload[NetIdx])
         {
-            /* LoadConf_Module already generated an event */
-            return SBN_ERROR;
+            Status = UnloadConf_Net(NetIdx);
         } /* end if */
+    }     /* end for */
 
-        EVSSendInfo(SBN_TBL_EID, "calling init fn");
-        if (Ops->InitModule(SBN_PROTOCOL_VERSION, TblPtr->ProtocolModules[ModuleIdx].BaseEID) != CFE_SUCCESS)
+    /* then the peers removed from the other nets, freeing their entries and slots */
+    for (NetIdx = 0; NetIdx < SBN.NetSlots && Status == SBN_SUCCESS; NetIdx++)
+    {
+        SBN_NetInterface_t *Net = &SBN.Nets[NetIdx];
+
+        for (PeerIdx = 0; PeerIdx < Net->PeerCnt && !Reload[NetIdx] && Status == SBN_SUCCESS; PeerIdx++)
         {
-            EVSSendErr(SBN_TBL_EID, "error in protocol init");
-            return SBN_ERROR;
-        } /* end if */
+            SBN_PeerInterface_t *Peer = &Net->Peers[PeerIdx];
 
-        SBN.IfOps[ModuleIdx]           = Ops;
-        SBN.ProtocolModules[ModuleIdx] = ModuleID;
-    } /* end for */
+            if (!Peer->Unused && FindEntry(TblPtr, NetIdx, Peer->ProcessorID, Peer->SpacecraftID) == NULL)
+            {
+                Status = RemovePeer(Peer);
+                PeerReloadCnt++;
+            } /* end if */
+        }     /* end for */
+    }         /* end for */
 
-    /* load filter modules */
-    for (ModuleIdx = 0; ModuleIdx < TblPtr->FilterCnt; ModuleIdx++)
+    for (PeerIdx = 0; PeerIdx < TblPtr->PeerCnt && Status == SBN_SUCCESS; PeerIdx++)
     {
-        CFE_ES_ModuleID_t ModuleID = 0;
-
-        Filters[ModuleIdx] = (SBN_FilterInterface_t *)LoadConf_Module(&TblPtr->FilterModules[ModuleIdx], &ModuleID);
+        SBN_Peer_Entry_t *   e    = &TblPtr->Peers[PeerIdx];
+        SBN_Peer_Entry_t *   o    = FindEntry(Old, e->NetNum, e->ProcessorID, e->SpacecraftID);
+        SBN_NetInterface_t * Net  = &SBN.Nets[e->NetNum];
+        SBN_PeerInterface_t *Peer = NULL;
 
-        if (Filters[ModuleIdx] == NULL)
+        if (Reload[e->NetNum])
         {
-            /* LoadConf_Module already generated an event */
-            return SBN_ERROR;
+            continue;
         } /* end if */
 
-        if (Filters[ModuleIdx]->InitModule(SBN_FILTER_VERSION, TblPtr->FilterModules[ModuleIdx].BaseEID) != CFE_SUCCESS)
+        if (o == NULL)
         {
-            EVSSendErr(SBN_TBL_EID, "error in filter init");
-            return SBN_ERROR;
+            if (AddPeer(TblPtr, e))
+            {
+                PeerReloadCnt++;
+            }
+            else
+            {
+                /* no room for it in the net, which is loaded again below */
+                Reload[e->NetNum] = true;
+                Status            = UnloadConf_Net(e->NetNum);
+            } /* end if */
+
+            continue;
         } /* end if */
 
-        SBN.FilterModules[ModuleIdx] = ModuleID;
-    } /* end for */
+        if (e->ProcessorID == MyProcessorID && e->SpacecraftID == MySpacecraftID)
+        {
+            if (FiltersChanged(o, e))
+            {
+                Net->FilterCnt =
+                    LoadConf_Filters(TblPtr->FilterModules, TblPtr->FilterCnt, SBN.Filters, e->Filters, Net->Filters);
+            } /* end if */
 
-    /* load nets and peers */
-    for (PeerIdx = 0; PeerIdx < TblPtr->PeerCnt; PeerIdx++)
-    {
-        SBN_Peer_Entry_t *e = &TblPtr->Peers[PeerIdx];
+            continue;
+        } /* end if */
+
+        if ((Peer = SBN_GetPeer(Net, e->ProcessorID)) == NULL)
+        {
+            continue;
+        } /* end if */
 
-        for (ModuleIdx = 0; ModuleIdx < TblPtr->ProtocolCnt; ModuleIdx++)
+        if (EntryMaxSubs(e) >= Peer->SubSlots)
+        {
+            /* no room for its subscriptions in its entry, so the net is loaded again below */
+            Reload[e->NetNum] = true;
+            Status            = UnloadConf_Net(e->NetNum);
+        }
+        else if (EntryChanged(o, e) || o->MaxSubs != e->MaxSubs)
         {
-            if (strcmp(TblPtr->ProtocolModules[ModuleIdx].Name, e->ProtocolName) == 0)
+            if ((Status = UnloadConf_Peer(Peer)) == SBN_SUCCESS)
             {
-                break;
-            }
+                LoadConf_Peer(TblPtr, e, Peer);
+                IndexPeer(Peer);
+                Net->IfOps->InitPeer(Peer);
+                PeerReloadCnt++;
+            } /* end if */
         }
-
-        if (ModuleIdx == TblPtr->ProtocolCnt)
+        else if (FiltersChanged(o, e))
         {
-            EVSSendCrit(SBN_TBL_EID, "invalid module name %s", e->ProtocolName);
-            return SBN_ERROR;
+            Peer->FilterCnt =
+                LoadConf_Filters(TblPtr->FilterModules, TblPtr->FilterCnt, SBN.Filters, e->Filters, Peer->Filters);
         } /* end if */
+    }     /* end for */
 
-        if (e->NetNum < 0 || e->NetNum >= SBN_MAX_NETS)
+    if (Status == SBN_SUCCESS)
+    {
+        /* nets past the new count had entries only in the old table, and were unloaded above */
+        SBN.NetCnt = NetCnt;
+    } /* end if */
+
+    for (NetIdx = 0; NetIdx < NetCnt && Status == SBN_SUCCESS; NetIdx++)
+    {
+        SBN_NetInterface_t *Net = &SBN.Nets[NetIdx];
+
+        if (!Reload[NetIdx])
         {
-            EVSSendCrit(SBN_TBL_EID, "too many networks");
-            return SBN_ERROR;
+            continue;
         } /* end if */
 
-        if (e->NetNum + 1 > SBN.NetCnt)
+        if ((Status = LoadConf_Net(TblPtr, NetIdx, MyProcessorID, MySpacecraftID)) != SBN_SUCCESS)
         {
-            SBN.NetCnt = e->NetNum + 1;
+            break;
         } /* end if */
 
-        SBN_NetInterface_t *Net = &SBN.Nets[e->NetNum];
-        if (e->ProcessorID == CFE_PSP_GetProcessorId() && e->SpacecraftID == CFE_PSP_GetSpacecraftId())
+        for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
         {
-            Net->Configured  = true;
-            Net->ProtocolIdx = ModuleIdx;
-            Net->IfOps       = SBN.IfOps[ModuleIdx];
-            Net->IfOps->LoadNet(Net, (const char *)e->Address);
-
-            Net->FilterCnt =
-                LoadConf_Filters(TblPtr->FilterModules, TblPtr->FilterCnt, Filters, e->Filters, Net->Filters);
+            IndexPeer(&Net->Peers[PeerIdx]);
+        } /* end for */
 
-            Net->TaskFlags = e->TaskFlags;
-        }
-        else
+        if (Net->Configured)
         {
-            SBN_PeerInterface_t *Peer = &Net->Peers[Net->PeerCnt++];
-            memset(Peer, 0, sizeof(*Peer));
-            Peer->Net          = Net;
-            Peer->ProcessorID  = e->ProcessorID;
-            Peer->SpacecraftID = e->SpacecraftID;
-
-            Peer->FilterCnt =
-                LoadConf_Filters(TblPtr->FilterModules, TblPtr->FilterCnt, Filters, e->Filters, Peer->Filters);
+            Net->IfOps->InitNet(Net);
 
-            SBN.IfOps[ModuleIdx]->LoadPeer(Peer, (const char *)e->Address);
-
-            Peer->TaskFlags = e->TaskFlags;
+            for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
+            {
+                Net->IfOps->InitPeer(&Net->Peers[PeerIdx]);
+            } /* end for */
         } /* end if */
-    }     /* end for */
 
-    /* address only needed at load time, release */
-    if (CFE_TBL_ReleaseAddress(SBN.ConfTblHandle) != CFE_SUCCESS)
-    {
-        EVSSendCrit(SBN_TBL_EID, "unable to release address of conf tbl");
-        return SBN_ERROR;
-    } /* end if */
+        NetReloadCnt++;
+    } /* end for */
 
-    /* ...but we keep the handle so we can be notified of updates */
-    return SBN_SUCCESS;
-} /* end LoadConf() */
+#ifdef SBN_BONDING
+    /* peers may have been added to or removed from a bond */
+    SBN_LinkBonds();
+#endif /* SBN_BONDING */
 
-static uint32 UnloadConf(void)
-{
-    uint32 Status;
+#ifdef SBN_SEND_WORKERS
+    AssignSendWorkers();
+#endif /* SBN_SEND_WORKERS */
 
-    int NetIdx = 0;
-    for (NetIdx = 0; NetIdx < SBN.NetCnt; NetIdx++)
+    if (Status != SBN_SUCCESS)
     {
-        SBN_NetInterface_t *Net = &SBN.Nets[NetIdx];
-        if ((Status = Net->IfOps->UnloadNet(Net)) != SBN_SUCCESS)
-        {
-            EVSSendCrit(SBN_TBL_EID, "unable to unload network %d", NetIdx);
-            return Status;
-        } /* end if */
-    }     /* end for */
+        /* nothing left to compare against, so the next reload reloads everything */
+        SBN.Conf = NULL;
+        return Status;
+    } /* end if */
 
-    return UnloadModules();
-} /* end UnloadConf() */
+    SBN.Conf = TblPtr;
+
+    EVSSendInfo(SBN_TBL_EID, "conf tbl reloaded, %d nets and %d peers changed", NetReloadCnt, PeerReloadCnt);
+
+    return SBN_SUCCESS;
+} /* end ReloadConf() */
 
 static uint32 LoadConfTbl(void)
 {
     int32 Status = CFE_SUCCESS;
 
-    if ((Status = CFE_TBL_Register(&SBN.ConfTblHandle, "SBN_ConfTbl", sizeof(SBN_ConfTbl_t), CFE_TBL_OPT_DEFAULT,
+    /* double buffered, so the table last applied stays intact for ReloadConf() to compare against */
+    if ((Status = CFE_TBL_Register(&SBN.ConfTblHandle, "SBN_ConfTbl", sizeof(SBN_ConfTbl_t), CFE_TBL_OPT_DBL_BUFFER,
                                    NULL)) != CFE_SUCCESS)
     {
         EVSSendErr(SBN_TBL_EID, "unable to register conf tbl handle");
@@ -1228,14 +3577,88 @@ void SBN_AppMain(void)
         return;
     } /* end if */
 
-    /** Create mutex for send tasks */
-    Status = OS_MutSemCreate(&(SBN.SendMutex), "sbn_send_mutex", 0);
+    Status = OS_MutSemCreate(&(SBN.ReasmMutex), "sbn_reasm_mutex", 0);
+
+    if (Status != OS_SUCCESS)
+    {
+        EVSSendErr(SBN_INIT_EID, "error creating mutex for reassembly");
+        return;
+    }
+
+    if (SBN_InitReasm() != SBN_SUCCESS)
+    {
+        return;
+    } /* end if */
+
+#ifdef SBN_CREDITS
+    Status = OS_MutSemCreate(&(SBN.HeldMutex), "sbn_held_mutex", 0);
+
+    if (Status != OS_SUCCESS)
+    {
+        EVSSendErr(SBN_INIT_EID, "error creating mutex for held messages");
+        return;
+    }
+#endif /* SBN_CREDITS */
+
+#ifdef SBN_DEDUP
+    Status = OS_MutSemCreate(&(SBN.DedupMutex), "sbn_dedup_mutex", 0);
 
     if (Status != OS_SUCCESS)
     {
-        EVSSendErr(SBN_INIT_EID, "error creating mutex for send tasks");
+        EVSSendErr(SBN_INIT_EID, "error creating mutex for the dedup table");
         return;
     }
+#endif /* SBN_DEDUP */
+
+    if (SBN_InitBufPool() != SBN_SUCCESS)
+    {
+        return;
+    } /* end if */
+
+#ifdef SBN_RECV_WORKERS
+    if (CreateRecvWorkers() != SBN_SUCCESS)
+    {
+        return;
+    } /* end if */
+#endif /* SBN_RECV_WORKERS */
+
+#ifdef SBN_SEND_WORKERS
+    if (CreateSendWorkers() != SBN_SUCCESS)
+    {
+        return;
+    } /* end if */
+#endif /* SBN_SEND_WORKERS */
+
+#ifdef SBN_SHARED_PIPE
+    /* Create the pipe shared by all peers without a send task */
+    Status = CFE_SB_CreatePipe(&SBN.SharedPipe, SBN_SHARED_PIPE_DEPTH, "SBNSharedPipe");
+    if (Status != CFE_SUCCESS)
+    {
+        EVSSendErr(SBN_INIT_EID, "failed to create shared pipe (Status=%d)", (int)Status);
+        return;
+    } /* end if */
+
+    Status = CFE_SB_SetPipeOpts(SBN.SharedPipe, CFE_SB_PIPEOPTS_IGNOREMINE);
+    if (Status != CFE_SUCCESS)
+    {
+        EVSSendErr(SBN_INIT_EID, "failed to set shared pipe options (Status=%d)", (int)Status);
+        return;
+    } /* end if */
+
+    Status = CFE_SB_CreatePipe(&SBN.SharedHiPipe, SBN_SHARED_HI_PIPE_DEPTH, "SBNSharedHiPipe");
+    if (Status != CFE_SUCCESS)
+    {
+        EVSSendErr(SBN_INIT_EID, "failed to create shared hi pipe (Status=%d)", (int)Status);
+        return;
+    } /* end if */
+
+    Status = CFE_SB_SetPipeOpts(SBN.SharedHiPipe, CFE_SB_PIPEOPTS_IGNOREMINE);
+    if (Status != CFE_SUCCESS)
+    {
+        EVSSendErr(SBN_INIT_EID, "failed to set shared hi pipe options (Status=%d)", (int)Status);
+        return;
+    } /* end if */
+#endif /* SBN_SHARED_PIPE */
 
     if (InitInterfaces() == SBN_ERROR)
     {
@@ -1331,6 +3754,122 @@ void SBN_AppMain(void)
     CFE_ES_ExitApp(RunStatus);
 } /* end SBN_AppMain */
 
+/**
+ * Forgets the capabilities negotiated with a peer, until the peer's next
+ * SBN_PROTO_MSG only the base protocol is used.
+ *
+ * @param[in] Peer The peer.
+ */
+static void ResetPeerCaps(SBN_PeerInterface_t *Peer)
+{
+    Peer->Features = 0;
+    Peer->MTU      = Peer->Net->MTU;
+    Peer->MaxBatch = 1;
+    Peer->RelLanes = 0;
+
+#ifdef SBN_CREDITS
+    SBN_ResetCredit(Peer);
+#endif /* SBN_CREDITS */
+} /* end ResetPeerCaps() */
+
+/**
+ * Sends the protocol version and the capabilities of this CPU to a peer.
+ *
+ * @param[in] Peer The peer.
+ * @return SBN_SUCCESS on success, otherwise the SBN_SendNetMsg error.
+ */
+static SBN_Status_t SendProtoMsg(SBN_PeerInterface_t *Peer)
+{
+    uint8  Buf[SBN_PACKED_PROTO_SZ];
+    Pack_t Pack;
+
+    Pack_Init(&Pack, Buf, sizeof(Buf), true);
+    Pack_UInt8(&Pack, SBN_PROTO_VER);
+    Pack_UInt32(&Pack, SBN_LOCAL_FEATURES);
+    Pack_UInt32(&Pack, Peer->Net->MTU ? Peer->Net->MTU : SBN_MAX_PACKED_MSG_SZ);
+    Pack_UInt16(&Pack, SBN_MAX_BATCH_MSGS);
+    Pack_UInt8(&Pack, SBN_MAX_REL_LANES);
+
+    return SBN_SendNetMsg(SBN_PROTO_MSG, (SBN_MsgSz_t)Pack.BufUsed, Buf, Peer);
+} /* end SendProtoMsg() */
+
+/**
+ * Processes the protocol version and capabilities a peer sends on connect,
+ * negotiating the highest feature set and the tightest limits both ends
+ * support. Peers older than SBN_PROTO_VER_CAPS only send the version, and
+ * get the base protocol. Newer peers may append fields we ignore.
+ *
+ * @param[in] Peer The peer.
+ * @param[in] MsgSz The size of the SBN_PROTO_MSG payload.
+ * @param[in] Msg The SBN_PROTO_MSG payload.
+ * @return SBN_SUCCESS
+ */
+static SBN_Status_t ProcessProtoMsg(SBN_PeerInterface_t *Peer, SBN_MsgSz_t MsgSz, void *Msg)
+{
+    uint8  Ver = ((uint8 *)Msg)[0], RelLanes = 0;
+    uint32 Features = 0, MaxFrame = 0;
+    uint16 MaxBatch = 0;
+    Pack_t Pack;
+
+    if (Ver != SBN_PROTO_VER)
+    {
+        EVSSendErr(SBN_SB_EID,
+                   "SBN protocol version mismatch with ProcessorID %d, "
+                   "my version=%d, peer version %d",
+                   (int)Peer->ProcessorID, (int)SBN_PROTO_VER, (int)Ver);
+    }
+    else
+    {
+        EVSSendInfo(SBN_SB_EID, "SBN protocol version match with ProcessorID %d", (int)Peer->ProcessorID);
+    } /* end if */
+
+    ResetPeerCaps(Peer);
+
+    if (Ver < SBN_PROTO_VER_CAPS || MsgSz < (SBN_MsgSz_t)SBN_PACKED_PROTO_SZ)
+    {
+        return SBN_SUCCESS;
+    } /* end if */
+
+    Pack_Init(&Pack, (uint8 *)Msg + 1, MsgSz - 1, false);
+    Unpack_UInt32(&Pack, &Features);
+    Unpack_UInt32(&Pack, &MaxFrame);
+    Unpack_UInt16(&Pack, &MaxBatch);
+    Unpack_UInt8(&Pack, &RelLanes);
+
+    Peer->Features = Features & SBN_LOCAL_FEATURES;
+
+    /* a limit too small to carry a fragment is ignored */
+    if (MaxFrame > SBN_PACKED_HDR_SZ + SBN_PACKED_FRAG_HDR_SZ && (Peer->MTU == 0 || MaxFrame < Peer->MTU) &&
+        MaxFrame < SBN_MAX_PACKED_MSG_SZ)
+    {
+        Peer->MTU = MaxFrame;
+    } /* end if */
+
+    if (MaxBatch > 1 && (Peer->Features & SBN_FEAT_BATCH))
+    {
+        Peer->MaxBatch = MaxBatch < SBN_MAX_BATCH_MSGS ? MaxBatch : SBN_MAX_BATCH_MSGS;
+    } /* end if */
+
+    if (Peer->Features & SBN_FEAT_RELIABLE)
+    {
+        Peer->RelLanes = RelLanes < SBN_MAX_REL_LANES ? RelLanes : SBN_MAX_REL_LANES;
+    } /* end if */
+
+    EVSSendInfo(SBN_PROTO_EID, "negotiated with ProcessorID %d: features=0x%x MTU=%d batch=%d lanes=%d",
+                (int)Peer->ProcessorID, (unsigned int)Peer->Features, (int)Peer->MTU, (int)Peer->MaxBatch,
+                (int)Peer->RelLanes);
+
+#ifdef SBN_CREDITS
+    if (Peer->Features & SBN_FEAT_CREDIT)
+    {
+        /* the peer sends me nothing until I grant it credit */
+        SBN_GrantCredit(Peer);
+    } /* end if */
+#endif /* SBN_CREDITS */
+
+    return SBN_SUCCESS;
+} /* end ProcessProtoMsg() */
+
 /**
  * Sends a message to a peer.
  * @param[in] MsgType The type of the message (application data, SBN protocol)
@@ -1356,31 +3895,57 @@ SBN_Status_t SBN_ProcessNetMsg(SBN_NetInterface_t *Net, SBN_MsgType_t MsgType, C
     switch (MsgType)
     {
         case SBN_PROTO_MSG:
-        {
-            uint8 Ver = ((uint8 *)Msg)[0];
-            if (Ver != SBN_PROTO_VER)
+            SBN_Status = ProcessProtoMsg(Peer, MsgSize, Msg);
+            if (SBN_Status != SBN_SUCCESS || !Peer->Connected || !(Peer->Features & SBN_FEAT_SUBRANGE))
             {
-                EVSSendErr(SBN_SB_EID,
-                           "SBN protocol version mismatch with ProcessorID %d, "
-                           "my version=%d, peer version %d",
-                           (int)Peer->ProcessorID, (int)SBN_PROTO_VER, (int)Ver);
-            }
-            else
-            {
-                EVSSendInfo(SBN_SB_EID, "SBN protocol version match with ProcessorID %d", (int)Peer->ProcessorID);
+                return SBN_Status;
             } /* end if */
-            break;
-        } /* end case */
+
+            /* the peer takes ranges, resend the subscriptions sent on connect more compactly */
+            return SBN_SendLocalSubsToPeer(Peer);
+
         case SBN_APP_MSG:
+#ifdef SBN_BRIDGE
+        case SBN_RELAY_MSG:
+#endif /* SBN_BRIDGE */
         {
             SBN_ModuleIdx_t  FilterIdx = 0;
             SBN_Filter_Ctx_t Filter_Context;
 
+#ifdef SBN_CREDITS
+            /* whatever becomes of it, the peer sent it against my grant */
+            SBN_CountCredit(Peer);
+#endif /* SBN_CREDITS */
+
+#ifdef SBN_BRIDGE
+            CFE_ProcessorID_t Origin = Peer->ProcessorID;
+            uint8             Hops   = 0;
+
+            if (MsgType == SBN_RELAY_MSG && SBN_UnpackRelay(Peer, &MsgSize, Msg, &Origin, &Hops) != SBN_SUCCESS)
+            {
+                return SBN_ERROR;
+            } /* end if */
+
+            if (SBN_SeenMsg(Origin, MsgSize, Msg))
+            {
+                /* already received over another path */
+                return SBN_SUCCESS;
+            } /* end if */
+#elif defined(SBN_BONDING)
+            if (Peer->BondFirst != NULL && SBN_SeenMsg(Peer->ProcessorID, MsgSize, Msg))
+            {
+                /* already received over another path of the bond */
+                return SBN_SUCCESS;
+            } /* end if */
+#endif /* SBN_BRIDGE */
+
             Filter_Context.MyProcessorID    = CFE_PSP_GetProcessorId();
             Filter_Context.MySpacecraftID   = CFE_PSP_GetSpacecraftId();
             Filter_Context.PeerProcessorID  = Peer->ProcessorID;
             Filter_Context.PeerSpacecraftID = Peer->SpacecraftID;
 
+            CFE_ES_PerfLogEntry(SBN_PEER_PERF_ID(Peer, SBN_PERF_RECVFILTER_ID));
+
             for (FilterIdx = 0; FilterIdx < Peer->FilterCnt; FilterIdx++)
             {
                 if (Peer->Filters[FilterIdx]->FilterRecv == NULL)
@@ -1393,17 +3958,40 @@ SBN_Status_t SBN_ProcessNetMsg(SBN_NetInterface_t *Net, SBN_MsgType_t MsgType, C
                 /* includes SBN_IF_EMPTY, for when filter recommends removing */
                 if (SBN_Status != SBN_SUCCESS)
                 {
-                    return SBN_Status;
+                    break;
                 } /* end if */
             }     /* end for */
 
+            CFE_ES_PerfLogExit(SBN_PEER_PERF_ID(Peer, SBN_PERF_RECVFILTER_ID));
+
+            if (SBN_Status != SBN_SUCCESS)
+            {
+                return SBN_Status;
+            } /* end if */
+
+            CFE_ES_PerfLogEntry(SBN_PEER_PERF_ID(Peer, SBN_PERF_PASSMSG_ID));
             CFE_Status = CFE_SB_PassMsg(Msg);
+            CFE_ES_PerfLogExit(SBN_PEER_PERF_ID(Peer, SBN_PERF_PASSMSG_ID));
 
             if (CFE_Status != CFE_SUCCESS)
             {
                 EVSSendErr(SBN_SB_EID, "CFE_SB_PassMsg error (Status=%d MsgType=0x%x)", CFE_Status, MsgType);
+#ifdef SBN_CREDITS
+                SBN_WithholdCredit(Peer);
+#endif /* SBN_CREDITS */
                 return SBN_ERROR;
             } /* end if */
+
+#ifdef SBN_MID_STATS
+            if (SBN.MidStats != NULL)
+            {
+                CountMid(SBN.MidStats[Peer->Slot].Recv, Msg, MsgSize);
+            } /* end if */
+#endif /* SBN_MID_STATS */
+
+#ifdef SBN_BRIDGE
+            SBN_RelayMsg(Peer, Origin, Hops, MsgSize, Msg);
+#endif /* SBN_BRIDGE */
             break;
         } /* end case */
         case SBN_SUB_MSG:
@@ -1412,6 +4000,20 @@ SBN_Status_t SBN_ProcessNetMsg(SBN_NetInterface_t *Net, SBN_MsgType_t MsgType, C
         case SBN_UNSUB_MSG:
             return SBN_ProcessUnsubsFromPeer(Peer, Msg);
 
+        case SBN_SUBRANGE_MSG:
+            return SBN_ProcessSubRangesFromPeer(Peer, Msg);
+
+        case SBN_UNSUBRANGE_MSG:
+            return SBN_ProcessUnsubRangesFromPeer(Peer, Msg);
+
+        case SBN_FRAG_MSG:
+            return SBN_ProcessFragFromPeer(Peer, MsgSize, Msg);
+
+#ifdef SBN_CREDITS
+        case SBN_CREDIT_MSG:
+            return SBN_ProcessCreditMsg(Peer, MsgSize, Msg);
+#endif /* SBN_CREDITS */
+
         case SBN_NO_MSG:
             return SBN_SUCCESS;
         default:
@@ -1431,35 +4033,75 @@ SBN_Status_t SBN_ProcessNetMsg(SBN_NetInterface_t *Net, SBN_MsgType_t MsgType, C
  */
 SBN_PeerInterface_t *SBN_GetPeer(SBN_NetInterface_t *Net, CFE_ProcessorID_t ProcessorID)
 {
-    SBN_PeerIdx_t PeerIdx = 0;
+    SBN_PeerInterface_t *Peer = __atomic_load_n(&Net->PeerHash[SBN_PEER_HASH(ProcessorID)], __ATOMIC_ACQUIRE);
 
-    for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
+    for (; Peer != NULL; Peer = Peer->HashNext)
     {
-        if (Net->Peers[PeerIdx].ProcessorID == ProcessorID)
+        if (Peer->ProcessorID == ProcessorID)
         {
-            return &Net->Peers[PeerIdx];
+            return Peer;
         } /* end if */
     }     /* end for */
 
     return NULL;
 } /* end SBN_GetPeer */
 
-SBN_Status_t SBN_Connected(SBN_PeerInterface_t *Peer)
+/**
+ * \brief Chains every peer into its net's SBN_GetPeer() hash table and puts it
+ * on the poll wheel, due at the next wakeup. Called once the peers are loaded.
+ */
+void SBN_IndexPeers(void)
 {
-    SBN_Status_t SBN_Status = SBN_SUCCESS;
-    CFE_Status_t CFE_Status;
+    SBN_NetIdx_t  NetIdx  = 0;
+    SBN_PeerIdx_t PeerIdx = 0;
+    OS_time_t     Now;
 
-    if (Peer->Connected != 0)
+    memset(SBN.PollWheel, 0, sizeof(SBN.PollWheel));
+
+    /* every peer is due on the next wakeup */
+    OS_GetLocalTime(&Now);
+    SBN.PollTick = SBN_POLL_TICK(&Now);
+
+    for (NetIdx = 0; NetIdx < SBN.NetCnt; NetIdx++)
     {
-        EVSSendErr(SBN_PEER_EID, "CPU %d already connected", Peer->ProcessorID);
-        return SBN_ERROR;
-    } /* end if */
+        SBN_NetInterface_t *Net = &SBN.Nets[NetIdx];
+
+        memset(Net->PeerHash, 0, sizeof(Net->PeerHash));
+
+        for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
+        {
+            if (!Net->Peers[PeerIdx].Unused)
+            {
+                IndexPeer(&Net->Peers[PeerIdx]);
+            } /* end if */
+        }     /* end for */
+    }         /* end for */
+} /* end SBN_IndexPeers() */
+
+void SBN_SchedulePoll(SBN_PeerInterface_t *Peer, uint32 DelayMS)
+{
+    Peer->PollDelayMS = DelayMS;
+} /* end SBN_SchedulePoll() */
 
-    char PipeName[OS_MAX_API_NAME];
+/**
+ * \brief Create one of the pipes that collect the messages the peer
+ *        subscribes to.
+ *
+ * @param[out] PipePtr The pipe ID created.
+ * @param[in] Depth The pipe depth.
+ * @param[in] NameFmt The pipe name format, takes the peer's ProcessorID.
+ * @param[in] Peer The peer interface.
+ *
+ * @return SBN_SUCCESS on success, otherwise SBN_ERROR.
+ */
+static SBN_Status_t CreatePeerPipe(CFE_SB_PipeId_t *PipePtr, uint16 Depth, const char *NameFmt,
+                                   SBN_PeerInterface_t *Peer)
+{
+    CFE_Status_t CFE_Status;
+    char         PipeName[OS_MAX_API_NAME];
 
-    /* create a pipe name string similar to SBN_0_Pipe */
-    snprintf(PipeName, OS_MAX_API_NAME, "SBN_%d_Pipe", Peer->ProcessorID);
-    CFE_Status = CFE_SB_CreatePipe(&(Peer->Pipe), SBN_PEER_PIPE_DEPTH, PipeName);
+    snprintf(PipeName, OS_MAX_API_NAME, NameFmt, Peer->ProcessorID);
+    CFE_Status = CFE_SB_CreatePipe(PipePtr, Depth, PipeName);
 
     if (CFE_Status != CFE_SUCCESS)
     {
@@ -1470,7 +4112,7 @@ SBN_Status_t SBN_Connected(SBN_PeerInterface_t *Peer)
 
     EVSSendInfo(SBN_PEER_EID, "pipe created '%s'", PipeName);
 
-    CFE_Status = CFE_SB_SetPipeOpts(Peer->Pipe, CFE_SB_PIPEOPTS_IGNOREMINE);
+    CFE_Status = CFE_SB_SetPipeOpts(*PipePtr, CFE_SB_PIPEOPTS_IGNOREMINE);
     if (CFE_Status != CFE_SUCCESS)
     {
         EVSSendErr(SBN_PEER_EID, "failed to set pipe options '%s'", PipeName);
@@ -1478,23 +4120,81 @@ SBN_Status_t SBN_Connected(SBN_PeerInterface_t *Peer)
         return SBN_ERROR;
     } /* end if */
 
+    return SBN_SUCCESS;
+} /* end CreatePeerPipe() */
+
+/**
+ * \brief Create the low and high priority pipes for a peer, and the pipe
+ * for its conflated message ID's if it has any.
+ *
+ * @param[in] Peer The peer interface.
+ *
+ * @return SBN_SUCCESS on success, otherwise SBN_ERROR.
+ */
+static SBN_Status_t CreatePeerPipes(SBN_PeerInterface_t *Peer)
+{
+#ifdef SBN_SHARED_PIPE
+    if (SBN_USES_SHARED_PIPE(Peer))
+    {
+        /* subscriptions go to the shared pipes, see SBN_CheckSharedPipe() */
+        return SBN_SUCCESS;
+    } /* end if */
+#endif /* SBN_SHARED_PIPE */
+
+    /* create pipe name strings similar to SBN_0_Pipe */
+    if (CreatePeerPipe(&Peer->Pipe, SBN_PEER_PIPE_DEPTH, "SBN_%d_Pipe", Peer) != SBN_SUCCESS)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    if (CreatePeerPipe(&Peer->HiPipe, SBN_PEER_HI_PIPE_DEPTH, "SBN_%d_HiPipe", Peer) != SBN_SUCCESS)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    if (Peer->ConflateCnt == 0)
+    {
+        return SBN_SUCCESS;
+    } /* end if */
+
+    /* drained whenever the other pipes are read, so it only needs to hold what arrives during a send */
+    return CreatePeerPipe(&Peer->ConflatePipe, Peer->ConflateCnt * SBN_DEFAULT_MSG_LIM, "SBN_%d_LvPipe", Peer);
+} /* end CreatePeerPipes() */
+
+SBN_Status_t SBN_Connected(SBN_PeerInterface_t *Peer)
+{
+    SBN_Status_t SBN_Status = SBN_SUCCESS;
+
+    if (Peer->Connected != 0)
+    {
+        EVSSendErr(SBN_PEER_EID, "CPU %d already connected", Peer->ProcessorID);
+        return SBN_ERROR;
+    } /* end if */
+
+    if (CreatePeerPipes(Peer) != SBN_SUCCESS)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
     EVSSendInfo(SBN_PEER_EID, "CPU %d connected", Peer->ProcessorID);
 
-    uint8 ProtocolVer = SBN_PROTO_VER;
-    SBN_Status        = SBN_SendNetMsg(SBN_PROTO_MSG, sizeof(ProtocolVer), &ProtocolVer, Peer);
+    ResetPeerCaps(Peer);
+
+    SBN_Status = SendProtoMsg(Peer);
     if (SBN_Status != SBN_SUCCESS)
     {
         return SBN_Status;
     } /* end if */
 
     /* set this to current time so we don't think we've already timed out */
-    OS_GetLocalTime(&Peer->LastRecv);
-
-    SBN_Status = SBN_SendLocalSubsToPeer(Peer);
+    Stamp(&Peer->RecvSeq, &Peer->LastRecv, NULL);
+    SBN_ResetArrivals(Peer);
 
     Peer->Connected = 1;
 
-    return SBN_Status;
+    /* send the local subscriptions now in the base format every peer takes,
+     * rather than waiting on an SBN_PROTO_MSG that may never arrive */
+    return SBN_SendLocalSubsToPeer(Peer);
 } /* end SBN_Connected() */
 
 SBN_Status_t SBN_Disconnected(SBN_PeerInterface_t *Peer)
@@ -1508,29 +4208,122 @@ SBN_Status_t SBN_Disconnected(SBN_PeerInterface_t *Peer)
 
     Peer->Connected = 0; /**< mark as disconnected before deleting pipe */
 
-    CFE_SB_DeletePipe(Peer->Pipe); /* ignore returned errors */
-    Peer->Pipe = 0;
+#ifdef SBN_SHARED_PIPE
+    if (SBN_USES_SHARED_PIPE(Peer))
+    {
+        /* drop this peer from the shared pipe fan-out */
+        SBN_RemoveAllSubsFromPeer(Peer);
+    }
+    else
+#endif /* SBN_SHARED_PIPE */
+    {
+        CFE_SB_DeletePipe(Peer->Pipe); /* ignore returned errors */
+        Peer->Pipe = 0;
+
+        CFE_SB_DeletePipe(Peer->HiPipe); /* ignore returned errors */
+        Peer->HiPipe = 0;
+
+        if (Peer->ConflateCnt != 0)
+        {
+            CFE_SB_DeletePipe(Peer->ConflatePipe); /* ignore returned errors */
+            Peer->ConflatePipe = 0;
+        } /* end if */
+
+        SBN_ResetConflated(Peer);
+    } /* end if */
 
     Peer->SubCnt = 0; /* reset sub count, in case this is a reconnection */
 
+#ifdef SBN_CREDITS
+    SBN_DropHeld(Peer);
+#endif /* SBN_CREDITS */
+
+    ResetPeerCaps(Peer);
+
     EVSSendInfo(SBN_PEER_EID, "CPU %d disconnected", Peer->ProcessorID);
 
+#ifdef SBN_BONDING
+    SBN_BondPathDown(Peer);
+#endif /* SBN_BONDING */
+
     return SBN_SUCCESS;
 } /* end SBN_Disconnected() */
 
+/**
+ * Waits for the send and receive workers to finish the pass they are in and
+ * keeps them from starting another, so that a reload can change the nets and
+ * peers under them. Undone by ResumeWorkers().
+ */
+static void QuiesceWorkers(void)
+{
+#ifdef SBN_SEND_WORKERS
+    int SendIdx = 0;
+
+    for (SendIdx = 0; SendIdx < SBN_SEND_WORKERS; SendIdx++)
+    {
+        OS_MutSemTake(SBN.SendWorkerMutexes[SendIdx]);
+    } /* end for */
+#endif /* SBN_SEND_WORKERS */
+
+#ifdef SBN_RECV_WORKERS
+    int RecvIdx = 0;
+
+    for (RecvIdx = 0; RecvIdx < SBN_RECV_WORKERS; RecvIdx++)
+    {
+        OS_MutSemTake(SBN.RecvWorkerMutexes[RecvIdx]);
+    } /* end for */
+#endif /* SBN_RECV_WORKERS */
+} /* end QuiesceWorkers() */
+
+/** Lets the workers stopped by QuiesceWorkers() run again. */
+static void ResumeWorkers(void)
+{
+#ifdef SBN_SEND_WORKERS
+    int SendIdx = 0;
+
+    for (SendIdx = 0; SendIdx < SBN_SEND_WORKERS; SendIdx++)
+    {
+        OS_MutSemGive(SBN.SendWorkerMutexes[SendIdx]);
+    } /* end for */
+#endif /* SBN_SEND_WORKERS */
+
+#ifdef SBN_RECV_WORKERS
+    int RecvIdx = 0;
+
+    for (RecvIdx = 0; RecvIdx < SBN_RECV_WORKERS; RecvIdx++)
+    {
+        OS_MutSemGive(SBN.RecvWorkerMutexes[RecvIdx]);
+    } /* end for */
+#endif /* SBN_RECV_WORKERS */
+} /* end ResumeWorkers() */
+
 SBN_Status_t SBN_ReloadConfTbl(void)
 {
-    SBN_Status_t Status;
+    SBN_ConfTbl_t *TblPtr = NULL;
+    SBN_Status_t   Status = SBN_SUCCESS;
+    CFE_Status_t   CFE_Status;
 
-    if ((Status = UnloadConf()) != SBN_SUCCESS)
+    if (CFE_TBL_Update(SBN.ConfTblHandle) != CFE_SUCCESS)
     {
-        return Status;
+        return SBN_ERROR;
     } /* end if */
 
-    if (CFE_TBL_Update(SBN.ConfTblHandle) != CFE_SUCCESS)
+    CFE_Status = CFE_TBL_GetAddress((void **)&TblPtr, SBN.ConfTblHandle);
+    if (CFE_Status != CFE_SUCCESS && CFE_Status != CFE_TBL_INFO_UPDATED)
+    {
+        EVSSendErr(SBN_TBL_EID, "unable to get conf table address");
+        return SBN_ERROR;
+    } /* end if */
+
+    QuiesceWorkers();
+    Status = ReloadConf(TblPtr);
+    ResumeWorkers();
+
+    if (CFE_TBL_ReleaseAddress(SBN.ConfTblHandle) != CFE_SUCCESS)
     {
+        EVSSendCrit(SBN_TBL_EID, "unable to release address of conf tbl");
         return SBN_ERROR;
     } /* end if */
 
-    return LoadConf();
+    return Status;
 } /* end SBN_ReloadConfTbl() */
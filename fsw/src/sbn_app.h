@@ -39,6 +39,15 @@
 #include "sbn_msgids.h"
 #include "sbn_cmds.h"
 #include "sbn_subs.h"
+#include "sbn_frag.h"
+#include "sbn_bridge.h"
+#include "sbn_credit.h"
+#include "sbn_detect.h"
+#include "sbn_bond.h"
+#include "sbn_conflate.h"
+#include "sbn_ttl.h"
+#include "sbn_task.h"
+#include "sbn_buf.h"
 #include "sbn_main_events.h"
 #include "sbn_perfids.h"
 #include "sbn_types.h"
@@ -63,6 +72,150 @@ SBN_Status_t SBN_RecvNetMsgs(void);
 
 void SBN_CheckPeerPipes(void);
 
+/** \brief SBN_PROTO_MSG is Version, Features, MaxFrame, MaxBatch, RelLanes */
+#define SBN_PACKED_PROTO_SZ (sizeof(uint8) + sizeof(uint32) * 2 + sizeof(uint16) + sizeof(uint8))
+
+/** \brief Subscriptions with a high QoS priority go on the high priority lane. */
+#define SBN_IS_HI_QOS(QoS) ((QoS).Priority == CFE_SB_QosPriority_HIGH)
+
+/** \brief Subscriptions to consecutive message ID's with the same QoS can share a range. */
+#define SBN_SAME_QOS(A, B) ((A).Priority == (B).Priority && (A).Reliability == (B).Reliability)
+
+/** \brief The bucket of its net's PeerHash the peer with this ProcessorID is chained in. */
+#define SBN_PEER_HASH(ProcessorID) ((ProcessorID) & (SBN_PEER_HASH_SZ - 1))
+
+/** \brief The poll wheel tick of an OS_time_t, wraps continuously at 2^32 ticks. */
+#define SBN_POLL_TICK(TimePtr) \
+    ((TimePtr)->seconds * (1000 / SBN_POLL_WHEEL_TICK) + (TimePtr)->microsecs / (SBN_POLL_WHEEL_TICK * 1000))
+
+/** \brief The perf log ID of a pipeline stage (an SBN_PERF_*_ID stage ID) for this peer. */
+#define SBN_PEER_PERF_ID(Peer, StageID) SBN_PERF_PEER_ID((Peer)->Slot, (StageID))
+
+/**
+ * \brief Bumps a peer HK counter. Counters are bumped with a relaxed atomic
+ * add so that increments from different tasks (or a racing reset) are not lost.
+ */
+#define SBN_HK_INC(Cnt) ((void)__atomic_fetch_add(&(Cnt), 1, __ATOMIC_RELAXED))
+
+/** \brief Stores a peer HK counter or time field that other tasks read. */
+#define SBN_HK_SET(Field, Val) __atomic_store_n(&(Field), (Val), __ATOMIC_RELAXED)
+
+/** \brief Loads a peer HK counter or time field that other tasks write. */
+#define SBN_HK_GET(Field) __atomic_load_n(&(Field), __ATOMIC_RELAXED)
+
+#ifdef SBN_SHARED_PIPE
+/**
+ * \brief A message ID that one or more polled peers have subscribed to on the
+ * shared fan-out pipe, and the set of those peers (one bit per slot in
+ * SBN.Peers).
+ */
+typedef struct
+{
+    CFE_SB_MsgId_t MsgID;
+    uint16         PeerCnt;
+    bool           HiLane;   /**< subscribed on SharedHiPipe rather than SharedPipe */
+    uint32 *       PeerMask; /**< SBN.PeerMaskWords words of SBN.SharedMasks, for the entry's index */
+} SBN_SharedSub_t;
+
+/** \brief Peers without a send task are fed from the shared pipe. */
+#define SBN_USES_SHARED_PIPE(Peer) (!((Peer)->TaskFlags & SBN_TASK_SEND))
+#endif /* SBN_SHARED_PIPE */
+
+#ifdef SBN_RECV_WORKERS
+/** \brief The largest control message a receive worker hands to the main task. */
+#define SBN_MAX_CTRL_MSG_SZ SBN_PACKED_SUBRANGE_SZ
+
+/**
+ * \brief A control (non-app) message received by a receive worker, queued
+ * for the main task to process.
+ */
+typedef struct
+{
+    SBN_NetIdx_t      NetIdx;
+    CFE_ProcessorID_t ProcessorID;
+    SBN_MsgType_t     MsgType;
+    SBN_MsgSz_t       MsgSz;
+    uint8             Msg[SBN_MAX_CTRL_MSG_SZ];
+} SBN_CtrlMsg_t;
+#endif /* SBN_RECV_WORKERS */
+
+/**
+ * \brief A buffer in which an SB message is reassembled from the fragments
+ * received from a peer. Free when Peer is NULL.
+ */
+typedef struct
+{
+    SBN_PeerInterface_t *Peer;
+    uint16               FragID, FragCnt, RecvCnt;
+    uint32               TotalSz;
+
+    /** \brief One bit per fragment received, to drop duplicates. */
+    uint32 RecvMask[(SBN_MAX_FRAGS + 31) / 32];
+
+    /** \brief When the first fragment was received, for timing out. */
+    OS_time_t Started;
+
+    uint8 Buf[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
+} SBN_Reasm_t;
+
+#ifdef SBN_DEDUP
+/** \brief Spreads origins and message ID's over the SBN_DEDUP_SZ entries of the dedup table. */
+#define SBN_DEDUP_HASH(Origin, MsgID) \
+    (((((uint32)(Origin) << 16) ^ (uint32)(MsgID)) * 2654435761u >> 16) & (SBN_DEDUP_SZ - 1))
+
+/**
+ * \brief The CCSDS sequence counts of the latest messages received with one
+ * message ID from one origin. Bit N of Window is set if LastSeq - N has been
+ * received, an entry is free when Window is 0.
+ */
+typedef struct
+{
+    CFE_ProcessorID_t Origin;
+    CFE_SB_MsgId_t    MsgID;
+    uint16            LastSeq;
+    uint32            Window;
+} SBN_Dedup_t;
+#endif /* SBN_DEDUP */
+
+/**
+ * \brief A buffer in the message buffer pool, large enough for a packed SBN
+ * message and aligned for an SB message. Free buffers are chained through
+ * Next.
+ */
+typedef union SBN_BufSlot_u
+{
+    union SBN_BufSlot_u *Next;
+    uint64               Align;
+    uint8                Data[SBN_MAX_PACKED_MSG_SZ];
+} SBN_BufSlot_t;
+
+#ifdef SBN_MID_STATS
+/** \brief Spreads message ID's over a peer's SBN_MID_STATS_SZ counters. */
+#define SBN_MID_HASH(MsgID) ((((uint32)(MsgID)) * 2654435761u >> 16) & (SBN_MID_STATS_SZ - 1))
+
+/** \brief Traffic for one message ID in one direction to or from a peer. */
+typedef struct
+{
+    bool           InUse;
+    CFE_SB_MsgId_t MsgID;
+
+    /** \brief Written only by the peer's send (or receive) side. */
+    uint32 MsgCnt, Bytes;
+
+    /** \brief The counts at the last SBN_HK_PEERMIDS_CC report, written by the main task. */
+    uint32 BaseMsgCnt, BaseBytes;
+} SBN_MidStats_t;
+
+/** \brief A peer's per message ID traffic, open addressed by SBN_MID_HASH(). */
+typedef struct
+{
+    /** \brief When the current reporting interval started. */
+    OS_time_t Since;
+
+    SBN_MidStats_t Send[SBN_MID_STATS_SZ], Recv[SBN_MID_STATS_SZ];
+} SBN_PeerMidStats_t;
+#endif /* SBN_MID_STATS */
+
 /**
  * \brief SBN global data structure definition
  */
@@ -70,8 +223,41 @@ typedef struct
 {
     SBN_NetIdx_t NetCnt;
 
-    /** \brief Data only on host definitions. */
-    SBN_NetInterface_t Nets[SBN_MAX_NETS];
+    /**
+     * \brief The nets, NetSlots of them allocated when the configuration is
+     * loaded, as many as it configures. A reload that adds nets past NetSlots
+     * reloads everything. Each net allocates its own peers (and their
+     * subscription tables.)
+     */
+    SBN_NetInterface_t *Nets;
+
+    SBN_NetIdx_t NetSlots;
+
+    /**
+     * \brief The PeerCnt peers of all nets, each in the slot it was given when
+     * it was loaded (NULL for a free slot.) A peer keeps its slot, and so its
+     * shared pipe bit, message ID counters and perf ID's, across reloads that
+     * do not change it.
+     */
+    SBN_PeerInterface_t **Peers;
+    uint16                PeerCnt;
+
+    /**
+     * \brief The number of slots in Peers, ReadyPeers and MidStats, allocated
+     * by the last full load for the entries in the configuration table and
+     * the spare entries of each net. A reload configuring more peers than
+     * this reloads everything.
+     */
+    SBN_PeerIdx_t PeerSlots;
+
+    /** \brief The polled peers still draining their pipes, see CheckPeerPipes(). */
+    SBN_PeerInterface_t **ReadyPeers;
+
+    /** \brief The peers due to be polled in each tick of the poll wheel. */
+    SBN_PeerInterface_t *PollWheel[SBN_POLL_WHEEL_SLOTS];
+
+    /** \brief The next poll wheel tick to process. */
+    uint32 PollTick;
 
     /** \brief The application ID provided by ES */
     CFE_ES_AppID_t AppID;
@@ -103,6 +289,51 @@ typedef struct
      */
     SBN_Subs_t Subs[SBN_MAX_SUBS_PER_PEER + 1];
 
+    /**
+     * \brief A bit per message ID in Subs, set and cleared by the main task,
+     * so receive tasks can check for a local subscription (SBN_Subscribed())
+     * without walking Subs while the main task changes it.
+     */
+    uint8 SubMap[CFE_PLATFORM_SB_HIGHEST_VALID_MSGID / 8 + 1];
+
+#ifdef SBN_SHARED_PIPE
+    /**
+     * \brief The pipe SBN subscribes to, once per message ID, on behalf of
+     * all polled peers.
+     */
+    CFE_SB_PipeId_t SharedPipe;
+
+    /** \brief The shared pipe for high priority message ID's. */
+    CFE_SB_PipeId_t SharedHiPipe;
+
+    /**
+     * \brief Maps a message ID to its (index + 1) in SharedSubs, 0 if no
+     * polled peer is subscribed to that message ID.
+     */
+    uint16 SharedSubIdx[CFE_PLATFORM_SB_HIGHEST_VALID_MSGID + 1];
+
+    /** \brief Message ID's subscribed to on the shared pipe, and by whom. */
+    SBN_SharedSub_t SharedSubs[SBN_MAX_SHARED_SUBS];
+
+    uint16 SharedSubCnt;
+
+    /** \brief The 32-bit words in a mask with a bit per slot in Peers. */
+    uint16 PeerMaskWords;
+
+    /**
+     * \brief The peer masks of SharedSubs, then the two SBN_CheckSharedPipe()
+     * works with, SentMask and ShareMask, allocated with Peers.
+     */
+    uint32 *SharedMasks;
+    uint32 *SentMask;
+    uint32 *ShareMask;
+#endif /* SBN_SHARED_PIPE */
+
+    /** \brief Messages being reassembled from fragments, for all peers, ReasmCnt of them allocated at startup. */
+    SBN_Reasm_t *Reasm;
+
+    uint16 ReasmCnt;
+
     /** \brief CFE scheduling pipe */
     CFE_SB_PipeId_t SchPipe;
 
@@ -118,16 +349,105 @@ typedef struct
     /** @brief Retain the module ID's for each interface in case we need to unload. */
     CFE_ES_ModuleID_t FilterModules[SBN_MAX_MOD_CNT];
 
-    SBN_ConfTbl_t *ConfTbl;
+    /** @brief The interfaces of the filter modules, in configuration table order. */
+    SBN_FilterInterface_t *Filters[SBN_MAX_MOD_CNT];
+
+    /**
+     * @brief The configuration table as last applied, a reload only touches
+     * the nets and peers whose entries differ from it. The table is double
+     * buffered, so this is still the old table while a reload compares the
+     * new one against it. NULL if the last reload failed.
+     */
+    SBN_ConfTbl_t *Conf;
+
+    /** Mutex for the reassembly buffers, shared by all receive tasks. */
+    CFE_ES_MutexID_t ReasmMutex;
+
+#ifdef SBN_CREDITS
+    /** Mutex for the messages held for peers out of credit, see SBN_HoldMsg(). */
+    CFE_ES_MutexID_t HeldMutex;
+
+    /** \brief The pool buffers holding messages for all peers. */
+    uint16 HeldBufCnt;
+#endif /* SBN_CREDITS */
+
+#ifdef SBN_DEDUP
+    /** \brief The messages received lately, by origin and message ID, see SBN_SeenMsg(). */
+    SBN_Dedup_t Dedup[SBN_DEDUP_SZ];
+
+    /** Mutex for the dedup table, shared by all receive tasks. */
+    CFE_ES_MutexID_t DedupMutex;
 
-    /** Global mutex for Send Tasks. */
-    CFE_ES_MutexID_t SendMutex;
+    /** \brief Messages dropped as already received. */
+    SBN_HKTlm_t DupCnt;
+#endif /* SBN_DEDUP */
+
+#ifdef SBN_BRIDGE
+    /** \brief Messages relayed to peers. */
+    SBN_HKTlm_t RelayCnt;
+#endif /* SBN_BRIDGE */
+
+    /** \brief The message buffer pool, see SBN_GetBuf(), BufCnt of them allocated at startup. */
+    SBN_BufSlot_t *Bufs;
+    SBN_BufSlot_t *FreeBufs;
+    uint16         BufCnt;
+
+    /** Mutex for the free list of the buffer pool. */
+    CFE_ES_MutexID_t BufMutex;
+
+    /** \brief Number of times SBN_GetBuf() found no free buffer. */
+    uint32 BufEmptyCnt;
+
+#ifdef SBN_SEND_WORKERS
+    /** \brief The send worker tasks. */
+    OS_TaskID_t SendWorkerIDs[SBN_SEND_WORKERS];
+
+    /**
+     * \brief The SBN_TASK_SEND peers each send worker serves, at most
+     * SBN.PeerSlots / SBN_SEND_WORKERS (rounded up) each, allocated with
+     * SBN.Peers.
+     */
+    SBN_PeerInterface_t **SendWorkerPeers[SBN_SEND_WORKERS];
+
+    uint16 SendWorkerPeerCnt[SBN_SEND_WORKERS];
+
+    /** \brief Counts the times the peers were reassigned, so a worker can tell its peers changed while it pended. */
+    uint32 SendWorkerGen;
+
+    /** \brief Held by each send worker for one pass over its peers, so a reload can wait the workers out. */
+    CFE_ES_MutexID_t SendWorkerMutexes[SBN_SEND_WORKERS];
+#endif /* SBN_SEND_WORKERS */
+
+#ifdef SBN_MID_STATS
+    /** \brief The per message ID traffic of each peer, indexed by peer slot (PeerSlots of them.) */
+    SBN_PeerMidStats_t *MidStats;
+#endif /* SBN_MID_STATS */
+
+#ifdef SBN_RECV_WORKERS
+    /** \brief The receive worker tasks, worker N polls nets N, N + SBN_RECV_WORKERS, ... */
+    OS_TaskID_t RecvWorkerIDs[SBN_RECV_WORKERS];
+
+    /** \brief Held by each receive worker for one pass over its nets, so a reload can wait the workers out. */
+    CFE_ES_MutexID_t RecvWorkerMutexes[SBN_RECV_WORKERS];
+
+    /** \brief Queue on which receive workers hand control messages to the main task. */
+    uint32 CtrlQueue;
+#endif /* SBN_RECV_WORKERS */
 
     SBN_HKTlm_t CmdCnt, CmdErrCnt;
 
     CFE_TBL_Handle_t ConfTblHandle;
 } SBN_App_t;
 
+/**
+ * \brief A self-consistent copy of a peer's HK counters, see SBN_SnapshotPeer().
+ */
+typedef struct
+{
+    OS_time_t   LastSend, LastRecv;
+    SBN_HKTlm_t SendCnt, RecvCnt, SendErrCnt, RecvErrCnt, ReasmErrCnt;
+} SBN_PeerStats_t;
+
 /**
  * \brief SBN glocal data structure references, indexed by AppId.
  */
@@ -140,10 +460,26 @@ void                 SBN_AppMain(void);
 SBN_Status_t         SBN_ProcessNetMsg(SBN_NetInterface_t *Net, SBN_MsgType_t MsgType, CFE_ProcessorID_t ProcessorID,
                                        SBN_MsgSz_t MsgSz, void *Msg);
 SBN_PeerInterface_t *SBN_GetPeer(SBN_NetInterface_t *Net, CFE_ProcessorID_t ProcessorID);
+void                 SBN_IndexPeers(void);
+bool                 SBN_SnapshotPeer(SBN_PeerInterface_t *Peer, SBN_PeerStats_t *Stats);
+void                 SBN_ResetStamps(SBN_PeerInterface_t *Peer);
 uint32               SBN_ReloadConfTbl(void);
 void                 SBN_RecvNetTask(void);
 void                 SBN_RecvPeerTask(void);
 void                 SBN_SendTask(void);
+#ifdef SBN_RECV_WORKERS
+void SBN_RecvWorkerTask(void);
+#endif /* SBN_RECV_WORKERS */
+#ifdef SBN_SEND_WORKERS
+void SBN_SendWorkerTask(void);
+#endif /* SBN_SEND_WORKERS */
+#ifdef SBN_SHARED_PIPE
+SBN_Status_t SBN_CheckSharedPipe(void);
+#endif /* SBN_SHARED_PIPE */
+SBN_Status_t         SBN_FilterSendMsg(SBN_PeerInterface_t *Peer, CFE_SB_MsgPtr_t SBMsgPtr,
+                                       SBN_Filter_Ctx_t *Filter_Context);
+SBN_Status_t         SBN_SendNetMsgNow(SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Msg,
+                                       SBN_PeerInterface_t *Peer);
 
 #endif /* _sbn_app_ */
 /*****************************************************************************/
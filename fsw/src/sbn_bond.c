@@ -0,0 +1,163 @@
+/******************************************************************************
+ ** \file sbn_bond.c
+ **
+ **      Copyright (c) 2004-2006, United States government as represented by the
+ **      administrator of the National Aeronautics Space Administration.
+ **      All rights reserved. This software(cFE) was created at NASA's Goddard
+ **      Space Flight Center pursuant to government contracts.
+ **
+ **      This software may be used only pursuant to a United States government
+ **      sponsored project and the United States government may not be charged
+ **      for use thereof.
+ **
+ ** Purpose:
+ **      This file contains source code for bonding nets. The peers with the
+ **      same ProcessorID on different nets are the paths of one bond; each app
+ **      message queued for the CPU is sent over only one of them, the
+ **      connected path on the lowest numbered net or, for bulk messages, one
+ **      picked by message ID from all the connected paths. A path that the
+ **      failure detector (or its module) disconnects is passed over from the
+ **      next message on. The receiver drops what arrives over more than one
+ **      path by its CCSDS sequence count, see SBN_SeenMsg().
+ */
+
+#include "sbn_app.h"
+
+#ifdef SBN_BONDING
+
+/**
+ * Chains each peer to the peers with the same ProcessorID on the other nets,
+ * in net order. Called whenever the peers are (re)loaded, after
+ * SBN_IndexPeers().
+ */
+void SBN_LinkBonds(void)
+{
+    SBN_NetIdx_t         NetIdx = 0, LowerIdx = 0;
+    SBN_PeerIdx_t        PeerIdx = 0;
+    SBN_PeerInterface_t *First = NULL, *Last = NULL;
+
+    for (NetIdx = 0; NetIdx < SBN.NetCnt; NetIdx++)
+    {
+        SBN_NetInterface_t *Net = &SBN.Nets[NetIdx];
+
+        for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
+        {
+            SBN_PeerInterface_t *Peer = &Net->Peers[PeerIdx];
+
+            Peer->BondFirst = NULL;
+            Peer->BondNext  = NULL;
+
+            if (Peer->Unused)
+            {
+                continue;
+            } /* end if */
+
+            /* the bond, if any, was started by the peer on the lowest net */
+            First = NULL;
+            for (LowerIdx = 0; LowerIdx < NetIdx && First == NULL; LowerIdx++)
+            {
+                First = SBN_GetPeer(&SBN.Nets[LowerIdx], Peer->ProcessorID);
+            } /* end for */
+
+            if (First == NULL)
+            {
+                continue;
+            } /* end if */
+
+            First->BondFirst = First;
+
+            Last = First;
+            while (Last->BondNext != NULL)
+            {
+                Last = Last->BondNext;
+            } /* end while */
+
+            Last->BondNext  = Peer;
+            Peer->BondFirst = First;
+        } /* end for */
+    }     /* end for */
+} /* end SBN_LinkBonds() */
+
+/**
+ * Decides whether an app message for a bonded CPU goes out over this path.
+ * Every path has the CPU's subscriptions, so the message is offered to each;
+ * only the one picked sends it. Messages smaller than SBN_BOND_STRIPE_SZ go
+ * over the preferred path, the first connected one, larger ones over a
+ * connected path picked by message ID.
+ *
+ * @param[in] Peer The path the message is offered to.
+ * @param[in] MsgSz The size of the SB message.
+ * @param[in] Msg The SB message.
+ *
+ * @return true if the message should be sent to Peer.
+ */
+bool SBN_BondSends(SBN_PeerInterface_t *Peer, SBN_MsgSz_t MsgSz, void *Msg)
+{
+    SBN_PeerInterface_t *Path = NULL;
+    int                  PathCnt = 0, Pick = 0;
+
+    if (Peer->BondFirst == NULL)
+    {
+        return true;
+    } /* end if */
+
+    for (Path = Peer->BondFirst; Path != NULL; Path = Path->BondNext)
+    {
+        if (Path->Connected)
+        {
+            PathCnt++;
+        } /* end if */
+    }     /* end for */
+
+    if (PathCnt == 0)
+    {
+        /* nothing to fail over to, leave it to the path */
+        return true;
+    } /* end if */
+
+    if (SBN_BOND_STRIPE_SZ != 0 && MsgSz >= SBN_BOND_STRIPE_SZ && MsgSz >= (SBN_MsgSz_t)sizeof(CCSDS_PriHdr_t))
+    {
+        Pick = CFE_SB_GetMsgId(Msg) % PathCnt;
+    } /* end if */
+
+    for (Path = Peer->BondFirst; Path != NULL; Path = Path->BondNext)
+    {
+        if (Path->Connected && Pick-- == 0)
+        {
+            break;
+        } /* end if */
+    }     /* end for */
+
+    return Path == Peer;
+} /* end SBN_BondSends() */
+
+/**
+ * Reports a bond failing over when one of its paths is disconnected.
+ *
+ * @param[in] Peer The path that went down, already marked disconnected.
+ */
+void SBN_BondPathDown(SBN_PeerInterface_t *Peer)
+{
+    SBN_PeerInterface_t *Path = NULL;
+    int                  PathCnt = 0, UpCnt = 0;
+
+    if (Peer->BondFirst == NULL)
+    {
+        return;
+    } /* end if */
+
+    for (Path = Peer->BondFirst; Path != NULL; Path = Path->BondNext)
+    {
+        PathCnt++;
+
+        if (Path->Connected)
+        {
+            UpCnt++;
+        } /* end if */
+    }     /* end for */
+
+    EVSSendInfo(SBN_PEER_EID, "CPU %d path on net %d down, %d of %d paths left", (int)Peer->ProcessorID,
+                (int)(Peer->Net - SBN.Nets), UpCnt, PathCnt);
+} /* end SBN_BondPathDown() */
+
+#endif /* SBN_BONDING */
@@ -0,0 +1,31 @@
+/******************************************************************************
+** File: sbn_bond.h
+**
+**      Copyright (c) 2004-2006, United States government as represented by the
+**      administrator of the National Aeronautics Space Administration.
+**      All rights reserved. This software(cFE) was created at NASA's Goddard
+**      Space Flight Center pursuant to government contracts.
+**
+**      This software may be used only pursuant to a United States government
+**      sponsored project and the United States government may not be charged
+**      for use thereof.
+**
+** Purpose:
+**      This header file contains prototypes for private functions related to
+**      bonding the peers with the same ProcessorID on different nets into
+**      one link, with failover and striping across its paths.
+**
+******************************************************************************/
+
+#ifndef _sbn_bond_h_
+#define _sbn_bond_h_
+
+#include "sbn_app.h"
+
+#ifdef SBN_BONDING
+void SBN_LinkBonds(void);
+bool SBN_BondSends(SBN_PeerInterface_t *Peer, SBN_MsgSz_t MsgSz, void *Msg);
+void SBN_BondPathDown(SBN_PeerInterface_t *Peer);
+#endif /* SBN_BONDING */
+
+#endif /* _sbn_bond_h_ */
@@ -0,0 +1,244 @@
+/******************************************************************************
+ ** \file sbn_bridge.c
+ **
+ **      Copyright (c) 2004-2006, United States government as represented by the
+ **      administrator of the National Aeronautics Space Administration.
+ **      All rights reserved. This software(cFE) was created at NASA's Goddard
+ **      Space Flight Center pursuant to government contracts.
+ **
+ **      This software may be used only pursuant to a United States government
+ **      sponsored project and the United States government may not be charged
+ **      for use thereof.
+ **
+ ** Purpose:
+ **      This file contains source code for bridging nets. App messages a
+ **      bridge receives from a peer are relayed to the subscribed peers on its
+ **      other nets, tagged with the ProcessorID they originated on, so a
+ **      message that comes back around a loop, or arrives again over a second
+ **      path (a second bridge, or a bond, see sbn_bond.c), is dropped by its
+ **      origin and CCSDS sequence count.
+ */
+
+#include "sbn_app.h"
+#include <string.h>
+#include "sbn_pack.h"
+
+#ifdef SBN_DEDUP
+
+/** \brief CCSDS sequence counts are 14 bits and wrap. */
+#define SEQ_MASK 0x3FFF
+
+/** \brief How many sequence counts before the latest one the dedup window covers. */
+#define SEQ_WINDOW 32
+
+#endif /* SBN_DEDUP */
+
+#ifdef SBN_BRIDGE
+
+/**
+ * Takes the relay trailer off an SBN_RELAY_MSG payload.
+ *
+ * @param[in] Peer The peer the message was received from.
+ * @param[in,out] MsgSzPtr The size of the payload in, the size of the SB message out.
+ * @param[in] Msg The payload, the SB message followed by the trailer.
+ * @param[out] OriginPtr The ProcessorID the SB message originated on.
+ * @param[out] HopsPtr The number of bridges the message has passed through.
+ *
+ * @return SBN_SUCCESS, or SBN_ERROR if the payload is not a relayed SB message.
+ */
+SBN_Status_t SBN_UnpackRelay(SBN_PeerInterface_t *Peer, SBN_MsgSz_t *MsgSzPtr, void *Msg,
+                             CFE_ProcessorID_t *OriginPtr, uint8 *HopsPtr)
+{
+    SBN_MsgSz_t MsgSz  = *MsgSzPtr - (SBN_MsgSz_t)SBN_PACKED_RELAY_SZ;
+    uint32      Origin = 0;
+    Pack_t      Pack;
+
+    if (MsgSz < (SBN_MsgSz_t)sizeof(CCSDS_PriHdr_t) || CFE_SB_GetTotalMsgLength(Msg) != MsgSz)
+    {
+        EVSSendErr(SBN_MSG_EID, "invalid relayed message from ProcessorID %d (MsgSz=%d)", (int)Peer->ProcessorID,
+                   (int)*MsgSzPtr);
+        SBN_HK_INC(Peer->RecvErrCnt);
+        return SBN_ERROR;
+    } /* end if */
+
+    Pack_Init(&Pack, (uint8 *)Msg + MsgSz, SBN_PACKED_RELAY_SZ, false);
+    Unpack_UInt32(&Pack, &Origin);
+    Unpack_UInt8(&Pack, HopsPtr);
+
+    *OriginPtr = Origin;
+    *MsgSzPtr  = MsgSz;
+
+    return SBN_SUCCESS;
+} /* end SBN_UnpackRelay() */
+
+#endif /* SBN_BRIDGE */
+
+#ifdef SBN_DEDUP
+
+/**
+ * Checks an app message against the messages received lately from the same
+ * origin with the same message ID, and records it.
+ *
+ * SB only maintains the sequence counts of telemetry, so commands are never
+ * taken for duplicates; a bridge only keeps them from looping by
+ * SBN_BRIDGE_MAX_HOPS.
+ *
+ * @param[in] Origin The ProcessorID the message originated on.
+ * @param[in] MsgSz The size of the SB message.
+ * @param[in] Msg The SB message.
+ *
+ * @return true if the message has been received before (or originated here),
+ *         and should be dropped.
+ */
+bool SBN_SeenMsg(CFE_ProcessorID_t Origin, SBN_MsgSz_t MsgSz, void *Msg)
+{
+    CFE_SB_MsgPtr_t SBMsgPtr = Msg;
+    CFE_SB_MsgId_t  MsgID    = 0;
+    SBN_Dedup_t *   Dedup    = NULL;
+    uint16          Seq = 0, Ahead = 0, Behind = 0;
+    bool            Seen = false;
+
+    if (Origin == CFE_PSP_GetProcessorId())
+    {
+        /* my own message came back around a loop */
+        SBN_HK_INC(SBN.DupCnt);
+        return true;
+    } /* end if */
+
+    if (MsgSz < (SBN_MsgSz_t)sizeof(CCSDS_PriHdr_t) || CCSDS_RD_TYPE(SBMsgPtr->Hdr) == CCSDS_CMD)
+    {
+        return false;
+    } /* end if */
+
+    MsgID = CFE_SB_GetMsgId(SBMsgPtr);
+    Seq   = CCSDS_RD_SEQ(SBMsgPtr->Hdr);
+    Dedup = &SBN.Dedup[SBN_DEDUP_HASH(Origin, MsgID)];
+
+    if (OS_MutSemTake(SBN.DedupMutex) != OS_SUCCESS)
+    {
+        EVSSendErr(SBN_MSG_EID, "unable to take mutex");
+        return false;
+    } /* end if */
+
+    Ahead  = (Seq - Dedup->LastSeq) & SEQ_MASK;
+    Behind = (Dedup->LastSeq - Seq) & SEQ_MASK;
+
+    if (Dedup->Window == 0 || Dedup->Origin != Origin || Dedup->MsgID != MsgID ||
+        (Ahead > SEQ_MASK / 2 && Behind >= SEQ_WINDOW))
+    {
+        /* a new stream, one that takes the entry from another, or one whose count restarted */
+        Dedup->Origin  = Origin;
+        Dedup->MsgID   = MsgID;
+        Dedup->LastSeq = Seq;
+        Dedup->Window  = 1;
+    }
+    else if (Ahead != 0 && Ahead <= SEQ_MASK / 2)
+    {
+        Dedup->Window  = Ahead < SEQ_WINDOW ? (Dedup->Window << Ahead) | 1 : 1;
+        Dedup->LastSeq = Seq;
+    }
+    else
+    {
+        Seen = (Dedup->Window >> Behind) & 1;
+        Dedup->Window |= 1U << Behind;
+    } /* end if */
+
+    OS_MutSemGive(SBN.DedupMutex);
+
+    if (Seen)
+    {
+        SBN_HK_INC(SBN.DupCnt);
+    } /* end if */
+
+    return Seen;
+} /* end SBN_SeenMsg() */
+
+#endif /* SBN_DEDUP */
+
+#ifdef SBN_BRIDGE
+
+/**
+ * Relays an app message received from a peer to the connected peers on the
+ * other nets that have subscribed to it. Peers that take SBN_RELAY_MSG are
+ * told where the message originated, to others (or when the trailer would not
+ * fit in the peer's MTU) it is sent as an SBN_APP_MSG from this CPU.
+ *
+ * @param[in] From The peer the message was received from.
+ * @param[in] Origin The ProcessorID the message originated on.
+ * @param[in] Hops The number of bridges the message has passed through.
+ * @param[in] MsgSz The size of the SB message.
+ * @param[in] Msg The SB message, after the receive filters of From.
+ */
+void SBN_RelayMsg(SBN_PeerInterface_t *From, CFE_ProcessorID_t Origin, uint8 Hops, SBN_MsgSz_t MsgSz, void *Msg)
+{
+    SBN_PeerInterface_t *Peer       = NULL;
+    SBN_Status_t         SBN_Status = SBN_SUCCESS;
+    CFE_SB_MsgId_t       MsgID      = 0;
+    uint8 *              Buf        = NULL;
+    int                  PeerIdx    = 0;
+    SBN_Filter_Ctx_t     Filter_Context;
+    Pack_t               Pack;
+
+    if (Hops >= SBN_BRIDGE_MAX_HOPS)
+    {
+        return;
+    } /* end if */
+
+    MsgID = CFE_SB_GetMsgId(Msg);
+
+    Filter_Context.MyProcessorID  = CFE_PSP_GetProcessorId();
+    Filter_Context.MySpacecraftID = CFE_PSP_GetSpacecraftId();
+
+    for (PeerIdx = 0; PeerIdx < SBN.PeerSlots; PeerIdx++)
+    {
+        Peer = SBN.Peers[PeerIdx];
+
+        /* never back onto the net it came from, nor to the CPU it came from */
+        if (Peer == NULL || Peer->Net == From->Net || !Peer->Connected || Peer->ProcessorID == Origin ||
+            !SBN_PeerSubscribed(Peer, MsgID))
+        {
+            continue;
+        } /* end if */
+
+        if (Buf == NULL && (Buf = SBN_GetBuf()) == NULL)
+        {
+            return;
+        } /* end if */
+
+        /* each peer's send filters get their own copy */
+        memcpy(Buf, Msg, MsgSz);
+
+        SBN_Status = SBN_FilterSendMsg(Peer, (CFE_SB_MsgPtr_t)(void *)Buf, &Filter_Context);
+        if (SBN_Status != SBN_SUCCESS)
+        {
+            /* includes SBN_IF_EMPTY, for when a filter rejects the message */
+            continue;
+        } /* end if */
+
+        if ((Peer->Features & SBN_FEAT_RELAY) && MsgSz + SBN_PACKED_RELAY_SZ <= CFE_MISSION_SB_MAX_SB_MSG_SIZE &&
+            !SBN_NEEDS_FRAG(Peer, SBN_APP_MSG, MsgSz + SBN_PACKED_RELAY_SZ))
+        {
+            Pack_Init(&Pack, Buf + MsgSz, SBN_PACKED_RELAY_SZ, false);
+            Pack_UInt32(&Pack, Origin);
+            Pack_UInt8(&Pack, Hops + 1);
+
+            SBN_Status = SBN_SendNetMsg(SBN_RELAY_MSG, MsgSz + SBN_PACKED_RELAY_SZ, Buf, Peer);
+        }
+        else
+        {
+            SBN_Status = SBN_SendNetMsg(SBN_APP_MSG, MsgSz, Buf, Peer);
+        } /* end if */
+
+        if (SBN_Status == SBN_SUCCESS)
+        {
+            SBN_HK_INC(SBN.RelayCnt);
+        } /* end if */
+    }     /* end for */
+
+    if (Buf != NULL)
+    {
+        SBN_PutBuf(Buf);
+    } /* end if */
+} /* end SBN_RelayMsg() */
+
+#endif /* SBN_BRIDGE */
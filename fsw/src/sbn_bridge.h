@@ -0,0 +1,43 @@
+/******************************************************************************
+** File: sbn_bridge.h
+**
+**      Copyright (c) 2004-2006, United States government as represented by the
+**      administrator of the National Aeronautics Space Administration.
+**      All rights reserved. This software(cFE) was created at NASA's Goddard
+**      Space Flight Center pursuant to government contracts.
+**
+**      This software may be used only pursuant to a United States government
+**      sponsored project and the United States government may not be charged
+**      for use thereof.
+**
+** Purpose:
+**      This header file contains prototypes for private functions related to
+**      bridging nets: relaying app messages to the peers on other nets and
+**      dropping messages that arrive more than once.
+**
+******************************************************************************/
+
+#ifndef _sbn_bridge_h_
+#define _sbn_bridge_h_
+
+#include "sbn_app.h"
+
+/**
+ * @brief A relayed message is sent as an SBN_RELAY_MSG whose payload is the
+ * SB message followed by the ProcessorID it originated on + the number of
+ * bridges it has passed through.
+ */
+#define SBN_PACKED_RELAY_SZ (sizeof(uint32) + sizeof(uint8))
+
+#ifdef SBN_DEDUP
+bool SBN_SeenMsg(CFE_ProcessorID_t Origin, SBN_MsgSz_t MsgSz, void *Msg);
+#endif /* SBN_DEDUP */
+
+#ifdef SBN_BRIDGE
+SBN_Status_t SBN_UnpackRelay(SBN_PeerInterface_t *Peer, SBN_MsgSz_t *MsgSzPtr, void *Msg,
+                             CFE_ProcessorID_t *OriginPtr, uint8 *HopsPtr);
+void         SBN_RelayMsg(SBN_PeerInterface_t *From, CFE_ProcessorID_t Origin, uint8 Hops, SBN_MsgSz_t MsgSz,
+                          void *Msg);
+#endif /* SBN_BRIDGE */
+
+#endif /* _sbn_bridge_h_ */
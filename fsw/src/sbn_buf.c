@@ -0,0 +1,106 @@
+/******************************************************************************
+ ** \file sbn_buf.c
+ **
+ **      Copyright (c) 2004-2006, United States government as represented by the
+ **      administrator of the National Aeronautics Space Administration.
+ **      All rights reserved. This software(cFE) was created at NASA's Goddard
+ **      Space Flight Center pursuant to government contracts.
+ **
+ **      This software may be used only pursuant to a United States government
+ **      sponsored project and the United States government may not be charged
+ **      for use thereof.
+ **
+ ** Purpose:
+ **      This file contains source code for the pool of message buffers that
+ **      SBN and its modules receive into and pack messages in, so that tasks
+ **      do not need a maximum-sized message buffer on their stacks.
+ */
+
+#include "sbn_buf.h"
+#include <stdlib.h>
+
+/**
+ * Creates the pool mutex, allocates as many buffers as the configuration
+ * table asks for (SBN_BUF_POOL_CNT if it does not say) and puts every buffer
+ * on the free list.
+ *
+ * @return SBN_SUCCESS on success, SBN_ERROR otherwise.
+ */
+SBN_Status_t SBN_InitBufPool(void)
+{
+    int BufIdx = 0;
+
+    if (OS_MutSemCreate(&(SBN.BufMutex), "sbn_buf_mutex", 0) != OS_SUCCESS)
+    {
+        EVSSendErr(SBN_INIT_EID, "error creating mutex for buffer pool");
+        return SBN_ERROR;
+    } /* end if */
+
+    SBN.BufCnt = SBN.Conf != NULL && SBN.Conf->BufCnt != 0 ? SBN.Conf->BufCnt : SBN_BUF_POOL_CNT;
+
+    SBN.Bufs = calloc(SBN.BufCnt, sizeof(*SBN.Bufs));
+    if (SBN.Bufs == NULL)
+    {
+        EVSSendErr(SBN_INIT_EID, "unable to allocate %d message buffers", (int)SBN.BufCnt);
+        return SBN_ERROR;
+    } /* end if */
+
+    SBN.FreeBufs = NULL;
+
+    for (BufIdx = SBN.BufCnt - 1; BufIdx >= 0; BufIdx--)
+    {
+        SBN.Bufs[BufIdx].Next = SBN.FreeBufs;
+        SBN.FreeBufs          = &SBN.Bufs[BufIdx];
+    } /* end for */
+
+    return SBN_SUCCESS;
+} /* end SBN_InitBufPool() */
+
+/**
+ * Takes a buffer from the pool. The buffer is not cleared.
+ *
+ * @return A buffer of SBN_MAX_PACKED_MSG_SZ bytes, or NULL if all buffers are
+ *         in use.
+ */
+void *SBN_GetBuf(void)
+{
+    SBN_BufSlot_t *Slot = NULL;
+
+    OS_MutSemTake(SBN.BufMutex);
+
+    Slot = SBN.FreeBufs;
+    if (Slot)
+    {
+        SBN.FreeBufs = Slot->Next;
+    }
+    else
+    {
+        SBN.BufEmptyCnt++;
+    } /* end if */
+
+    OS_MutSemGive(SBN.BufMutex);
+
+    return Slot;
+} /* end SBN_GetBuf() */
+
+/**
+ * Returns a buffer from SBN_GetBuf() to the pool.
+ *
+ * @param[in] Buf The buffer, NULL is ignored.
+ */
+void SBN_PutBuf(void *Buf)
+{
+    SBN_BufSlot_t *Slot = (SBN_BufSlot_t *)Buf;
+
+    if (!Slot)
+    {
+        return;
+    } /* end if */
+
+    OS_MutSemTake(SBN.BufMutex);
+
+    Slot->Next   = SBN.FreeBufs;
+    SBN.FreeBufs = Slot;
+
+    OS_MutSemGive(SBN.BufMutex);
+} /* end SBN_PutBuf() */
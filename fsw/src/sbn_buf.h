@@ -0,0 +1,28 @@
+/******************************************************************************
+** File: sbn_buf.h
+**
+**      Copyright (c) 2004-2006, United States government as represented by the
+**      administrator of the National Aeronautics Space Administration.
+**      All rights reserved. This software(cFE) was created at NASA's Goddard
+**      Space Flight Center pursuant to government contracts.
+**
+**      This software may be used only pursuant to a United States government
+**      sponsored project and the United States government may not be charged
+**      for use thereof.
+**
+** Purpose:
+**      This header file contains prototypes for private functions related to
+**      the preallocated pool of message buffers shared by the receive and send
+**      paths. (SBN_GetBuf()/SBN_PutBuf() are in sbn_interfaces.h, as modules
+**      use them too.)
+**
+******************************************************************************/
+
+#ifndef _sbn_buf_h_
+#define _sbn_buf_h_
+
+#include "sbn_app.h"
+
+SBN_Status_t SBN_InitBufPool(void);
+
+#endif /* _sbn_buf_h_ */
@@ -6,18 +6,24 @@
 #include "sbn_pack.h"
 
 /**
- * @brief Initializes the housekeeping counters for a peer.
+ * @brief Initializes the housekeeping counters for a peer. The send and
+ * receive tasks may be updating them, so each is cleared atomically, and the
+ * last send and receive times and counts are cleared through their sequences;
+ * a message sent or received during the reset may keep its time and count.
  *
  * @param[in] Peer The peer interface for which to reset housekeeping.
  */
 static void InitializePeerCounters(SBN_PeerInterface_t *Peer)
 {
-    Peer->LastSend   = (OS_time_t) {0, 0};
-    Peer->LastRecv   = (OS_time_t) {0, 0};
-    Peer->SendCnt    = 0;
-    Peer->RecvCnt    = 0;
-    Peer->SendErrCnt = 0;
-    Peer->RecvErrCnt = 0;
+    SBN_ResetStamps(Peer);
+    SBN_HK_SET(Peer->SendErrCnt, 0);
+    SBN_HK_SET(Peer->RecvErrCnt, 0);
+    SBN_HK_SET(Peer->ReasmErrCnt, 0);
+    SBN_HK_SET(Peer->ConflatedCnt, 0);
+    SBN_HK_SET(Peer->ExpiredCnt, 0);
+    SBN_HK_SET(Peer->StallCnt, 0);
+    SBN_HK_SET(Peer->StallMS, 0);
+    SBN_HK_SET(Peer->CreditDropCnt, 0);
 } /* end InitializePeerCounters() */
 
 /**
@@ -350,8 +356,14 @@ static void HKPeerCmd(CFE_SB_MsgPtr_t MsgPtr)
 
     EVSSendInfo(SBN_CMD_EID, "hk command, net=%d, peer=%d", NetIdx, PeerIdx);
 
-    uint8  HKBuf[SBN_HKPEER_LEN];
-    Pack_t Pack;
+    uint8           HKBuf[SBN_HKPEER_LEN];
+    Pack_t          Pack;
+    SBN_PeerStats_t Stats;
+
+    if (!SBN_SnapshotPeer(Peer, &Stats))
+    {
+        EVSSendDbg(SBN_CMD_EID, "counters for CPU %d changed while copying", Peer->ProcessorID);
+    } /* end if */
 
     CFE_SB_InitMsg(HKBuf, SBN_TLM_MID, SBN_HKPEER_LEN, true);
 
@@ -359,13 +371,21 @@ static void HKPeerCmd(CFE_SB_MsgPtr_t MsgPtr)
 
     Pack_UInt8(&Pack, SBN_HK_PEER_CC);
     Pack_UInt32(&Pack, Peer->ProcessorID);
-    Pack_Time(&Pack, Peer->LastSend);
-    Pack_Time(&Pack, Peer->LastRecv);
-    Pack_UInt16(&Pack, Peer->SendCnt);
-    Pack_UInt16(&Pack, Peer->RecvCnt);
-    Pack_UInt16(&Pack, Peer->SendErrCnt);
-    Pack_UInt16(&Pack, Peer->RecvErrCnt);
+    Pack_Time(&Pack, Stats.LastSend);
+    Pack_Time(&Pack, Stats.LastRecv);
+    Pack_UInt16(&Pack, Stats.SendCnt);
+    Pack_UInt16(&Pack, Stats.RecvCnt);
+    Pack_UInt16(&Pack, Stats.SendErrCnt);
+    Pack_UInt16(&Pack, Stats.RecvErrCnt);
     Pack_UInt16(&Pack, Peer->SubCnt);
+    Pack_UInt16(&Pack, Stats.ReasmErrCnt);
+    Pack_UInt16(&Pack, SBN_HK_GET(Peer->ConflatedCnt));
+    Pack_UInt16(&Pack, SBN_HK_GET(Peer->ExpiredCnt));
+#ifdef SBN_CREDITS
+    Pack_UInt16(&Pack, SBN_HK_GET(Peer->StallCnt));
+    Pack_UInt32(&Pack, SBN_HK_GET(Peer->StallMS));
+    Pack_UInt16(&Pack, SBN_HK_GET(Peer->CreditDropCnt));
+#endif /* SBN_CREDITS */
 
     /*
     ** Timestamp and send packet
@@ -484,12 +504,28 @@ static void PeerSubsCmd(CFE_SB_MsgPtr_t MsgPtr)
     Pack_UInt8(&Pack, SBN_HK_PEERSUBS_CC);
     Pack_UInt16(&Pack, NetIdx);
     Pack_UInt16(&Pack, PeerIdx);
-    Pack_UInt16(&Pack, Peer->SubCnt);
 
-    int i;
+    /* ranges are reported as the message ID's they cover, as many as fit */
+    int    i = 0, MsgIDCnt = 0;
+    uint32 MsgID = 0;
     for (i = 0; i < Peer->SubCnt; i++)
     {
-        Pack_MsgID(&Pack, Peer->Subs[i].MsgID);
+        MsgIDCnt += Peer->Subs[i].LastMsgID - Peer->Subs[i].MsgID + 1;
+    }
+
+    if (MsgIDCnt > SBN_MAX_SUBS_PER_PEER)
+    {
+        MsgIDCnt = SBN_MAX_SUBS_PER_PEER;
+    } /* end if */
+
+    Pack_UInt16(&Pack, MsgIDCnt);
+
+    for (i = 0; i < Peer->SubCnt; i++)
+    {
+        for (MsgID = Peer->Subs[i].MsgID; MsgID <= Peer->Subs[i].LastMsgID && MsgIDCnt > 0; MsgID++, MsgIDCnt--)
+        {
+            Pack_MsgID(&Pack, (CFE_SB_MsgId_t)MsgID);
+        }
     }
 
     /*
@@ -499,6 +535,161 @@ static void PeerSubsCmd(CFE_SB_MsgPtr_t MsgPtr)
     CFE_SB_SendMsg((CFE_SB_Msg_t *)HKBuf);
 } /* end PeerSubsCmd */
 
+#ifdef SBN_MID_STATS
+/**
+ * @brief Packs the (up to) SBN_MID_STATS_TOP message ID's with the most bytes
+ * since the last report from one direction's counters, then starts a new
+ * interval for them.
+ *
+ * @param[in] Pack The telemetry being packed.
+ * @param[in] Tbl The peer's send or receive counters.
+ */
+static void PackTopMids(Pack_t *Pack, SBN_MidStats_t *Tbl)
+{
+    int    Top[SBN_MID_STATS_TOP];
+    uint32 TopBytes[SBN_MID_STATS_TOP];
+    uint32 MsgCnt[SBN_MID_STATS_SZ], Bytes[SBN_MID_STATS_SZ];
+    bool   Seen[SBN_MID_STATS_SZ];
+    int    TopCnt = 0, i = 0, j = 0;
+
+    for (i = 0; i < SBN_MID_STATS_SZ; i++)
+    {
+        SBN_MidStats_t *Mid = &Tbl[i];
+
+        Seen[i] = __atomic_load_n(&Mid->InUse, __ATOMIC_ACQUIRE);
+        if (!Seen[i])
+        {
+            continue;
+        } /* end if */
+
+        /* read once, the same counts are ranked, reported and become the base */
+        MsgCnt[i] = SBN_HK_GET(Mid->MsgCnt);
+        Bytes[i]  = SBN_HK_GET(Mid->Bytes);
+
+        if (MsgCnt[i] == Mid->BaseMsgCnt)
+        {
+            continue; /* no traffic this interval */
+        }             /* end if */
+
+        uint32 Delta = Bytes[i] - Mid->BaseBytes;
+
+        if (TopCnt == SBN_MID_STATS_TOP && Delta <= TopBytes[TopCnt - 1])
+        {
+            continue;
+        } /* end if */
+
+        j = TopCnt < SBN_MID_STATS_TOP ? TopCnt++ : TopCnt - 1;
+        for (; j > 0 && TopBytes[j - 1] < Delta; j--)
+        {
+            Top[j]      = Top[j - 1];
+            TopBytes[j] = TopBytes[j - 1];
+        } /* end for */
+
+        Top[j]      = i;
+        TopBytes[j] = Delta;
+    } /* end for */
+
+    Pack_UInt16(Pack, TopCnt);
+
+    for (j = 0; j < SBN_MID_STATS_TOP; j++)
+    {
+        if (j < TopCnt)
+        {
+            SBN_MidStats_t *Mid = &Tbl[Top[j]];
+
+            Pack_MsgID(Pack, Mid->MsgID);
+            Pack_UInt32(Pack, MsgCnt[Top[j]] - Mid->BaseMsgCnt);
+            Pack_UInt32(Pack, TopBytes[j]);
+        }
+        else
+        {
+            /* fixed size telemetry, unused entries are zero */
+            Pack_MsgID(Pack, 0);
+            Pack_UInt32(Pack, 0);
+            Pack_UInt32(Pack, 0);
+        } /* end if */
+    }     /* end for */
+
+    for (i = 0; i < SBN_MID_STATS_SZ; i++)
+    {
+        if (Seen[i])
+        {
+            Tbl[i].BaseMsgCnt = MsgCnt[i];
+            Tbl[i].BaseBytes  = Bytes[i];
+        } /* end if */
+    }     /* end for */
+} /* end PackTopMids() */
+
+/** \brief Peer Message ID Traffic Telemetry
+ *
+ *  \par Assumptions, External Events, and Notes:
+ *       Reports the message ID's with the most bytes sent to and received
+ *       from the peer since the last time this was requested for it.
+ *
+ *  \param [in]   MsgPtr A #CFE_SB_MsgPtr_t pointer that
+ *                       references the software bus message
+ *
+ *  \sa #SBN_HK_PEERMIDS_CC
+ */
+static void PeerMidsCmd(CFE_SB_MsgPtr_t MsgPtr)
+{
+    if (!VerifyMsgLen(MsgPtr, SBN_CMD_PEER_LEN, "peer mids"))
+    {
+        return;
+    } /* end if */
+
+    uint8 *Ptr     = (uint8 *)MsgPtr + CFE_SB_CMD_HDR_SIZE;
+    uint8  NetIdx  = *Ptr++;
+    uint8  PeerIdx = *Ptr;
+
+    if (NetIdx >= SBN.NetCnt)
+    {
+        EVSSendErr(SBN_CMD_EID, "Invalid NetIdx (%d, max is %d)", NetIdx, SBN.NetCnt - 1);
+        return;
+    } /* end if */
+
+    if (PeerIdx >= SBN.Nets[NetIdx].PeerCnt)
+    {
+        EVSSendErr(SBN_CMD_EID, "Invalid PeerIdx (NetIdx=%d PeerIdx=%d, max is %d)", NetIdx, PeerIdx,
+                   SBN.Nets[NetIdx].PeerCnt - 1);
+        return;
+    } /* end if */
+
+    EVSSendInfo(SBN_CMD_EID, "hk mids command, net=%d peer=%d", NetIdx, PeerIdx);
+
+    SBN_PeerInterface_t *Peer  = &SBN.Nets[NetIdx].Peers[PeerIdx];
+    SBN_PeerMidStats_t * Stats = &SBN.MidStats[Peer->Slot];
+
+    uint8     HKBuf[SBN_HKPEERMIDS_LEN];
+    Pack_t    Pack;
+    OS_time_t Now;
+
+    OS_GetLocalTime(&Now);
+
+    CFE_SB_InitMsg(HKBuf, SBN_TLM_MID, SBN_HKPEERMIDS_LEN, true);
+
+    Pack_Init(&Pack, HKBuf + CFE_SB_TLM_HDR_SIZE, SBN_HKPEERMIDS_LEN - CFE_SB_TLM_HDR_SIZE, 1);
+
+    Pack_UInt8(&Pack, SBN_HK_PEERMIDS_CC);
+    Pack_UInt16(&Pack, NetIdx);
+    Pack_UInt16(&Pack, PeerIdx);
+    Pack_UInt32(&Pack, Peer->ProcessorID);
+    Pack_UInt32(&Pack, (Now.seconds - Stats->Since.seconds) * 1000 +
+                           ((int32)Now.microsecs - (int32)Stats->Since.microsecs) / 1000);
+
+    PackTopMids(&Pack, Stats->Send);
+    PackTopMids(&Pack, Stats->Recv);
+
+    Stats->Since = Now;
+
+    /*
+    ** Timestamp and send packet
+    */
+    CFE_SB_TimeStampMsg((CFE_SB_Msg_t *)HKBuf);
+    CFE_SB_SendMsg((CFE_SB_Msg_t *)HKBuf);
+} /* end PeerMidsCmd */
+#endif /* SBN_MID_STATS */
+
 /*******************************************************************/
 /*                                                                 */
 /* Process a command pipe message                                  */
@@ -543,6 +734,11 @@ void SBN_HandleCommand(CFE_SB_MsgPtr_t MsgPtr)
         case SBN_HK_RESET_PEER_CC:
             HKResetPeerCmd(MsgPtr);
             break;
+#ifdef SBN_MID_STATS
+        case SBN_HK_PEERMIDS_CC:
+            PeerMidsCmd(MsgPtr);
+            break;
+#endif /* SBN_MID_STATS */
 
         case SBN_SCH_WAKEUP_CC:
             EVSSendDbg(SBN_CMD_EID, "wakeup");
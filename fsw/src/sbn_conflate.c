@@ -0,0 +1,188 @@
+/******************************************************************************
+ ** \file sbn_conflate.c
+ **
+ **      Copyright (c) 2004-2006, United States government as represented by the
+ **      administrator of the National Aeronautics Space Administration.
+ **      All rights reserved. This software(cFE) was created at NASA's Goddard
+ **      Space Flight Center pursuant to government contracts.
+ **
+ **      This software may be used only pursuant to a United States government
+ **      sponsored project and the United States government may not be charged
+ **      for use thereof.
+ **
+ ** Purpose:
+ **      This file contains source code for conflating messages. A peer's
+ **      conflated message ID's are subscribed on a pipe of their own, which is
+ **      drained into one slot per message ID whenever the peer's pipes are
+ **      read, so that when the link falls behind the slots hold the latest
+ **      message of each rather than SB holding the oldest copies in the pipe.
+ */
+
+#include "sbn_app.h"
+#include <string.h>
+
+/**
+ * Sets up a peer's conflation slots from its configuration table entry.
+ *
+ * @param[in] Peer The peer, freshly loaded.
+ * @param[in] MsgIDs The entry's SBN_MAX_CONFLATE_PER_PEER ConflateMIDs, 0 if unused.
+ */
+void SBN_LoadConflate(SBN_PeerInterface_t *Peer, CFE_SB_MsgId_t *MsgIDs)
+{
+    int i = 0;
+
+    memset(Peer->Conflate, 0, sizeof(Peer->Conflate));
+    Peer->ConflateCnt  = 0;
+    Peer->ConflateNext = 0;
+
+    for (i = 0; i < SBN_MAX_CONFLATE_PER_PEER; i++)
+    {
+        if (MsgIDs[i] != 0 && !SBN_Conflated(Peer, MsgIDs[i]))
+        {
+            Peer->Conflate[Peer->ConflateCnt++].MsgID = MsgIDs[i];
+        } /* end if */
+    }     /* end for */
+} /* end SBN_LoadConflate() */
+
+static SBN_Conflate_t *FindSlot(SBN_PeerInterface_t *Peer, CFE_SB_MsgId_t MsgID)
+{
+    int i = 0;
+
+    for (i = 0; i < Peer->ConflateCnt; i++)
+    {
+        if (Peer->Conflate[i].MsgID == MsgID)
+        {
+            return &Peer->Conflate[i];
+        } /* end if */
+    }     /* end for */
+
+    return NULL;
+} /* end FindSlot() */
+
+/**
+ * Is the message ID one the peer keeps only the latest of? Subscriptions to it
+ * go on the peer's ConflatePipe rather than its other pipes.
+ *
+ * @param[in] Peer The peer.
+ * @param[in] MsgID The message ID.
+ *
+ * @return true if the message ID is conflated for the peer.
+ */
+bool SBN_Conflated(SBN_PeerInterface_t *Peer, CFE_SB_MsgId_t MsgID)
+{
+    return FindSlot(Peer, MsgID) != NULL;
+} /* end SBN_Conflated() */
+
+/**
+ * Reads everything in the peer's ConflatePipe into the slots, replacing any
+ * message still waiting in a slot. A message that does not fit in a slot is
+ * handed back to send as it is, or when SBMsgPtrPtr is NULL, dropped.
+ *
+ * @return true if a message was handed back in *SBMsgPtrPtr.
+ */
+static bool Drain(SBN_PeerInterface_t *Peer, CFE_SB_MsgPtr_t *SBMsgPtrPtr)
+{
+    CFE_SB_MsgPtr_t SBMsgPtr = NULL;
+    SBN_Conflate_t *Slot     = NULL;
+    SBN_MsgSz_t     MsgSz    = 0;
+
+    while (CFE_SB_RcvMsg(&SBMsgPtr, Peer->ConflatePipe, CFE_SB_POLL) == CFE_SUCCESS)
+    {
+        MsgSz = CFE_SB_GetTotalMsgLength(SBMsgPtr);
+        Slot  = FindSlot(Peer, CFE_SB_GetMsgId(SBMsgPtr));
+
+        if (Slot == NULL || MsgSz > (SBN_MsgSz_t)sizeof(Slot->Buf))
+        {
+            if (SBMsgPtrPtr != NULL)
+            {
+                *SBMsgPtrPtr = SBMsgPtr;
+                return true;
+            } /* end if */
+
+            SBN_HK_INC(Peer->ConflatedCnt);
+            continue;
+        } /* end if */
+
+        if (Slot->Pending)
+        {
+            SBN_HK_INC(Peer->ConflatedCnt);
+        } /* end if */
+
+        memcpy(Slot->Buf, SBMsgPtr, MsgSz);
+        Slot->Pending = true;
+    } /* end while */
+
+    return false;
+} /* end Drain() */
+
+/**
+ * Keeps the latest of the peer's conflated messages while nothing can be sent
+ * to it, so the ConflatePipe does not fill.
+ *
+ * @param[in] Peer The peer.
+ */
+void SBN_DrainConflated(SBN_PeerInterface_t *Peer)
+{
+    if (Peer->ConflateCnt != 0)
+    {
+        Drain(Peer, NULL);
+    } /* end if */
+} /* end SBN_DrainConflated() */
+
+/**
+ * Reads the next conflated message to send to the peer, taking the slots in
+ * turn so one busy message ID does not hold back the others. The message is
+ * left in its slot, which is not written again until the peer's pipes are
+ * next read.
+ *
+ * @param[out] SBMsgPtrPtr The message.
+ * @param[in] Peer The peer.
+ *
+ * @return CFE_SUCCESS if there was a message, CFE_SB_NO_MESSAGE otherwise.
+ */
+CFE_Status_t SBN_NextConflated(CFE_SB_MsgPtr_t *SBMsgPtrPtr, SBN_PeerInterface_t *Peer)
+{
+    SBN_Conflate_t *Slot = NULL;
+    int             i = 0, SlotIdx = 0;
+
+    if (Peer->ConflateCnt == 0)
+    {
+        return CFE_SB_NO_MESSAGE;
+    } /* end if */
+
+    if (Drain(Peer, SBMsgPtrPtr))
+    {
+        return CFE_SUCCESS;
+    } /* end if */
+
+    for (i = 0; i < Peer->ConflateCnt; i++)
+    {
+        SlotIdx = (Peer->ConflateNext + i) % Peer->ConflateCnt;
+        Slot    = &Peer->Conflate[SlotIdx];
+
+        if (Slot->Pending)
+        {
+            Slot->Pending      = false;
+            Peer->ConflateNext = (SlotIdx + 1) % Peer->ConflateCnt;
+            *SBMsgPtrPtr       = (CFE_SB_MsgPtr_t)(void *)Slot->Buf;
+            return CFE_SUCCESS;
+        } /* end if */
+    }     /* end for */
+
+    return CFE_SB_NO_MESSAGE;
+} /* end SBN_NextConflated() */
+
+/**
+ * Forgets the messages waiting in the peer's slots, when it disconnects.
+ *
+ * @param[in] Peer The peer.
+ */
+void SBN_ResetConflated(SBN_PeerInterface_t *Peer)
+{
+    int i = 0;
+
+    for (i = 0; i < Peer->ConflateCnt; i++)
+    {
+        Peer->Conflate[i].Pending = false;
+    } /* end for */
+} /* end SBN_ResetConflated() */
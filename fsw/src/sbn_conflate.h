@@ -0,0 +1,31 @@
+/******************************************************************************
+** File: sbn_conflate.h
+**
+**      Copyright (c) 2004-2006, United States government as represented by the
+**      administrator of the National Aeronautics Space Administration.
+**      All rights reserved. This software(cFE) was created at NASA's Goddard
+**      Space Flight Center pursuant to government contracts.
+**
+**      This software may be used only pursuant to a United States government
+**      sponsored project and the United States government may not be charged
+**      for use thereof.
+**
+** Purpose:
+**      This header file contains prototypes for private functions related to
+**      conflating messages: keeping only the latest message for each of a
+**      peer's conflated message ID's until it can be sent.
+**
+******************************************************************************/
+
+#ifndef _sbn_conflate_h_
+#define _sbn_conflate_h_
+
+#include "sbn_app.h"
+
+void         SBN_LoadConflate(SBN_PeerInterface_t *Peer, CFE_SB_MsgId_t *MsgIDs);
+bool         SBN_Conflated(SBN_PeerInterface_t *Peer, CFE_SB_MsgId_t MsgID);
+void         SBN_DrainConflated(SBN_PeerInterface_t *Peer);
+CFE_Status_t SBN_NextConflated(CFE_SB_MsgPtr_t *SBMsgPtrPtr, SBN_PeerInterface_t *Peer);
+void         SBN_ResetConflated(SBN_PeerInterface_t *Peer);
+
+#endif /* _sbn_conflate_h_ */
@@ -0,0 +1,348 @@
+/******************************************************************************
+ ** \file sbn_credit.c
+ **
+ **      Copyright (c) 2004-2006, United States government as represented by the
+ **      administrator of the National Aeronautics Space Administration.
+ **      All rights reserved. This software(cFE) was created at NASA's Goddard
+ **      Space Flight Center pursuant to government contracts.
+ **
+ **      This software may be used only pursuant to a United States government
+ **      sponsored project and the United States government may not be charged
+ **      for use thereof.
+ **
+ ** Purpose:
+ **      This file contains source code for credit-based flow control. A
+ **      receiver grants each peer a window of app messages, again every time
+ **      it has taken half a window, and a sender out of credit holds messages
+ **      in the peer's pipes, so that when the receiver falls behind messages
+ **      are lost at the sender, where SB's per message ID limits decide which.
+ **      Messages from the shared pipe or a bridge, which have no pipe of the
+ **      peer's to stay in, are held in a few pool buffers instead.
+ */
+
+#include "sbn_app.h"
+#include "sbn_pack.h"
+#include <string.h>
+
+#ifdef SBN_CREDITS
+
+/**
+ * Forgets the credit granted to and by a peer, called when the capabilities
+ * negotiated with the peer are reset. Until the peer grants some there is no
+ * credit to send it app messages.
+ *
+ * @param[in] Peer The peer.
+ */
+void SBN_ResetCredit(SBN_PeerInterface_t *Peer)
+{
+    SBN_HK_SET(Peer->CreditLimit, SBN_HK_GET(Peer->CreditSent));
+    SBN_HK_SET(Peer->CreditRecvCnt, 0);
+    Peer->CreditGrantedCnt = 0;
+} /* end SBN_ResetCredit() */
+
+/**
+ * Grants a peer a window of SBN_CREDIT_WINDOW app messages, from whatever it
+ * has sent by the time the grant arrives.
+ *
+ * @param[in] Peer The peer.
+ */
+void SBN_GrantCredit(SBN_PeerInterface_t *Peer)
+{
+    uint8  Buf[SBN_PACKED_CREDIT_SZ];
+    Pack_t Pack;
+
+    Pack_Init(&Pack, Buf, sizeof(Buf), true);
+    Pack_UInt16(&Pack, SBN_CREDIT_WINDOW);
+
+    Peer->CreditGrantedCnt = SBN_HK_GET(Peer->CreditRecvCnt);
+
+    SBN_SendNetMsg(SBN_CREDIT_MSG, (SBN_MsgSz_t)Pack.BufUsed, Buf, Peer);
+} /* end SBN_GrantCredit() */
+
+/**
+ * @param[in] Peer The peer.
+ *
+ * @return true if an app message can be sent to the peer now, always when
+ *         the peer does not take credit.
+ */
+bool SBN_HasCredit(SBN_PeerInterface_t *Peer)
+{
+    return !(Peer->Features & SBN_FEAT_CREDIT) ||
+           (int32)(SBN_HK_GET(Peer->CreditLimit) - SBN_HK_GET(Peer->CreditSent)) > 0;
+} /* end SBN_HasCredit() */
+
+/**
+ * Checks for credit before reading a peer's pipes, timing how long the peer
+ * is stalled for. Called only from the side that drains the peer's pipes.
+ *
+ * @param[in] Peer The peer.
+ *
+ * @return true if the messages should be left in the pipes for now, also
+ *         while messages held from a bridge are waiting to go first.
+ */
+bool SBN_HoldForCredit(SBN_PeerInterface_t *Peer)
+{
+    bool      Hold = Peer->HeldCnt != 0 || !SBN_HasCredit(Peer);
+    OS_time_t Now;
+
+    if (Hold == Peer->Stalled)
+    {
+        return Hold;
+    } /* end if */
+
+    OS_GetLocalTime(&Now);
+
+    if (Hold)
+    {
+        Peer->StallStart = Now;
+        SBN_HK_INC(Peer->StallCnt);
+    }
+    else
+    {
+        SBN_HK_SET(Peer->StallMS, Peer->StallMS + SBN_ElapsedMS(&Peer->StallStart, &Now));
+    } /* end if */
+
+    Peer->Stalled = Hold;
+
+    return Hold;
+} /* end SBN_HoldForCredit() */
+
+/**
+ * Holds an app or relay message for a peer out of credit, or with messages
+ * already held, until SBN_SendHeld() can send it. Sent now instead if the
+ * last held message went out while waiting for the mutex.
+ *
+ * @param[in] Peer The peer.
+ * @param[in] MsgType SBN_APP_MSG or SBN_RELAY_MSG.
+ * @param[in] MsgSz The size of the message.
+ * @param[in] Msg The message, copied.
+ *
+ * @return SBN_SUCCESS if the message was held, SBN_IF_EMPTY if it was dropped
+ *         because the peer, or the pool, has no more room for held messages,
+ *         otherwise the status of sending it.
+ */
+SBN_Status_t SBN_HoldMsg(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Msg)
+{
+    SBN_Status_t   SBN_Status = SBN_IF_EMPTY;
+    SBN_HeldMsg_t *Held       = NULL;
+    void *         Buf        = NULL;
+
+    if (OS_MutSemTake(SBN.HeldMutex) != OS_SUCCESS)
+    {
+        EVSSendErr(SBN_PEER_EID, "unable to take mutex");
+        return SBN_ERROR;
+    } /* end if */
+
+    if (Peer->HeldCnt == 0 && SBN_HasCredit(Peer))
+    {
+        SBN_Status = SBN_SendNetMsgNow(MsgType, MsgSz, Msg, Peer);
+    }
+    else if (Peer->HeldCnt < SBN_CREDIT_HOLD_DEPTH && SBN.HeldBufCnt < SBN.BufCnt / 2 && (Buf = SBN_GetBuf()) != NULL)
+    {
+        memcpy(Buf, Msg, MsgSz);
+
+        Held          = &Peer->Held[(Peer->HeldFirst + Peer->HeldCnt) % SBN_CREDIT_HOLD_DEPTH];
+        Held->Buf     = Buf;
+        Held->MsgSz   = MsgSz;
+        Held->MsgType = MsgType;
+
+        Peer->HeldCnt++;
+        SBN.HeldBufCnt++;
+        SBN_Status = SBN_SUCCESS;
+    }
+    else
+    {
+        SBN_HK_INC(Peer->CreditDropCnt);
+    } /* end if */
+
+    OS_MutSemGive(SBN.HeldMutex);
+
+    return SBN_Status;
+} /* end SBN_HoldMsg() */
+
+/**
+ * Sends the messages held for a peer, oldest first, for as long as the peer
+ * has credit. Each leaves the queue only once it is sent, so SBN_SendNetMsg()
+ * does not send a newer message ahead of it.
+ *
+ * @param[in] Peer The peer.
+ */
+void SBN_SendHeld(SBN_PeerInterface_t *Peer)
+{
+    SBN_HeldMsg_t *Held = NULL;
+
+    if (Peer->HeldCnt == 0 || OS_MutSemTake(SBN.HeldMutex) != OS_SUCCESS)
+    {
+        return;
+    } /* end if */
+
+    while (Peer->HeldCnt != 0 && SBN_HasCredit(Peer))
+    {
+        Held = &Peer->Held[Peer->HeldFirst];
+
+        SBN_SendNetMsgNow(Held->MsgType, Held->MsgSz, Held->Buf, Peer); /* ignore errors */
+
+        SBN_PutBuf(Held->Buf);
+        Held->Buf = NULL;
+
+        Peer->HeldFirst = (Peer->HeldFirst + 1) % SBN_CREDIT_HOLD_DEPTH;
+        Peer->HeldCnt--;
+        SBN.HeldBufCnt--;
+    } /* end while */
+
+    OS_MutSemGive(SBN.HeldMutex);
+} /* end SBN_SendHeld() */
+
+/**
+ * Drops the messages held for a peer, returning their buffers to the pool,
+ * for when the peer disconnects.
+ *
+ * @param[in] Peer The peer.
+ */
+void SBN_DropHeld(SBN_PeerInterface_t *Peer)
+{
+    OS_MutSemTake(SBN.HeldMutex);
+
+    while (Peer->HeldCnt != 0)
+    {
+        SBN_PutBuf(Peer->Held[Peer->HeldFirst].Buf);
+        Peer->Held[Peer->HeldFirst].Buf = NULL;
+
+        Peer->HeldFirst = (Peer->HeldFirst + 1) % SBN_CREDIT_HOLD_DEPTH;
+        Peer->HeldCnt--;
+        SBN.HeldBufCnt--;
+    } /* end while */
+
+    Peer->HeldFirst = 0;
+
+    OS_MutSemGive(SBN.HeldMutex);
+} /* end SBN_DropHeld() */
+
+/**
+ * Counts an app message sent to a peer against its credit.
+ *
+ * @param[in] Peer The peer.
+ */
+void SBN_UseCredit(SBN_PeerInterface_t *Peer)
+{
+    /* a bridge relays to the peer from the receive side, hence atomic */
+    SBN_HK_INC(Peer->CreditSent);
+} /* end SBN_UseCredit() */
+
+/**
+ * Counts an app message received from a peer, granting the peer more credit
+ * once it has sent half a window since it was last granted some. Called from
+ * the side that receives from the peer.
+ *
+ * @param[in] Peer The peer.
+ */
+void SBN_CountCredit(SBN_PeerInterface_t *Peer)
+{
+    if (!(Peer->Features & SBN_FEAT_CREDIT))
+    {
+        return;
+    } /* end if */
+
+    SBN_HK_INC(Peer->CreditRecvCnt);
+
+    if ((int32)(Peer->CreditRecvCnt - Peer->CreditGrantedCnt) >= SBN_CREDIT_WINDOW / 2)
+    {
+        SBN_GrantCredit(Peer);
+    } /* end if */
+} /* end SBN_CountCredit() */
+
+/**
+ * Puts off the next grant to a peer by a message, for a message from the
+ * peer that the software bus would not take, so a receiver whose SB is
+ * overflowing pushes back on its senders.
+ *
+ * @param[in] Peer The peer.
+ */
+void SBN_WithholdCredit(SBN_PeerInterface_t *Peer)
+{
+    Peer->CreditGrantedCnt++;
+} /* end SBN_WithholdCredit() */
+
+/**
+ * Processes a grant of credit from a peer. Messages the peer received before
+ * it sent the grant but after the last one are not counted against the new
+ * window, so a sender can have up to two windows in flight.
+ *
+ * @param[in] Peer The peer.
+ * @param[in] MsgSz The size of the SBN_CREDIT_MSG payload.
+ * @param[in] Msg The SBN_CREDIT_MSG payload.
+ *
+ * @return SBN_SUCCESS, or SBN_ERROR if credit was not negotiated with the
+ *         peer or the payload is too short.
+ */
+SBN_Status_t SBN_ProcessCreditMsg(SBN_PeerInterface_t *Peer, SBN_MsgSz_t MsgSz, void *Msg)
+{
+    uint16 Window = 0;
+    Pack_t Pack;
+
+    if (!(Peer->Features & SBN_FEAT_CREDIT) || MsgSz < (SBN_MsgSz_t)SBN_PACKED_CREDIT_SZ)
+    {
+        EVSSendErr(SBN_PROTO_EID, "unexpected credit message from ProcessorID %d (MsgSz=%d)",
+                   (int)Peer->ProcessorID, (int)MsgSz);
+        return SBN_ERROR;
+    } /* end if */
+
+    Pack_Init(&Pack, Msg, MsgSz, false);
+    Unpack_UInt16(&Pack, &Window);
+
+    SBN_HK_SET(Peer->CreditLimit, SBN_HK_GET(Peer->CreditSent) + Window);
+
+    SBN_SendHeld(Peer);
+
+    return SBN_SUCCESS;
+} /* end SBN_ProcessCreditMsg() */
+
+/**
+ * Grants credit again to the peers no app messages have been received from
+ * for SBN_CREDIT_REGRANT_TIME, in case they are stalled because a grant, or
+ * messages that would have earned one, were lost, and sends what is held for
+ * peers that have credit again. Called once per wakeup.
+ */
+void SBN_CheckCredits(void)
+{
+    SBN_NetIdx_t  NetIdx  = 0;
+    SBN_PeerIdx_t PeerIdx = 0;
+    uint32        RecvCnt = 0;
+    OS_time_t     Now;
+
+    OS_GetLocalTime(&Now);
+
+    for (NetIdx = 0; NetIdx < SBN.NetCnt; NetIdx++)
+    {
+        SBN_NetInterface_t *Net = &SBN.Nets[NetIdx];
+
+        for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
+        {
+            SBN_PeerInterface_t *Peer = &Net->Peers[PeerIdx];
+
+            if (!Peer->Connected || !(Peer->Features & SBN_FEAT_CREDIT))
+            {
+                continue;
+            } /* end if */
+
+            SBN_SendHeld(Peer);
+
+            RecvCnt = SBN_HK_GET(Peer->CreditRecvCnt);
+
+            if (RecvCnt != Peer->CreditCheckedCnt)
+            {
+                Peer->CreditCheckedCnt  = RecvCnt;
+                Peer->CreditCheckedTime = Now;
+                continue;
+            } /* end if */
+
+            if (SBN_ElapsedMS(&Peer->CreditCheckedTime, &Now) >= SBN_CREDIT_REGRANT_TIME)
+            {
+                SBN_GrantCredit(Peer);
+                Peer->CreditCheckedTime = Now;
+            } /* end if */
+        }     /* end for */
+    }         /* end for */
+} /* end SBN_CheckCredits() */
+
+#endif /* SBN_CREDITS */
@@ -0,0 +1,43 @@
+/******************************************************************************
+** File: sbn_credit.h
+**
+**      Copyright (c) 2004-2006, United States government as represented by the
+**      administrator of the National Aeronautics Space Administration.
+**      All rights reserved. This software(cFE) was created at NASA's Goddard
+**      Space Flight Center pursuant to government contracts.
+**
+**      This software may be used only pursuant to a United States government
+**      sponsored project and the United States government may not be charged
+**      for use thereof.
+**
+** Purpose:
+**      This header file contains prototypes for private functions related to
+**      credit-based flow control: receivers granting peers credit to send app
+**      messages, and senders holding messages when they are out of credit.
+**
+******************************************************************************/
+
+#ifndef _sbn_credit_h_
+#define _sbn_credit_h_
+
+#include "sbn_app.h"
+
+/** @brief An SBN_CREDIT_MSG payload is the number of app messages granted. */
+#define SBN_PACKED_CREDIT_SZ sizeof(uint16)
+
+#ifdef SBN_CREDITS
+void         SBN_ResetCredit(SBN_PeerInterface_t *Peer);
+void         SBN_GrantCredit(SBN_PeerInterface_t *Peer);
+bool         SBN_HasCredit(SBN_PeerInterface_t *Peer);
+bool         SBN_HoldForCredit(SBN_PeerInterface_t *Peer);
+SBN_Status_t SBN_HoldMsg(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Msg);
+void         SBN_SendHeld(SBN_PeerInterface_t *Peer);
+void         SBN_DropHeld(SBN_PeerInterface_t *Peer);
+void         SBN_UseCredit(SBN_PeerInterface_t *Peer);
+void         SBN_CountCredit(SBN_PeerInterface_t *Peer);
+void         SBN_WithholdCredit(SBN_PeerInterface_t *Peer);
+SBN_Status_t SBN_ProcessCreditMsg(SBN_PeerInterface_t *Peer, SBN_MsgSz_t MsgSz, void *Msg);
+void         SBN_CheckCredits(void);
+#endif /* SBN_CREDITS */
+
+#endif /* _sbn_credit_h_ */
@@ -0,0 +1,170 @@
+/******************************************************************************
+ ** \file sbn_detect.c
+ **
+ **      Copyright (c) 2004-2006, United States government as represented by the
+ **      administrator of the National Aeronautics Space Administration.
+ **      All rights reserved. This software(cFE) was created at NASA's Goddard
+ **      Space Flight Center pursuant to government contracts.
+ **
+ **      This software may be used only pursuant to a United States government
+ **      sponsored project and the United States government may not be charged
+ **      for use thereof.
+ **
+ ** Purpose:
+ **      This file contains source code for deciding when to send peers
+ **      heartbeats and when a silent peer has failed. The receive side keeps
+ **      a smoothed interval between each peer's messages and its mean
+ **      deviation, as TCP does for round trip times, and the longer a peer's
+ **      silence runs past the interval (in deviations) the more it is
+ **      suspected, so the timeout follows the link rather than a constant.
+ */
+
+#include "sbn_app.h"
+
+/** \brief Intervals longer than this (in microseconds, about 35 minutes) count as this. */
+#define MAX_INTERVAL_US 0x7FFFFFFF
+
+static uint32 ElapsedUS(OS_time_t *Then, OS_time_t *Now)
+{
+    int64 US = ((int64)Now->seconds - Then->seconds) * 1000000 + ((int64)Now->microsecs - Then->microsecs);
+
+    if (US < 0)
+    {
+        return 0;
+    } /* end if */
+
+    return US > MAX_INTERVAL_US ? MAX_INTERVAL_US : (uint32)US;
+} /* end ElapsedUS() */
+
+/** Reads a time another task may be writing, a field at a time. */
+static void GetTime(OS_time_t *TimePtr, OS_time_t *Out)
+{
+    Out->seconds   = SBN_HK_GET(TimePtr->seconds);
+    Out->microsecs = SBN_HK_GET(TimePtr->microsecs);
+} /* end GetTime() */
+
+/**
+ * Forgets the intervals between a peer's messages, when it (re)connects.
+ *
+ * @param[in] Peer The peer.
+ */
+void SBN_ResetArrivals(SBN_PeerInterface_t *Peer)
+{
+    SBN_HK_SET(Peer->ArrivalCnt, 0);
+} /* end SBN_ResetArrivals() */
+
+/**
+ * Takes the interval between two messages from a peer into its smoothed
+ * interval and deviation, with the gains of TCP's estimator (RFC 6298) of
+ * 1/8 and 1/4. Called from the side that receives from the peer.
+ *
+ * @param[in] Peer The peer the message was received from.
+ * @param[in] Prev When the previous message was received from the peer.
+ * @param[in] Now When this message was received.
+ */
+void SBN_RecordArrival(SBN_PeerInterface_t *Peer, OS_time_t *Prev, OS_time_t *Now)
+{
+    int32  Interval = (int32)ElapsedUS(Prev, Now);
+    int32  Mean = 0, Dev = 0, Err = 0;
+    uint16 Cnt = Peer->ArrivalCnt;
+
+    if (Cnt == 0)
+    {
+        Mean = Interval;
+        Dev  = Interval / 2;
+    }
+    else
+    {
+        Mean = (int32)Peer->ArrivalMeanUS;
+        Dev  = (int32)Peer->ArrivalDevUS;
+        Err  = Interval - Mean;
+
+        Mean += Err / 8;
+        Dev += ((Err < 0 ? -Err : Err) - Dev) / 4;
+    } /* end if */
+
+    SBN_HK_SET(Peer->ArrivalMeanUS, (uint32)Mean);
+    SBN_HK_SET(Peer->ArrivalDevUS, (uint32)Dev);
+
+    if (Cnt < SBN_FD_MIN_SAMPLES)
+    {
+        SBN_HK_SET(Peer->ArrivalCnt, Cnt + 1);
+    } /* end if */
+} /* end SBN_RecordArrival() */
+
+bool SBN_HeartbeatDue(SBN_PeerInterface_t *Peer)
+{
+    OS_time_t Now, LastSend;
+
+    if (Peer->Net->HeartbeatMS == 0)
+    {
+        return false;
+    } /* end if */
+
+    OS_GetLocalTime(&Now);
+    GetTime(&Peer->LastSend, &LastSend);
+
+    return ElapsedUS(&LastSend, &Now) >= Peer->Net->HeartbeatMS * 1000;
+} /* end SBN_HeartbeatDue() */
+
+bool SBN_PeerTimedOut(SBN_PeerInterface_t *Peer)
+{
+    SBN_NetInterface_t *Net     = Peer->Net;
+    uint64              LimitUS = (uint64)Net->TimeoutMS * 1000, SuspectUS = 0;
+    uint32              SilentUS = 0;
+    OS_time_t           Now, LastRecv;
+
+    if (Net->TimeoutMS == 0)
+    {
+        return false;
+    } /* end if */
+
+    OS_GetLocalTime(&Now);
+    GetTime(&Peer->LastRecv, &LastRecv);
+    SilentUS = ElapsedUS(&LastRecv, &Now);
+
+    /* without heartbeats a peer may be silent for want of anything to say */
+    if (Net->HeartbeatMS != 0 && SBN_HK_GET(Peer->ArrivalCnt) >= SBN_FD_MIN_SAMPLES)
+    {
+        SuspectUS = (uint64)SBN_HK_GET(Peer->ArrivalMeanUS) + (uint64)SBN_HK_GET(Peer->ArrivalDevUS) * SBN_FD_THRESHOLD;
+
+        if (SuspectUS < (uint64)Net->HeartbeatMS * 1000 * SBN_FD_MIN_HEARTBEATS)
+        {
+            SuspectUS = (uint64)Net->HeartbeatMS * 1000 * SBN_FD_MIN_HEARTBEATS;
+        } /* end if */
+
+        if (SuspectUS < LimitUS)
+        {
+            LimitUS = SuspectUS;
+        } /* end if */
+    }     /* end if */
+
+    if (SilentUS < LimitUS)
+    {
+        return false;
+    } /* end if */
+
+    EVSSendInfo(SBN_PEER_EID, "CPU %d silent for %d ms (limit %d ms, mean interval %d ms)", (int)Peer->ProcessorID,
+                (int)(SilentUS / 1000), (int)(LimitUS / 1000), (int)(SBN_HK_GET(Peer->ArrivalMeanUS) / 1000));
+
+    return true;
+} /* end SBN_PeerTimedOut() */
+
+uint32 SBN_LivenessPollMS(SBN_PeerInterface_t *Peer)
+{
+    SBN_NetInterface_t *Net     = Peer->Net;
+    uint32              DelayMS = 1000;
+
+    /* a quarter of the interval keeps heartbeats and timeouts within a quarter late */
+    if (Net->HeartbeatMS != 0 && Net->HeartbeatMS / 4 < DelayMS)
+    {
+        DelayMS = Net->HeartbeatMS / 4;
+    } /* end if */
+
+    if (Net->TimeoutMS != 0 && Net->TimeoutMS / 4 < DelayMS)
+    {
+        DelayMS = Net->TimeoutMS / 4;
+    } /* end if */
+
+    return DelayMS;
+} /* end SBN_LivenessPollMS() */
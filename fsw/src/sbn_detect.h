@@ -0,0 +1,28 @@
+/******************************************************************************
+** File: sbn_detect.h
+**
+**      Copyright (c) 2004-2006, United States government as represented by the
+**      administrator of the National Aeronautics Space Administration.
+**      All rights reserved. This software(cFE) was created at NASA's Goddard
+**      Space Flight Center pursuant to government contracts.
+**
+**      This software may be used only pursuant to a United States government
+**      sponsored project and the United States government may not be charged
+**      for use thereof.
+**
+** Purpose:
+**      This header file contains prototypes for private functions related to
+**      detecting failed peers. The functions modules call are declared in
+**      sbn_interfaces.h.
+**
+******************************************************************************/
+
+#ifndef _sbn_detect_h_
+#define _sbn_detect_h_
+
+#include "sbn_app.h"
+
+void SBN_ResetArrivals(SBN_PeerInterface_t *Peer);
+void SBN_RecordArrival(SBN_PeerInterface_t *Peer, OS_time_t *Prev, OS_time_t *Now);
+
+#endif /* _sbn_detect_h_ */
@@ -0,0 +1,368 @@
+/******************************************************************************
+ ** \file sbn_frag.c
+ **
+ **      Copyright (c) 2004-2006, United States government as represented by the
+ **      administrator of the National Aeronautics Space Administration.
+ **      All rights reserved. This software(cFE) was created at NASA's Goddard
+ **      Space Flight Center pursuant to government contracts.
+ **
+ **      This software may be used only pursuant to a United States government
+ **      sponsored project and the United States government may not be charged
+ **      for use thereof.
+ **
+ ** Purpose:
+ **      This file contains source code for fragmenting SB messages that do not
+ **      fit in the MTU of a net, and reassembling them on the receiving side.
+ **      This is done above the protocol modules so it works the same for any
+ **      datagram or serial net (UDP, serial, SpaceWire.)
+ */
+
+#include "sbn_app.h"
+#include <stdlib.h>
+#include <string.h>
+#include "sbn_pack.h"
+
+/**
+ * Allocates as many reassembly buffers as the configuration table asks for,
+ * SBN_MAX_REASM_BUFS if it does not say.
+ *
+ * @return SBN_SUCCESS on success, SBN_ERROR otherwise.
+ */
+SBN_Status_t SBN_InitReasm(void)
+{
+    SBN.ReasmCnt = SBN.Conf != NULL && SBN.Conf->ReasmBufCnt != 0 ? SBN.Conf->ReasmBufCnt : SBN_MAX_REASM_BUFS;
+
+    SBN.Reasm = calloc(SBN.ReasmCnt, sizeof(*SBN.Reasm));
+    if (SBN.Reasm == NULL)
+    {
+        EVSSendErr(SBN_INIT_EID, "unable to allocate %d reassembly buffers", (int)SBN.ReasmCnt);
+        return SBN_ERROR;
+    } /* end if */
+
+    return SBN_SUCCESS;
+} /* end SBN_InitReasm() */
+
+/**
+ * Splits an SB message into SBN_FRAG_MSG messages that each fit in the MTU
+ * negotiated with the peer and sends them.
+ *
+ * @param[in] MsgSz The size of the SB message.
+ * @param[in] Msg The SB message.
+ * @param[in] Peer The peer to send the message to.
+ *
+ * @return SBN_SUCCESS if all fragments were sent, otherwise the status of the
+ *         first fragment to fail.
+ */
+SBN_Status_t SBN_SendFragmented(SBN_MsgSz_t MsgSz, void *Msg, SBN_PeerInterface_t *Peer)
+{
+    SBN_Status_t SBN_Status = SBN_SUCCESS;
+    uint32       ChunkSz = 0, FragCnt = 0;
+    uint32       FragIdx = 0, Offset = 0, DataSz = 0;
+    uint16       FragID  = 0;
+    uint8 *      FragBuf = NULL;
+    Pack_t       Pack;
+
+    if (Peer->MTU <= SBN_PACKED_HDR_SZ + SBN_PACKED_FRAG_HDR_SZ)
+    {
+        /* no room for any of the message in a fragment */
+        EVSSendErr(SBN_MSG_EID, "MTU %d too small to fragment for ProcessorID %d", (int)Peer->MTU,
+                   (int)Peer->ProcessorID);
+        SBN_HK_INC(Peer->SendErrCnt);
+        return SBN_ERROR;
+    } /* end if */
+
+    ChunkSz = Peer->MTU - SBN_PACKED_HDR_SZ - SBN_PACKED_FRAG_HDR_SZ;
+    if (ChunkSz > SBN_MAX_PACKED_MSG_SZ - SBN_PACKED_FRAG_HDR_SZ)
+    {
+        /* each fragment is built in a buffer from the pool */
+        ChunkSz = SBN_MAX_PACKED_MSG_SZ - SBN_PACKED_FRAG_HDR_SZ;
+    } /* end if */
+
+    FragCnt = (MsgSz + ChunkSz - 1) / ChunkSz;
+
+    if (!(Peer->Features & SBN_FEAT_FRAG))
+    {
+        EVSSendErr(SBN_MSG_EID, "ProcessorID %d cannot reassemble, dropping message (MsgSz=%d, MTU=%d)",
+                   (int)Peer->ProcessorID, (int)MsgSz, (int)Peer->MTU);
+        SBN_HK_INC(Peer->SendErrCnt);
+        return SBN_ERROR;
+    } /* end if */
+
+    if (FragCnt > SBN_MAX_FRAGS)
+    {
+        EVSSendErr(SBN_MSG_EID, "message too large to fragment (MsgSz=%d, MTU=%d, ProcessorID=%d)", (int)MsgSz,
+                   (int)Peer->MTU, (int)Peer->ProcessorID);
+        SBN_HK_INC(Peer->SendErrCnt);
+        return SBN_ERROR;
+    } /* end if */
+
+    FragBuf = SBN_GetBuf();
+    if (FragBuf == NULL)
+    {
+        EVSSendErr(SBN_MSG_EID, "no buffer to fragment into");
+        SBN_HK_INC(Peer->SendErrCnt);
+        return SBN_ERROR;
+    } /* end if */
+
+    FragID = Peer->NextFragID++;
+
+    for (FragIdx = 0; FragIdx < FragCnt; FragIdx++)
+    {
+        Offset = FragIdx * ChunkSz;
+        DataSz = MsgSz - Offset < ChunkSz ? MsgSz - Offset : ChunkSz;
+
+        Pack_Init(&Pack, FragBuf, SBN_PACKED_FRAG_HDR_SZ + DataSz, false);
+        Pack_UInt16(&Pack, FragID);
+        Pack_UInt16(&Pack, (uint16)FragIdx);
+        Pack_UInt16(&Pack, (uint16)FragCnt);
+        Pack_UInt32(&Pack, Offset);
+        Pack_UInt32(&Pack, (uint32)MsgSz);
+        Pack_Data(&Pack, (uint8 *)Msg + Offset, DataSz);
+
+        SBN_Status = SBN_SendNetMsg(SBN_FRAG_MSG, (SBN_MsgSz_t)Pack.BufUsed, FragBuf, Peer);
+        if (SBN_Status != SBN_SUCCESS)
+        {
+            break;
+        } /* end if */
+    }     /* end for */
+
+    SBN_PutBuf(FragBuf);
+
+    return SBN_Status;
+} /* end SBN_SendFragmented() */
+
+/**
+ * Finds the reassembly buffer for a message from a peer, or claims one. When
+ * all buffers are in use, the partial message that was started first is
+ * dropped to make room.
+ *
+ * @note Called with SBN.ReasmMutex held.
+ *
+ * @return The buffer, or NULL if every buffer holds a complete message that
+ *         is still being delivered.
+ */
+static SBN_Reasm_t *GetReasm(SBN_PeerInterface_t *Peer, uint16 FragID, OS_time_t *Now)
+{
+    SBN_Reasm_t *Reasm = NULL, *Free = NULL, *Oldest = NULL;
+    int          i     = 0;
+
+    for (i = 0; i < SBN.ReasmCnt; i++)
+    {
+        Reasm = &SBN.Reasm[i];
+
+        if (Reasm->Peer == NULL)
+        {
+            if (Free == NULL)
+            {
+                Free = Reasm;
+            } /* end if */
+            continue;
+        } /* end if */
+
+        if (Reasm->Peer == Peer && Reasm->FragID == FragID)
+        {
+            return Reasm;
+        } /* end if */
+
+        /* complete messages are being delivered, leave them be */
+        if (Reasm->RecvCnt < Reasm->FragCnt &&
+            (Oldest == NULL || SBN_ElapsedMS(&Reasm->Started, &Oldest->Started) > 0))
+        {
+            Oldest = Reasm;
+        } /* end if */
+    }     /* end for */
+
+    if (Free == NULL)
+    {
+        if (Oldest == NULL)
+        {
+            return NULL;
+        } /* end if */
+
+        EVSSendDbg(SBN_MSG_EID, "dropping partial message %d from ProcessorID %d, no reassembly buffers",
+                   (int)Oldest->FragID, (int)Oldest->Peer->ProcessorID);
+        SBN_HK_INC(Oldest->Peer->ReasmErrCnt);
+        Free = Oldest;
+    } /* end if */
+
+    memset(Free->RecvMask, 0, sizeof(Free->RecvMask));
+    Free->Peer    = Peer;
+    Free->FragID  = FragID;
+    Free->FragCnt = 0;
+    Free->RecvCnt = 0;
+    Free->TotalSz = 0;
+    Free->Started = *Now;
+
+    return Free;
+} /* end GetReasm() */
+
+/**
+ * Processes a fragment received from a peer, once all fragments of the
+ * message have been received the SB message is processed as if it were
+ * received whole.
+ *
+ * @param[in] Peer The peer that sent the fragment.
+ * @param[in] MsgSz The size of the SBN_FRAG_MSG payload.
+ * @param[in] Msg The SBN_FRAG_MSG payload.
+ *
+ * @return SBN_SUCCESS if the fragment was accepted (or was a duplicate),
+ *         otherwise the status of processing the reassembled message, or
+ *         SBN_ERROR if the fragment could not be used.
+ */
+SBN_Status_t SBN_ProcessFragFromPeer(SBN_PeerInterface_t *Peer, SBN_MsgSz_t MsgSz, void *Msg)
+{
+    SBN_Status_t SBN_Status = SBN_SUCCESS;
+    SBN_Reasm_t *Reasm      = NULL;
+    uint16       FragID = 0, FragIdx = 0, FragCnt = 0;
+    uint32       Offset = 0, TotalSz = 0, DataSz = 0;
+    OS_time_t    Now;
+    Pack_t       Pack;
+
+    Pack_Init(&Pack, Msg, MsgSz, false);
+    if (MsgSz < (SBN_MsgSz_t)SBN_PACKED_FRAG_HDR_SZ || !Unpack_UInt16(&Pack, &FragID) ||
+        !Unpack_UInt16(&Pack, &FragIdx) || !Unpack_UInt16(&Pack, &FragCnt) || !Unpack_UInt32(&Pack, &Offset) ||
+        !Unpack_UInt32(&Pack, &TotalSz))
+    {
+        EVSSendErr(SBN_MSG_EID, "short fragment from ProcessorID %d", (int)Peer->ProcessorID);
+        SBN_HK_INC(Peer->ReasmErrCnt);
+        return SBN_ERROR;
+    } /* end if */
+
+    DataSz = MsgSz - SBN_PACKED_FRAG_HDR_SZ;
+
+    if (FragCnt == 0 || FragCnt > SBN_MAX_FRAGS || FragIdx >= FragCnt || TotalSz > CFE_MISSION_SB_MAX_SB_MSG_SIZE ||
+        TotalSz > SBN_MSGSZ_MAX || Offset > TotalSz || DataSz > TotalSz - Offset)
+    {
+        EVSSendErr(SBN_MSG_EID, "invalid fragment from ProcessorID %d (FragIdx=%d FragCnt=%d Offset=%d TotalSz=%d)",
+                   (int)Peer->ProcessorID, (int)FragIdx, (int)FragCnt, (int)Offset, (int)TotalSz);
+        SBN_HK_INC(Peer->ReasmErrCnt);
+        return SBN_ERROR;
+    } /* end if */
+
+    OS_GetLocalTime(&Now);
+
+    if (OS_MutSemTake(SBN.ReasmMutex) != OS_SUCCESS)
+    {
+        EVSSendErr(SBN_MSG_EID, "unable to take mutex");
+        return SBN_ERROR;
+    } /* end if */
+
+    Reasm = GetReasm(Peer, FragID, &Now);
+
+    if (Reasm == NULL)
+    {
+        SBN_Status = SBN_ERROR;
+    }
+    else if (Reasm->RecvCnt == 0)
+    {
+        Reasm->FragCnt = FragCnt;
+        Reasm->TotalSz = TotalSz;
+    }
+    else if (Reasm->FragCnt != FragCnt || Reasm->TotalSz != TotalSz)
+    {
+        /* the peer restarted its fragment ID's, drop what we had (unless it is being delivered) */
+        EVSSendDbg(SBN_MSG_EID, "fragment mismatch for message %d from ProcessorID %d", (int)FragID,
+                   (int)Peer->ProcessorID);
+        if (Reasm->RecvCnt < Reasm->FragCnt)
+        {
+            Reasm->Peer = NULL;
+        } /* end if */
+        SBN_Status = SBN_ERROR;
+    } /* end if */
+
+    if (SBN_Status != SBN_SUCCESS)
+    {
+        SBN_HK_INC(Peer->ReasmErrCnt);
+        OS_MutSemGive(SBN.ReasmMutex);
+        return SBN_Status;
+    } /* end if */
+
+    if (Reasm->RecvMask[FragIdx / 32] & (1U << (FragIdx % 32)))
+    {
+        /* duplicate */
+        OS_MutSemGive(SBN.ReasmMutex);
+        return SBN_SUCCESS;
+    } /* end if */
+
+    Reasm->RecvMask[FragIdx / 32] |= 1U << (FragIdx % 32);
+    memcpy(Reasm->Buf + Offset, (uint8 *)Msg + SBN_PACKED_FRAG_HDR_SZ, DataSz);
+    Reasm->RecvCnt++;
+
+    OS_MutSemGive(SBN.ReasmMutex);
+
+    if (Reasm->RecvCnt < Reasm->FragCnt)
+    {
+        return SBN_SUCCESS;
+    } /* end if */
+
+    /* complete, the buffer is ours until we release it */
+    SBN_Status = SBN_ProcessNetMsg(Peer->Net, SBN_APP_MSG, Peer->ProcessorID, (SBN_MsgSz_t)Reasm->TotalSz, Reasm->Buf);
+
+    OS_MutSemTake(SBN.ReasmMutex);
+    Reasm->Peer = NULL;
+    OS_MutSemGive(SBN.ReasmMutex);
+
+    return SBN_Status;
+} /* end SBN_ProcessFragFromPeer() */
+
+/**
+ * Drops partial messages whose remaining fragments did not arrive within
+ * SBN_REASM_TIMEOUT milliseconds, called once per wakeup.
+ */
+void SBN_CheckReasmTimeouts(void)
+{
+    SBN_Reasm_t *Reasm = NULL;
+    OS_time_t    Now;
+    int          i = 0;
+
+    OS_GetLocalTime(&Now);
+
+    if (OS_MutSemTake(SBN.ReasmMutex) != OS_SUCCESS)
+    {
+        EVSSendErr(SBN_MSG_EID, "unable to take mutex");
+        return;
+    } /* end if */
+
+    for (i = 0; i < SBN.ReasmCnt; i++)
+    {
+        Reasm = &SBN.Reasm[i];
+
+        if (Reasm->Peer == NULL || Reasm->RecvCnt >= Reasm->FragCnt ||
+            SBN_ElapsedMS(&Reasm->Started, &Now) < SBN_REASM_TIMEOUT)
+        {
+            continue;
+        } /* end if */
+
+        EVSSendDbg(SBN_MSG_EID, "timed out reassembling message %d from ProcessorID %d (%d of %d fragments)",
+                   (int)Reasm->FragID, (int)Reasm->Peer->ProcessorID, (int)Reasm->RecvCnt, (int)Reasm->FragCnt);
+        SBN_HK_INC(Reasm->Peer->ReasmErrCnt);
+        Reasm->Peer = NULL;
+    } /* end for */
+
+    OS_MutSemGive(SBN.ReasmMutex);
+} /* end SBN_CheckReasmTimeouts() */
+
+/**
+ * Releases the reassembly buffers of a peer that is being unloaded, so that
+ * none is left pointing at it.
+ */
+void SBN_DropReasm(SBN_PeerInterface_t *Peer)
+{
+    int i = 0;
+
+    if (OS_MutSemTake(SBN.ReasmMutex) != OS_SUCCESS)
+    {
+        EVSSendErr(SBN_MSG_EID, "unable to take mutex");
+        return;
+    } /* end if */
+
+    for (i = 0; i < SBN.ReasmCnt; i++)
+    {
+        if (SBN.Reasm[i].Peer == Peer)
+        {
+            SBN.Reasm[i].Peer = NULL;
+        } /* end if */
+    } /* end for */
+
+    OS_MutSemGive(SBN.ReasmMutex);
+} /* end SBN_DropReasm() */
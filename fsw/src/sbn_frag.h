@@ -0,0 +1,44 @@
+/******************************************************************************
+** File: sbn_frag.h
+**
+**      Copyright (c) 2004-2006, United States government as represented by the
+**      administrator of the National Aeronautics Space Administration.
+**      All rights reserved. This software(cFE) was created at NASA's Goddard
+**      Space Flight Center pursuant to government contracts.
+**
+**      This software may be used only pursuant to a United States government
+**      sponsored project and the United States government may not be charged
+**      for use thereof.
+**
+** Purpose:
+**      This header file contains prototypes for private functions related to
+**      fragmenting SB messages larger than a net's MTU and reassembling them
+**      on receipt.
+**
+******************************************************************************/
+
+#ifndef _sbn_frag_h_
+#define _sbn_frag_h_
+
+#include "sbn_app.h"
+
+/**
+ * @brief Fragments are sent as SBN_FRAG_MSG messages whose payload is
+ * FragID + FragIdx + FragCnt + Offset + TotalSz followed by the fragment data.
+ */
+#define SBN_PACKED_FRAG_HDR_SZ (sizeof(uint16) * 3 + sizeof(uint32) * 2)
+
+/**
+ * @brief True if an SBN message of this type and size must be fragmented to
+ * be sent to the peer.
+ */
+#define SBN_NEEDS_FRAG(Peer, MsgType, MsgSz) \
+    ((MsgType) == SBN_APP_MSG && (Peer)->MTU != 0 && (MsgSz) + SBN_PACKED_HDR_SZ > (Peer)->MTU)
+
+SBN_Status_t SBN_InitReasm(void);
+SBN_Status_t SBN_SendFragmented(SBN_MsgSz_t MsgSz, void *Msg, SBN_PeerInterface_t *Peer);
+SBN_Status_t SBN_ProcessFragFromPeer(SBN_PeerInterface_t *Peer, SBN_MsgSz_t MsgSz, void *Msg);
+void         SBN_CheckReasmTimeouts(void);
+void         SBN_DropReasm(SBN_PeerInterface_t *Peer);
+
+#endif /* _sbn_frag_h_ */
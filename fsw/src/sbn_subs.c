@@ -81,27 +81,256 @@ static SBN_Status_t SendLocalSubToPeer(int SubType, CFE_SB_MsgId_t MsgID, CFE_SB
 } /* end SendLocalSubToPeer */
 
 /**
- * \brief Sends all local subscriptions over the wire to a peer.
+ * \brief Orders the local subscriptions by message ID.
  *
- * @param[in] Peer The peer interface.
+ * @param[out] Order The indexes of SBN.Subs, by message ID.
  */
-SBN_Status_t SBN_SendLocalSubsToPeer(SBN_PeerInterface_t *Peer)
+static void SortLocalSubs(uint16 *Order)
 {
-    uint8  Buf[SBN_PACKED_SUB_SZ];
-    Pack_t Pack;
-    Pack_Init(&Pack, &Buf, SBN_PACKED_SUB_SZ, 0);
-    Pack_Data(&Pack, (void *)SBN_IDENT, SBN_IDENT_LEN);
-    Pack_UInt16(&Pack, SBN.SubCnt);
+    int    i = 0, j = 0;
+    uint16 Idx = 0;
 
-    int i = 0;
     for (i = 0; i < SBN.SubCnt; i++)
     {
-        Pack_MsgID(&Pack, SBN.Subs[i].MsgID);
-        /* 2 uint8's */
-        Pack_Data(&Pack, &SBN.Subs[i].QoS, sizeof(SBN.Subs[i].QoS));
+        Idx = (uint16)i;
+
+        for (j = i; j > 0 && SBN.Subs[Order[j - 1]].MsgID > SBN.Subs[Idx].MsgID; j--)
+        {
+            Order[j] = Order[j - 1];
+        } /* end for */
+
+        Order[j] = Idx;
     } /* end for */
+} /* end SortLocalSubs() */
+
+/**
+ * \brief Finds the end of a run of local subscriptions to consecutive message
+ *        ID's with the same QoS, at most SBN_MAX_SUB_RANGE long.
+ *
+ * @param[in] Order The indexes of SBN.Subs, by message ID.
+ * @param[in] Start The position in Order the run starts at.
+ *
+ * @return The position in Order after the end of the run.
+ */
+static int LocalSubRunEnd(uint16 *Order, int Start)
+{
+    SBN_Subs_t *First = &SBN.Subs[Order[Start]];
+    SBN_Subs_t *Sub   = NULL;
+    int         End   = Start + 1;
+
+    for (; End < SBN.SubCnt && End - Start < SBN_MAX_SUB_RANGE; End++)
+    {
+        Sub = &SBN.Subs[Order[End]];
+
+        if (Sub->MsgID != First->MsgID + (End - Start) || !SBN_SAME_QOS(Sub->QoS, First->QoS))
+        {
+            break;
+        } /* end if */
+    }     /* end for */
+
+    return End;
+} /* end LocalSubRunEnd() */
+
+/**
+ * \brief Sends all local subscriptions over the wire to a peer. Peers that
+ *        take SBN_SUBRANGE_MSG get runs of consecutive message ID's as one
+ *        range each, and the rest in an SBN_SUB_MSG.
+ *
+ * @param[in] Peer The peer interface.
+ */
+static SBN_Status_t SendAppSubsToPeer(SBN_PeerInterface_t *Peer)
+{
+    uint8        Buf[SBN_PACKED_SUBRANGE_SZ];
+    uint16       Order[SBN_MAX_SUBS_PER_PEER];
+    Pack_t       Pack;
+    SBN_Status_t SBN_Status = SBN_SUCCESS;
+    int          i = 0, End = 0, SingleCnt = 0, RangeCnt = 0;
+
+    if (!(Peer->Features & SBN_FEAT_SUBRANGE))
+    {
+        Pack_Init(&Pack, &Buf, SBN_PACKED_SUB_SZ, 0);
+        Pack_Data(&Pack, (void *)SBN_IDENT, SBN_IDENT_LEN);
+        Pack_UInt16(&Pack, SBN.SubCnt);
+
+        for (i = 0; i < SBN.SubCnt; i++)
+        {
+            Pack_MsgID(&Pack, SBN.Subs[i].MsgID);
+            /* 2 uint8's */
+            Pack_Data(&Pack, &SBN.Subs[i].QoS, sizeof(SBN.Subs[i].QoS));
+        } /* end for */
+
+        return SBN_SendNetMsg(SBN_SUB_MSG, Pack.BufUsed, Buf, Peer);
+    } /* end if */
+
+    SortLocalSubs(Order);
+
+    for (i = 0; i < SBN.SubCnt; i = End)
+    {
+        End = LocalSubRunEnd(Order, i);
+
+        if (End - i > 1)
+        {
+            RangeCnt++;
+        }
+        else
+        {
+            SingleCnt++;
+        } /* end if */
+    }     /* end for */
+
+    Pack_Init(&Pack, &Buf, sizeof(Buf), 0);
+    Pack_Data(&Pack, (void *)SBN_IDENT, SBN_IDENT_LEN);
+    Pack_UInt16(&Pack, SingleCnt);
+
+    for (i = 0; i < SBN.SubCnt; i = End)
+    {
+        End = LocalSubRunEnd(Order, i);
+
+        if (End - i == 1)
+        {
+            Pack_MsgID(&Pack, SBN.Subs[Order[i]].MsgID);
+            Pack_Data(&Pack, &SBN.Subs[Order[i]].QoS, sizeof(SBN.Subs[Order[i]].QoS));
+        } /* end if */
+    }     /* end for */
+
+    SBN_Status = SBN_SendNetMsg(SBN_SUB_MSG, Pack.BufUsed, Buf, Peer);
+    if (SBN_Status != SBN_SUCCESS || RangeCnt == 0)
+    {
+        return SBN_Status;
+    } /* end if */
+
+    Pack_Init(&Pack, &Buf, sizeof(Buf), 0);
+    Pack_Data(&Pack, (void *)SBN_IDENT, SBN_IDENT_LEN);
+    Pack_UInt16(&Pack, RangeCnt);
+
+    for (i = 0; i < SBN.SubCnt; i = End)
+    {
+        End = LocalSubRunEnd(Order, i);
+
+        if (End - i > 1)
+        {
+            Pack_MsgID(&Pack, SBN.Subs[Order[i]].MsgID);
+            Pack_MsgID(&Pack, SBN.Subs[Order[End - 1]].MsgID);
+            Pack_Data(&Pack, &SBN.Subs[Order[i]].QoS, sizeof(SBN.Subs[Order[i]].QoS));
+        } /* end if */
+    }     /* end for */
+
+    return SBN_SendNetMsg(SBN_SUBRANGE_MSG, Pack.BufUsed, Buf, Peer);
+} /* end SendAppSubsToPeer() */
+
+#ifdef SBN_BRIDGE
+/**
+ * \brief Sends a range of message ID's a bridge (un)subscribes to on behalf
+ *        of peers on other nets over the wire to a peer, in ranges of at most
+ *        SBN_MAX_SUB_RANGE if the peer takes SBN_SUBRANGE_MSG.
+ *
+ * @param[in] Unsub True for an unsubscription.
+ * @param[in] MsgID The first CCSDS message ID of the range.
+ * @param[in] LastMsgID The last CCSDS message ID of the range.
+ * @param[in] QoS The CCSDS quality of service.
+ * @param[in] Peer The peer interface.
+ */
+static SBN_Status_t SendSubRangeToPeer(bool Unsub, CFE_SB_MsgId_t MsgID, CFE_SB_MsgId_t LastMsgID, CFE_SB_Qos_t QoS,
+                                       SBN_PeerInterface_t *Peer)
+{
+    uint8        Buf[SBN_PACKED_SUBRANGE_SZ];
+    SBN_Status_t SBN_Status = SBN_SUCCESS;
+    uint32       First = 0, Last = 0, Sub = 0;
+    Pack_t       Pack;
+
+    for (First = MsgID; First <= LastMsgID; First = Last + 1)
+    {
+        Last = First + SBN_MAX_SUB_RANGE - 1 < LastMsgID ? First + SBN_MAX_SUB_RANGE - 1 : LastMsgID;
+
+        Pack_Init(&Pack, &Buf, sizeof(Buf), 0);
+        Pack_Data(&Pack, (void *)SBN_IDENT, SBN_IDENT_LEN);
+
+        if (Last > First && (Peer->Features & SBN_FEAT_SUBRANGE))
+        {
+            Pack_UInt16(&Pack, 1);
+            Pack_MsgID(&Pack, (CFE_SB_MsgId_t)First);
+            Pack_MsgID(&Pack, (CFE_SB_MsgId_t)Last);
+            Pack_Data(&Pack, &QoS, sizeof(QoS));
+
+            SBN_Status = SBN_SendNetMsg(Unsub ? SBN_UNSUBRANGE_MSG : SBN_SUBRANGE_MSG, Pack.BufUsed, Buf, Peer);
+        }
+        else
+        {
+            Pack_UInt16(&Pack, (uint16)(Last - First + 1));
+
+            for (Sub = First; Sub <= Last; Sub++)
+            {
+                Pack_MsgID(&Pack, (CFE_SB_MsgId_t)Sub);
+                Pack_Data(&Pack, &QoS, sizeof(QoS));
+            } /* end for */
+
+            SBN_Status = SBN_SendNetMsg(Unsub ? SBN_UNSUB_MSG : SBN_SUB_MSG, Pack.BufUsed, Buf, Peer);
+        } /* end if */
+
+        if (SBN_Status != SBN_SUCCESS)
+        {
+            return SBN_Status;
+        } /* end if */
+    }     /* end for */
+
+    return SBN_SUCCESS;
+} /* end SendSubRangeToPeer() */
+
+/**
+ * \brief Sends a peer the subscriptions of the peers on the other nets, which
+ *        a bridge subscribes to on their behalf.
+ *
+ * @param[in] Peer The peer interface.
+ */
+static SBN_Status_t SendBridgedSubsToPeer(SBN_PeerInterface_t *Peer)
+{
+    SBN_PeerInterface_t *Other      = NULL;
+    SBN_Status_t         SBN_Status = SBN_SUCCESS;
+    int                  PeerIdx = 0, SubIdx = 0;
+
+    for (PeerIdx = 0; PeerIdx < SBN.PeerSlots; PeerIdx++)
+    {
+        Other = SBN.Peers[PeerIdx];
+
+        if (Other == NULL || Other->Net == Peer->Net)
+        {
+            continue;
+        } /* end if */
+
+        for (SubIdx = 0; SubIdx < Other->SubCnt; SubIdx++)
+        {
+            SBN_Status = SendSubRangeToPeer(false, Other->Subs[SubIdx].MsgID, Other->Subs[SubIdx].LastMsgID,
+                                            Other->Subs[SubIdx].QoS, Peer);
+            if (SBN_Status != SBN_SUCCESS)
+            {
+                return SBN_Status;
+            } /* end if */
+        }     /* end for */
+    }         /* end for */
 
-    return SBN_SendNetMsg(SBN_SUB_MSG, Pack.BufUsed, Buf, Peer);
+    return SBN_SUCCESS;
+} /* end SendBridgedSubsToPeer() */
+#endif /* SBN_BRIDGE */
+
+/**
+ * \brief Sends all the subscriptions of this CPU over the wire to a peer:
+ *        those of local apps and, for a bridge, those of the peers on the
+ *        other nets.
+ *
+ * @param[in] Peer The peer interface.
+ */
+SBN_Status_t SBN_SendLocalSubsToPeer(SBN_PeerInterface_t *Peer)
+{
+    SBN_Status_t SBN_Status = SendAppSubsToPeer(Peer);
+
+#ifdef SBN_BRIDGE
+    if (SBN_Status == SBN_SUCCESS)
+    {
+        SBN_Status = SendBridgedSubsToPeer(Peer);
+    } /* end if */
+#endif /* SBN_BRIDGE */
+
+    return SBN_Status;
 } /* end SBN_SendLocalSubsToPeer */
 
 /**
@@ -133,31 +362,192 @@ static int IsMsgIDSub(int *IdxPtr, CFE_SB_MsgId_t MsgID)
 } /* end IsMsgIDSub */
 
 /**
- * \brief Is this peer subscribed to this message ID? If so, what is the index
- *        of the subscription?
+ * \brief Where does this message ID fall in the peer's subscriptions? The
+ *        peer's table holds ranges of message ID's that do not overlap, in
+ *        order, so this is a binary search.
  *
- * @param[out] SubIdxPtr The pointer to the subscription index value.
+ * @param[in] Peer The peer interface.
  * @param[in] MsgID The CCSDS message ID of the subscription being sought.
+ *
+ * @return The index of the first subscription whose range ends at or after
+ *         MsgID (Peer->SubCnt if there is none), the peer is subscribed to
+ *         MsgID if that range also starts at or before it.
+ */
+static int PeerSubIdx(SBN_PeerInterface_t *Peer, CFE_SB_MsgId_t MsgID)
+{
+    int Low = 0, High = Peer->SubCnt, Mid = 0;
+
+    while (Low < High)
+    {
+        Mid = (Low + High) / 2;
+
+        if (Peer->Subs[Mid].LastMsgID < MsgID)
+        {
+            Low = Mid + 1;
+        }
+        else
+        {
+            High = Mid;
+        } /* end if */
+    }     /* end while */
+
+    return Low;
+} /* end PeerSubIdx() */
+
+/**
+ * \brief Is the peer subscribed to a message ID?
+ *
  * @param[in] Peer The peer interface.
+ * @param[in] MsgID The CCSDS message ID.
  *
- * @return true if found.
+ * @return true if one of the peer's subscriptions covers MsgID.
  */
-static int IsPeerSubMsgID(int *SubIdxPtr, CFE_SB_MsgId_t MsgID, SBN_PeerInterface_t *Peer)
+bool SBN_PeerSubscribed(SBN_PeerInterface_t *Peer, CFE_SB_MsgId_t MsgID)
 {
-    int i = 0;
+    int SubIdx = PeerSubIdx(Peer, MsgID);
 
-    for (i = 0; i < Peer->SubCnt; i++)
+    return SubIdx < Peer->SubCnt && Peer->Subs[SubIdx].MsgID <= MsgID;
+} /* end SBN_PeerSubscribed() */
+
+#ifdef SBN_BRIDGE
+/**
+ * \brief Is a peer on a net other than this one subscribed to a message ID?
+ *        A bridge subscribes to those message ID's on the net, as well as to
+ *        the ones local apps subscribe to.
+ *
+ * @param[in] Net The net.
+ * @param[in] MsgID The CCSDS message ID.
+ * @param[in] Except A peer whose subscriptions do not count, or NULL.
+ *
+ * @return true if such a peer is subscribed.
+ */
+static bool BridgedSub(SBN_NetInterface_t *Net, CFE_SB_MsgId_t MsgID, SBN_PeerInterface_t *Except)
+{
+    SBN_PeerInterface_t *Peer    = NULL;
+    int                  PeerIdx = 0;
+
+    for (PeerIdx = 0; PeerIdx < SBN.PeerSlots; PeerIdx++)
     {
-        if (Peer->Subs[i].MsgID == MsgID)
+        Peer = SBN.Peers[PeerIdx];
+
+        if (Peer != NULL && Peer != Except && Peer->Net != Net && SBN_PeerSubscribed(Peer, MsgID))
         {
-            *SubIdxPtr = i;
             return true;
         } /* end if */
     }     /* end for */
 
     return false;
+} /* end BridgedSub() */
+
+/**
+ * \brief Does a change to a peer's subscription to a message ID start, or
+ *        stop, a bridge wanting it on a net?
+ *
+ * @param[in] Net The net.
+ * @param[in] Peer The peer whose subscriptions change, not on Net.
+ * @param[in] MsgID The CCSDS message ID.
+ * @param[in] Unsub True if the peer is unsubscribing.
+ *
+ * @return true if the bridge should (un)subscribe to MsgID on Net.
+ */
+static bool BridgeChanges(SBN_NetInterface_t *Net, SBN_PeerInterface_t *Peer, CFE_SB_MsgId_t MsgID, bool Unsub)
+{
+    if (IsMsgIDSub(NULL, MsgID))
+    {
+        /* local apps subscribe to it on every net */
+        return false;
+    } /* end if */
+
+    if (Unsub)
+    {
+        return SBN_PeerSubscribed(Peer, MsgID) && !BridgedSub(Net, MsgID, Peer);
+    } /* end if */
+
+    return !BridgedSub(Net, MsgID, NULL);
+} /* end BridgeChanges() */
+
+/**
+ * \brief Passes a change to a peer's subscriptions on to the connected peers
+ *        on the other nets, for the message ID's of the range it changes for
+ *        each net. Called before the peer's table is changed.
+ *
+ * @param[in] Peer The peer interface.
+ * @param[in] MsgID The first CCSDS message ID of the range.
+ * @param[in] LastMsgID The last CCSDS message ID of the range.
+ * @param[in] QoS The subscription quality of service.
+ * @param[in] Unsub True if the peer is unsubscribing.
+ */
+static void BridgeSubs(SBN_PeerInterface_t *Peer, CFE_SB_MsgId_t MsgID, CFE_SB_MsgId_t LastMsgID, CFE_SB_Qos_t QoS,
+                       bool Unsub)
+{
+    SBN_NetInterface_t *Net = NULL;
+    int                 NetIdx = 0, PeerIdx = 0;
+    uint32              First = 0, Last = 0;
+
+    for (NetIdx = 0; NetIdx < SBN.NetCnt; NetIdx++)
+    {
+        Net = &SBN.Nets[NetIdx];
+
+        if (Net == Peer->Net)
+        {
+            continue;
+        } /* end if */
+
+        for (First = MsgID; First <= LastMsgID; First = Last + 1)
+        {
+            Last = First;
+
+            if (!BridgeChanges(Net, Peer, (CFE_SB_MsgId_t)First, Unsub))
+            {
+                continue;
+            } /* end if */
+
+            while (Last < LastMsgID && BridgeChanges(Net, Peer, (CFE_SB_MsgId_t)(Last + 1), Unsub))
+            {
+                Last++;
+            } /* end while */
+
+            for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
+            {
+                if (!Net->Peers[PeerIdx].Unused && Net->Peers[PeerIdx].Connected)
+                {
+                    /* ignore errors, the other peers should still hear of it */
+                    SendSubRangeToPeer(Unsub, (CFE_SB_MsgId_t)First, (CFE_SB_MsgId_t)Last, QoS, &Net->Peers[PeerIdx]);
+                } /* end if */
+            }     /* end for */
+        }         /* end for */
+    }             /* end for */
+} /* end BridgeSubs() */
+#endif /* SBN_BRIDGE */
+
+/**
+ * \brief Has this CPU subscribed to a message ID on a net? Called from the
+ *        receive side, by modules whose peers share a medium.
+ *
+ * @param[in] Net The net.
+ * @param[in] MsgID The CCSDS message ID.
+ *
+ * @return true if local apps are subscribed to MsgID or, for a bridge, peers
+ *         on the other nets are.
+ */
+bool SBN_Subscribed(SBN_NetInterface_t *Net, CFE_SB_MsgId_t MsgID)
+{
+    if (MsgID > CFE_PLATFORM_SB_HIGHEST_VALID_MSGID)
+    {
+        return false;
+    } /* end if */
+
+    if (SBN.SubMap[MsgID / 8] & (1 << (MsgID % 8)))
+    {
+        return true;
+    } /* end if */
 
-} /* end IsPeerSubMsgID */
+#ifdef SBN_BRIDGE
+    return BridgedSub(Net, MsgID, NULL);
+#else  /* !SBN_BRIDGE */
+    return false;
+#endif /* SBN_BRIDGE */
+} /* end SBN_Subscribed() */
 
 /**
  * \brief I have seen a local subscription, send it on to peers if this is the
@@ -200,6 +590,11 @@ static SBN_Status_t ProcessLocalSub(CFE_SB_MsgId_t MsgID, CFE_SB_Qos_t QoS)
     SBN.Subs[SBN.SubCnt].QoS      = QoS;
     SBN.SubCnt++;
 
+    if (MsgID <= CFE_PLATFORM_SB_HIGHEST_VALID_MSGID)
+    {
+        SBN.SubMap[MsgID / 8] |= (uint8)(1 << (MsgID % 8));
+    } /* end if */
+
     int NetIdx = 0, PeerIdx = 0;
     for (NetIdx = 0; NetIdx < SBN.NetCnt; NetIdx++)
     {
@@ -208,6 +603,19 @@ static SBN_Status_t ProcessLocalSub(CFE_SB_MsgId_t MsgID, CFE_SB_Qos_t QoS)
         {
             SBN_PeerInterface_t *Peer = &Net->Peers[PeerIdx];
 
+            if (Peer->Unused)
+            {
+                continue;
+            } /* end if */
+
+#ifdef SBN_BRIDGE
+            if (BridgedSub(Net, MsgID, NULL))
+            {
+                /* already subscribed to on this net for a peer on another */
+                continue;
+            } /* end if */
+#endif /* SBN_BRIDGE */
+
             SBN_Status = SendLocalSubToPeer(SBN_SUB_MSG, MsgID, QoS, Peer);
 
             if (SBN_Status != SBN_SUCCESS)
@@ -231,6 +639,7 @@ static SBN_Status_t ProcessLocalUnsub(CFE_SB_MsgId_t MsgID)
 {
     SBN_Status_t SBN_Status = SBN_SUCCESS;
     int          SubIdx;
+    CFE_SB_Qos_t QoS;
 
     /* find idx of matching subscription */
     if (!IsMsgIDSub(&SubIdx, MsgID))
@@ -248,6 +657,13 @@ static SBN_Status_t ProcessLocalUnsub(CFE_SB_MsgId_t MsgID)
         return SBN_SUCCESS;
     } /* end if */
 
+    QoS = SBN.Subs[SubIdx].QoS;
+
+    if (MsgID <= CFE_PLATFORM_SB_HIGHEST_VALID_MSGID)
+    {
+        SBN.SubMap[MsgID / 8] &= (uint8)~(1 << (MsgID % 8));
+    } /* end if */
+
     /* remove sub from array for and
     ** shift all subscriptions in higher elements to fill the gap
     ** note that the Subs[] array has one extra element to allow for an
@@ -270,7 +686,20 @@ static SBN_Status_t ProcessLocalUnsub(CFE_SB_MsgId_t MsgID)
         {
             SBN_PeerInterface_t *Peer = &Net->Peers[PeerIdx];
 
-            SBN_Status = SendLocalSubToPeer(SBN_UNSUB_MSG, SBN.Subs[PeerIdx].MsgID, SBN.Subs[PeerIdx].QoS, Peer);
+            if (Peer->Unused)
+            {
+                continue;
+            } /* end if */
+
+#ifdef SBN_BRIDGE
+            if (BridgedSub(Net, MsgID, NULL))
+            {
+                /* still subscribed to on this net for a peer on another */
+                continue;
+            } /* end if */
+#endif /* SBN_BRIDGE */
+
+            SBN_Status = SendLocalSubToPeer(SBN_UNSUB_MSG, MsgID, QoS, Peer);
 
             if (SBN_Status != SBN_SUCCESS)
             {
@@ -337,151 +766,558 @@ SBN_Status_t SBN_CheckSubscriptionPipe(void)
     return SBN_ERROR;
 } /* end SBN_CheckSubscriptionPipe */
 
+#ifdef SBN_SHARED_PIPE
 /**
- * \brief Record keep the subscription locally so that when we no longer have any peers subscribed
- *        to this MID, I unsubscribe from the MID.
+ * \brief The bit representing this peer in an SBN_SharedSub_t PeerMask.
+ *
+ * @param[in] Peer The peer interface.
+ *
+ * @return The bit index.
+ */
+static int SharedPeerBit(SBN_PeerInterface_t *Peer)
+{
+    return (int)Peer->Slot;
+} /* end SharedPeerBit() */
+
+/**
+ * \brief Add the peer to the set of peers wanting this message ID from the
+ *        shared pipe, subscribing the shared pipe if this is the first one.
  *
  * @param[in] Peer The peer interface.
- * @param[in] MsgID The subscription SBN message ID.
+ * @param[in] MsgID The CCSDS message ID.
  * @param[in] QoS The subscription quality of service.
  *
- * @return SBN_SUCCESS on successfully adding the sub to my records, otherwise SBN_ERROR
+ * @return SBN_SUCCESS on success, otherwise SBN_ERROR.
  */
-static SBN_Status_t AddSub(SBN_PeerInterface_t *Peer, CFE_SB_MsgId_t MsgID, CFE_SB_Qos_t QoS)
+static SBN_Status_t SharedSubAdd(SBN_PeerInterface_t *Peer, CFE_SB_MsgId_t MsgID, CFE_SB_Qos_t QoS)
 {
-    int          idx        = 0;
-    CFE_Status_t CFE_Status = SBN_SUCCESS;
+    int              PeerBit    = SharedPeerBit(Peer);
+    SBN_SharedSub_t *Sub        = NULL;
+    CFE_Status_t     CFE_Status = CFE_SUCCESS;
 
-    /* if msg id already in the list, ignore */
-    if (IsPeerSubMsgID(&idx, MsgID, Peer))
+    if (MsgID > CFE_PLATFORM_SB_HIGHEST_VALID_MSGID)
     {
-        return SBN_SUCCESS;
+        EVSSendErr(SBN_SUB_EID, "invalid MID 0x%04X for shared pipe", MsgID);
+        return SBN_ERROR;
     } /* end if */
 
-    if (Peer->SubCnt >= SBN_MAX_SUBS_PER_PEER)
+    if (!SBN.SharedSubIdx[MsgID])
     {
-        EVSSendErr(SBN_SUB_EID, "cannot process subscription from ProcessorID %d, max (%d) met", Peer->ProcessorID,
-                   SBN_MAX_SUBS_PER_PEER);
-        return SBN_ERROR;
+        if (SBN.SharedSubCnt >= SBN_MAX_SHARED_SUBS)
+        {
+            EVSSendErr(SBN_SUB_EID, "shared pipe subscription ignored for MID 0x%04X, max (%d) met", MsgID,
+                       SBN_MAX_SHARED_SUBS);
+            return SBN_ERROR;
+        } /* end if */
+
+        /* SubscribeLocal suppresses the subscription report */
+        if (SBN_IS_HI_QOS(QoS))
+        {
+            CFE_Status = CFE_SB_SubscribeLocal(MsgID, SBN.SharedHiPipe, SBN_HI_MSG_LIM);
+        }
+        else
+        {
+            CFE_Status = CFE_SB_SubscribeLocal(MsgID, SBN.SharedPipe, SBN_DEFAULT_MSG_LIM);
+        } /* end if */
+
+        if (CFE_Status != CFE_SUCCESS)
+        {
+            return SBN_ERROR;
+        } /* end if */
+
+        Sub = &SBN.SharedSubs[SBN.SharedSubCnt];
+        memset(Sub, 0, sizeof(*Sub));
+        Sub->MsgID    = MsgID;
+        Sub->HiLane   = SBN_IS_HI_QOS(QoS);
+        Sub->PeerMask = &SBN.SharedMasks[SBN.SharedSubCnt++ * SBN.PeerMaskWords];
+        memset(Sub->PeerMask, 0, SBN.PeerMaskWords * sizeof(*Sub->PeerMask));
+
+        SBN.SharedSubIdx[MsgID] = SBN.SharedSubCnt;
     } /* end if */
 
-    /* SubscribeLocal suppresses the subscription report */
-    CFE_Status = CFE_SB_SubscribeLocal(MsgID, Peer->Pipe, SBN_DEFAULT_MSG_LIM);
-    if (CFE_Status != CFE_SUCCESS)
+    Sub = &SBN.SharedSubs[SBN.SharedSubIdx[MsgID] - 1];
+
+    if (SBN_IS_HI_QOS(QoS) && !Sub->HiLane)
     {
-        EVSSendErr(SBN_SUB_EID, "unable to subscribe to MID 0x%04X", MsgID);
-        return SBN_ERROR;
-    } /* end if */
+        /* a peer wants this MID at high priority, promote it for everyone */
+        if (CFE_SB_SubscribeLocal(MsgID, SBN.SharedHiPipe, SBN_HI_MSG_LIM) != CFE_SUCCESS)
+        {
+            return SBN_ERROR;
+        } /* end if */
 
-    /* log the subscription in the peer table */
-    Peer->Subs[Peer->SubCnt].MsgID = MsgID;
-    Peer->Subs[Peer->SubCnt].QoS   = QoS;
+        CFE_SB_UnsubscribeLocal(MsgID, SBN.SharedPipe); /* ignore returned errors */
+        Sub->HiLane = true;
+    } /* end if */
 
-    Peer->SubCnt++;
+    if (!(Sub->PeerMask[PeerBit / 32] & (1U << (PeerBit % 32))))
+    {
+        Sub->PeerMask[PeerBit / 32] |= (1U << (PeerBit % 32));
+        Sub->PeerCnt++;
+    } /* end if */
 
     return SBN_SUCCESS;
-} /* end AddSub */
+} /* end SharedSubAdd() */
 
 /**
- * \brief Process a subscription from a peer.
+ * \brief Remove the peer from the set of peers wanting this message ID from
+ *        the shared pipe, unsubscribing the shared pipe if this was the last.
  *
  * @param[in] Peer The peer interface.
- * @param[in] MsgID The subscription SBN message ID.
+ * @param[in] MsgID The CCSDS message ID.
+ *
+ * @return SBN_SUCCESS on success, otherwise SBN_ERROR.
+ */
+static SBN_Status_t SharedSubDel(SBN_PeerInterface_t *Peer, CFE_SB_MsgId_t MsgID)
+{
+    int              PeerBit = SharedPeerBit(Peer);
+    int              SubIdx  = 0;
+    SBN_SharedSub_t *Sub     = NULL;
+    CFE_SB_PipeId_t  Pipe    = SBN.SharedPipe;
+
+    if (MsgID > CFE_PLATFORM_SB_HIGHEST_VALID_MSGID || !SBN.SharedSubIdx[MsgID])
+    {
+        return SBN_SUCCESS;
+    } /* end if */
+
+    SubIdx = SBN.SharedSubIdx[MsgID] - 1;
+    Sub    = &SBN.SharedSubs[SubIdx];
+
+    if (!(Sub->PeerMask[PeerBit / 32] & (1U << (PeerBit % 32))))
+    {
+        return SBN_SUCCESS;
+    } /* end if */
+
+    Sub->PeerMask[PeerBit / 32] &= ~(1U << (PeerBit % 32));
+    Sub->PeerCnt--;
+
+    if (Sub->PeerCnt > 0)
+    {
+        return SBN_SUCCESS;
+    } /* end if */
+
+    if (Sub->HiLane)
+    {
+        Pipe = SBN.SharedHiPipe;
+    } /* end if */
+
+    /* last peer for this MID, fill the gap with the last entry */
+    SBN.SharedSubIdx[MsgID] = 0;
+    SBN.SharedSubCnt--;
+
+    if (SubIdx != SBN.SharedSubCnt)
+    {
+        /* the mask stays with the entry's index, only its bits move */
+        uint32 *PeerMask = Sub->PeerMask;
+
+        memcpy(Sub, &SBN.SharedSubs[SBN.SharedSubCnt], sizeof(*Sub));
+        memcpy(PeerMask, Sub->PeerMask, SBN.PeerMaskWords * sizeof(*PeerMask));
+        Sub->PeerMask                = PeerMask;
+        SBN.SharedSubIdx[Sub->MsgID] = SubIdx + 1;
+    } /* end if */
+
+    if (CFE_SB_UnsubscribeLocal(MsgID, Pipe) != CFE_SUCCESS)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    return SBN_SUCCESS;
+} /* end SharedSubDel() */
+#endif /* SBN_SHARED_PIPE */
+
+/**
+ * \brief Subscribe the pipe feeding this peer to a message ID, high priority
+ *        subscriptions go on the peer's high priority pipe and conflated
+ *        message ID's on its ConflatePipe.
+ *
+ * @param[in] Peer The peer interface.
+ * @param[in] MsgID The CCSDS message ID.
  * @param[in] QoS The subscription quality of service.
  *
- * @return SBN_SUCCESS on successfully handling subscription from peer, otherwise SBN_ERROR
+ * @return SBN_SUCCESS on success, otherwise SBN_ERROR.
  */
-static SBN_Status_t ProcessSubFromPeer(SBN_PeerInterface_t *Peer, CFE_SB_MsgId_t MsgID, CFE_SB_Qos_t QoS)
+static SBN_Status_t SubscribePeerPipe(SBN_PeerInterface_t *Peer, CFE_SB_MsgId_t MsgID, CFE_SB_Qos_t QoS)
 {
-    SBN_ModuleIdx_t  FilterIdx;
-    SBN_Filter_Ctx_t Filter_Context;
-    SBN_Status_t     SBN_Status;
+    CFE_Status_t CFE_Status = CFE_SUCCESS;
 
-    Filter_Context.MyProcessorID   = CFE_PSP_GetProcessorId();
-    Filter_Context.MySpacecraftID  = CFE_PSP_GetSpacecraftId();
-    Filter_Context.PeerProcessorID = Peer->ProcessorID;
-    Filter_Context.MySpacecraftID  = Peer->SpacecraftID;
+#ifdef SBN_SHARED_PIPE
+    if (SBN_USES_SHARED_PIPE(Peer))
+    {
+        return SharedSubAdd(Peer, MsgID, QoS);
+    } /* end if */
+#endif /* SBN_SHARED_PIPE */
 
-    for (FilterIdx = 0; FilterIdx < Peer->FilterCnt; FilterIdx++)
+    /* SubscribeLocal suppresses the subscription report */
+    if (SBN_Conflated(Peer, MsgID))
     {
-        if (Peer->Filters[FilterIdx]->RemapMID == NULL)
+        CFE_Status = CFE_SB_SubscribeLocal(MsgID, Peer->ConflatePipe, SBN_DEFAULT_MSG_LIM);
+    }
+    else if (SBN_IS_HI_QOS(QoS))
+    {
+        CFE_Status = CFE_SB_SubscribeLocal(MsgID, Peer->HiPipe, SBN_HI_MSG_LIM);
+    }
+    else
+    {
+        CFE_Status = CFE_SB_SubscribeLocal(MsgID, Peer->Pipe, SBN_DEFAULT_MSG_LIM);
+    } /* end if */
+
+    if (CFE_Status != CFE_SUCCESS)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    return SBN_SUCCESS;
+} /* end SubscribePeerPipe() */
+
+/**
+ * \brief Unsubscribe the pipe feeding this peer from a message ID.
+ *
+ * @param[in] Peer The peer interface.
+ * @param[in] MsgID The CCSDS message ID.
+ * @param[in] QoS The quality of service the message ID was subscribed with.
+ *
+ * @return SBN_SUCCESS on success, otherwise SBN_ERROR.
+ */
+static SBN_Status_t UnsubscribePeerPipe(SBN_PeerInterface_t *Peer, CFE_SB_MsgId_t MsgID, CFE_SB_Qos_t QoS)
+{
+    CFE_SB_PipeId_t Pipe = 0;
+
+#ifdef SBN_SHARED_PIPE
+    if (SBN_USES_SHARED_PIPE(Peer))
+    {
+        return SharedSubDel(Peer, MsgID);
+    } /* end if */
+#endif /* SBN_SHARED_PIPE */
+
+    if (SBN_Conflated(Peer, MsgID))
+    {
+        Pipe = Peer->ConflatePipe;
+    }
+    else
+    {
+        Pipe = SBN_IS_HI_QOS(QoS) ? Peer->HiPipe : Peer->Pipe;
+    } /* end if */
+
+    if (CFE_SB_UnsubscribeLocal(MsgID, Pipe) != CFE_SUCCESS)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    return SBN_SUCCESS;
+} /* end UnsubscribePeerPipe() */
+
+/**
+ * \brief Subscribe the pipe feeding this peer to each message ID in a range,
+ *        or to none of them.
+ *
+ * @param[in] Peer The peer interface.
+ * @param[in] MsgID The first CCSDS message ID of the range.
+ * @param[in] LastMsgID The last CCSDS message ID of the range.
+ * @param[in] QoS The subscription quality of service.
+ *
+ * @return SBN_SUCCESS on success, otherwise SBN_ERROR.
+ */
+static SBN_Status_t SubscribeRange(SBN_PeerInterface_t *Peer, CFE_SB_MsgId_t MsgID, CFE_SB_MsgId_t LastMsgID,
+                                   CFE_SB_Qos_t QoS)
+{
+    uint32 Sub = 0, Unsub = 0;
+
+    for (Sub = MsgID; Sub <= LastMsgID; Sub++)
+    {
+        if (SubscribePeerPipe(Peer, (CFE_SB_MsgId_t)Sub, QoS) != SBN_SUCCESS)
         {
-            continue;
+            EVSSendErr(SBN_SUB_EID, "unable to subscribe to MID 0x%04X", (unsigned int)Sub);
+
+            for (Unsub = MsgID; Unsub < Sub; Unsub++)
+            {
+                UnsubscribePeerPipe(Peer, (CFE_SB_MsgId_t)Unsub, QoS); /* ignore returned errors */
+            }                                                         /* end for */
+
+            return SBN_ERROR;
         } /* end if */
+    }     /* end for */
 
-        SBN_Status = (Peer->Filters[FilterIdx]->RemapMID)(&MsgID, &Filter_Context);
+    return SBN_SUCCESS;
+} /* end SubscribeRange() */
 
-        if (SBN_Status != SBN_SUCCESS)
+/**
+ * \brief Unsubscribe the pipe feeding this peer from each message ID in a range.
+ *
+ * @param[in] Peer The peer interface.
+ * @param[in] MsgID The first CCSDS message ID of the range.
+ * @param[in] LastMsgID The last CCSDS message ID of the range.
+ * @param[in] QoS The quality of service the range was subscribed with.
+ *
+ * @return SBN_SUCCESS if all were unsubscribed, otherwise SBN_ERROR.
+ */
+static SBN_Status_t UnsubscribeRange(SBN_PeerInterface_t *Peer, CFE_SB_MsgId_t MsgID, CFE_SB_MsgId_t LastMsgID,
+                                     CFE_SB_Qos_t QoS)
+{
+    SBN_Status_t SBN_Status = SBN_SUCCESS;
+    uint32       Unsub      = 0;
+
+    for (Unsub = MsgID; Unsub <= LastMsgID; Unsub++)
+    {
+        if (UnsubscribePeerPipe(Peer, (CFE_SB_MsgId_t)Unsub, QoS) != SBN_SUCCESS)
         {
-            return SBN_Status;
+            EVSSendErr(SBN_SUB_EID, "unable to unsubscribe from MID 0x%04X", (unsigned int)Unsub);
+            SBN_Status = SBN_ERROR;
         } /* end if */
     }     /* end for */
 
-    return AddSub(Peer, MsgID, QoS);
-} /* ProcessSubFromPeer */
+    return SBN_Status;
+} /* end UnsubscribeRange() */
 
 /**
- * \brief Process a subscription message from a peer.
+ * \brief Remove a subscription from a peer's table, keeping it in order.
  *
- * @param[in] PeerIdx The peer index (in SBN.Peer)
- * @param[in] Msg The subscription SBN message.
+ * @param[in] Peer The peer interface.
+ * @param[in] SubIdx The index of the subscription.
+ */
+static void RemovePeerSub(SBN_PeerInterface_t *Peer, int SubIdx)
+{
+    memmove(&Peer->Subs[SubIdx], &Peer->Subs[SubIdx + 1], (Peer->SubCnt - SubIdx - 1) * sizeof(SBN_Subs_t));
+    Peer->SubCnt--;
+} /* end RemovePeerSub() */
+
+/**
+ * \brief Subscribe the peer to a range of message ID's it has no subscription
+ *        to, extending the ranges on either side if they have the same QoS.
  *
- * @return SBN_SUCCESS on successfully handling all subscriptions from peer, otherwise SBN_ERROR
+ * @param[in] Peer The peer interface.
+ * @param[in] SubIdx Where the range goes in the peer's table (see PeerSubIdx().)
+ * @param[in] MsgID The first CCSDS message ID of the range.
+ * @param[in] LastMsgID The last CCSDS message ID of the range.
+ * @param[in] QoS The subscription quality of service.
+ *
+ * @return SBN_SUCCESS on success, otherwise SBN_ERROR.
  */
-SBN_Status_t SBN_ProcessSubsFromPeer(SBN_PeerInterface_t *Peer, void *Msg)
+static SBN_Status_t AddSubGap(SBN_PeerInterface_t *Peer, int SubIdx, CFE_SB_MsgId_t MsgID, CFE_SB_MsgId_t LastMsgID,
+                              CFE_SB_Qos_t QoS)
 {
-    SBN_Status_t SBN_Status = SBN_SUCCESS;
-    Pack_t       Pack;
-    char         VersionHash[SBN_IDENT_LEN];
+    SBN_Subs_t *Prev = NULL, *Next = NULL;
 
-    Pack_Init(&Pack, Msg, CFE_MISSION_SB_MAX_SB_MSG_SIZE, false);
+    if (SubIdx > 0 && Peer->Subs[SubIdx - 1].LastMsgID + 1 == MsgID &&
+        SBN_SAME_QOS(Peer->Subs[SubIdx - 1].QoS, QoS))
+    {
+        Prev = &Peer->Subs[SubIdx - 1];
+    } /* end if */
 
-    Unpack_Data(&Pack, VersionHash, SBN_IDENT_LEN);
+    if (SubIdx < Peer->SubCnt && Peer->Subs[SubIdx].MsgID == LastMsgID + 1 && SBN_SAME_QOS(Peer->Subs[SubIdx].QoS, QoS))
+    {
+        Next = &Peer->Subs[SubIdx];
+    } /* end if */
 
-    if (strncmp(VersionHash, SBN_IDENT, SBN_IDENT_LEN))
+    if (Prev == NULL && Next == NULL && Peer->SubCnt >= Peer->MaxSubs)
     {
-        EVSSendErr(SBN_PROTO_EID, "version number mismatch with peer CpuID %d", Peer->ProcessorID);
+        EVSSendErr(SBN_SUB_EID, "cannot process subscription from ProcessorID %d, max (%d) met", Peer->ProcessorID,
+                   Peer->MaxSubs);
         return SBN_ERROR;
+    } /* end if */
+
+    if (SubscribeRange(Peer, MsgID, LastMsgID, QoS) != SBN_SUCCESS)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    if (Prev != NULL && Next != NULL)
+    {
+        /* the gap joined two ranges */
+        Prev->LastMsgID = Next->LastMsgID;
+        RemovePeerSub(Peer, SubIdx);
+    }
+    else if (Prev != NULL)
+    {
+        Prev->LastMsgID = LastMsgID;
+    }
+    else if (Next != NULL)
+    {
+        Next->MsgID = MsgID;
     }
+    else
+    {
+        /* log the subscription in the peer table */
+        memmove(&Peer->Subs[SubIdx + 1], &Peer->Subs[SubIdx], (Peer->SubCnt - SubIdx) * sizeof(SBN_Subs_t));
 
-    uint16 SubCnt;
-    Unpack_UInt16(&Pack, &SubCnt);
+        memset(&Peer->Subs[SubIdx], 0, sizeof(SBN_Subs_t));
+        Peer->Subs[SubIdx].MsgID     = MsgID;
+        Peer->Subs[SubIdx].LastMsgID = LastMsgID;
+        Peer->Subs[SubIdx].QoS       = QoS;
 
-    int SubIdx = 0;
-    for (SubIdx = 0; SubIdx < SubCnt; SubIdx++)
+        Peer->SubCnt++;
+    } /* end if */
+
+    return SBN_SUCCESS;
+} /* end AddSubGap() */
+
+/**
+ * \brief Record keep the subscription locally so that when we no longer have any peers subscribed
+ *        to this MID, I unsubscribe from the MID. Message ID's in the range the peer is already
+ *        subscribed to keep the QoS they were subscribed with.
+ *
+ * @param[in] Peer The peer interface.
+ * @param[in] MsgID The first subscription SBN message ID.
+ * @param[in] LastMsgID The last subscription SBN message ID (MsgID for a single one.)
+ * @param[in] QoS The subscription quality of service.
+ *
+ * @return SBN_SUCCESS on successfully adding the sub to my records, otherwise SBN_ERROR
+ */
+static SBN_Status_t AddSub(SBN_PeerInterface_t *Peer, CFE_SB_MsgId_t MsgID, CFE_SB_MsgId_t LastMsgID,
+                           CFE_SB_Qos_t QoS)
+{
+    uint32 GapStart = MsgID, GapEnd = 0;
+    int    SubIdx   = 0;
+
+#ifdef SBN_BRIDGE
+    BridgeSubs(Peer, MsgID, LastMsgID, QoS, false);
+#endif /* SBN_BRIDGE */
+
+    while (GapStart <= LastMsgID)
     {
-        CFE_SB_MsgId_t MsgID;
-        Unpack_MsgID(&Pack, &MsgID);
-        CFE_SB_Qos_t QoS;
-        Unpack_Data(&Pack, &QoS, sizeof(QoS));
+        SubIdx = PeerSubIdx(Peer, (CFE_SB_MsgId_t)GapStart);
 
-        SBN_Status = ProcessSubFromPeer(Peer, MsgID, QoS);
+        if (SubIdx < Peer->SubCnt && Peer->Subs[SubIdx].MsgID <= GapStart)
+        {
+            /* already subscribed, skip to the end of that range */
+            GapStart = Peer->Subs[SubIdx].LastMsgID + 1;
+            continue;
+        } /* end if */
 
-        if (SBN_Status != SBN_SUCCESS)
+        GapEnd = LastMsgID;
+        if (SubIdx < Peer->SubCnt && Peer->Subs[SubIdx].MsgID <= LastMsgID)
         {
-            return SBN_Status;
+            GapEnd = Peer->Subs[SubIdx].MsgID - 1;
         } /* end if */
-    }     /* end for */
+
+        if (AddSubGap(Peer, SubIdx, (CFE_SB_MsgId_t)GapStart, (CFE_SB_MsgId_t)GapEnd, QoS) != SBN_SUCCESS)
+        {
+            return SBN_ERROR;
+        } /* end if */
+
+        GapStart = GapEnd + 1;
+    } /* end while */
 
     return SBN_SUCCESS;
-} /* SBN_ProcessSubsFromPeer */
+} /* end AddSub */
 
 /**
- * \brief Process an unsubscription message from a peer.
+ * \brief Remove a range of message ID's from a peer's subscriptions, trimming
+ *        or splitting the ranges it overlaps.
  *
- * @param[in] Peer The peer interface
- * @param[in] MsgID The unsubscription SBN message ID.
+ * @param[in] Peer The peer interface.
+ * @param[in] MsgID The first unsubscription SBN message ID.
+ * @param[in] LastMsgID The last unsubscription SBN message ID (MsgID for a single one.)
  *
- * @return SBN_SUCCESS on successful unsubscription from peer, otherwise SBN_ERROR
+ * @return SBN_SUCCESS if all were unsubscribed, otherwise SBN_ERROR.
  */
-static SBN_Status_t ProcessUnsubFromPeer(SBN_PeerInterface_t *Peer, CFE_SB_MsgId_t MsgID)
+static SBN_Status_t DelSub(SBN_PeerInterface_t *Peer, CFE_SB_MsgId_t MsgID, CFE_SB_MsgId_t LastMsgID)
+{
+    SBN_Status_t   SBN_Status = SBN_SUCCESS;
+    SBN_Subs_t *   Sub        = NULL;
+    CFE_SB_MsgId_t First = 0, Last = 0;
+    int            SubIdx = PeerSubIdx(Peer, MsgID);
+    bool           Found  = false;
+
+    while (SubIdx < Peer->SubCnt && Peer->Subs[SubIdx].MsgID <= LastMsgID)
+    {
+        Sub   = &Peer->Subs[SubIdx];
+        First = Sub->MsgID > MsgID ? Sub->MsgID : MsgID;
+        Last  = Sub->LastMsgID < LastMsgID ? Sub->LastMsgID : LastMsgID;
+        Found = true;
+
+#ifdef SBN_BRIDGE
+        BridgeSubs(Peer, First, Last, Sub->QoS, true);
+#endif /* SBN_BRIDGE */
+
+        /* unsubscribe to the msg id's on the peer pipe */
+        if (UnsubscribeRange(Peer, First, Last, Sub->QoS) != SBN_SUCCESS)
+        {
+            SBN_Status = SBN_ERROR;
+        } /* end if */
+
+        if (Sub->MsgID < First && Sub->LastMsgID > Last)
+        {
+            /* split the range around the unsubscription */
+            if (Peer->SubCnt >= Peer->MaxSubs)
+            {
+                EVSSendErr(SBN_SUB_EID,
+                           "cannot split subscription from ProcessorID %d, max (%d) met, dropping MIDs 0x%04X-0x%04X",
+                           Peer->ProcessorID, Peer->MaxSubs, Last + 1, Sub->LastMsgID);
+#ifdef SBN_BRIDGE
+                BridgeSubs(Peer, Last + 1, Sub->LastMsgID, Sub->QoS, true);
+#endif /* SBN_BRIDGE */
+                UnsubscribeRange(Peer, Last + 1, Sub->LastMsgID, Sub->QoS);
+            }
+            else
+            {
+                memmove(&Peer->Subs[SubIdx + 1], Sub, (Peer->SubCnt - SubIdx) * sizeof(SBN_Subs_t));
+                Peer->Subs[SubIdx + 1].MsgID = Last + 1;
+                Peer->SubCnt++;
+            } /* end if */
+
+            Sub->LastMsgID = First - 1;
+            break;
+        }
+        else if (Sub->MsgID < First)
+        {
+            Sub->LastMsgID = First - 1;
+            SubIdx++;
+        }
+        else if (Sub->LastMsgID > Last)
+        {
+            Sub->MsgID = Last + 1;
+            SubIdx++;
+        }
+        else
+        {
+            RemovePeerSub(Peer, SubIdx);
+        } /* end if */
+    }     /* end while */
+
+    if (!Found)
+    {
+        EVSSendInfo(SBN_SUB_EID, "cannot process unsubscription from ProcessorID %d, msg 0x%04X not found",
+                    Peer->ProcessorID, MsgID);
+    } /* end if */
+
+    return SBN_Status;
+} /* end DelSub() */
+
+/**
+ * \brief Does a filter for this peer remap message ID's?
+ *
+ * @param[in] Peer The peer interface.
+ *
+ * @return true if any of the peer's filters has a RemapMID.
+ */
+static bool RemapsMsgIDs(SBN_PeerInterface_t *Peer)
+{
+    SBN_ModuleIdx_t FilterIdx = 0;
+
+    for (FilterIdx = 0; FilterIdx < Peer->FilterCnt; FilterIdx++)
+    {
+        if (Peer->Filters[FilterIdx]->RemapMID != NULL)
+        {
+            return true;
+        } /* end if */
+    }     /* end for */
+
+    return false;
+} /* end RemapsMsgIDs() */
+
+/**
+ * \brief Remap a message ID (un)subscribed by a peer through the peer's filters.
+ *
+ * @param[in] Peer The peer interface.
+ * @param[in,out] MsgIDPtr The message ID to remap.
+ *
+ * @return SBN_SUCCESS, or the status of the filter that failed.
+ */
+static SBN_Status_t RemapPeerMsgID(SBN_PeerInterface_t *Peer, CFE_SB_MsgId_t *MsgIDPtr)
 {
     SBN_ModuleIdx_t  FilterIdx;
     SBN_Filter_Ctx_t Filter_Context;
     SBN_Status_t     SBN_Status;
 
-    int i = 0, idx = 0;
-
     Filter_Context.MyProcessorID   = CFE_PSP_GetProcessorId();
     Filter_Context.MySpacecraftID  = CFE_PSP_GetSpacecraftId();
     Filter_Context.PeerProcessorID = Peer->ProcessorID;
@@ -494,7 +1330,7 @@ static SBN_Status_t ProcessUnsubFromPeer(SBN_PeerInterface_t *Peer, CFE_SB_MsgId
             continue;
         } /* end if */
 
-        SBN_Status = (Peer->Filters[FilterIdx]->RemapMID)(&MsgID, &Filter_Context);
+        SBN_Status = (Peer->Filters[FilterIdx]->RemapMID)(MsgIDPtr, &Filter_Context);
 
         if (SBN_Status != SBN_SUCCESS)
         {
@@ -503,76 +1339,235 @@ static SBN_Status_t ProcessUnsubFromPeer(SBN_PeerInterface_t *Peer, CFE_SB_MsgId
         } /* end if */
     }     /* end for */
 
-    if (!IsPeerSubMsgID(&idx, MsgID, Peer))
+    return SBN_SUCCESS;
+} /* end RemapPeerMsgID() */
+
+/**
+ * \brief Is a range of message ID's from a peer one we can take?
+ *
+ * @param[in] Peer The peer interface.
+ * @param[in] MsgID The first message ID of the range.
+ * @param[in] LastMsgID The last message ID of the range.
+ *
+ * @return true if it is.
+ */
+static bool ValidSubRange(SBN_PeerInterface_t *Peer, CFE_SB_MsgId_t MsgID, CFE_SB_MsgId_t LastMsgID)
+{
+    if (LastMsgID < MsgID || LastMsgID - MsgID >= SBN_MAX_SUB_RANGE)
     {
-        EVSSendInfo(SBN_SUB_EID, "cannot process unsubscription from ProcessorID %d, msg 0x%04X not found",
-                    Peer->ProcessorID, MsgID);
-        return SBN_SUCCESS;
+        EVSSendErr(SBN_SUB_EID, "invalid MID range 0x%04X-0x%04X from ProcessorID %d", MsgID, LastMsgID,
+                   Peer->ProcessorID);
+        return false;
     } /* end if */
 
-    /* remove sub from array for that peer and
-    ** shift all subscriptions in higher elements to fill the gap
-    ** note that the Subs[] array has one extra element to allow for an
-    ** unsub from a full table.
-    */
-    for (i = idx; i < Peer->SubCnt; i++)
-    {
-        memcpy(&Peer->Subs[i], &Peer->Subs[i + 1], sizeof(SBN_Subs_t));
-    } /* end for */
+    return true;
+} /* end ValidSubRange() */
 
-    /* decrement sub cnt */
-    Peer->SubCnt--;
+/**
+ * \brief Process a subscription from a peer. If the peer's filters remap
+ *        message ID's, a range is remapped one message ID at a time.
+ *
+ * @param[in] Peer The peer interface.
+ * @param[in] MsgID The first subscription SBN message ID.
+ * @param[in] LastMsgID The last subscription SBN message ID (MsgID for a single one.)
+ * @param[in] QoS The subscription quality of service.
+ *
+ * @return SBN_SUCCESS on successfully handling subscription from peer, otherwise SBN_ERROR
+ */
+static SBN_Status_t ProcessSubFromPeer(SBN_PeerInterface_t *Peer, CFE_SB_MsgId_t MsgID, CFE_SB_MsgId_t LastMsgID,
+                                       CFE_SB_Qos_t QoS)
+{
+    SBN_Status_t   SBN_Status = SBN_SUCCESS;
+    CFE_SB_MsgId_t Remapped   = 0;
+    uint32         Sub        = 0;
 
-    /* unsubscribe to the msg id on the peer pipe */
-    if (CFE_SB_UnsubscribeLocal(MsgID, Peer->Pipe) != CFE_SUCCESS)
+    if (!ValidSubRange(Peer, MsgID, LastMsgID))
     {
-        EVSSendErr(SBN_SUB_EID, "unable to unsubscribe from MID 0x%04X", MsgID);
         return SBN_ERROR;
     } /* end if */
 
+    if (!RemapsMsgIDs(Peer))
+    {
+        return AddSub(Peer, MsgID, LastMsgID, QoS);
+    } /* end if */
+
+    for (Sub = MsgID; Sub <= LastMsgID; Sub++)
+    {
+        Remapped = (CFE_SB_MsgId_t)Sub;
+
+        SBN_Status = RemapPeerMsgID(Peer, &Remapped);
+        if (SBN_Status != SBN_SUCCESS)
+        {
+            return SBN_Status;
+        } /* end if */
+
+        SBN_Status = AddSub(Peer, Remapped, Remapped, QoS);
+        if (SBN_Status != SBN_SUCCESS)
+        {
+            return SBN_Status;
+        } /* end if */
+    }     /* end for */
+
     return SBN_SUCCESS;
+} /* ProcessSubFromPeer */
+
+/**
+ * \brief Process an unsubscription from a peer. If the peer's filters remap
+ *        message ID's, a range is remapped one message ID at a time.
+ *
+ * @param[in] Peer The peer interface
+ * @param[in] MsgID The first unsubscription SBN message ID.
+ * @param[in] LastMsgID The last unsubscription SBN message ID (MsgID for a single one.)
+ *
+ * @return SBN_SUCCESS on successful unsubscription from peer, otherwise SBN_ERROR
+ */
+static SBN_Status_t ProcessUnsubFromPeer(SBN_PeerInterface_t *Peer, CFE_SB_MsgId_t MsgID, CFE_SB_MsgId_t LastMsgID)
+{
+    SBN_Status_t   SBN_Status = SBN_SUCCESS;
+    CFE_SB_MsgId_t Remapped   = 0;
+    uint32         Unsub      = 0;
+
+    if (!ValidSubRange(Peer, MsgID, LastMsgID))
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    if (!RemapsMsgIDs(Peer))
+    {
+        return DelSub(Peer, MsgID, LastMsgID);
+    } /* end if */
+
+    for (Unsub = MsgID; Unsub <= LastMsgID; Unsub++)
+    {
+        Remapped = (CFE_SB_MsgId_t)Unsub;
+
+        if (RemapPeerMsgID(Peer, &Remapped) != SBN_SUCCESS || DelSub(Peer, Remapped, Remapped) != SBN_SUCCESS)
+        {
+            SBN_Status = SBN_ERROR;
+        } /* end if */
+    }     /* end for */
+
+    return SBN_Status;
 } /* end ProcessUnsubFromPeer */
 
 /**
- * \brief Process an unsubscription message from a peer.
+ * \brief Process the (un)subscriptions in a message from a peer.
  *
- * @param[in] PeerIdx The peer index (in SBN.Peer)
- * @param[in] Msg The unsubscription SBN message.
+ * @param[in] Peer The peer interface.
+ * @param[in] Msg The SBN_SUB_MSG, SBN_UNSUB_MSG, SBN_SUBRANGE_MSG or SBN_UNSUBRANGE_MSG payload.
+ * @param[in] Ranges True if each entry has a last message ID.
+ * @param[in] Unsub True for unsubscriptions.
  *
- * @return SBN_SUCCESS always (whether or not there were some unsubs that failed.)
+ * @return For subscriptions, SBN_SUCCESS on successfully handling all of them,
+ *         otherwise SBN_ERROR. For unsubscriptions, SBN_SUCCESS always
+ *         (whether or not there were some unsubs that failed.)
  */
-SBN_Status_t SBN_ProcessUnsubsFromPeer(SBN_PeerInterface_t *Peer, void *Msg)
+static SBN_Status_t ProcessSubMsgFromPeer(SBN_PeerInterface_t *Peer, void *Msg, bool Ranges, bool Unsub)
 {
-    Pack_t Pack;
+    SBN_Status_t   SBN_Status = SBN_SUCCESS;
+    Pack_t         Pack;
+    char           VersionHash[SBN_IDENT_LEN];
+    uint16         SubCnt = 0;
+    int            SubIdx = 0;
+    CFE_SB_MsgId_t MsgID = 0, LastMsgID = 0;
+    CFE_SB_Qos_t   QoS;
 
     Pack_Init(&Pack, Msg, CFE_MISSION_SB_MAX_SB_MSG_SIZE, false);
 
-    char VersionHash[SBN_IDENT_LEN];
-
     Unpack_Data(&Pack, VersionHash, SBN_IDENT_LEN);
 
     if (strncmp(VersionHash, SBN_IDENT, SBN_IDENT_LEN))
     {
+        if (!Unsub)
+        {
+            EVSSendErr(SBN_PROTO_EID, "version number mismatch with peer CpuID %d", Peer->ProcessorID);
+            return SBN_ERROR;
+        } /* end if */
+
         EVSSendInfo(SBN_PROTO_EID, "version number mismatch with peer CpuID %d", Peer->ProcessorID);
-    }
+    } /* end if */
 
-    uint16 SubCnt;
     Unpack_UInt16(&Pack, &SubCnt);
 
-    int SubIdx = 0;
     for (SubIdx = 0; SubIdx < SubCnt; SubIdx++)
     {
-        CFE_SB_MsgId_t MsgID;
         Unpack_MsgID(&Pack, &MsgID);
-        CFE_SB_Qos_t QoS;
+        LastMsgID = MsgID;
+        if (Ranges)
+        {
+            Unpack_MsgID(&Pack, &LastMsgID);
+        } /* end if */
         Unpack_Data(&Pack, &QoS, sizeof(QoS));
 
-        ProcessUnsubFromPeer(Peer, MsgID); /* ignore return value, I want to unsub as much as I can */
-    }                                      /* end for */
+        if (Unsub)
+        {
+            ProcessUnsubFromPeer(Peer, MsgID, LastMsgID); /* ignore return value, I want to unsub as much as I can */
+            continue;
+        } /* end if */
+
+        SBN_Status = ProcessSubFromPeer(Peer, MsgID, LastMsgID, QoS);
+
+        if (SBN_Status != SBN_SUCCESS)
+        {
+            return SBN_Status;
+        } /* end if */
+    }     /* end for */
 
     return SBN_SUCCESS;
+} /* end ProcessSubMsgFromPeer() */
+
+/**
+ * \brief Process a subscription message from a peer.
+ *
+ * @param[in] Peer The peer interface.
+ * @param[in] Msg The subscription SBN message.
+ *
+ * @return SBN_SUCCESS on successfully handling all subscriptions from peer, otherwise SBN_ERROR
+ */
+SBN_Status_t SBN_ProcessSubsFromPeer(SBN_PeerInterface_t *Peer, void *Msg)
+{
+    return ProcessSubMsgFromPeer(Peer, Msg, false, false);
+} /* SBN_ProcessSubsFromPeer */
+
+/**
+ * \brief Process a range subscription message from a peer.
+ *
+ * @param[in] Peer The peer interface.
+ * @param[in] Msg The SBN_SUBRANGE_MSG payload.
+ *
+ * @return SBN_SUCCESS on successfully handling all subscriptions from peer, otherwise SBN_ERROR
+ */
+SBN_Status_t SBN_ProcessSubRangesFromPeer(SBN_PeerInterface_t *Peer, void *Msg)
+{
+    return ProcessSubMsgFromPeer(Peer, Msg, true, false);
+} /* end SBN_ProcessSubRangesFromPeer() */
+
+/**
+ * \brief Process an unsubscription message from a peer.
+ *
+ * @param[in] Peer The peer interface.
+ * @param[in] Msg The unsubscription SBN message.
+ *
+ * @return SBN_SUCCESS always (whether or not there were some unsubs that failed.)
+ */
+SBN_Status_t SBN_ProcessUnsubsFromPeer(SBN_PeerInterface_t *Peer, void *Msg)
+{
+    return ProcessSubMsgFromPeer(Peer, Msg, false, true);
 } /* end SBN_ProcessUnsubsFromPeer() */
 
+/**
+ * \brief Process a range unsubscription message from a peer.
+ *
+ * @param[in] Peer The peer interface.
+ * @param[in] Msg The SBN_UNSUBRANGE_MSG payload.
+ *
+ * @return SBN_SUCCESS always (whether or not there were some unsubs that failed.)
+ */
+SBN_Status_t SBN_ProcessUnsubRangesFromPeer(SBN_PeerInterface_t *Peer, void *Msg)
+{
+    return ProcessSubMsgFromPeer(Peer, Msg, true, true);
+} /* end SBN_ProcessUnsubRangesFromPeer() */
+
 /**
  * When SBN starts, it queries for all existing subscriptions. This method
  * processes those subscriptions.
@@ -615,20 +1610,28 @@ SBN_Status_t SBN_ProcessAllSubscriptions(CFE_SB_AllSubscriptionsTlm_t *Ptr)
  */
 SBN_Status_t SBN_RemoveAllSubsFromPeer(SBN_PeerInterface_t *Peer)
 {
-    int          i          = 0;
-    CFE_Status_t CFE_Status = CFE_SUCCESS;
+    int    i = 0, MsgIDCnt = 0;
+    uint32 Unsub = 0;
 
     for (i = 0; i < Peer->SubCnt; i++)
     {
-        CFE_Status = CFE_SB_UnsubscribeLocal(Peer->Subs[i].MsgID, Peer->Pipe);
-        if (CFE_Status != CFE_SUCCESS)
+#ifdef SBN_BRIDGE
+        BridgeSubs(Peer, Peer->Subs[i].MsgID, Peer->Subs[i].LastMsgID, Peer->Subs[i].QoS, true);
+#endif /* SBN_BRIDGE */
+
+        for (Unsub = Peer->Subs[i].MsgID; Unsub <= Peer->Subs[i].LastMsgID; Unsub++)
         {
-            EVSSendErr(SBN_SUB_EID, "unable to unsubscribe from message id 0x%04X", Peer->Subs[i].MsgID);
-            /* but continue processing... */
-        } /* end if */
+            if (UnsubscribePeerPipe(Peer, (CFE_SB_MsgId_t)Unsub, Peer->Subs[i].QoS) != SBN_SUCCESS)
+            {
+                EVSSendErr(SBN_SUB_EID, "unable to unsubscribe from message id 0x%04X", (unsigned int)Unsub);
+                /* but continue processing... */
+            } /* end if */
+
+            MsgIDCnt++;
+        } /* end for */
     }     /* end for */
 
-    EVSSendInfo(SBN_SUB_EID, "unsubscribed %d message id's from ProcessorID %d", (int)Peer->SubCnt, Peer->ProcessorID);
+    EVSSendInfo(SBN_SUB_EID, "unsubscribed %d message id's from ProcessorID %d", MsgIDCnt, Peer->ProcessorID);
 
     Peer->SubCnt = 0;
 
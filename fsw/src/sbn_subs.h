@@ -30,8 +30,11 @@ SBN_Status_t SBN_SendLocalSubsToPeer(SBN_PeerInterface_t *Peer);
 SBN_Status_t SBN_CheckSubscriptionPipe(void);
 SBN_Status_t SBN_ProcessSubsFromPeer(SBN_PeerInterface_t *Peer, void *submsg);
 SBN_Status_t SBN_ProcessUnsubsFromPeer(SBN_PeerInterface_t *Peer, void *submsg);
+SBN_Status_t SBN_ProcessSubRangesFromPeer(SBN_PeerInterface_t *Peer, void *submsg);
+SBN_Status_t SBN_ProcessUnsubRangesFromPeer(SBN_PeerInterface_t *Peer, void *submsg);
 SBN_Status_t SBN_ProcessAllSubscriptions(CFE_SB_AllSubscriptionsTlm_t *Ptr);
 SBN_Status_t SBN_RemoveAllSubsFromPeer(SBN_PeerInterface_t *Peer);
+bool         SBN_PeerSubscribed(SBN_PeerInterface_t *Peer, CFE_SB_MsgId_t MsgID);
 SBN_Status_t SBN_SendSubsRequests(void);
 
 #endif /* _sbn_subs_h_ */
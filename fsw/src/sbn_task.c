@@ -0,0 +1,88 @@
+/******************************************************************************
+ ** \file sbn_task.c
+ **
+ **      Copyright (c) 2004-2006, United States government as represented by the
+ **      administrator of the National Aeronautics Space Administration.
+ **      All rights reserved. This software(cFE) was created at NASA's Goddard
+ **      Space Flight Center pursuant to government contracts.
+ **
+ **      This software may be used only pursuant to a United States government
+ **      sponsored project and the United States government may not be charged
+ **      for use thereof.
+ **
+ ** Purpose:
+ **      This file contains source code for creating SBN's send and receive
+ **      tasks with the priority, stack size and cores the configuration table
+ **      gives them (SBN_TaskConf_t.)
+ */
+
+/* for pthread_setaffinity_np(), unless the build already asked for it */
+#if defined(SBN_TASK_AFFINITY) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif /* SBN_TASK_AFFINITY && !_GNU_SOURCE */
+
+#include "sbn_app.h"
+
+#ifdef SBN_TASK_AFFINITY
+#include <pthread.h>
+#include <sched.h>
+#endif /* SBN_TASK_AFFINITY */
+
+/**
+ * Creates a send or receive task.
+ *
+ * @param[out] TaskIDPtr The ID of the task created.
+ * @param[in] TaskName The task name.
+ * @param[in] FuncPtr The task's main function.
+ * @param[in] Conf The task's priority, stack size and cores.
+ * @param[in] DataSz The size of the task's data on its stack, for the default
+ *            stack size.
+ * @return The CFE_ES_CreateChildTask() status.
+ */
+CFE_Status_t SBN_CreateTask(OS_TaskID_t *TaskIDPtr, const char *TaskName, CFE_ES_ChildTaskMainFuncPtr_t FuncPtr,
+                            const SBN_TaskConf_t *Conf, uint32 DataSz)
+{
+    uint32 StackSz = Conf->StackSz;
+
+    if (StackSz == 0)
+    {
+        StackSz = CFE_PLATFORM_ES_DEFAULT_STACK_SIZE + 2 * DataSz;
+    } /* end if */
+
+    return CFE_ES_CreateChildTask(TaskIDPtr, TaskName, FuncPtr, NULL, StackSz, Conf->Priority, 0);
+} /* end SBN_CreateTask() */
+
+/**
+ * Pins the calling task to the cores its configuration allows, called by
+ * each task as it starts as OSAL cannot do so for the task that creates it.
+ * Does nothing without SBN_TASK_AFFINITY or when CoreMask is 0.
+ *
+ * @param[in] Conf The task's configuration.
+ */
+void SBN_PinTask(const SBN_TaskConf_t *Conf)
+{
+#ifdef SBN_TASK_AFFINITY
+    cpu_set_t CPUs;
+    int       Core = 0;
+
+    if (Conf->CoreMask == 0)
+    {
+        return;
+    } /* end if */
+
+    CPU_ZERO(&CPUs);
+
+    for (Core = 0; Core < 32; Core++)
+    {
+        if (Conf->CoreMask & (1U << Core))
+        {
+            CPU_SET(Core, &CPUs);
+        } /* end if */
+    }     /* end for */
+
+    if (pthread_setaffinity_np(pthread_self(), sizeof(CPUs), &CPUs) != 0)
+    {
+        EVSSendErr(SBN_PEERTASK_EID, "unable to pin task to cores 0x%x", (unsigned int)Conf->CoreMask);
+    } /* end if */
+#endif /* SBN_TASK_AFFINITY */
+} /* end SBN_PinTask() */
@@ -0,0 +1,28 @@
+/******************************************************************************
+** File: sbn_task.h
+**
+**      Copyright (c) 2004-2006, United States government as represented by the
+**      administrator of the National Aeronautics Space Administration.
+**      All rights reserved. This software(cFE) was created at NASA's Goddard
+**      Space Flight Center pursuant to government contracts.
+**
+**      This software may be used only pursuant to a United States government
+**      sponsored project and the United States government may not be charged
+**      for use thereof.
+**
+** Purpose:
+**      This header file contains prototypes for private functions related to
+**      creating SBN's send and receive tasks as the configuration table says.
+**
+******************************************************************************/
+
+#ifndef _sbn_task_h_
+#define _sbn_task_h_
+
+#include "sbn_app.h"
+
+CFE_Status_t SBN_CreateTask(OS_TaskID_t *TaskIDPtr, const char *TaskName, CFE_ES_ChildTaskMainFuncPtr_t FuncPtr,
+                            const SBN_TaskConf_t *Conf, uint32 DataSz);
+void         SBN_PinTask(const SBN_TaskConf_t *Conf);
+
+#endif /* _sbn_task_h_ */
@@ -0,0 +1,81 @@
+/******************************************************************************
+ ** \file sbn_ttl.c
+ **
+ **      Copyright (c) 2004-2006, United States government as represented by the
+ **      administrator of the National Aeronautics Space Administration.
+ **      All rights reserved. This software(cFE) was created at NASA's Goddard
+ **      Space Flight Center pursuant to government contracts.
+ **
+ **      This software may be used only pursuant to a United States government
+ **      sponsored project and the United States government may not be charged
+ **      for use thereof.
+ **
+ ** Purpose:
+ **      This file contains source code for dropping stale messages. The
+ **      configuration table gives message ID's a time-to-live, and a message
+ **      read for a peer whose secondary header time is older than that is not
+ **      worth the link capacity it would take.
+ */
+
+#include "sbn_app.h"
+
+/**
+ * The age of a message, from the time in its secondary header to now.
+ *
+ * @param[in] Then The message time.
+ * @param[in] Now The current time.
+ * @return The age in milliseconds, negative if the message is from the future.
+ */
+static int64 AgeMS(CFE_TIME_SysTime_t *Then, CFE_TIME_SysTime_t *Now)
+{
+    /* subseconds are in units of 2^-32 seconds */
+    return ((int64)Now->Seconds - (int64)Then->Seconds) * 1000 +
+           (((int64)Now->Subseconds - (int64)Then->Subseconds) * 1000) / 0x100000000LL;
+} /* end AgeMS() */
+
+/**
+ * Whether a message read for a peer is older than the time-to-live the
+ * configuration table gives its message ID (SBN_ConfTbl_t TTLs.)
+ *
+ * @param[in] SBMsgPtr The message.
+ * @return true if the message should be dropped rather than sent, false if
+ *         its message ID has no time-to-live or the message has no time.
+ */
+bool SBN_MsgExpired(CFE_SB_MsgPtr_t SBMsgPtr)
+{
+    SBN_ConfTbl_t *    Conf  = SBN.Conf;
+    CFE_SB_MsgId_t     MsgID = 0;
+    CFE_TIME_SysTime_t MsgTime, Now;
+    int                i = 0;
+
+    if (Conf == NULL || Conf->TTLCnt == 0)
+    {
+        return false;
+    } /* end if */
+
+    MsgID = CFE_SB_GetMsgId(SBMsgPtr);
+
+    for (i = 0; i < Conf->TTLCnt; i++)
+    {
+        if (Conf->TTLs[i].MsgID == MsgID)
+        {
+            break;
+        } /* end if */
+    }     /* end for */
+
+    if (i == Conf->TTLCnt || Conf->TTLs[i].TTLMS == 0)
+    {
+        return false;
+    } /* end if */
+
+    MsgTime = CFE_SB_GetMsgTime(SBMsgPtr);
+    if (MsgTime.Seconds == 0 && MsgTime.Subseconds == 0)
+    {
+        /* commands and messages without a secondary header never expire */
+        return false;
+    } /* end if */
+
+    Now = CFE_TIME_GetTime();
+
+    return AgeMS(&MsgTime, &Now) > (int64)Conf->TTLs[i].TTLMS;
+} /* end SBN_MsgExpired() */
@@ -0,0 +1,26 @@
+/******************************************************************************
+** File: sbn_ttl.h
+**
+**      Copyright (c) 2004-2006, United States government as represented by the
+**      administrator of the National Aeronautics Space Administration.
+**      All rights reserved. This software(cFE) was created at NASA's Goddard
+**      Space Flight Center pursuant to government contracts.
+**
+**      This software may be used only pursuant to a United States government
+**      sponsored project and the United States government may not be charged
+**      for use thereof.
+**
+** Purpose:
+**      This header file contains prototypes for private functions related to
+**      dropping messages that are older than their message ID's time-to-live.
+**
+******************************************************************************/
+
+#ifndef _sbn_ttl_h_
+#define _sbn_ttl_h_
+
+#include "sbn_app.h"
+
+bool SBN_MsgExpired(CFE_SB_MsgPtr_t SBMsgPtr);
+
+#endif /* _sbn_ttl_h_ */
@@ -227,8 +227,11 @@ int SBN_DTN_UnloadNet(SBN_NetInterface_t *Net)
     int PeerIdx = 0;
     for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
     {
-        SBN_DTN_UnloadPeer(&Net->Peers[PeerIdx]);
-    } /* end for */
+        if (!Net->Peers[PeerIdx].Unused)
+        {
+            SBN_DTN_UnloadPeer(&Net->Peers[PeerIdx]);
+        } /* end if */
+    }     /* end for */
 
     return SBN_SUCCESS;
 } /* end SBN_DTN_ResetPeer */
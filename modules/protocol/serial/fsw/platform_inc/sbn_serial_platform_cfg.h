@@ -15,6 +15,7 @@
 
 #define SBN_SERIAL_CHILD_TASK_PRIORITY 70 /**< Priority of the child tasks */
 
+/** Defaults (in seconds) for nets whose configuration leaves HeartbeatMS or TimeoutMS 0 */
 #define SBN_SERIAL_PEER_HEARTBEAT 5
 #define SBN_SERIAL_PEER_TIMEOUT   10
 #endif
@@ -30,7 +30,16 @@ int SBN_SERIAL_Init(int Version)
 
 int SBN_SERIAL_LoadNet(SBN_NetInterface_t *Net, const char *Address)
 {
-    /* this space intentionally left blank */
+    if (Net->HeartbeatMS == 0)
+    {
+        Net->HeartbeatMS = SBN_SERIAL_PEER_HEARTBEAT * 1000;
+    } /* end if */
+
+    if (Net->TimeoutMS == 0)
+    {
+        Net->TimeoutMS = SBN_SERIAL_PEER_TIMEOUT * 1000;
+    } /* end if */
+
     return SBN_SUCCESS;
 } /* end SBN_SERIAL_LoadNet */
 
@@ -133,15 +142,12 @@ int SBN_SERIAL_PollPeer(SBN_PeerInterface_t *Peer)
         } /* end if */
     }     /* end if */
 
-    OS_time_t CurrentTime;
-    OS_GetLocalTime(&CurrentTime);
-
-    if (SBN_SERIAL_PEER_HEARTBEAT > 0 && CurrentTime.seconds - Peer->LastSend.seconds > SBN_SERIAL_PEER_HEARTBEAT)
+    if (SBN_HeartbeatDue(Peer))
     {
         SBN_SERIAL_Send(Peer, SBN_SERIAL_HEARTBEAT_MSG, 0, NULL);
     } /* end if */
 
-    if (SBN_SERIAL_PEER_TIMEOUT > 0 && CurrentTime.seconds - Peer->LastRecv.seconds > SBN_SERIAL_PEER_TIMEOUT)
+    if (SBN_PeerTimedOut(Peer))
     {
         CFE_EVS_SendEvent(SBN_SERIAL_DEBUG_EID, CFE_EVS_INFORMATION, "CPU %d disconnected", Peer->ProcessorID);
 
@@ -318,8 +324,11 @@ int SBN_SERIAL_UnloadNet(SBN_NetInterface_t *Net)
     int PeerIdx = 0;
     for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
     {
-        SBN_SERIAL_UnloadPeer(&Net->Peers[PeerIdx]);
-    } /* end if */
+        if (!Net->Peers[PeerIdx].Unused)
+        {
+            SBN_SERIAL_UnloadPeer(&Net->Peers[PeerIdx]);
+        } /* end if */
+    }     /* end for */
 
     return SBN_SUCCESS;
 } /* end SBN_SERIAL_ResetPeer */
@@ -5,6 +5,7 @@
 
 #include <network_includes.h>
 #include <string.h>
+#include <stdlib.h>
 #include <errno.h>
 
 #define SBN_TCP_HEARTBEAT_MSG 0xA0
@@ -12,7 +13,8 @@
 /**
  * If I haven't sent a message in SBN_TCP_PEER_HEARTBEAT seconds, send an empty
  * one just to maintain the connection. If this is set to 0, no heartbeat
- * messages will be generated.
+ * messages will be generated. Only for nets whose configuration leaves
+ * HeartbeatMS 0.
  */
 #define SBN_TCP_PEER_HEARTBEAT 5
 /* #define SBN_TCP_PEER_HEARTBEAT 0 */
@@ -20,35 +22,57 @@
 /**
  * If I haven't received a message from a peer in SBN_TCP_PEER_TIMEOUT seconds,
  * consider the peer lost and disconnect. If this is set to 0, no timeout is
- * checked.
+ * checked. Only for nets whose configuration leaves TimeoutMS 0; the failure
+ * detector may disconnect sooner, see SBN_PeerTimedOut().
  */
 /* #define SBN_TCP_PEER_TIMEOUT 10 */
 #define SBN_TCP_PEER_TIMEOUT 0
 
+/**
+ * Connections a net has room for beyond one per peer, for connections
+ * accepted before the peer is known or before the peer's previous connection
+ * is found to be closed.
+ */
+#define SBN_TCP_SPARE_CONNS 4
+
 typedef struct
 {
     bool                 InUse, ReceivingBody;
     int                  RecvSz;
     int                  Socket;
-    uint8                BufNum;
     SBN_PeerInterface_t *PeerInterface; /* affiliated peer, if known */
+    uint8                RecvBuf[SBN_MAX_PACKED_MSG_SZ];
 } SBN_TCP_Conn_t;
 
 typedef struct
 {
     OS_SockAddr_t   Addr;
     bool            ConnectOut;
-    uint8           BufNum; /* incoming buffer */
     OS_time_t       LastConnectTry;
     SBN_TCP_Conn_t *Conn; /* when connected and affiliated */
 } SBN_TCP_Peer_t;
 
+/**
+ * The connections of a net, allocated by InitNet once the number of peers is
+ * known. The set of connection sockets is kept up to date as connections
+ * open and close rather than rebuilt for every select, and the sockets one
+ * select finds readable are read by successive Recv calls before selecting
+ * again.
+ */
 typedef struct
 {
-    OS_SockAddr_t  Addr;
-    uint8          BufNum; /* outgoing buffer */
-    int            Socket; /* server socket */
-    SBN_TCP_Conn_t Conns[SBN_MAX_PEER_CNT];
+    OS_FdSet       ConnFds;   /* sockets of the connections in use */
+    OS_FdSet       ReadyFds;  /* readable sockets from the last select */
+    int            NextReady; /* the connection to check in ReadyFds next */
+    int            ConnCnt;
+    SBN_TCP_Conn_t Conns[];
+} SBN_TCP_ConnTbl_t;
+
+typedef struct
+{
+    OS_SockAddr_t      Addr;
+    int                Socket; /* server socket */
+    SBN_TCP_ConnTbl_t *ConnTbl;
 } SBN_TCP_Net_t;
 
 CFE_EVS_EventID_t SBN_TCP_FIRST_EID = 0;
@@ -113,35 +137,53 @@ static SBN_Status_t ConfAddr(OS_SockAddr_t *Addr, const char *Address)
     return SBN_SUCCESS;
 } /* end ConfAddr() */
 
-static uint8 SendBufs[SBN_MAX_NETS][SBN_MAX_PACKED_MSG_SZ];
-static int   SendBufCnt = 0;
-
 static SBN_TCP_Conn_t *NewConn(SBN_TCP_Net_t *NetData, int Socket)
 {
     /* warning -- no protections against flooding */
     /* TODO: do I need a mutex? */
 
-    int ConnID = 0;
+    SBN_TCP_ConnTbl_t *ConnTbl = NetData->ConnTbl;
+    int                ConnID  = 0;
+
+    if (ConnTbl == NULL)
+    {
+        return NULL;
+    } /* end if */
 
-    for (ConnID = 0; ConnID < SBN_MAX_PEER_CNT && NetData->Conns[ConnID].InUse; ConnID++)
+    for (ConnID = 0; ConnID < ConnTbl->ConnCnt && ConnTbl->Conns[ConnID].InUse; ConnID++)
         ;
 
-    if (ConnID == SBN_MAX_PEER_CNT)
+    if (ConnID == ConnTbl->ConnCnt)
     {
+        EVSSendErr(SBN_TCP_SOCK_EID, "no free connections, closing socket");
         return NULL;
     } /* end if */
 
-    SBN_TCP_Conn_t *Conn = &NetData->Conns[ConnID];
+    SBN_TCP_Conn_t *Conn = &ConnTbl->Conns[ConnID];
 
-    memset(Conn, 0, sizeof(*Conn));
+    Conn->ReceivingBody = false;
+    Conn->RecvSz        = 0;
+    Conn->PeerInterface = NULL;
 
     Conn->Socket = Socket;
 
     Conn->InUse = true;
 
+    OS_SelectFdAdd(&ConnTbl->ConnFds, Socket);
+
     return Conn;
 } /* end NewConn() */
 
+static void CloseConn(SBN_TCP_Net_t *NetData, SBN_TCP_Conn_t *Conn)
+{
+    OS_close(Conn->Socket);
+
+    OS_SelectFdClear(&NetData->ConnTbl->ConnFds, Conn->Socket);
+    OS_SelectFdClear(&NetData->ConnTbl->ReadyFds, Conn->Socket);
+
+    Conn->InUse = false;
+} /* end CloseConn() */
+
 static void Disconnected(SBN_PeerInterface_t *Peer)
 {
     SBN_TCP_Peer_t *PeerData = (SBN_TCP_Peer_t *)Peer->ModulePvt;
@@ -149,9 +191,8 @@ static void Disconnected(SBN_PeerInterface_t *Peer)
 
     if (Conn)
     {
-        OS_close(Conn->Socket);
+        CloseConn((SBN_TCP_Net_t *)Peer->Net->ModulePvt, Conn);
 
-        Conn->InUse    = false;
         PeerData->Conn = NULL;
     } /* end if */
 
@@ -164,21 +205,26 @@ static SBN_Status_t LoadNet(SBN_NetInterface_t *Net, const char *Address)
 
     EVSSendInfo(SBN_TCP_CONFIG_EID, "configuring net 0x%lx -> %s", (unsigned long int)NetData, Address);
 
+    if (Net->HeartbeatMS == 0)
+    {
+        Net->HeartbeatMS = SBN_TCP_PEER_HEARTBEAT * 1000;
+    } /* end if */
+
+    if (Net->TimeoutMS == 0)
+    {
+        Net->TimeoutMS = SBN_TCP_PEER_TIMEOUT * 1000;
+    } /* end if */
+
     SBN_Status_t Status = ConfAddr(&NetData->Addr, Address);
 
     if (Status == SBN_SUCCESS)
     {
-        NetData->BufNum = SendBufCnt++;
-
         EVSSendInfo(SBN_TCP_CONFIG_EID, "net 0x%lx configured", (unsigned long int)NetData);
     } /* end if */
 
     return Status;
 } /* end LoadNet() */
 
-static uint8 RecvBufs[SBN_MAX_PEER_CNT][SBN_MAX_PACKED_MSG_SZ];
-static uint8 RecvBufCnt = 0;
-
 static SBN_Status_t LoadPeer(SBN_PeerInterface_t *Peer, const char *Address)
 {
     SBN_TCP_Peer_t *PeerData = (SBN_TCP_Peer_t *)Peer->ModulePvt;
@@ -189,8 +235,6 @@ static SBN_Status_t LoadPeer(SBN_PeerInterface_t *Peer, const char *Address)
 
     if (Status == SBN_SUCCESS)
     {
-        PeerData->BufNum = RecvBufCnt++;
-
         EVSSendInfo(SBN_TCP_CONFIG_EID, "peer 0x%lx configured", (unsigned long int)PeerData);
     } /* end if */
 
@@ -224,6 +268,18 @@ static SBN_Status_t InitNet(SBN_NetInterface_t *Net)
 
     NetData->Socket = Socket;
 
+    NetData->ConnTbl =
+        calloc(1, sizeof(*NetData->ConnTbl) + (Net->PeerCnt + SBN_TCP_SPARE_CONNS) * sizeof(SBN_TCP_Conn_t));
+    if (NetData->ConnTbl == NULL)
+    {
+        EVSSendErr(SBN_TCP_SOCK_EID, "unable to allocate %d connections", Net->PeerCnt + SBN_TCP_SPARE_CONNS);
+        return SBN_ERROR;
+    } /* end if */
+
+    NetData->ConnTbl->ConnCnt = Net->PeerCnt + SBN_TCP_SPARE_CONNS;
+    OS_SelectFdZero(&NetData->ConnTbl->ConnFds);
+    OS_SelectFdZero(&NetData->ConnTbl->ReadyFds);
+
     return SBN_SUCCESS;
 } /* end InitNet() */
 
@@ -256,8 +312,11 @@ static void CheckNet(SBN_NetInterface_t *Net)
     /* NOTE: OSAL currently has a bug that causes OS_SocketAccept to fail, see ticket #349. */
     while ((Status = OS_SocketAccept(NetData->Socket, &ClientFd, &Addr, 0)) == OS_SUCCESS)
     {
-        NewConn(NetData, ClientFd);
-    } /* end while */
+        if (NewConn(NetData, ClientFd) == NULL)
+        {
+            OS_close(ClientFd);
+        } /* end if */
+    }     /* end while */
 
     if (Status != OS_ERROR_TIMEOUT)
     {
@@ -273,6 +332,11 @@ static void CheckNet(SBN_NetInterface_t *Net)
         SBN_PeerInterface_t *Peer     = &Net->Peers[PeerIdx];
         SBN_TCP_Peer_t *     PeerData = (SBN_TCP_Peer_t *)Peer->ModulePvt;
 
+        if (Peer->Unused)
+        {
+            continue;
+        } /* end if */
+
         if (PeerData->ConnectOut && !Peer->Connected)
         {
             /* TODO: make a #define */
@@ -311,6 +375,10 @@ static void CheckNet(SBN_NetInterface_t *Net)
                     PeerData->Conn      = Conn;
 
                     SBN_Connected(Peer);
+                }
+                else
+                {
+                    OS_close(Socket);
                 } /* end if */
             }     /* end if */
         }         /* end if */
@@ -319,9 +387,8 @@ static void CheckNet(SBN_NetInterface_t *Net)
 
 static SBN_Status_t Send(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Msg)
 {
-    SBN_TCP_Peer_t *    PeerData = (SBN_TCP_Peer_t *)Peer->ModulePvt;
-    SBN_NetInterface_t *Net      = Peer->Net;
-    SBN_TCP_Net_t *     NetData  = (SBN_TCP_Net_t *)Net->ModulePvt;
+    SBN_TCP_Peer_t *PeerData = (SBN_TCP_Peer_t *)Peer->ModulePvt;
+    uint8 *         Buf      = NULL;
 
     if (PeerData->Conn == NULL)
     {
@@ -329,8 +396,18 @@ static SBN_Status_t Send(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_M
         return 0;
     } /* end if */
 
-    SBN_PackMsg(&SendBufs[NetData->BufNum], MsgSz, MsgType, CFE_PSP_GetProcessorId(), Msg);
-    SBN_MsgSz_t sent_size = OS_write(PeerData->Conn->Socket, &SendBufs[NetData->BufNum], MsgSz + SBN_PACKED_HDR_SZ);
+    Buf = SBN_GetBuf();
+    if (Buf == NULL)
+    {
+        EVSSendErr(SBN_TCP_SOCK_EID, "no buffer to send from");
+        return SBN_ERROR;
+    } /* end if */
+
+    SBN_PackMsg(Buf, MsgSz, MsgType, CFE_PSP_GetProcessorId(), Msg);
+    SBN_MsgSz_t sent_size = OS_write(PeerData->Conn->Socket, Buf, MsgSz + SBN_PACKED_HDR_SZ);
+
+    SBN_PutBuf(Buf);
+
     if (sent_size < MsgSz + SBN_PACKED_HDR_SZ)
     {
         EVSSendInfo(SBN_TCP_DEBUG_EID, "CPU %d failed to write, disconnected", Peer->ProcessorID);
@@ -344,22 +421,26 @@ static SBN_Status_t Send(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_M
 
 static SBN_Status_t PollPeer(SBN_PeerInterface_t *Peer)
 {
-    CheckNet(Peer->Net);
+    /* at least every second, more often if the net's heartbeats or timeout need it */
+    SBN_SchedulePoll(Peer, SBN_LivenessPollMS(Peer));
+
+    if (Peer == &Peer->Net->Peers[0])
+    {
+        /* accepting and connecting out is for the whole net, do it once */
+        CheckNet(Peer->Net);
+    } /* end if */
 
     if (!Peer->Connected)
     {
         return SBN_SUCCESS;
     } /* end if */
 
-    OS_time_t CurrentTime;
-    OS_GetLocalTime(&CurrentTime);
-
-    if (SBN_TCP_PEER_HEARTBEAT > 0 && CurrentTime.seconds - Peer->LastSend.seconds > SBN_TCP_PEER_HEARTBEAT)
+    if (SBN_HeartbeatDue(Peer))
     {
         Send(Peer, SBN_TCP_HEARTBEAT_MSG, 0, NULL);
     } /* end if */
 
-    if (SBN_TCP_PEER_TIMEOUT > 0 && CurrentTime.seconds - Peer->LastRecv.seconds > SBN_TCP_PEER_TIMEOUT)
+    if (SBN_PeerTimedOut(Peer))
     {
         EVSSendInfo(SBN_TCP_DEBUG_EID, "CPU %d timeout, disconnected", Peer->ProcessorID);
 
@@ -369,144 +450,170 @@ static SBN_Status_t PollPeer(SBN_PeerInterface_t *Peer)
     return SBN_SUCCESS;
 } /* end PollPeer() */
 
-static SBN_Status_t Recv(SBN_NetInterface_t *Net, SBN_MsgType_t *MsgTypePtr, SBN_MsgSz_t *MsgSzPtr,
-                         CFE_ProcessorID_t *ProcessorIDPtr, void *MsgBuf)
+/**
+ * Reads what is available on a connection the last select found readable.
+ *
+ * @return SBN_SUCCESS when a complete message has been read, SBN_IF_EMPTY
+ *         when more is to come (or the connection was closed), SBN_ERROR if
+ *         the message could not be unpacked.
+ */
+static SBN_Status_t RecvConn(SBN_NetInterface_t *Net, SBN_TCP_Conn_t *Conn, SBN_MsgType_t *MsgTypePtr,
+                             SBN_MsgSz_t *MsgSzPtr, CFE_ProcessorID_t *ProcessorIDPtr, void *MsgBuf)
 {
-    OS_FdSet           FdSet;
-    OS_SelectTimeout_t timeout = 0;
-    int                ConnID  = 0;
+    SBN_TCP_Net_t *NetData  = (SBN_TCP_Net_t *)Net->ModulePvt;
+    ssize_t        Received = 0;
+    int            ToRead   = 0;
 
-    SBN_TCP_Net_t *NetData = (SBN_TCP_Net_t *)Net->ModulePvt;
-
-    if (Net->TaskFlags & SBN_TASK_RECV)
+    if (!Conn->ReceivingBody)
     {
-        timeout = 1000;
-    } /* end if */
+        /* recv the header first */
+        ToRead = SBN_PACKED_HDR_SZ - Conn->RecvSz;
 
-    OS_SelectFdZero(&FdSet);
+        Received = OS_read(Conn->Socket, (char *)Conn->RecvBuf + Conn->RecvSz, ToRead);
 
-    for (ConnID = 0; ConnID < SBN_MAX_PEER_CNT; ConnID++)
-    {
-        if (NetData->Conns[ConnID].InUse)
+        if (Received <= 0)
         {
-            OS_SelectFdAdd(&FdSet, NetData->Conns[ConnID].Socket);
-        } /* end if */
-    }     /* end for */
+            EVSSendInfo(SBN_TCP_DEBUG_EID, "Connection %d head recv failed, disconnected",
+                        (int)(Conn - NetData->ConnTbl->Conns));
 
-    if (OS_SelectMultiple(&FdSet, NULL, timeout) != OS_SUCCESS)
-    {
-        return SBN_IF_EMPTY;
-    } /* end if */
-
-    for (ConnID = 0; ConnID < SBN_MAX_PEER_CNT; ConnID++)
-    {
-        SBN_TCP_Conn_t *Conn = &NetData->Conns[ConnID];
+            if (Conn->PeerInterface)
+            {
+                Disconnected(Conn->PeerInterface);
+            }
+            else
+            {
+                CloseConn(NetData, Conn);
+            } /* end if */
 
-        if (!Conn->InUse)
-        {
-            continue;
+            return SBN_IF_EMPTY;
         } /* end if */
 
-        if (OS_SelectFdIsSet(&FdSet, Conn->Socket))
+        Conn->RecvSz += Received;
+
+        if (Received >= ToRead)
         {
-            ssize_t Received = 0;
+            Conn->ReceivingBody = true; /* and continue on to recv body */
+        }
+        else
+        {
+            return SBN_IF_EMPTY; /* wait for the complete header */
+        }                        /* end if */
+    }                            /* end if */
+
+    /* only get here if we're recv'd the header and ready for the body */
 
-            int ToRead = 0;
+    ToRead = CFE_MAKE_BIG16(*((SBN_MsgSz_t *)Conn->RecvBuf)) + SBN_PACKED_HDR_SZ - Conn->RecvSz;
+    if (ToRead)
+    {
+        Received = OS_read(Conn->Socket, (char *)Conn->RecvBuf + Conn->RecvSz, ToRead);
 
-            if (!Conn->ReceivingBody)
+        if (Received <= 0)
+        {
+            CFE_ProcessorID_t ProcessorID = -1;
+            if (Conn->PeerInterface != NULL)
             {
-                /* recv the header first */
-                ToRead = SBN_PACKED_HDR_SZ - Conn->RecvSz;
+                ProcessorID = Conn->PeerInterface->ProcessorID;
 
-                Received = OS_read(Conn->Socket, (char *)&RecvBufs[Conn->BufNum] + Conn->RecvSz, ToRead);
+                Disconnected(Conn->PeerInterface);
+            }
+            else
+            {
+                CloseConn(NetData, Conn);
+            } /* end if */
 
-                if (Received <= 0)
-                {
-                    EVSSendInfo(SBN_TCP_DEBUG_EID, "Connection %d head recv failed, disconnected", ConnID);
+            EVSSendInfo(SBN_TCP_DEBUG_EID, "CPUID %d body recv failed, disconnected", ProcessorID);
 
-                    OS_close(Conn->Socket);
+            return SBN_IF_EMPTY;
+        } /* end if */
 
-                    Disconnected(Conn->PeerInterface);
+        Conn->RecvSz += Received;
 
-                    return SBN_IF_EMPTY;
-                } /* end if */
+        if (Received < ToRead)
+        {
+            return SBN_IF_EMPTY; /* wait for the complete body */
+        }                        /* end if */
+    }                            /* end if */
 
-                Conn->RecvSz += Received;
+    Conn->ReceivingBody = false;
+    Conn->RecvSz        = 0;
 
-                if (Received >= ToRead)
-                {
-                    Conn->ReceivingBody = true; /* and continue on to recv body */
-                }
-                else
-                {
-                    return SBN_IF_EMPTY; /* wait for the complete header */
-                }                        /* end if */
-            }                            /* end if */
+    /* we have the complete body, decode! */
+    if (SBN_UnpackMsg(Conn->RecvBuf, MsgSzPtr, MsgTypePtr, ProcessorIDPtr, MsgBuf) == false)
+    {
+        return SBN_ERROR;
+    } /* end if */
 
-            /* only get here if we're recv'd the header and ready for the body */
+    if (!Conn->PeerInterface)
+    {
+        /* New peer, link it to the connection */
+        SBN_PeerInterface_t *PeerInterface = SBN_GetPeer(Net, *ProcessorIDPtr);
 
-            ToRead = CFE_MAKE_BIG16(*((SBN_MsgSz_t *)&RecvBufs[Conn->BufNum])) + SBN_PACKED_HDR_SZ - Conn->RecvSz;
-            if (ToRead)
-            {
-                Received = OS_read(Conn->Socket, (char *)&RecvBufs[Conn->BufNum] + Conn->RecvSz, ToRead);
+        if (PeerInterface != NULL)
+        {
+            SBN_TCP_Peer_t *PeerData = (SBN_TCP_Peer_t *)PeerInterface->ModulePvt;
 
-                if (Received <= 0)
-                {
-                    CFE_ProcessorID_t ProcessorID = -1;
-                    if (Conn->PeerInterface != NULL)
-                    {
-                        ProcessorID = Conn->PeerInterface->ProcessorID;
-                    } /* end if */
+            PeerData->Conn = Conn;
 
-                    EVSSendInfo(SBN_TCP_DEBUG_EID, "CPUID %d body recv failed, disconnected", ProcessorID);
+            Conn->PeerInterface = PeerInterface;
 
-                    return SBN_ERROR;
-                } /* end if */
+            SBN_Connected(PeerInterface);
+        } /* end if */
+    }     /* end if */
 
-                Conn->RecvSz += Received;
+    return SBN_SUCCESS;
+} /* end RecvConn() */
 
-                if (Received < ToRead)
-                {
-                    return SBN_IF_EMPTY; /* wait for the complete body */
-                }                        /* end if */
-            }                            /* end if */
+static SBN_Status_t Recv(SBN_NetInterface_t *Net, SBN_MsgType_t *MsgTypePtr, SBN_MsgSz_t *MsgSzPtr,
+                         CFE_ProcessorID_t *ProcessorIDPtr, void *MsgBuf)
+{
+    OS_SelectTimeout_t timeout = 0;
+    SBN_Status_t       Status  = SBN_IF_EMPTY;
 
-            /* we have the complete body, decode! */
-            if (SBN_UnpackMsg(&RecvBufs[Conn->BufNum], MsgSzPtr, MsgTypePtr, ProcessorIDPtr, MsgBuf) == false)
-            {
-                return SBN_ERROR;
-            } /* end if */
+    SBN_TCP_Net_t *    NetData = (SBN_TCP_Net_t *)Net->ModulePvt;
+    SBN_TCP_ConnTbl_t *ConnTbl = NetData->ConnTbl;
 
-            if (!Conn->PeerInterface)
-            {
-                /* New peer, link it to the connection */
-                int PeerInterfaceID = 0;
+    if (ConnTbl == NULL)
+    {
+        return SBN_IF_EMPTY;
+    } /* end if */
 
-                for (PeerInterfaceID = 0; PeerInterfaceID < Net->PeerCnt; PeerInterfaceID++)
-                {
-                    SBN_PeerInterface_t *PeerInterface = &Net->Peers[PeerInterfaceID];
+    if (ConnTbl->NextReady >= ConnTbl->ConnCnt)
+    {
+        /* everything the last select found has been read, select again */
+        if (Net->TaskFlags & SBN_TASK_RECV)
+        {
+            timeout = 1000;
+        } /* end if */
+
+        ConnTbl->ReadyFds = ConnTbl->ConnFds;
 
-                    if (PeerInterface->ProcessorID == *ProcessorIDPtr)
-                    {
-                        SBN_TCP_Peer_t *PeerData = (SBN_TCP_Peer_t *)PeerInterface->ModulePvt;
+        if (OS_SelectMultiple(&ConnTbl->ReadyFds, NULL, timeout) != OS_SUCCESS)
+        {
+            return SBN_IF_EMPTY;
+        } /* end if */
 
-                        PeerData->Conn = Conn;
+        ConnTbl->NextReady = 0;
+    } /* end if */
 
-                        Conn->PeerInterface = PeerInterface;
+    while (ConnTbl->NextReady < ConnTbl->ConnCnt)
+    {
+        SBN_TCP_Conn_t *Conn = &ConnTbl->Conns[ConnTbl->NextReady++];
 
-                        SBN_Connected(PeerInterface);
+        if (!Conn->InUse || !OS_SelectFdIsSet(&ConnTbl->ReadyFds, Conn->Socket))
+        {
+            continue;
+        } /* end if */
 
-                        break;
-                    } /* end if */
-                }     /* end for */
-            }         /* end if */
+        Status = RecvConn(Net, Conn, MsgTypePtr, MsgSzPtr, ProcessorIDPtr, MsgBuf);
 
-            Conn->ReceivingBody = false;
-            Conn->RecvSz        = 0;
+        if (Status != SBN_IF_EMPTY)
+        {
+            /* a message (or a bad one), the other ready connections are read on the next call */
+            return Status;
         } /* end if */
-    }     /* end for */
+    }     /* end while */
 
-    return SBN_SUCCESS;
+    return SBN_IF_EMPTY;
 } /* end Recv() */
 
 static SBN_Status_t UnloadPeer(SBN_PeerInterface_t *Peer)
@@ -528,7 +635,26 @@ static SBN_Status_t UnloadNet(SBN_NetInterface_t *Net)
     SBN_PeerIdx_t PeerIdx = 0;
     for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
     {
-        UnloadPeer(&Net->Peers[PeerIdx]);
+        if (!Net->Peers[PeerIdx].Unused)
+        {
+            UnloadPeer(&Net->Peers[PeerIdx]);
+        } /* end if */
+    }     /* end for */
+
+    if (NetData->ConnTbl)
+    {
+        int ConnID = 0;
+        for (ConnID = 0; ConnID < NetData->ConnTbl->ConnCnt; ConnID++)
+        {
+            if (NetData->ConnTbl->Conns[ConnID].InUse)
+            {
+                /* accepted, but the peer never identified itself */
+                CloseConn(NetData, &NetData->ConnTbl->Conns[ConnID]);
+            } /* end if */
+        }     /* end for */
+
+        free(NetData->ConnTbl);
+        NetData->ConnTbl = NULL;
     } /* end if */
 
     return SBN_SUCCESS;
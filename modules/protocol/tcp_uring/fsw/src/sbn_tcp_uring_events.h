@@ -0,0 +1,10 @@
+#ifndef _sbn_tcp_uring_events_h
+#define _sbn_tcp_uring_events_h
+
+extern CFE_EVS_EventID_t SBN_TCP_URING_FIRST_EID; /* defined at module init time */
+
+#define SBN_TCP_URING_SOCK_EID   SBN_TCP_URING_FIRST_EID + 1 /* skip 0th */
+#define SBN_TCP_URING_CONFIG_EID SBN_TCP_URING_FIRST_EID + 2
+#define SBN_TCP_URING_DEBUG_EID  SBN_TCP_URING_FIRST_EID + 3
+
+#endif /* _sbn_tcp_uring_events_h */
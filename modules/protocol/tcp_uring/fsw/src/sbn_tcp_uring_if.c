@@ -0,0 +1,943 @@
+/* for accept4() */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif /* !_GNU_SOURCE */
+
+#include "sbn_tcp_uring_if.h"
+
+#include <sys/socket.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+
+CFE_EVS_EventID_t SBN_TCP_URING_FIRST_EID = 0;
+
+#define EXP_VERSION 5
+
+static SBN_Status_t Init(int Version, CFE_EVS_EventID_t EID)
+{
+    SBN_TCP_URING_FIRST_EID = EID;
+    if (Version != EXP_VERSION)
+    {
+        OS_printf("SBN_TCP_URING version mismatch: expected %d, got %d\n", EXP_VERSION, Version);
+        return CFE_ES_ERR_APP_CREATE;
+    } /* end if */
+
+    OS_printf("SBN_TCP_URING Lib Initialized.\n");
+    return CFE_SUCCESS;
+} /* end Init() */
+
+static SBN_Status_t ConfAddr(struct sockaddr_in *Addr, const char *Address)
+{
+    char  AddrHost[OS_MAX_API_NAME];
+    int   AddrLen;
+    char *Colon = strchr(Address, ':');
+
+    if (!Colon || (AddrLen = Colon - Address) >= OS_MAX_API_NAME)
+    {
+        EVSSendErr(SBN_TCP_URING_CONFIG_EID, "invalid net address");
+        return SBN_ERROR;
+    } /* end if */
+
+    strncpy(AddrHost, Address, AddrLen);
+    AddrHost[AddrLen] = '\0';
+    char *ValidatePtr = NULL;
+
+    long Port = strtol(Colon + 1, &ValidatePtr, 0);
+
+    if (!ValidatePtr || ValidatePtr == Colon + 1 || Port < 0 || Port > 0xFFFF)
+    {
+        EVSSendErr(SBN_TCP_URING_CONFIG_EID, "invalid port");
+        return SBN_ERROR;
+    } /* end if */
+
+    memset(Addr, 0, sizeof(*Addr));
+    Addr->sin_family = AF_INET;
+    Addr->sin_port   = htons((uint16)Port);
+
+    if (inet_pton(AF_INET, AddrHost, &Addr->sin_addr) != 1)
+    {
+        EVSSendErr(SBN_TCP_URING_SOCK_EID, "setting address host failed (AddrHost=%s)", AddrHost);
+        return SBN_ERROR;
+    } /* end if */
+
+    return SBN_SUCCESS;
+} /* end ConfAddr() */
+
+/** Gets a submission queue entry, submitting what is queued if there is none free. */
+static struct io_uring_sqe *GetSQE(SBN_TCP_URING_Ring_t *Ring)
+{
+    struct io_uring_sqe *SQE = io_uring_get_sqe(&Ring->Ring);
+
+    if (SQE == NULL)
+    {
+        io_uring_submit(&Ring->Ring);
+        SQE = io_uring_get_sqe(&Ring->Ring);
+    } /* end if */
+
+    return SQE;
+} /* end GetSQE() */
+
+/**
+ * Posts a multishot receive on a connection, taking its buffers from the
+ * net's buffer ring. Called with the net's mutex held.
+ */
+static SBN_Status_t ArmRecv(SBN_TCP_URING_Ring_t *Ring, SBN_TCP_URING_Conn_t *Conn)
+{
+    struct io_uring_sqe *SQE = GetSQE(Ring);
+
+    if (SQE == NULL)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    io_uring_prep_recv_multishot(SQE, Conn->Socket, NULL, 0, 0);
+    SQE->flags |= IOSQE_BUFFER_SELECT;
+    SQE->buf_group = SBN_TCP_URING_BGID;
+    io_uring_sqe_set_data64(SQE, USER_DATA(Conn - Ring->Conns, OP_RECV));
+
+    Conn->OpsInFlight++;
+
+    io_uring_submit(&Ring->Ring);
+
+    return SBN_SUCCESS;
+} /* end ArmRecv() */
+
+/**
+ * Sends what is left of the send in flight. Called with the net's mutex
+ * held.
+ */
+static SBN_Status_t PrepSend(SBN_TCP_URING_Ring_t *Ring, SBN_TCP_URING_Conn_t *Conn)
+{
+    struct io_uring_sqe *SQE = GetSQE(Ring);
+
+    if (SQE == NULL)
+    {
+        Conn->SendSz = 0;
+        return SBN_ERROR;
+    } /* end if */
+
+    io_uring_prep_send(SQE, Conn->Socket, Conn->SendQ[!Conn->Fill] + Conn->SentSz, Conn->SendSz - Conn->SentSz,
+                       MSG_NOSIGNAL | MSG_WAITALL);
+    io_uring_sqe_set_data64(SQE, USER_DATA(Conn - Ring->Conns, OP_SEND));
+
+    Conn->OpsInFlight++;
+
+    io_uring_submit(&Ring->Ring);
+
+    return SBN_SUCCESS;
+} /* end PrepSend() */
+
+/**
+ * Sends the frames queued on a connection as one send and starts queueing
+ * into the other buffer. Called with the net's mutex held and no send in
+ * flight.
+ */
+static SBN_Status_t SubmitSend(SBN_TCP_URING_Ring_t *Ring, SBN_TCP_URING_Conn_t *Conn)
+{
+    Conn->SendSz = Conn->FillSz;
+    Conn->SentSz = 0;
+    Conn->Fill   = !Conn->Fill;
+    Conn->FillSz = 0;
+
+    return PrepSend(Ring, Conn);
+} /* end SubmitSend() */
+
+static SBN_TCP_URING_Conn_t *NewConn(SBN_TCP_URING_Net_t *NetData, int Socket)
+{
+    SBN_TCP_URING_Ring_t *Ring   = NetData->Ring;
+    SBN_TCP_URING_Conn_t *Conn   = NULL;
+    int                   ConnID = 0, NoDelay = 1;
+
+    if (Ring == NULL)
+    {
+        return NULL;
+    } /* end if */
+
+    OS_MutSemTake(NetData->Mutex);
+
+    /* a closed connection is reused once the kernel is done with its buffers */
+    for (ConnID = 0; ConnID < Ring->ConnCnt && (Ring->Conns[ConnID].InUse || Ring->Conns[ConnID].OpsInFlight);
+         ConnID++)
+        ;
+
+    if (ConnID == Ring->ConnCnt)
+    {
+        OS_MutSemGive(NetData->Mutex);
+        EVSSendErr(SBN_TCP_URING_SOCK_EID, "no free connections, closing socket");
+        return NULL;
+    } /* end if */
+
+    Conn = &Ring->Conns[ConnID];
+
+    Conn->RecvOff       = 0;
+    Conn->RecvSz        = 0;
+    Conn->Fill          = 0;
+    Conn->FillSz        = 0;
+    Conn->SendSz        = 0;
+    Conn->SentSz        = 0;
+    Conn->PeerInterface = NULL;
+
+    Conn->Socket = Socket;
+
+    /* frames are batched here, do not let the stack hold them back as well */
+    setsockopt(Socket, IPPROTO_TCP, TCP_NODELAY, &NoDelay, sizeof(NoDelay));
+
+    if (ArmRecv(Ring, Conn) != SBN_SUCCESS)
+    {
+        OS_MutSemGive(NetData->Mutex);
+        EVSSendErr(SBN_TCP_URING_SOCK_EID, "unable to post receive, closing socket");
+        return NULL;
+    } /* end if */
+
+    Conn->InUse = true;
+
+    OS_MutSemGive(NetData->Mutex);
+
+    return Conn;
+} /* end NewConn() */
+
+static void CloseConn(SBN_TCP_URING_Net_t *NetData, SBN_TCP_URING_Conn_t *Conn)
+{
+    OS_MutSemTake(NetData->Mutex);
+
+    if (Conn->InUse)
+    {
+        /* completes the receive and any send in flight, the kernel holds the socket until they have */
+        shutdown(Conn->Socket, SHUT_RDWR);
+        close(Conn->Socket);
+
+        Conn->InUse         = false;
+        Conn->PeerInterface = NULL;
+    } /* end if */
+
+    OS_MutSemGive(NetData->Mutex);
+} /* end CloseConn() */
+
+static void Disconnected(SBN_PeerInterface_t *Peer)
+{
+    SBN_TCP_URING_Peer_t *PeerData = (SBN_TCP_URING_Peer_t *)Peer->ModulePvt;
+    SBN_TCP_URING_Conn_t *Conn     = PeerData->Conn;
+
+    if (Conn)
+    {
+        CloseConn((SBN_TCP_URING_Net_t *)Peer->Net->ModulePvt, Conn);
+
+        PeerData->Conn = NULL;
+    } /* end if */
+
+    SBN_Disconnected(Peer);
+} /* end Disconnected() */
+
+/** Closes a connection that failed, disconnecting its peer if it has one. */
+static void DropConn(SBN_NetInterface_t *Net, SBN_TCP_URING_Conn_t *Conn)
+{
+    if (Conn->PeerInterface)
+    {
+        Disconnected(Conn->PeerInterface);
+    }
+    else
+    {
+        CloseConn((SBN_TCP_URING_Net_t *)Net->ModulePvt, Conn);
+    } /* end if */
+} /* end DropConn() */
+
+static SBN_Status_t LoadNet(SBN_NetInterface_t *Net, const char *Address)
+{
+    SBN_TCP_URING_Net_t *NetData = (SBN_TCP_URING_Net_t *)Net->ModulePvt;
+
+    EVSSendInfo(SBN_TCP_URING_CONFIG_EID, "configuring net 0x%lx -> %s", (unsigned long int)NetData, Address);
+
+    if (Net->HeartbeatMS == 0)
+    {
+        Net->HeartbeatMS = SBN_TCP_URING_PEER_HEARTBEAT * 1000;
+    } /* end if */
+
+    if (Net->TimeoutMS == 0)
+    {
+        Net->TimeoutMS = SBN_TCP_URING_PEER_TIMEOUT * 1000;
+    } /* end if */
+
+    SBN_Status_t Status = ConfAddr(&NetData->Addr, Address);
+
+    if (Status == SBN_SUCCESS)
+    {
+        EVSSendInfo(SBN_TCP_URING_CONFIG_EID, "net 0x%lx configured", (unsigned long int)NetData);
+    } /* end if */
+
+    return Status;
+} /* end LoadNet() */
+
+static SBN_Status_t LoadPeer(SBN_PeerInterface_t *Peer, const char *Address)
+{
+    SBN_TCP_URING_Peer_t *PeerData = (SBN_TCP_URING_Peer_t *)Peer->ModulePvt;
+
+    EVSSendInfo(SBN_TCP_URING_CONFIG_EID, "configuring peer 0x%lx -> %s", (unsigned long int)PeerData, Address);
+
+    SBN_Status_t Status = ConfAddr(&PeerData->Addr, Address);
+
+    if (Status == SBN_SUCCESS)
+    {
+        EVSSendInfo(SBN_TCP_URING_CONFIG_EID, "peer 0x%lx configured", (unsigned long int)PeerData);
+    } /* end if */
+
+    return Status;
+} /* end LoadPeer() */
+
+/**
+ * Sets up the net's ring and its buffer ring, with all the receive buffers
+ * provided to the kernel.
+ *
+ * @return SBN_SUCCESS on success, SBN_ERROR otherwise
+ */
+static SBN_Status_t InitRing(SBN_TCP_URING_Ring_t *Ring)
+{
+    int Status = 0, BufID = 0;
+
+    Status = io_uring_queue_init(SBN_TCP_URING_SQ_DEPTH, &Ring->Ring, 0);
+    if (Status < 0)
+    {
+        EVSSendErr(SBN_TCP_URING_SOCK_EID, "unable to create ring (%d)", Status);
+        return SBN_ERROR;
+    } /* end if */
+
+    Ring->Bufs = malloc(SBN_TCP_URING_BUF_CNT * SBN_TCP_URING_BUF_SZ);
+    if (Ring->Bufs == NULL)
+    {
+        EVSSendErr(SBN_TCP_URING_SOCK_EID, "unable to allocate receive buffers");
+        return SBN_ERROR;
+    } /* end if */
+
+    Ring->BufRing = io_uring_setup_buf_ring(&Ring->Ring, SBN_TCP_URING_BUF_CNT, SBN_TCP_URING_BGID, 0, &Status);
+    if (Ring->BufRing == NULL)
+    {
+        EVSSendErr(SBN_TCP_URING_SOCK_EID, "unable to register buffer ring (%d)", Status);
+        return SBN_ERROR;
+    } /* end if */
+
+    for (BufID = 0; BufID < SBN_TCP_URING_BUF_CNT; BufID++)
+    {
+        io_uring_buf_ring_add(Ring->BufRing, Ring->Bufs + BufID * SBN_TCP_URING_BUF_SZ, SBN_TCP_URING_BUF_SZ, BufID,
+                              io_uring_buf_ring_mask(SBN_TCP_URING_BUF_CNT), BufID);
+    } /* end for */
+
+    io_uring_buf_ring_advance(Ring->BufRing, SBN_TCP_URING_BUF_CNT);
+
+    return SBN_SUCCESS;
+} /* end InitRing() */
+
+/**
+ * Initializes a TCP (io_uring) net: its server socket, its ring and its
+ * connections.
+ *
+ * @param  Interface data structure containing the file entry
+ * @return SBN_SUCCESS on success, error code otherwise
+ */
+static SBN_Status_t InitNet(SBN_NetInterface_t *Net)
+{
+    static int           MutexCnt = 0;
+    SBN_TCP_URING_Net_t *NetData  = (SBN_TCP_URING_Net_t *)Net->ModulePvt;
+    int                  Socket = 0, ReuseAddr = 1, ConnCnt = Net->PeerCnt + SBN_TCP_URING_SPARE_CONNS;
+    char                 MutexName[OS_MAX_API_NAME];
+
+    Socket = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (Socket < 0)
+    {
+        EVSSendErr(SBN_TCP_URING_SOCK_EID, "unable to create socket");
+        return SBN_ERROR;
+    } /* end if */
+
+    setsockopt(Socket, SOL_SOCKET, SO_REUSEADDR, &ReuseAddr, sizeof(ReuseAddr));
+
+    if (bind(Socket, (struct sockaddr *)&NetData->Addr, sizeof(NetData->Addr)) != 0 || listen(Socket, SOMAXCONN) != 0)
+    {
+        EVSSendErr(SBN_TCP_URING_SOCK_EID, "bind call failed (0x%lx errno=%d)", (unsigned long int)NetData, errno);
+        close(Socket);
+        return SBN_ERROR;
+    } /* end if */
+
+    NetData->Socket = Socket;
+
+    snprintf(MutexName, sizeof(MutexName), "sbn_tcpu_%d", MutexCnt);
+    if (OS_MutSemCreate(&NetData->Mutex, MutexName, 0) != OS_SUCCESS)
+    {
+        EVSSendErr(SBN_TCP_URING_SOCK_EID, "unable to create mutex");
+        return SBN_ERROR;
+    } /* end if */
+
+    snprintf(MutexName, sizeof(MutexName), "sbn_tcpr_%d", MutexCnt++);
+    if (OS_MutSemCreate(&NetData->RecvMutex, MutexName, 0) != OS_SUCCESS)
+    {
+        EVSSendErr(SBN_TCP_URING_SOCK_EID, "unable to create mutex");
+        return SBN_ERROR;
+    } /* end if */
+
+    NetData->Closing = false;
+
+    NetData->Ring = calloc(1, sizeof(*NetData->Ring) + ConnCnt * sizeof(SBN_TCP_URING_Conn_t));
+    if (NetData->Ring == NULL)
+    {
+        EVSSendErr(SBN_TCP_URING_SOCK_EID, "unable to allocate %d connections", ConnCnt);
+        return SBN_ERROR;
+    } /* end if */
+
+    NetData->Ring->ConnCnt = ConnCnt;
+
+    return InitRing(NetData->Ring);
+} /* end InitNet() */
+
+/**
+ * Initializes a TCP (io_uring) peer.
+ *
+ * @param  Interface data structure containing the file entry
+ * @return SBN_SUCCESS on success, error code otherwise
+ */
+static SBN_Status_t InitPeer(SBN_PeerInterface_t *Peer)
+{
+    SBN_TCP_URING_Peer_t *PeerData = (SBN_TCP_URING_Peer_t *)Peer->ModulePvt;
+
+    PeerData->ConnectOut = (Peer->ProcessorID > CFE_PSP_GetProcessorId());
+
+    return SBN_SUCCESS;
+} /* end InitPeer() */
+
+static void CheckNet(SBN_NetInterface_t *Net)
+{
+    SBN_TCP_URING_Net_t *NetData  = (SBN_TCP_URING_Net_t *)Net->ModulePvt;
+    SBN_PeerIdx_t        PeerIdx  = 0;
+    int                  ClientFd = 0;
+
+    OS_time_t LocalTime;
+    OS_GetLocalTime(&LocalTime);
+
+    while ((ClientFd = accept4(NetData->Socket, NULL, NULL, SOCK_CLOEXEC)) >= 0)
+    {
+        if (NewConn(NetData, ClientFd) == NULL)
+        {
+            close(ClientFd);
+        } /* end if */
+    }     /* end while */
+
+    if (errno != EAGAIN && errno != EWOULDBLOCK)
+    {
+        EVSSendErr(SBN_TCP_URING_DEBUG_EID, "CPU accept error");
+    } /* end if */
+
+    /**
+     * For peers I connect out to, and which are not currently connected,
+     * try connecting now.
+     */
+    for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
+    {
+        SBN_PeerInterface_t * Peer     = &Net->Peers[PeerIdx];
+        SBN_TCP_URING_Peer_t *PeerData = (SBN_TCP_URING_Peer_t *)Peer->ModulePvt;
+
+        if (Peer->Unused)
+        {
+            continue;
+        } /* end if */
+
+        if (PeerData->ConnectOut && !Peer->Connected &&
+            LocalTime.seconds > PeerData->LastConnectTry.seconds + SBN_TCP_URING_CONNECT_RETRY)
+        {
+            /* bounds connect(), cleared once connected */
+            struct timeval        Timeout = {0, 100000};
+            SBN_TCP_URING_Conn_t *Conn    = NULL;
+            int                   Socket  = 0;
+
+            EVSSendInfo(SBN_TCP_URING_DEBUG_EID, "connecting to peer (PeerData=0x%lx, ProcessorID=%d)",
+                        (unsigned long int)PeerData, Peer->ProcessorID);
+
+            PeerData->LastConnectTry.seconds = LocalTime.seconds;
+
+            Socket = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            if (Socket < 0)
+            {
+                EVSSendErr(SBN_TCP_URING_SOCK_EID, "unable to create socket");
+                continue;
+            } /* end if */
+
+            setsockopt(Socket, SOL_SOCKET, SO_SNDTIMEO, &Timeout, sizeof(Timeout));
+
+            if (connect(Socket, (struct sockaddr *)&PeerData->Addr, sizeof(PeerData->Addr)) != 0)
+            {
+                EVSSendErr(SBN_TCP_URING_SOCK_EID, "unable to connect to peer (PeerData=0x%lx)",
+                           (unsigned long int)PeerData);
+
+                close(Socket);
+
+                /* the other peers may well be reachable */
+                continue;
+            } /* end if */
+
+            EVSSendInfo(SBN_TCP_URING_DEBUG_EID, "CPU %d connected", Peer->ProcessorID);
+
+            /* a send that has to block, in the kernel's worker, is not to time out */
+            Timeout.tv_usec = 0;
+            setsockopt(Socket, SOL_SOCKET, SO_SNDTIMEO, &Timeout, sizeof(Timeout));
+
+            Conn = NewConn(NetData, Socket);
+            if (Conn)
+            {
+                Conn->PeerInterface = Peer;
+                PeerData->Conn      = Conn;
+
+                SBN_Connected(Peer);
+            }
+            else
+            {
+                close(Socket);
+            } /* end if */
+        }     /* end if */
+    }         /* end for */
+} /* end CheckNet() */
+
+static SBN_Status_t Send(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Msg)
+{
+    SBN_TCP_URING_Peer_t *PeerData = (SBN_TCP_URING_Peer_t *)Peer->ModulePvt;
+    SBN_TCP_URING_Net_t * NetData  = (SBN_TCP_URING_Net_t *)Peer->Net->ModulePvt;
+    SBN_TCP_URING_Conn_t *Conn     = NULL;
+    SBN_Status_t          Status   = SBN_SUCCESS;
+
+    OS_MutSemTake(NetData->Mutex);
+
+    Conn = PeerData->Conn;
+
+    if (Conn == NULL || !Conn->InUse)
+    {
+        /* fail silently as the peer is not connected (yet) */
+        OS_MutSemGive(NetData->Mutex);
+        return 0;
+    } /* end if */
+
+    if (Conn->FillSz + SBN_PACKED_HDR_SZ + MsgSz > SBN_TCP_URING_SENDQ_SZ)
+    {
+        /* the peer is not keeping up */
+        OS_MutSemGive(NetData->Mutex);
+        EVSSendDbg(SBN_TCP_URING_DEBUG_EID, "CPU %d send queue full, message dropped", Peer->ProcessorID);
+        return SBN_ERROR;
+    } /* end if */
+
+    SBN_PackMsg(Conn->SendQ[Conn->Fill] + Conn->FillSz, MsgSz, MsgType, CFE_PSP_GetProcessorId(), Msg);
+    Conn->FillSz += MsgSz + SBN_PACKED_HDR_SZ;
+
+    if (Conn->SendSz == 0)
+    {
+        /* otherwise sent with whatever else is queued when the send in flight completes */
+        Status = SubmitSend(NetData->Ring, Conn);
+    } /* end if */
+
+    OS_MutSemGive(NetData->Mutex);
+
+    return Status;
+} /* end Send() */
+
+static SBN_Status_t PollPeer(SBN_PeerInterface_t *Peer)
+{
+    /* at least every second, more often if the net's heartbeats or timeout need it */
+    SBN_SchedulePoll(Peer, SBN_LivenessPollMS(Peer));
+
+    if (Peer == &Peer->Net->Peers[0])
+    {
+        /* accepting and connecting out is for the whole net, do it once */
+        CheckNet(Peer->Net);
+    } /* end if */
+
+    if (!Peer->Connected)
+    {
+        return SBN_SUCCESS;
+    } /* end if */
+
+    if (SBN_HeartbeatDue(Peer))
+    {
+        /* through SBN, so that LastSend is stamped */
+        SBN_SendNetMsg(SBN_TCP_URING_HEARTBEAT_MSG, 0, NULL, Peer);
+    } /* end if */
+
+    if (SBN_PeerTimedOut(Peer))
+    {
+        EVSSendInfo(SBN_TCP_URING_DEBUG_EID, "CPU %d timeout, disconnected", Peer->ProcessorID);
+
+        Disconnected(Peer);
+    } /* end if */
+
+    return SBN_SUCCESS;
+} /* end PollPeer() */
+
+/**
+ * Handles a completion of a connection's multishot receive: appends what was
+ * received to what the connection has yet to decode and hands the buffer
+ * back to the kernel. Posts the receive again if the kernel ended it without
+ * the connection failing.
+ */
+static void RecvDone(SBN_NetInterface_t *Net, SBN_TCP_URING_Conn_t *Conn, int Res, uint32 Flags)
+{
+    SBN_TCP_URING_Net_t * NetData = (SBN_TCP_URING_Net_t *)Net->ModulePvt;
+    SBN_TCP_URING_Ring_t *Ring    = NetData->Ring;
+    bool                  Failed  = false;
+
+    if (Flags & IORING_CQE_F_BUFFER)
+    {
+        int    BufID = Flags >> IORING_CQE_BUFFER_SHIFT;
+        uint8 *Buf   = Ring->Bufs + BufID * SBN_TCP_URING_BUF_SZ;
+
+        if (Res > 0 && Conn->InUse)
+        {
+            /* everything complete was decoded before this was reaped, so less than a frame is left */
+            memmove(Conn->RecvBuf, Conn->RecvBuf + Conn->RecvOff, Conn->RecvSz - Conn->RecvOff);
+            Conn->RecvSz -= Conn->RecvOff;
+            Conn->RecvOff = 0;
+
+            if (Conn->RecvSz + Res <= (int)sizeof(Conn->RecvBuf))
+            {
+                memcpy(Conn->RecvBuf + Conn->RecvSz, Buf, Res);
+                Conn->RecvSz += Res;
+            }
+            else
+            {
+                Failed = true;
+            } /* end if */
+        }     /* end if */
+
+        io_uring_buf_ring_add(Ring->BufRing, Buf, SBN_TCP_URING_BUF_SZ, BufID,
+                              io_uring_buf_ring_mask(SBN_TCP_URING_BUF_CNT), 0);
+        io_uring_buf_ring_advance(Ring->BufRing, 1);
+    } /* end if */
+
+    if (!(Flags & IORING_CQE_F_MORE))
+    {
+        OS_MutSemTake(NetData->Mutex);
+
+        Conn->OpsInFlight--;
+
+        /* out of buffers for the moment, or the kernel chose to end it */
+        if (Conn->InUse && !Failed && (Res > 0 || Res == -ENOBUFS) && ArmRecv(Ring, Conn) == SBN_SUCCESS)
+        {
+            OS_MutSemGive(NetData->Mutex);
+            return;
+        } /* end if */
+
+        OS_MutSemGive(NetData->Mutex);
+
+        Failed = true;
+    } /* end if */
+
+    if (Failed && Conn->InUse)
+    {
+        EVSSendInfo(SBN_TCP_URING_DEBUG_EID, "Connection %d recv failed (%d), disconnected",
+                    (int)(Conn - Ring->Conns), Res);
+
+        DropConn(Net, Conn);
+    } /* end if */
+} /* end RecvDone() */
+
+/**
+ * Handles a completion of a connection's send: sends the rest if it was
+ * short, otherwise whatever was queued while it was in flight.
+ */
+static void SendDone(SBN_NetInterface_t *Net, SBN_TCP_URING_Conn_t *Conn, int Res)
+{
+    SBN_TCP_URING_Net_t *NetData = (SBN_TCP_URING_Net_t *)Net->ModulePvt;
+    SBN_Status_t         Status  = SBN_SUCCESS;
+
+    OS_MutSemTake(NetData->Mutex);
+
+    Conn->OpsInFlight--;
+
+    if (!Conn->InUse)
+    {
+        OS_MutSemGive(NetData->Mutex);
+        return;
+    } /* end if */
+
+    if (Res <= 0)
+    {
+        Status = SBN_ERROR;
+    }
+    else if ((Conn->SentSz += Res) < Conn->SendSz)
+    {
+        Status = PrepSend(NetData->Ring, Conn);
+    }
+    else
+    {
+        Conn->SendSz = 0;
+
+        if (Conn->FillSz)
+        {
+            Status = SubmitSend(NetData->Ring, Conn);
+        } /* end if */
+    }     /* end if */
+
+    OS_MutSemGive(NetData->Mutex);
+
+    if (Status != SBN_SUCCESS)
+    {
+        EVSSendInfo(SBN_TCP_URING_DEBUG_EID, "Connection %d failed to write (%d), disconnected",
+                    (int)(Conn - NetData->Ring->Conns), Res);
+
+        DropConn(Net, Conn);
+    } /* end if */
+} /* end SendDone() */
+
+/**
+ * Decodes the next complete frame any connection has received, starting
+ * after the connection last decoded from so that a busy connection does not
+ * starve the others.
+ *
+ * @return SBN_SUCCESS when a message was decoded, SBN_IF_EMPTY when no
+ *         connection has a complete frame, SBN_ERROR if the message could
+ *         not be unpacked.
+ */
+static SBN_Status_t DecodeFrame(SBN_NetInterface_t *Net, SBN_MsgType_t *MsgTypePtr, SBN_MsgSz_t *MsgSzPtr,
+                                CFE_ProcessorID_t *ProcessorIDPtr, void *MsgBuf)
+{
+    SBN_TCP_URING_Ring_t *Ring = ((SBN_TCP_URING_Net_t *)Net->ModulePvt)->Ring;
+    int                   i = 0, FrameSz = 0;
+
+    for (i = 0; i < Ring->ConnCnt; i++)
+    {
+        SBN_TCP_URING_Conn_t *Conn  = &Ring->Conns[(Ring->NextConn + i) % Ring->ConnCnt];
+        uint8 *               Frame = Conn->RecvBuf + Conn->RecvOff;
+        bool                  Unpacked;
+
+        if (!Conn->InUse || Conn->RecvSz - Conn->RecvOff < (int)SBN_PACKED_HDR_SZ)
+        {
+            continue;
+        } /* end if */
+
+        FrameSz = (uint16)CFE_MAKE_BIG16(*((SBN_MsgSz_t *)Frame)) + SBN_PACKED_HDR_SZ;
+
+        if (FrameSz > (int)SBN_MAX_PACKED_MSG_SZ)
+        {
+            EVSSendInfo(SBN_TCP_URING_DEBUG_EID, "Connection %d sent a bad frame, disconnected",
+                        (int)(Conn - Ring->Conns));
+
+            DropConn(Net, Conn);
+            continue;
+        } /* end if */
+
+        if (Conn->RecvSz - Conn->RecvOff < FrameSz)
+        {
+            continue; /* wait for the complete frame */
+        }             /* end if */
+
+        Ring->NextConn = (Conn - Ring->Conns + 1) % Ring->ConnCnt;
+
+        Unpacked = SBN_UnpackMsg(Frame, MsgSzPtr, MsgTypePtr, ProcessorIDPtr, MsgBuf);
+        Conn->RecvOff += FrameSz;
+
+        if (!Unpacked)
+        {
+            return SBN_ERROR;
+        } /* end if */
+
+        if (!Conn->PeerInterface)
+        {
+            /* New peer, link it to the connection */
+            SBN_PeerInterface_t *PeerInterface = SBN_GetPeer(Net, *ProcessorIDPtr);
+
+            if (PeerInterface != NULL)
+            {
+                SBN_TCP_URING_Peer_t *PeerData = (SBN_TCP_URING_Peer_t *)PeerInterface->ModulePvt;
+
+                if (PeerData->Conn != NULL)
+                {
+                    /* the peer restarted before its old connection was found closed */
+                    EVSSendInfo(SBN_TCP_URING_DEBUG_EID, "CPU %d reconnected, closing its old connection",
+                                PeerInterface->ProcessorID);
+
+                    Disconnected(PeerInterface);
+                } /* end if */
+
+                PeerData->Conn = Conn;
+
+                Conn->PeerInterface = PeerInterface;
+
+                SBN_Connected(PeerInterface);
+            } /* end if */
+        }     /* end if */
+
+        return SBN_SUCCESS;
+    } /* end for */
+
+    return SBN_IF_EMPTY;
+} /* end DecodeFrame() */
+
+/**
+ * Returns the next message received on the net. Frames already received are
+ * decoded first; only then are completions reaped, which takes no syscall
+ * while there are any. A receive task waits up to a second for one. Called
+ * with the net's receive mutex held.
+ */
+static SBN_Status_t RecvRing(SBN_NetInterface_t *Net, SBN_MsgType_t *MsgTypePtr, SBN_MsgSz_t *MsgSzPtr,
+                             CFE_ProcessorID_t *ProcessorIDPtr, void *MsgBuf)
+{
+    SBN_TCP_URING_Net_t *    NetData = (SBN_TCP_URING_Net_t *)Net->ModulePvt;
+    SBN_TCP_URING_Ring_t *   Ring    = NetData->Ring;
+    struct io_uring_cqe *    CQE     = NULL;
+    struct __kernel_timespec Timeout = {1, 0};
+    SBN_Status_t             Status  = SBN_IF_EMPTY;
+    bool                     Waited  = false;
+
+    while (1)
+    {
+        uint64 Data  = 0;
+        int    Res   = 0;
+        uint32 Flags = 0;
+
+        Status = DecodeFrame(Net, MsgTypePtr, MsgSzPtr, ProcessorIDPtr, MsgBuf);
+        if (Status != SBN_IF_EMPTY)
+        {
+            return Status;
+        } /* end if */
+
+        if (io_uring_peek_cqe(&Ring->Ring, &CQE) != 0)
+        {
+            if (!(Net->TaskFlags & SBN_TASK_RECV) || Waited)
+            {
+                return SBN_IF_EMPTY;
+            } /* end if */
+
+            /* the kernels this needs take the timeout as an argument, so this does not touch the submission queue */
+            Waited = true;
+            if (io_uring_wait_cqe_timeout(&Ring->Ring, &CQE, &Timeout) != 0)
+            {
+                return SBN_IF_EMPTY;
+            } /* end if */
+        }     /* end if */
+
+        Data  = io_uring_cqe_get_data64(CQE);
+        Res   = CQE->res;
+        Flags = CQE->flags;
+        io_uring_cqe_seen(&Ring->Ring, CQE);
+
+        if (Data == WAKE_DATA)
+        {
+            /* the net is being unloaded */
+            return SBN_IF_EMPTY;
+        }
+        else if ((Data & 1) == OP_RECV)
+        {
+            RecvDone(Net, &Ring->Conns[Data >> 1], Res, Flags);
+        }
+        else
+        {
+            SendDone(Net, &Ring->Conns[Data >> 1], Res);
+        } /* end if */
+    }     /* end while */
+} /* end RecvRing() */
+
+static SBN_Status_t Recv(SBN_NetInterface_t *Net, SBN_MsgType_t *MsgTypePtr, SBN_MsgSz_t *MsgSzPtr,
+                         CFE_ProcessorID_t *ProcessorIDPtr, void *MsgBuf)
+{
+    SBN_TCP_URING_Net_t *NetData = (SBN_TCP_URING_Net_t *)Net->ModulePvt;
+    SBN_Status_t         Status  = SBN_IF_EMPTY;
+
+    if (NetData->Ring == NULL || OS_MutSemTake(NetData->RecvMutex) != OS_SUCCESS)
+    {
+        return SBN_IF_EMPTY;
+    } /* end if */
+
+    /* UnloadNet() may have torn the ring down while I waited for the mutex */
+    if (NetData->Ring != NULL && !NetData->Closing)
+    {
+        Status = RecvRing(Net, MsgTypePtr, MsgSzPtr, ProcessorIDPtr, MsgBuf);
+    } /* end if */
+
+    OS_MutSemGive(NetData->RecvMutex);
+
+    return Status;
+} /* end Recv() */
+
+static SBN_Status_t UnloadPeer(SBN_PeerInterface_t *Peer)
+{
+    Disconnected(Peer);
+
+    return SBN_SUCCESS;
+} /* end UnloadPeer() */
+
+/**
+ * Stops the net's receives: Recv() no longer waits on the ring, and one
+ * waiting now is woken by a no-op's completion rather than its timeout.
+ */
+static void WakeRecv(SBN_TCP_URING_Net_t *NetData)
+{
+    struct io_uring_sqe *SQE = NULL;
+
+    OS_MutSemTake(NetData->Mutex);
+
+    NetData->Closing = true;
+
+    SQE = GetSQE(NetData->Ring);
+    if (SQE != NULL)
+    {
+        io_uring_prep_nop(SQE);
+        io_uring_sqe_set_data64(SQE, WAKE_DATA);
+        io_uring_submit(&NetData->Ring->Ring);
+    } /* end if */
+
+    OS_MutSemGive(NetData->Mutex);
+} /* end WakeRecv() */
+
+static SBN_Status_t UnloadNet(SBN_NetInterface_t *Net)
+{
+    SBN_TCP_URING_Net_t *NetData = (SBN_TCP_URING_Net_t *)Net->ModulePvt;
+    SBN_PeerIdx_t        PeerIdx = 0;
+    int                  ConnID  = 0;
+
+    if (NetData->Socket)
+    {
+        close(NetData->Socket);
+    } /* end if */
+
+    if (NetData->Ring)
+    {
+        /* the receive task may be stopping, but still waiting on the ring */
+        WakeRecv(NetData);
+        OS_MutSemTake(NetData->RecvMutex);
+    } /* end if */
+
+    for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
+    {
+        if (!Net->Peers[PeerIdx].Unused)
+        {
+            UnloadPeer(&Net->Peers[PeerIdx]);
+        } /* end if */
+    }     /* end for */
+
+    if (NetData->Ring)
+    {
+        for (ConnID = 0; ConnID < NetData->Ring->ConnCnt; ConnID++)
+        {
+            /* accepted, but the peer never identified itself */
+            CloseConn(NetData, &NetData->Ring->Conns[ConnID]);
+        } /* end for */
+
+        /* cancels what is still in flight */
+        if (NetData->Ring->BufRing)
+        {
+            io_uring_free_buf_ring(&NetData->Ring->Ring, NetData->Ring->BufRing, SBN_TCP_URING_BUF_CNT,
+                                   SBN_TCP_URING_BGID);
+        } /* end if */
+
+        io_uring_queue_exit(&NetData->Ring->Ring);
+
+        free(NetData->Ring->Bufs);
+        free(NetData->Ring);
+        NetData->Ring = NULL;
+
+        OS_MutSemGive(NetData->RecvMutex);
+        OS_MutSemDelete(NetData->RecvMutex);
+        OS_MutSemDelete(NetData->Mutex);
+    } /* end if */
+
+    return SBN_SUCCESS;
+} /* end UnloadNet() */
+
+SBN_IfOps_t SBN_TCP_URING_Ops = {Init, InitNet, InitPeer, LoadNet,   LoadPeer,   PollPeer,
+                                 Send, NULL,    Recv,     UnloadNet, UnloadPeer, NULL};
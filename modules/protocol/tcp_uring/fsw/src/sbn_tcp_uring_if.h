@@ -0,0 +1,128 @@
+#ifndef _SBN_TCP_URING_IF_H_
+#define _SBN_TCP_URING_IF_H_
+
+#include "sbn_interfaces.h"
+#include "sbn_platform_cfg.h"
+#include "cfe.h"
+#include "sbn_tcp_uring_events.h"
+
+#include <liburing.h>
+#include <netinet/in.h>
+
+/**
+ * A Linux-only alternative to the TCP module, on the wire the same (so the
+ * two interoperate) but built on io_uring. Each connection has a multishot
+ * receive posted, filling buffers from a ring provided to the kernel, so a
+ * busy connection costs no syscalls to read; completions are reaped from
+ * shared memory and fed to the frame decoder. Frames sent while a
+ * connection's previous send is still in flight are packed back to back and
+ * go out as one send when it completes, so the sends batch themselves under
+ * load. Needs liburing 2.4 and a 6.0 kernel or later.
+ */
+
+#define SBN_TCP_URING_HEARTBEAT_MSG 0xA0
+
+/**
+ * If I haven't sent a message in SBN_TCP_URING_PEER_HEARTBEAT seconds, send
+ * an empty one just to maintain the connection. If this is set to 0, no
+ * heartbeat messages will be generated. Only for nets whose configuration
+ * leaves HeartbeatMS 0.
+ */
+#define SBN_TCP_URING_PEER_HEARTBEAT 5
+
+/**
+ * If I haven't received a message from a peer in SBN_TCP_URING_PEER_TIMEOUT
+ * seconds, consider the peer lost and disconnect. If this is set to 0, no
+ * timeout is checked. Only for nets whose configuration leaves TimeoutMS 0;
+ * the failure detector may disconnect sooner, see SBN_PeerTimedOut().
+ */
+#define SBN_TCP_URING_PEER_TIMEOUT 0
+
+/**
+ * Connections a net has room for beyond one per peer, for connections
+ * accepted before the peer is known or before the peer's previous connection
+ * is found to be closed.
+ */
+#define SBN_TCP_URING_SPARE_CONNS 4
+
+/** Seconds between attempts to connect out to a peer. */
+#define SBN_TCP_URING_CONNECT_RETRY 5
+
+/** Entries in a net's submission queue, the completion queue is twice as deep. */
+#define SBN_TCP_URING_SQ_DEPTH 256
+
+/**
+ * The receive buffers a net provides to the kernel, shared by its
+ * connections, and their size. The count must be a power of two. Each is
+ * returned to the kernel as soon as its data is copied to the connection.
+ */
+#define SBN_TCP_URING_BUF_CNT 64
+#define SBN_TCP_URING_BUF_SZ  4096
+
+/**
+ * The bytes of frames a connection queues while its previous send is in
+ * flight, at least SBN_MAX_PACKED_MSG_SZ. Frames that do not fit are dropped
+ * and reported to SBN as send errors.
+ */
+#define SBN_TCP_URING_SENDQ_SZ (2 * SBN_MAX_PACKED_MSG_SZ)
+
+#define SBN_TCP_URING_BGID 0
+
+/* completion user data, the connection's index and which operation */
+#define OP_RECV           0
+#define OP_SEND           1
+#define USER_DATA(ID, OP) (((uint64)(ID) << 1) | (OP))
+
+/* completion user data of the no-op UnloadNet() posts to wake the receive task */
+#define WAKE_DATA (~(uint64)0)
+
+typedef struct
+{
+    bool                 InUse;
+    int                  Socket;
+    int                  OpsInFlight;   /* the multishot receive and the send, not reused until both completed */
+    SBN_PeerInterface_t *PeerInterface; /* affiliated peer, if known */
+
+    /* received bytes from RecvOff to RecvSz are yet to be decoded */
+    int   RecvOff, RecvSz;
+    uint8 RecvBuf[SBN_MAX_PACKED_MSG_SZ + SBN_TCP_URING_BUF_SZ];
+
+    /* frames are packed into SendQ[Fill] while SendQ[!Fill] is being sent */
+    int   Fill, FillSz;
+    int   SendSz, SentSz; /* of the send in flight, SendSz 0 if none */
+    uint8 SendQ[2][SBN_TCP_URING_SENDQ_SZ];
+} SBN_TCP_URING_Conn_t;
+
+/**
+ * A net's ring and connections, allocated by InitNet once the number of
+ * peers is known.
+ */
+typedef struct
+{
+    struct io_uring           Ring;
+    struct io_uring_buf_ring *BufRing;
+    uint8 *                   Bufs;
+    int                       NextConn; /* the connection to decode from first */
+    int                       ConnCnt;
+    SBN_TCP_URING_Conn_t      Conns[];
+} SBN_TCP_URING_Ring_t;
+
+typedef struct
+{
+    struct sockaddr_in    Addr;
+    bool                  ConnectOut;
+    OS_time_t             LastConnectTry;
+    SBN_TCP_URING_Conn_t *Conn; /* when connected and affiliated */
+} SBN_TCP_URING_Peer_t;
+
+typedef struct
+{
+    struct sockaddr_in    Addr;
+    int                   Socket;    /* server socket */
+    OS_MutexID_t          Mutex;     /* for the submission queue and the connections' send state */
+    OS_MutexID_t          RecvMutex; /* held by Recv() while it uses the ring, so UnloadNet() can wait it out */
+    bool                  Closing;   /* set by UnloadNet(), Recv() no longer waits */
+    SBN_TCP_URING_Ring_t *Ring;
+} SBN_TCP_URING_Net_t;
+
+#endif /* _SBN_TCP_URING_IF_H_ */
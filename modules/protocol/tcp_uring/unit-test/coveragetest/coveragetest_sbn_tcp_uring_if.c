@@ -0,0 +1,974 @@
+/*
+**  GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**  Copyright (c) 2006-2020 United States Government as represented by
+**  the Administrator of the National Aeronautics and Space Administration.
+**  All Rights Reserved.
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**    http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+*/
+
+/*
+** File: coveragetest_sbn_tcp_uring_if.c
+**
+** Purpose:
+** Coverage Unit Test cases for the SBN TCP (io_uring) protocol module
+**
+** Notes:
+** liburing and the socket calls are stubbed (see ut-stubs/), so a net's
+** ring is allocated by InitNet() as it would be but never reaches the
+** kernel; completions are handed to Recv() through the stubs' data
+** buffers.
+*/
+
+#include "sbn_stubs.h"
+#include "sbn_tcp_uring_if_coveragetest_common.h"
+#include "sbn_tcp_uring_if.h"
+#include "sbn_app.h"
+#include "ut_sockets.h"
+
+#include <stdlib.h>
+#include <sys/time.h>
+
+#define SBN_PROTOCOL_VERSION 5
+
+#define UT_SERVER_SOCK 3
+
+SBN_App_t SBN;
+
+/* SBN allocates these when it loads its configuration table */
+static SBN_NetInterface_t  Nets[1];
+static SBN_PeerInterface_t Peers[2];
+static SBN_Subs_t          PeerSubs[2][SBN_MAX_SUBS_PER_PEER + 1];
+static SBN_PeerInterface_t *PeerSlots[2];
+
+SBN_NetInterface_t *  NetPtr;
+SBN_PeerInterface_t * PeerPtr;
+SBN_TCP_URING_Net_t * NetData;
+SBN_TCP_URING_Peer_t *PeerData;
+typedef struct
+{
+    uint16      ExpectedEvent;
+    int         MatchCount;
+    const char *ExpectedText;
+} UT_CheckEvent_t;
+UT_CheckEvent_t EventTest;
+
+#define EVENT_CNT(C) \
+    UtAssert_True(EventTest.MatchCount == (C), "SBN_TCP_URING event generated (%d)", EventTest.MatchCount)
+
+#define START() START_fn(__func__, __LINE__)
+
+static void START_fn(const char *fn, int ln)
+{
+    SBN_TCP_URING_Net_t *OldNetData = (SBN_TCP_URING_Net_t *)Nets[0].ModulePvt;
+    int                  PeerIdx    = 0;
+    OS_time_t            LocalTime  = {100, 0};
+
+    /* what the last test's InitNet() allocated, if it did not unload the net */
+    if (OldNetData->Ring)
+    {
+        free(OldNetData->Ring->Bufs);
+        free(OldNetData->Ring);
+    } /* end if */
+
+    UT_ResetState(0);
+    printf("Start item %s (%d)\n", fn, ln);
+    memset(&SBN, 0, sizeof(SBN));
+    memset(Nets, 0, sizeof(Nets));
+    memset(Peers, 0, sizeof(Peers));
+    memset(PeerSubs, 0, sizeof(PeerSubs));
+    SBN.Nets        = Nets;
+    SBN.Peers       = PeerSlots;
+    SBN.PeerSlots   = 2;
+    SBN.PeerCnt     = 2;
+    SBN.NetCnt      = 1;
+    NetPtr          = &SBN.Nets[0];
+    NetPtr->Peers   = Peers;
+    NetPtr->PeerCnt = 2;
+    NetData         = (SBN_TCP_URING_Net_t *)NetPtr->ModulePvt;
+
+    for (PeerIdx = 0; PeerIdx < 2; PeerIdx++)
+    {
+        SBN.Peers[PeerIdx]          = &Peers[PeerIdx];
+        Peers[PeerIdx].Subs         = PeerSubs[PeerIdx];
+        Peers[PeerIdx].MaxSubs      = SBN_MAX_SUBS_PER_PEER;
+        Peers[PeerIdx].Net          = NetPtr;
+        Peers[PeerIdx].ProcessorID  = PeerIdx + 1;
+        Peers[PeerIdx].SpacecraftID = 42;
+    } /* end for */
+
+    PeerPtr  = &NetPtr->Peers[0];
+    PeerData = (SBN_TCP_URING_Peer_t *)PeerPtr->ModulePvt;
+
+    /* CheckNet() gets the time once per poll */
+    UT_SetDataBuffer(UT_KEY(OS_GetLocalTime), &LocalTime, sizeof(LocalTime), true);
+} /* end START_fn() */
+
+extern SBN_IfOps_t SBN_TCP_URING_Ops;
+
+/*
+ * An example hook function to check for a specific event.
+ */
+static int32 UT_CheckEvent_Hook(void *UserObj, int32 StubRetcode, uint32 CallCount, const UT_StubContext_t *Context,
+                                va_list va)
+{
+    UT_CheckEvent_t *State = UserObj;
+    char             TestText[CFE_MISSION_EVS_MAX_MESSAGE_LENGTH];
+    uint16           EventId;
+    const char *     Spec;
+
+    /*
+     * The CFE_EVS_SendEvent stub passes the EventID as the
+     * first context argument.
+     */
+    if (Context->ArgCount > 0)
+    {
+        EventId = UT_Hook_GetArgValueByName(Context, "EventID", uint16);
+        if (EventId == State->ExpectedEvent)
+        {
+            if (State->ExpectedText != NULL)
+            {
+                Spec = UT_Hook_GetArgValueByName(Context, "Spec", const char *);
+                if (Spec != NULL)
+                {
+                    vsnprintf(TestText, sizeof(TestText), Spec, va);
+                    if (strncmp(TestText, State->ExpectedText, strlen(State->ExpectedText)) == 0)
+                    {
+                        ++State->MatchCount;
+                    }
+                }
+            }
+            else
+            {
+                ++State->MatchCount;
+            } /* end if */
+        }     /* end if */
+    }         /* end if */
+
+    return 0;
+} /* end UT_CheckEvent_Hook() */
+
+/*
+ * Helper function to set up for event checking
+ * This attaches the hook function to CFE_EVS_SendEvent
+ */
+static void UT_CheckEvent_Setup(UT_CheckEvent_t *Evt, uint16 ExpectedEvent, const char *ExpectedText)
+{
+    memset(Evt, 0, sizeof(*Evt));
+    Evt->ExpectedEvent = ExpectedEvent;
+    Evt->ExpectedText  = ExpectedText;
+    UT_SetVaHookFunction(UT_KEY(CFE_EVS_SendEvent), UT_CheckEvent_Hook, Evt);
+} /* end UT_CheckEvent_Setup() */
+
+/* Initializes the net, its server socket UT_SERVER_SOCK, with all the stubs succeeding. */
+static void InitNet_Up(void)
+{
+    UT_SetDeferredRetcode(UT_KEY(UT_socket), 1, UT_SERVER_SOCK);
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.InitNet(NetPtr), SBN_SUCCESS);
+} /* end InitNet_Up() */
+
+/* Links a peer to one of the net's connections, as if it had connected on it. */
+static SBN_TCP_URING_Conn_t *Conn_Up(SBN_PeerInterface_t *Peer, int ConnID, int Socket)
+{
+    SBN_TCP_URING_Conn_t *Conn = &NetData->Ring->Conns[ConnID];
+
+    Conn->InUse  = true;
+    Conn->Socket = Socket;
+
+    if (Peer)
+    {
+        SBN_TCP_URING_Peer_t *Data = (SBN_TCP_URING_Peer_t *)Peer->ModulePvt;
+
+        Conn->PeerInterface = Peer;
+        Data->Conn          = Conn;
+        Peer->Connected     = true;
+    } /* end if */
+
+    return Conn;
+} /* end Conn_Up() */
+
+static void Init_VerErr(void)
+{
+    START();
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.InitModule(-1, 0), CFE_ES_ERR_APP_CREATE);
+} /* end Init_VerErr() */
+
+static void Init_Nominal(void)
+{
+    START();
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.InitModule(SBN_PROTOCOL_VERSION, 0), CFE_SUCCESS);
+} /* end Init_Nominal() */
+
+void Test_SBN_TCP_URING_Init(void)
+{
+    Init_VerErr();
+    Init_Nominal();
+} /* end Test_SBN_TCP_URING_Init() */
+
+static void LoadNet_AddrErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(&EventTest, SBN_TCP_URING_CONFIG_EID, "invalid net address");
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.LoadNet(NetPtr, "no colon"), SBN_ERROR);
+
+    EVENT_CNT(1);
+} /* end LoadNet_AddrErr() */
+
+static void LoadNet_PortErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(&EventTest, SBN_TCP_URING_CONFIG_EID, "invalid port");
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.LoadNet(NetPtr, "127.0.0.1:bar"), SBN_ERROR);
+
+    EVENT_CNT(1);
+} /* end LoadNet_PortErr() */
+
+static void LoadNet_HostErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(&EventTest, SBN_TCP_URING_SOCK_EID, "setting address host failed");
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.LoadNet(NetPtr, "localhost:1234"), SBN_ERROR);
+
+    EVENT_CNT(1);
+} /* end LoadNet_HostErr() */
+
+static void LoadNet_Nominal(void)
+{
+    START();
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.LoadNet(NetPtr, "127.0.0.1:1234"), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(NetPtr->HeartbeatMS, SBN_TCP_URING_PEER_HEARTBEAT * 1000);
+    UtAssert_INT32_EQ(NetData->Addr.sin_port, htons(1234));
+} /* end LoadNet_Nominal() */
+
+void Test_SBN_TCP_URING_LoadNet(void)
+{
+    LoadNet_AddrErr();
+    LoadNet_PortErr();
+    LoadNet_HostErr();
+    LoadNet_Nominal();
+} /* end Test_SBN_TCP_URING_LoadNet() */
+
+static void LoadPeer_AddrErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(&EventTest, SBN_TCP_URING_CONFIG_EID, "invalid net address");
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.LoadPeer(PeerPtr, "no colon"), SBN_ERROR);
+
+    EVENT_CNT(1);
+} /* end LoadPeer_AddrErr() */
+
+static void LoadPeer_Nominal(void)
+{
+    START();
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.LoadPeer(PeerPtr, "127.0.0.1:2234"), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(PeerData->Addr.sin_port, htons(2234));
+} /* end LoadPeer_Nominal() */
+
+void Test_SBN_TCP_URING_LoadPeer(void)
+{
+    LoadPeer_AddrErr();
+    LoadPeer_Nominal();
+} /* end Test_SBN_TCP_URING_LoadPeer() */
+
+static void InitNet_SockErr(void)
+{
+    START();
+
+    UT_SetDeferredRetcode(UT_KEY(UT_socket), 1, -1);
+    UT_CheckEvent_Setup(&EventTest, SBN_TCP_URING_SOCK_EID, "unable to create socket");
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.InitNet(NetPtr), SBN_ERROR);
+
+    EVENT_CNT(1);
+} /* end InitNet_SockErr() */
+
+static void InitNet_BindErr(void)
+{
+    START();
+
+    UT_SetDeferredRetcode(UT_KEY(UT_socket), 1, UT_SERVER_SOCK);
+    UT_SetDeferredRetcode(UT_KEY(UT_bind), 1, -1);
+    UT_CheckEvent_Setup(&EventTest, SBN_TCP_URING_SOCK_EID, "bind call failed");
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.InitNet(NetPtr), SBN_ERROR);
+
+    EVENT_CNT(1);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(UT_close)), 1);
+    UtAssert_True(NetData->Ring == NULL, "no ring allocated (%s)", __func__);
+} /* end InitNet_BindErr() */
+
+static void InitNet_RingErr(void)
+{
+    START();
+
+    UT_SetDeferredRetcode(UT_KEY(io_uring_queue_init), 1, -ENOMEM);
+    UT_CheckEvent_Setup(&EventTest, SBN_TCP_URING_SOCK_EID, "unable to create ring");
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.InitNet(NetPtr), SBN_ERROR);
+
+    EVENT_CNT(1);
+} /* end InitNet_RingErr() */
+
+static void InitNet_BufRingErr(void)
+{
+    START();
+
+    UT_SetDeferredRetcode(UT_KEY(io_uring_setup_buf_ring), 1, -EINVAL);
+    UT_CheckEvent_Setup(&EventTest, SBN_TCP_URING_SOCK_EID, "unable to register buffer ring");
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.InitNet(NetPtr), SBN_ERROR);
+
+    EVENT_CNT(1);
+} /* end InitNet_BufRingErr() */
+
+static void InitNet_Nominal(void)
+{
+    START();
+
+    InitNet_Up();
+
+    UtAssert_INT32_EQ(NetData->Socket, UT_SERVER_SOCK);
+    UtAssert_True(NetData->Ring != NULL, "ring allocated (%s)", __func__);
+    UtAssert_INT32_EQ(NetData->Ring->ConnCnt, NetPtr->PeerCnt + SBN_TCP_URING_SPARE_CONNS);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(io_uring_buf_ring_add)), SBN_TCP_URING_BUF_CNT);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(OS_MutSemCreate)), 2);
+    UtAssert_True(!NetData->Closing, "not closing (%s)", __func__);
+} /* end InitNet_Nominal() */
+
+void Test_SBN_TCP_URING_InitNet(void)
+{
+    InitNet_SockErr();
+    InitNet_BindErr();
+    InitNet_RingErr();
+    InitNet_BufRingErr();
+    InitNet_Nominal();
+} /* end Test_SBN_TCP_URING_InitNet() */
+
+static void InitPeer_ConnectOut(void)
+{
+    START();
+
+    UT_SetDeferredRetcode(UT_KEY(CFE_PSP_GetProcessorId), 1, 0);
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.InitPeer(PeerPtr), SBN_SUCCESS);
+
+    UtAssert_True(PeerData->ConnectOut, "connects out to a higher ProcessorID (%s)", __func__);
+} /* end InitPeer_ConnectOut() */
+
+static void InitPeer_ConnectIn(void)
+{
+    START();
+
+    UT_SetDeferredRetcode(UT_KEY(CFE_PSP_GetProcessorId), 1, 5);
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.InitPeer(PeerPtr), SBN_SUCCESS);
+
+    UtAssert_True(!PeerData->ConnectOut, "a lower ProcessorID connects in (%s)", __func__);
+} /* end InitPeer_ConnectIn() */
+
+void Test_SBN_TCP_URING_InitPeer(void)
+{
+    InitPeer_ConnectOut();
+    InitPeer_ConnectIn();
+} /* end Test_SBN_TCP_URING_InitPeer() */
+
+static void PollPeer_Accept(void)
+{
+    START();
+
+    InitNet_Up();
+
+    UT_SetDeferredRetcode(UT_KEY(UT_accept4), 1, 7);
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.PollPeer(PeerPtr), SBN_SUCCESS);
+
+    UtAssert_True(NetData->Ring->Conns[0].InUse, "connection accepted (%s)", __func__);
+    UtAssert_INT32_EQ(NetData->Ring->Conns[0].Socket, 7);
+    UtAssert_True(NetData->Ring->Conns[0].PeerInterface == NULL, "peer not yet known (%s)", __func__);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(io_uring_prep_recv_multishot)), 1);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(SBN_Connected)), 0);
+} /* end PollPeer_Accept() */
+
+static void PollPeer_AcceptNoRecv(void)
+{
+    START();
+
+    InitNet_Up();
+
+    UT_SetDeferredRetcode(UT_KEY(UT_accept4), 1, 7);
+    UT_SetForceFail(UT_KEY(io_uring_get_sqe), 1);
+    UT_CheckEvent_Setup(&EventTest, SBN_TCP_URING_SOCK_EID, "unable to post receive");
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.PollPeer(PeerPtr), SBN_SUCCESS);
+
+    EVENT_CNT(1);
+    UtAssert_True(!NetData->Ring->Conns[0].InUse, "connection not kept (%s)", __func__);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(UT_close)), 1);
+} /* end PollPeer_AcceptNoRecv() */
+
+static void PollPeer_ConnectContinues(void)
+{
+    START();
+
+    InitNet_Up();
+
+    ((SBN_TCP_URING_Peer_t *)Peers[0].ModulePvt)->ConnectOut = true;
+    ((SBN_TCP_URING_Peer_t *)Peers[1].ModulePvt)->ConnectOut = true;
+
+    /* the first peer is unreachable, which is no reason not to try the second */
+    UT_SetDeferredRetcode(UT_KEY(UT_connect), 1, -1);
+    UT_CheckEvent_Setup(&EventTest, SBN_TCP_URING_SOCK_EID, "unable to connect to peer");
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.PollPeer(PeerPtr), SBN_SUCCESS);
+
+    EVENT_CNT(1);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(UT_connect)), 2);
+    UtAssert_True(!Peers[0].Connected, "first peer not connected (%s)", __func__);
+    UtAssert_True(Peers[1].Connected, "second peer connected (%s)", __func__);
+    UtAssert_True(((SBN_TCP_URING_Peer_t *)Peers[1].ModulePvt)->Conn == &NetData->Ring->Conns[0],
+                  "second peer linked to its connection (%s)", __func__);
+    UtAssert_True(NetData->Ring->Conns[0].PeerInterface == &Peers[1], "connection linked to the peer (%s)",
+                  __func__);
+} /* end PollPeer_ConnectContinues() */
+
+static void PollPeer_ConnectSockErr(void)
+{
+    START();
+
+    InitNet_Up();
+
+    ((SBN_TCP_URING_Peer_t *)Peers[0].ModulePvt)->ConnectOut = true;
+    ((SBN_TCP_URING_Peer_t *)Peers[1].ModulePvt)->ConnectOut = true;
+
+    UT_SetDeferredRetcode(UT_KEY(UT_socket), 1, -1);
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.PollPeer(PeerPtr), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(UT_connect)), 1);
+    UtAssert_True(Peers[1].Connected, "second peer connected (%s)", __func__);
+} /* end PollPeer_ConnectSockErr() */
+
+static void PollPeer_ConnectTimeout(void)
+{
+    struct timeval SndTimeo[2];
+
+    START();
+
+    InitNet_Up();
+
+    PeerData->ConnectOut = true;
+    NetPtr->PeerCnt      = 1;
+
+    memset(SndTimeo, 0xFF, sizeof(SndTimeo));
+    UT_SetDataBuffer(UT_KEY(UT_setsockopt), SndTimeo, sizeof(SndTimeo), false);
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.PollPeer(PeerPtr), SBN_SUCCESS);
+
+    UtAssert_True(PeerPtr->Connected, "peer connected (%s)", __func__);
+    UtAssert_True(SndTimeo[0].tv_sec == 0 && SndTimeo[0].tv_usec == 100000, "connect() bounded (%s)", __func__);
+    UtAssert_True(SndTimeo[1].tv_sec == 0 && SndTimeo[1].tv_usec == 0, "send timeout cleared once connected (%s)",
+                  __func__);
+} /* end PollPeer_ConnectTimeout() */
+
+static void PollPeer_ConnectRetry(void)
+{
+    START();
+
+    InitNet_Up();
+
+    PeerData->ConnectOut             = true;
+    PeerData->LastConnectTry.seconds = 100 - SBN_TCP_URING_CONNECT_RETRY;
+    NetPtr->PeerCnt                  = 1;
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.PollPeer(PeerPtr), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(UT_connect)), 0);
+} /* end PollPeer_ConnectRetry() */
+
+static void PollPeer_Heartbeat(void)
+{
+    START();
+
+    InitNet_Up();
+    Conn_Up(PeerPtr, 0, 7);
+
+    UT_SetDeferredRetcode(UT_KEY(SBN_HeartbeatDue), 1, true);
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.PollPeer(PeerPtr), SBN_SUCCESS);
+
+    /* through SBN, which stamps LastSend, not straight to the connection */
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(SBN_SendNetMsg)), 1);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(io_uring_prep_send)), 0);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(SBN_SchedulePoll)), 1);
+} /* end PollPeer_Heartbeat() */
+
+static void PollPeer_Timeout(void)
+{
+    START();
+
+    InitNet_Up();
+    Conn_Up(PeerPtr, 0, 7);
+
+    UT_SetDeferredRetcode(UT_KEY(SBN_PeerTimedOut), 1, true);
+    UT_CheckEvent_Setup(&EventTest, SBN_TCP_URING_DEBUG_EID, "CPU 1 timeout, disconnected");
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.PollPeer(PeerPtr), SBN_SUCCESS);
+
+    EVENT_CNT(1);
+    UtAssert_True(!PeerPtr->Connected, "peer disconnected (%s)", __func__);
+    UtAssert_True(PeerData->Conn == NULL, "peer unlinked (%s)", __func__);
+    UtAssert_True(!NetData->Ring->Conns[0].InUse, "connection closed (%s)", __func__);
+} /* end PollPeer_Timeout() */
+
+void Test_SBN_TCP_URING_PollPeer(void)
+{
+    PollPeer_Accept();
+    PollPeer_AcceptNoRecv();
+    PollPeer_ConnectContinues();
+    PollPeer_ConnectSockErr();
+    PollPeer_ConnectTimeout();
+    PollPeer_ConnectRetry();
+    PollPeer_Heartbeat();
+    PollPeer_Timeout();
+} /* end Test_SBN_TCP_URING_PollPeer() */
+
+static void Send_NotConn(void)
+{
+    START();
+
+    InitNet_Up();
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.Send(PeerPtr, SBN_APP_MSG, 0, NULL), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(SBN_PackMsg)), 0);
+} /* end Send_NotConn() */
+
+static void Send_Nominal(void)
+{
+    SBN_TCP_URING_Conn_t *Conn = NULL;
+    uint8                 Msg[10];
+
+    START();
+
+    InitNet_Up();
+    Conn = Conn_Up(PeerPtr, 0, 7);
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.Send(PeerPtr, SBN_APP_MSG, sizeof(Msg), Msg), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(io_uring_prep_send)), 1);
+    UtAssert_INT32_EQ(Conn->SendSz, sizeof(Msg) + SBN_PACKED_HDR_SZ);
+    UtAssert_INT32_EQ(Conn->FillSz, 0);
+} /* end Send_Nominal() */
+
+static void Send_Batched(void)
+{
+    SBN_TCP_URING_Conn_t *Conn = NULL;
+    uint8                 Msg[10];
+
+    START();
+
+    InitNet_Up();
+    Conn = Conn_Up(PeerPtr, 0, 7);
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.Send(PeerPtr, SBN_APP_MSG, sizeof(Msg), Msg), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.Send(PeerPtr, SBN_APP_MSG, sizeof(Msg), Msg), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.Send(PeerPtr, SBN_APP_MSG, sizeof(Msg), Msg), SBN_SUCCESS);
+
+    /* the second and third wait for the first to complete, to be sent as one */
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(io_uring_prep_send)), 1);
+    UtAssert_INT32_EQ(Conn->FillSz, 2 * (sizeof(Msg) + SBN_PACKED_HDR_SZ));
+} /* end Send_Batched() */
+
+static void Send_QueueFull(void)
+{
+    SBN_TCP_URING_Conn_t *Conn = NULL;
+    uint8                 Msg[10];
+
+    START();
+
+    InitNet_Up();
+    Conn = Conn_Up(PeerPtr, 0, 7);
+
+    Conn->SendSz = 1;
+    Conn->FillSz = SBN_TCP_URING_SENDQ_SZ - SBN_PACKED_HDR_SZ;
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.Send(PeerPtr, SBN_APP_MSG, sizeof(Msg), Msg), SBN_ERROR);
+
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(SBN_PackMsg)), 0);
+} /* end Send_QueueFull() */
+
+void Test_SBN_TCP_URING_Send(void)
+{
+    Send_NotConn();
+    Send_Nominal();
+    Send_Batched();
+    Send_QueueFull();
+} /* end Test_SBN_TCP_URING_Send() */
+
+static void Recv_NoRing(void)
+{
+    START();
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.RecvFromNet(NetPtr, NULL, NULL, NULL, NULL), SBN_IF_EMPTY);
+
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(OS_MutSemTake)), 0);
+} /* end Recv_NoRing() */
+
+static void Recv_Empty(void)
+{
+    START();
+
+    InitNet_Up();
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.RecvFromNet(NetPtr, NULL, NULL, NULL, NULL), SBN_IF_EMPTY);
+
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(io_uring_peek_cqe)), 1);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(io_uring_wait_cqe_timeout)), 0);
+} /* end Recv_Empty() */
+
+static void Recv_Closing(void)
+{
+    START();
+
+    InitNet_Up();
+
+    NetData->Closing = true;
+    NetPtr->TaskFlags |= SBN_TASK_RECV;
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.RecvFromNet(NetPtr, NULL, NULL, NULL, NULL), SBN_IF_EMPTY);
+
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(io_uring_peek_cqe)), 0);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(io_uring_wait_cqe_timeout)), 0);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(OS_MutSemGive)), 1);
+} /* end Recv_Closing() */
+
+static void Recv_Woken(void)
+{
+    struct io_uring_cqe CQE;
+
+    START();
+
+    InitNet_Up();
+
+    NetPtr->TaskFlags |= SBN_TASK_RECV;
+
+    memset(&CQE, 0, sizeof(CQE));
+    CQE.user_data = WAKE_DATA;
+    UT_SetDataBuffer(UT_KEY(io_uring_wait_cqe_timeout), &CQE, sizeof(CQE), true);
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.RecvFromNet(NetPtr, NULL, NULL, NULL, NULL), SBN_IF_EMPTY);
+
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(io_uring_wait_cqe_timeout)), 1);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(io_uring_cqe_seen)), 1);
+} /* end Recv_Woken() */
+
+static void Recv_Data(void)
+{
+    SBN_TCP_URING_Conn_t *Conn = NULL;
+    struct io_uring_cqe   CQE;
+    SBN_Unpack_Buf_t      Buf;
+    SBN_MsgType_t         MsgType;
+    SBN_MsgSz_t           MsgSz;
+    CFE_ProcessorID_t     ProcessorID;
+
+    START();
+
+    InitNet_Up();
+    Conn = Conn_Up(PeerPtr, 0, 7);
+
+    /* an empty frame, the header alone, in the first buffer */
+    memset(NetData->Ring->Bufs, 0, SBN_PACKED_HDR_SZ);
+
+    memset(&CQE, 0, sizeof(CQE));
+    CQE.user_data = USER_DATA(0, OP_RECV);
+    CQE.res       = SBN_PACKED_HDR_SZ;
+    CQE.flags     = IORING_CQE_F_BUFFER | IORING_CQE_F_MORE;
+    UT_SetDataBuffer(UT_KEY(io_uring_peek_cqe), &CQE, sizeof(CQE), true);
+
+    memset(&Buf, 0, sizeof(Buf));
+    Buf.MsgType     = SBN_APP_MSG;
+    Buf.ProcessorID = PeerPtr->ProcessorID;
+    UT_SetDataBuffer(UT_KEY(SBN_UnpackMsg), &Buf, sizeof(Buf), true);
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.RecvFromNet(NetPtr, &MsgType, &MsgSz, &ProcessorID, NULL), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(MsgType, SBN_APP_MSG);
+    UtAssert_INT32_EQ(ProcessorID, PeerPtr->ProcessorID);
+    UtAssert_INT32_EQ(Conn->RecvOff, SBN_PACKED_HDR_SZ);
+    /* the buffer went straight back to the kernel */
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(io_uring_buf_ring_add)), SBN_TCP_URING_BUF_CNT + 1);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(SBN_GetPeer)), 0);
+} /* end Recv_Data() */
+
+static void Recv_RecvFailed(void)
+{
+    struct io_uring_cqe CQE;
+
+    START();
+
+    InitNet_Up();
+    Conn_Up(PeerPtr, 0, 7);
+
+    NetData->Ring->Conns[0].OpsInFlight = 1;
+
+    memset(&CQE, 0, sizeof(CQE));
+    CQE.user_data = USER_DATA(0, OP_RECV);
+    CQE.res       = -ECONNRESET;
+    UT_SetDataBuffer(UT_KEY(io_uring_peek_cqe), &CQE, sizeof(CQE), true);
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.RecvFromNet(NetPtr, NULL, NULL, NULL, NULL), SBN_IF_EMPTY);
+
+    UtAssert_True(!PeerPtr->Connected, "peer disconnected (%s)", __func__);
+    UtAssert_True(!NetData->Ring->Conns[0].InUse, "connection closed (%s)", __func__);
+    UtAssert_INT32_EQ(NetData->Ring->Conns[0].OpsInFlight, 0);
+} /* end Recv_RecvFailed() */
+
+static void Recv_SendDone(void)
+{
+    SBN_TCP_URING_Conn_t *Conn = NULL;
+    struct io_uring_cqe   CQE;
+
+    START();
+
+    InitNet_Up();
+    Conn = Conn_Up(PeerPtr, 0, 7);
+
+    /* a send of 20 in flight and 10 queued behind it */
+    Conn->OpsInFlight = 1;
+    Conn->SendSz      = 20;
+    Conn->FillSz      = 10;
+
+    memset(&CQE, 0, sizeof(CQE));
+    CQE.user_data = USER_DATA(0, OP_SEND);
+    CQE.res       = 20;
+    UT_SetDataBuffer(UT_KEY(io_uring_peek_cqe), &CQE, sizeof(CQE), true);
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.RecvFromNet(NetPtr, NULL, NULL, NULL, NULL), SBN_IF_EMPTY);
+
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(io_uring_prep_send)), 1);
+    UtAssert_INT32_EQ(Conn->SendSz, 10);
+    UtAssert_INT32_EQ(Conn->FillSz, 0);
+} /* end Recv_SendDone() */
+
+static void Recv_NewPeer(void)
+{
+    SBN_TCP_URING_Conn_t *Conn = NULL;
+    SBN_Unpack_Buf_t      Buf;
+    CFE_ProcessorID_t     ProcessorID;
+
+    START();
+
+    InitNet_Up();
+    Conn = Conn_Up(NULL, 0, 7);
+
+    memset(Conn->RecvBuf, 0, SBN_PACKED_HDR_SZ);
+    Conn->RecvSz = SBN_PACKED_HDR_SZ;
+
+    memset(&Buf, 0, sizeof(Buf));
+    Buf.ProcessorID = PeerPtr->ProcessorID;
+    UT_SetDataBuffer(UT_KEY(SBN_UnpackMsg), &Buf, sizeof(Buf), true);
+    UT_SetDataBuffer(UT_KEY(SBN_GetPeer), &PeerPtr, sizeof(PeerPtr), true);
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.RecvFromNet(NetPtr, NULL, NULL, &ProcessorID, NULL), SBN_SUCCESS);
+
+    UtAssert_True(PeerPtr->Connected, "peer connected (%s)", __func__);
+    UtAssert_True(PeerData->Conn == Conn, "peer linked to the connection (%s)", __func__);
+    UtAssert_True(Conn->PeerInterface == PeerPtr, "connection linked to the peer (%s)", __func__);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(SBN_Disconnected)), 0);
+} /* end Recv_NewPeer() */
+
+static void Recv_Reconnected(void)
+{
+    SBN_TCP_URING_Conn_t *OldConn = NULL, *NewConn = NULL;
+    SBN_Unpack_Buf_t      Buf;
+    CFE_ProcessorID_t     ProcessorID;
+
+    START();
+
+    InitNet_Up();
+
+    /* the peer restarted, its new connection identifies it before its old one is found closed */
+    OldConn = Conn_Up(PeerPtr, 0, 7);
+    NewConn = Conn_Up(NULL, 1, 8);
+
+    memset(NewConn->RecvBuf, 0, SBN_PACKED_HDR_SZ);
+    NewConn->RecvSz = SBN_PACKED_HDR_SZ;
+
+    memset(&Buf, 0, sizeof(Buf));
+    Buf.ProcessorID = PeerPtr->ProcessorID;
+    UT_SetDataBuffer(UT_KEY(SBN_UnpackMsg), &Buf, sizeof(Buf), true);
+    UT_SetDataBuffer(UT_KEY(SBN_GetPeer), &PeerPtr, sizeof(PeerPtr), true);
+    UT_CheckEvent_Setup(&EventTest, SBN_TCP_URING_DEBUG_EID, "CPU 1 reconnected, closing its old connection");
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.RecvFromNet(NetPtr, NULL, NULL, &ProcessorID, NULL), SBN_SUCCESS);
+
+    EVENT_CNT(1);
+    UtAssert_True(!OldConn->InUse, "old connection closed (%s)", __func__);
+    UtAssert_True(OldConn->PeerInterface == NULL, "old connection unlinked (%s)", __func__);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(UT_close)), 1);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(SBN_Disconnected)), 1);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(SBN_Connected)), 1);
+    UtAssert_True(PeerPtr->Connected, "peer connected (%s)", __func__);
+    UtAssert_True(PeerData->Conn == NewConn, "peer linked to the new connection (%s)", __func__);
+    UtAssert_True(NewConn->PeerInterface == PeerPtr, "new connection linked to the peer (%s)", __func__);
+} /* end Recv_Reconnected() */
+
+static void Recv_BadFrame(void)
+{
+    SBN_TCP_URING_Conn_t *Conn = NULL;
+
+    START();
+
+    InitNet_Up();
+    Conn = Conn_Up(PeerPtr, 0, 7);
+
+    memset(Conn->RecvBuf, 0xFF, SBN_PACKED_HDR_SZ);
+    Conn->RecvSz = SBN_PACKED_HDR_SZ;
+
+    UT_CheckEvent_Setup(&EventTest, SBN_TCP_URING_DEBUG_EID, "Connection 0 sent a bad frame");
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.RecvFromNet(NetPtr, NULL, NULL, NULL, NULL), SBN_IF_EMPTY);
+
+    EVENT_CNT(1);
+    UtAssert_True(!PeerPtr->Connected, "peer disconnected (%s)", __func__);
+    UtAssert_True(!Conn->InUse, "connection closed (%s)", __func__);
+} /* end Recv_BadFrame() */
+
+void Test_SBN_TCP_URING_Recv(void)
+{
+    Recv_NoRing();
+    Recv_Empty();
+    Recv_Closing();
+    Recv_Woken();
+    Recv_Data();
+    Recv_RecvFailed();
+    Recv_SendDone();
+    Recv_NewPeer();
+    Recv_Reconnected();
+    Recv_BadFrame();
+} /* end Test_SBN_TCP_URING_Recv() */
+
+static void Test_SBN_TCP_URING_UnloadPeer(void)
+{
+    SBN_TCP_URING_Conn_t *Conn = NULL;
+
+    START();
+
+    InitNet_Up();
+    Conn = Conn_Up(PeerPtr, 0, 7);
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.UnloadPeer(PeerPtr), SBN_SUCCESS);
+
+    UtAssert_True(!PeerPtr->Connected, "peer disconnected (%s)", __func__);
+    UtAssert_True(PeerData->Conn == NULL, "peer unlinked (%s)", __func__);
+    UtAssert_True(!Conn->InUse, "connection closed (%s)", __func__);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(UT_shutdown)), 1);
+} /* end Test_SBN_TCP_URING_UnloadPeer() */
+
+static void UnloadNet_Nominal(void)
+{
+    START();
+
+    InitNet_Up();
+    Conn_Up(PeerPtr, 0, 7);
+    Conn_Up(NULL, 1, 8);
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.UnloadNet(NetPtr), SBN_SUCCESS);
+
+    /* a receive task waiting on the ring is woken before the ring is freed */
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(io_uring_prep_nop)), 1);
+    UtAssert_True(NetData->Closing, "net closing (%s)", __func__);
+    UtAssert_True(NetData->Ring == NULL, "ring freed (%s)", __func__);
+    UtAssert_True(!PeerPtr->Connected, "peer disconnected (%s)", __func__);
+    /* the server socket and both connections */
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(UT_close)), 3);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(io_uring_free_buf_ring)), 1);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(io_uring_queue_exit)), 1);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(OS_MutSemDelete)), 2);
+} /* end UnloadNet_Nominal() */
+
+static void UnloadNet_NoSQE(void)
+{
+    START();
+
+    InitNet_Up();
+
+    UT_SetForceFail(UT_KEY(io_uring_get_sqe), 1);
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.UnloadNet(NetPtr), SBN_SUCCESS);
+
+    /* a receive task then wakes on its timeout, and finds the net closing */
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(io_uring_prep_nop)), 0);
+    UtAssert_True(NetData->Closing, "net closing (%s)", __func__);
+    UtAssert_True(NetData->Ring == NULL, "ring freed (%s)", __func__);
+} /* end UnloadNet_NoSQE() */
+
+static void UnloadNet_NoRing(void)
+{
+    START();
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_URING_Ops.UnloadNet(NetPtr), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(io_uring_prep_nop)), 0);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(OS_MutSemDelete)), 0);
+} /* end UnloadNet_NoRing() */
+
+void Test_SBN_TCP_URING_UnloadNet(void)
+{
+    UnloadNet_Nominal();
+    UnloadNet_NoSQE();
+    UnloadNet_NoRing();
+} /* end Test_SBN_TCP_URING_UnloadNet() */
+
+/*
+ * Setup function prior to every test
+ */
+void UT_Setup(void)
+{
+    UT_ResetState(0);
+}
+
+/*
+ * Teardown function after every test
+ */
+void UT_TearDown(void) {}
+
+void UtTest_Setup(void)
+{
+    ADD_TEST(SBN_TCP_URING_Init);
+    ADD_TEST(SBN_TCP_URING_LoadNet);
+    ADD_TEST(SBN_TCP_URING_LoadPeer);
+    ADD_TEST(SBN_TCP_URING_InitNet);
+    ADD_TEST(SBN_TCP_URING_InitPeer);
+    ADD_TEST(SBN_TCP_URING_PollPeer);
+    ADD_TEST(SBN_TCP_URING_Send);
+    ADD_TEST(SBN_TCP_URING_Recv);
+    ADD_TEST(SBN_TCP_URING_UnloadPeer);
+    ADD_TEST(SBN_TCP_URING_UnloadNet);
+}
@@ -0,0 +1,51 @@
+/*
+** File: liburing.h
+**
+** Purpose:
+** Stands in for liburing in the coverage test, declaring (rather than
+** inlining) the subset of the liburing 2.4 API the module uses, so that
+** each call reaches a stub in ut-stubs/ut_liburing_stubs.c. The ring and
+** buffer ring are opaque to the module, the kernel's definitions of the
+** submission and completion queue entries are used as they are.
+*/
+
+#ifndef _UT_LIBURING_H_
+#define _UT_LIBURING_H_
+
+#include <stddef.h>
+#include <linux/io_uring.h>
+#include <linux/time_types.h>
+
+struct io_uring
+{
+    int ring_fd;
+};
+
+struct io_uring_buf_ring;
+
+int  io_uring_queue_init(unsigned entries, struct io_uring *ring, unsigned flags);
+void io_uring_queue_exit(struct io_uring *ring);
+
+struct io_uring_sqe *io_uring_get_sqe(struct io_uring *ring);
+int                  io_uring_submit(struct io_uring *ring);
+
+int  io_uring_peek_cqe(struct io_uring *ring, struct io_uring_cqe **cqe_ptr);
+int  io_uring_wait_cqe_timeout(struct io_uring *ring, struct io_uring_cqe **cqe_ptr, struct __kernel_timespec *ts);
+void io_uring_cqe_seen(struct io_uring *ring, struct io_uring_cqe *cqe);
+
+void io_uring_prep_nop(struct io_uring_sqe *sqe);
+void io_uring_prep_recv_multishot(struct io_uring_sqe *sqe, int sockfd, void *buf, size_t len, int flags);
+void io_uring_prep_send(struct io_uring_sqe *sqe, int sockfd, const void *buf, size_t len, int flags);
+
+void  io_uring_sqe_set_data64(struct io_uring_sqe *sqe, __u64 data);
+__u64 io_uring_cqe_get_data64(const struct io_uring_cqe *cqe);
+
+struct io_uring_buf_ring *io_uring_setup_buf_ring(struct io_uring *ring, unsigned int nentries, int bgid,
+                                                  unsigned int flags, int *ret);
+int  io_uring_free_buf_ring(struct io_uring *ring, struct io_uring_buf_ring *br, unsigned int nentries, int bgid);
+void io_uring_buf_ring_add(struct io_uring_buf_ring *br, void *addr, unsigned int len, unsigned short bid, int mask,
+                           int buf_offset);
+void io_uring_buf_ring_advance(struct io_uring_buf_ring *br, int count);
+int  io_uring_buf_ring_mask(__u32 ring_entries);
+
+#endif /* _UT_LIBURING_H_ */
@@ -0,0 +1,24 @@
+/*
+** File: ut_sockets.h
+**
+** Purpose:
+** The socket calls the module makes, renamed for the coverage test. The
+** wrapper of the unit under test defines each call to its UT_ name, and
+** ut-stubs/ut_socket_stubs.c implements them.
+*/
+
+#ifndef _UT_SOCKETS_H_
+#define _UT_SOCKETS_H_
+
+#include <sys/socket.h>
+
+int UT_socket(int domain, int type, int protocol);
+int UT_setsockopt(int sockfd, int level, int optname, const void *optval, socklen_t optlen);
+int UT_bind(int sockfd, const struct sockaddr *addr, socklen_t addrlen);
+int UT_listen(int sockfd, int backlog);
+int UT_accept4(int sockfd, struct sockaddr *addr, socklen_t *addrlen, int flags);
+int UT_connect(int sockfd, const struct sockaddr *addr, socklen_t addrlen);
+int UT_shutdown(int sockfd, int how);
+int UT_close(int fd);
+
+#endif /* _UT_SOCKETS_H_ */
@@ -0,0 +1,156 @@
+/*
+** File: ut_liburing_stubs.c
+**
+** Purpose:
+** Stubs for the subset of liburing declared in inc/liburing.h.
+**
+** Notes:
+** A nonzero return code makes io_uring_get_sqe() run out of entries and
+** io_uring_setup_buf_ring() fail. Completions are queued for
+** io_uring_peek_cqe() and io_uring_wait_cqe_timeout() by setting a data
+** buffer of struct io_uring_cqe on either, each call takes the next; with
+** none left peeking finds the queue empty and waiting times out.
+*/
+
+#include <errno.h>
+#include <string.h>
+
+#include "utstubs.h"
+#include "liburing.h"
+
+int io_uring_queue_init(unsigned entries, struct io_uring *ring, unsigned flags)
+{
+    return UT_DEFAULT_IMPL(io_uring_queue_init);
+} /* end io_uring_queue_init() */
+
+void io_uring_queue_exit(struct io_uring *ring)
+{
+    UT_DEFAULT_IMPL(io_uring_queue_exit);
+} /* end io_uring_queue_exit() */
+
+struct io_uring_sqe *io_uring_get_sqe(struct io_uring *ring)
+{
+    static struct io_uring_sqe SQE;
+
+    if (UT_DEFAULT_IMPL(io_uring_get_sqe) != 0)
+    {
+        return NULL;
+    } /* end if */
+
+    memset(&SQE, 0, sizeof(SQE));
+
+    return &SQE;
+} /* end io_uring_get_sqe() */
+
+int io_uring_submit(struct io_uring *ring)
+{
+    return UT_DEFAULT_IMPL(io_uring_submit);
+} /* end io_uring_submit() */
+
+static int NextCQE(UT_EntryKey_t FuncKey, int32 Status, struct io_uring_cqe **cqe_ptr, int Empty)
+{
+    static struct io_uring_cqe CQE;
+
+    if (Status != 0)
+    {
+        return Status;
+    } /* end if */
+
+    if (UT_Stub_CopyToLocal(FuncKey, &CQE, sizeof(CQE)) < sizeof(CQE))
+    {
+        return Empty;
+    } /* end if */
+
+    *cqe_ptr = &CQE;
+
+    return 0;
+} /* end NextCQE() */
+
+int io_uring_peek_cqe(struct io_uring *ring, struct io_uring_cqe **cqe_ptr)
+{
+    return NextCQE(UT_KEY(io_uring_peek_cqe), UT_DEFAULT_IMPL(io_uring_peek_cqe), cqe_ptr, -EAGAIN);
+} /* end io_uring_peek_cqe() */
+
+int io_uring_wait_cqe_timeout(struct io_uring *ring, struct io_uring_cqe **cqe_ptr, struct __kernel_timespec *ts)
+{
+    return NextCQE(UT_KEY(io_uring_wait_cqe_timeout), UT_DEFAULT_IMPL(io_uring_wait_cqe_timeout), cqe_ptr, -ETIME);
+} /* end io_uring_wait_cqe_timeout() */
+
+void io_uring_cqe_seen(struct io_uring *ring, struct io_uring_cqe *cqe)
+{
+    UT_DEFAULT_IMPL(io_uring_cqe_seen);
+} /* end io_uring_cqe_seen() */
+
+void io_uring_prep_nop(struct io_uring_sqe *sqe)
+{
+    sqe->opcode = IORING_OP_NOP;
+
+    UT_DEFAULT_IMPL(io_uring_prep_nop);
+} /* end io_uring_prep_nop() */
+
+void io_uring_prep_recv_multishot(struct io_uring_sqe *sqe, int sockfd, void *buf, size_t len, int flags)
+{
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd     = sockfd;
+
+    UT_DEFAULT_IMPL(io_uring_prep_recv_multishot);
+} /* end io_uring_prep_recv_multishot() */
+
+void io_uring_prep_send(struct io_uring_sqe *sqe, int sockfd, const void *buf, size_t len, int flags)
+{
+    sqe->opcode = IORING_OP_SEND;
+    sqe->fd     = sockfd;
+    sqe->len    = len;
+
+    UT_DEFAULT_IMPL(io_uring_prep_send);
+} /* end io_uring_prep_send() */
+
+void io_uring_sqe_set_data64(struct io_uring_sqe *sqe, __u64 data)
+{
+    sqe->user_data = data;
+
+    UT_DEFAULT_IMPL(io_uring_sqe_set_data64);
+} /* end io_uring_sqe_set_data64() */
+
+__u64 io_uring_cqe_get_data64(const struct io_uring_cqe *cqe)
+{
+    return cqe->user_data;
+} /* end io_uring_cqe_get_data64() */
+
+struct io_uring_buf_ring *io_uring_setup_buf_ring(struct io_uring *ring, unsigned int nentries, int bgid,
+                                                  unsigned int flags, int *ret)
+{
+    static struct io_uring_buf BufRing[1];
+    int32                      Status = UT_DEFAULT_IMPL(io_uring_setup_buf_ring);
+
+    if (Status != 0)
+    {
+        *ret = Status;
+        return NULL;
+    } /* end if */
+
+    *ret = 0;
+
+    return (struct io_uring_buf_ring *)BufRing;
+} /* end io_uring_setup_buf_ring() */
+
+int io_uring_free_buf_ring(struct io_uring *ring, struct io_uring_buf_ring *br, unsigned int nentries, int bgid)
+{
+    return UT_DEFAULT_IMPL(io_uring_free_buf_ring);
+} /* end io_uring_free_buf_ring() */
+
+void io_uring_buf_ring_add(struct io_uring_buf_ring *br, void *addr, unsigned int len, unsigned short bid, int mask,
+                           int buf_offset)
+{
+    UT_DEFAULT_IMPL(io_uring_buf_ring_add);
+} /* end io_uring_buf_ring_add() */
+
+void io_uring_buf_ring_advance(struct io_uring_buf_ring *br, int count)
+{
+    UT_DEFAULT_IMPL(io_uring_buf_ring_advance);
+} /* end io_uring_buf_ring_advance() */
+
+int io_uring_buf_ring_mask(__u32 ring_entries)
+{
+    return ring_entries - 1;
+} /* end io_uring_buf_ring_mask() */
@@ -0,0 +1,71 @@
+/*
+** File: ut_socket_stubs.c
+**
+** Purpose:
+** Stubs for the socket calls declared in inc/ut_sockets.h.
+**
+** Notes:
+** Each returns its return code, 0 by default, other than UT_accept4(),
+** which has nothing to accept (-1, errno EAGAIN) unless given a positive
+** return code, the accepted socket; a negative one is returned as -1 with
+** that errno. UT_setsockopt() copies each SO_SNDTIMEO it is given to its
+** data buffer, if one is set.
+*/
+
+#include <errno.h>
+
+#include "utstubs.h"
+#include "ut_sockets.h"
+
+int UT_socket(int domain, int type, int protocol)
+{
+    return UT_DEFAULT_IMPL(UT_socket);
+} /* end UT_socket() */
+
+int UT_setsockopt(int sockfd, int level, int optname, const void *optval, socklen_t optlen)
+{
+    if (level == SOL_SOCKET && optname == SO_SNDTIMEO)
+    {
+        UT_Stub_CopyFromLocal(UT_KEY(UT_setsockopt), optval, optlen);
+    } /* end if */
+
+    return UT_DEFAULT_IMPL(UT_setsockopt);
+} /* end UT_setsockopt() */
+
+int UT_bind(int sockfd, const struct sockaddr *addr, socklen_t addrlen)
+{
+    return UT_DEFAULT_IMPL(UT_bind);
+} /* end UT_bind() */
+
+int UT_listen(int sockfd, int backlog)
+{
+    return UT_DEFAULT_IMPL(UT_listen);
+} /* end UT_listen() */
+
+int UT_accept4(int sockfd, struct sockaddr *addr, socklen_t *addrlen, int flags)
+{
+    int32 Status = UT_DEFAULT_IMPL(UT_accept4);
+
+    if (Status <= 0)
+    {
+        errno = Status < 0 ? -Status : EAGAIN;
+        return -1;
+    } /* end if */
+
+    return Status;
+} /* end UT_accept4() */
+
+int UT_connect(int sockfd, const struct sockaddr *addr, socklen_t addrlen)
+{
+    return UT_DEFAULT_IMPL(UT_connect);
+} /* end UT_connect() */
+
+int UT_shutdown(int sockfd, int how)
+{
+    return UT_DEFAULT_IMPL(UT_shutdown);
+} /* end UT_shutdown() */
+
+int UT_close(int fd)
+{
+    return UT_DEFAULT_IMPL(UT_close);
+} /* end UT_close() */
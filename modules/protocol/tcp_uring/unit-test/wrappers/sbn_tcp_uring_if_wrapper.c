@@ -0,0 +1,28 @@
+/*
+** File: sbn_tcp_uring_if_wrapper.c
+**
+** Purpose:
+** Wraps the unmodified sbn_tcp_uring_if.c for the coverage test, routing
+** its socket calls to ut-stubs/ut_socket_stubs.c. The system headers are
+** included first, so that only the module's calls are renamed.
+*/
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif /* !_GNU_SOURCE */
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "ut_sockets.h"
+
+#define socket     UT_socket
+#define setsockopt UT_setsockopt
+#define bind       UT_bind
+#define listen     UT_listen
+#define accept4    UT_accept4
+#define connect    UT_connect
+#define shutdown   UT_shutdown
+#define close      UT_close
+
+#include "sbn_tcp_uring_if.c"
@@ -1,9 +1,15 @@
+/* for struct ip_mreq */
+#define _DEFAULT_SOURCE
+
 #include "sbn_udp_events.h"
 #include "sbn_udp_if.h"
 #include "sbn_platform_cfg.h"
 #include <network_includes.h>
 #include <string.h>
 #include <errno.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
 
 #include "sbn_interfaces.h"
 #include "cfe.h"
@@ -12,6 +18,206 @@ CFE_EVS_EventID_t SBN_UDP_FIRST_EID;
 
 #define EXP_VERSION 5
 
+#if SBN_UDP_REL_WINDOW > 32
+#error SBN_UDP_REL_WINDOW must be at most 32, the width of the selective ACK mask
+#endif
+
+static void PackUInt16(uint8 *Buf, uint16 Val)
+{
+    Buf[0] = (uint8)(Val >> 8);
+    Buf[1] = (uint8)Val;
+} /* end PackUInt16() */
+
+static void PackUInt32(uint8 *Buf, uint32 Val)
+{
+    PackUInt16(Buf, (uint16)(Val >> 16));
+    PackUInt16(Buf + 2, (uint16)Val);
+} /* end PackUInt32() */
+
+static uint16 UnpackUInt16(const uint8 *Buf)
+{
+    return (uint16)((Buf[0] << 8) | Buf[1]);
+} /* end UnpackUInt16() */
+
+static uint32 UnpackUInt32(const uint8 *Buf)
+{
+    return ((uint32)UnpackUInt16(Buf) << 16) | UnpackUInt16(Buf + 2);
+} /* end UnpackUInt32() */
+
+/**
+ * \brief Forget all reliable delivery state for a peer and start a new epoch,
+ * called whenever the connection to the peer is (re)established or dropped.
+ * Like the other Rel functions, called with the peer's RelMutex held.
+ */
+static void RelReset(SBN_UDP_Peer_t *PeerData)
+{
+    OS_time_t Now;
+    uint16    Epoch = 0;
+
+    OS_GetLocalTime(&Now);
+    Epoch = (uint16)(Now.seconds ^ Now.microsecs);
+    if (Epoch == PeerData->Epoch)
+    {
+        Epoch++;
+    } /* end if */
+
+    if (Epoch == 0)
+    {
+        /* 0 means "no epoch" */
+        Epoch = 1;
+    } /* end if */
+
+    PeerData->Epoch      = Epoch;
+    PeerData->SendSeq    = 0;
+    PeerData->SendBase   = 0;
+    PeerData->PeerEpoch  = 0;
+    PeerData->RecvBase   = 0;
+    PeerData->RecvMask   = 0;
+    PeerData->AckPending = false;
+
+    if (PeerData->RelSlots != NULL)
+    {
+        memset(PeerData->RelSlots, 0, SBN_UDP_REL_WINDOW * sizeof(*PeerData->RelSlots));
+    } /* end if */
+} /* end RelReset() */
+
+/**
+ * \brief Pack the ACK block for what I have received from the peer.
+ */
+static void RelPackAck(uint8 *Buf, SBN_UDP_Peer_t *PeerData)
+{
+    PackUInt16(Buf, PeerData->PeerEpoch);
+    PackUInt16(Buf + 2, PeerData->RecvBase);
+    PackUInt32(Buf + 4, PeerData->RecvMask);
+
+    PeerData->AckPending = false;
+} /* end RelPackAck() */
+
+/**
+ * \brief Release the retransmit buffers for everything the peer has
+ * acknowledged, cumulatively or selectively.
+ */
+static void RelProcessAck(SBN_UDP_Peer_t *PeerData, const uint8 *Buf)
+{
+    uint16 AckEpoch = UnpackUInt16(Buf), Ack = UnpackUInt16(Buf + 2), Seq = 0;
+    uint32 Mask = UnpackUInt32(Buf + 4);
+
+    if (AckEpoch != PeerData->Epoch || PeerData->RelSlots == NULL)
+    {
+        /* ACK for a previous connection, or for nothing */
+        return;
+    } /* end if */
+
+    for (Seq = PeerData->SendBase; Seq != PeerData->SendSeq; Seq++)
+    {
+        SBN_UDP_RelSlot_t *Slot = &PeerData->RelSlots[Seq % SBN_UDP_REL_WINDOW];
+        int16              Diff = (int16)(Seq - Ack);
+
+        if (Slot->InUse && (Diff < 0 || (Diff < 32 && (Mask & (1U << Diff)))))
+        {
+            Slot->InUse = false;
+        } /* end if */
+    }     /* end for */
+
+    while (PeerData->SendBase != PeerData->SendSeq &&
+           !PeerData->RelSlots[PeerData->SendBase % SBN_UDP_REL_WINDOW].InUse)
+    {
+        PeerData->SendBase++;
+    } /* end while */
+} /* end RelProcessAck() */
+
+/**
+ * \brief Slide my receive window up to the oldest sequence number the peer
+ * has not given up on, what is before it will never be retransmitted.
+ */
+static void RelSlide(SBN_UDP_Peer_t *PeerData, uint16 Base)
+{
+    int16 Diff = (int16)(Base - PeerData->RecvBase);
+
+    if (Diff <= 0)
+    {
+        return;
+    } /* end if */
+
+    PeerData->RecvMask = Diff < 32 ? PeerData->RecvMask >> Diff : 0;
+    PeerData->RecvBase = Base;
+
+    while (PeerData->RecvMask & 1)
+    {
+        PeerData->RecvMask >>= 1;
+        PeerData->RecvBase++;
+    } /* end while */
+} /* end RelSlide() */
+
+/**
+ * \brief Record a reliable message received from the peer.
+ *
+ * @return true if this is the first time the message has been received,
+ *         false if it is a duplicate (or outside the window) and should be
+ *         dropped.
+ */
+static bool RelRecv(SBN_UDP_Peer_t *PeerData, uint16 Epoch, uint16 Seq, uint16 Base)
+{
+    int16 Diff = 0;
+
+    if (Epoch != PeerData->PeerEpoch)
+    {
+        /* the peer (re)started, its window starts here */
+        PeerData->PeerEpoch = Epoch;
+        PeerData->RecvBase  = Seq;
+        PeerData->RecvMask  = 0;
+    } /* end if */
+
+    RelSlide(PeerData, Base);
+
+    /* whether new or duplicate (the ACK was lost), the peer needs an ACK */
+    PeerData->AckPending = true;
+
+    Diff = (int16)(Seq - PeerData->RecvBase);
+    if (Diff < 0 || Diff >= 32 || (PeerData->RecvMask & (1U << Diff)))
+    {
+        return false;
+    } /* end if */
+
+    PeerData->RecvMask |= (1U << Diff);
+
+    while (PeerData->RecvMask & 1)
+    {
+        PeerData->RecvMask >>= 1;
+        PeerData->RecvBase++;
+    } /* end while */
+
+    return true;
+} /* end RelRecv() */
+
+/**
+ * \brief Is the message ID subscribed to by the peer with reliable QoS?
+ * SBN keeps the peer's subscriptions ordered by message ID, and their ranges
+ * do not overlap, so they are binary searched.
+ */
+static bool IsReliable(SBN_PeerInterface_t *Peer, CFE_SB_MsgId_t MsgID)
+{
+    int Low = 0, High = Peer->SubCnt, Mid = 0;
+
+    /* the first subscription not ending before MsgID */
+    while (Low < High)
+    {
+        Mid = (Low + High) / 2;
+
+        if (Peer->Subs[Mid].LastMsgID < MsgID)
+        {
+            Low = Mid + 1;
+        }
+        else
+        {
+            High = Mid;
+        } /* end if */
+    }     /* end while */
+
+    return Low < Peer->SubCnt && Peer->Subs[Low].MsgID <= MsgID &&
+           Peer->Subs[Low].QoS.Reliability == CFE_SB_QosReliability_HIGH;
+} /* end IsReliable() */
+
 static SBN_Status_t Init(int Version, CFE_EVS_EventID_t BaseEID)
 {
     SBN_UDP_FIRST_EID = BaseEID;
@@ -26,6 +232,52 @@ static SBN_Status_t Init(int Version, CFE_EVS_EventID_t BaseEID)
     return SBN_SUCCESS;
 } /* end Init() */
 
+/**
+ * \brief Open the net's multicast socket, bound to the group port and joined
+ * to the group on the interface of the net's address.
+ */
+static SBN_Status_t OpenGroup(SBN_UDP_Net_t *NetData)
+{
+    int            On = 1;
+    unsigned char  TTL = SBN_UDP_MCAST_TTL, Loop = 1;
+    struct ip_mreq Mreq;
+
+    Mreq.imr_multiaddr = NetData->GroupAddr.sin_addr;
+    Mreq.imr_interface = NetData->GroupIface;
+
+    NetData->GroupSocket = socket(AF_INET, SOCK_DGRAM, 0);
+    if (NetData->GroupSocket < 0)
+    {
+        EVSSendErr(SBN_UDP_SOCK_EID, "multicast socket call failed (errno=%d)", errno);
+        return SBN_ERROR;
+    } /* end if */
+
+    /* every CPU on a host binds the group port, as when testing on localhost */
+    if (setsockopt(NetData->GroupSocket, SOL_SOCKET, SO_REUSEADDR, &On, sizeof(On)) != 0 ||
+        bind(NetData->GroupSocket, (struct sockaddr *)&NetData->GroupAddr, sizeof(NetData->GroupAddr)) != 0)
+    {
+        EVSSendErr(SBN_UDP_SOCK_EID, "multicast bind failed (errno=%d)", errno);
+        close(NetData->GroupSocket);
+        NetData->GroupSocket = -1;
+        return SBN_ERROR;
+    } /* end if */
+
+    /* loop my sends back so other CPUs on this host receive them, I skip my own */
+    if (setsockopt(NetData->GroupSocket, IPPROTO_IP, IP_ADD_MEMBERSHIP, &Mreq, sizeof(Mreq)) != 0 ||
+        setsockopt(NetData->GroupSocket, IPPROTO_IP, IP_MULTICAST_IF, &NetData->GroupIface,
+                   sizeof(NetData->GroupIface)) != 0 ||
+        setsockopt(NetData->GroupSocket, IPPROTO_IP, IP_MULTICAST_TTL, &TTL, sizeof(TTL)) != 0 ||
+        setsockopt(NetData->GroupSocket, IPPROTO_IP, IP_MULTICAST_LOOP, &Loop, sizeof(Loop)) != 0)
+    {
+        EVSSendErr(SBN_UDP_SOCK_EID, "unable to join multicast group (errno=%d)", errno);
+        close(NetData->GroupSocket);
+        NetData->GroupSocket = -1;
+        return SBN_ERROR;
+    } /* end if */
+
+    return SBN_SUCCESS;
+} /* end OpenGroup() */
+
 /**
  * Initializes an UDP host.
  *
@@ -51,6 +303,11 @@ static SBN_Status_t InitNet(SBN_NetInterface_t *Net)
         return SBN_ERROR;
     } /* end if */
 
+    if (NetData->Multicast)
+    {
+        return OpenGroup(NetData);
+    } /* end if */
+
     return SBN_SUCCESS;
 } /* end InitNet() */
 
@@ -112,14 +369,92 @@ static SBN_Status_t ConfAddr(OS_SockAddr_t *Addr, const char *Address)
     return SBN_SUCCESS;
 } /* end ConfAddr() */
 
+/**
+ * \brief Configure the multicast group of a net from what follows the comma
+ * in its address ("host:port,group:port"), if anything does.
+ */
+static SBN_Status_t ConfGroup(SBN_UDP_Net_t *NetData, const char *Address)
+{
+    char  Host[OS_MAX_API_NAME];
+    char *Comma = strchr(Address, ','), *Colon = NULL, *ValidatePtr = NULL;
+    long  Port = 0;
+    int   HostLen = 0;
+
+    NetData->Multicast   = false;
+    NetData->GroupSocket = -1;
+
+    if (Comma == NULL)
+    {
+        /* unicast only */
+        return SBN_SUCCESS;
+    } /* end if */
+
+    Colon = strchr(Comma + 1, ':');
+    if (Colon == NULL || (HostLen = Colon - (Comma + 1)) >= OS_MAX_API_NAME)
+    {
+        EVSSendErr(SBN_UDP_CONFIG_EID, "invalid group address (Address=%s)", Address);
+        return SBN_ERROR;
+    } /* end if */
+
+    memcpy(Host, Comma + 1, HostLen);
+    Host[HostLen] = '\0';
+
+    Port = strtol(Colon + 1, &ValidatePtr, 0);
+    if (ValidatePtr == Colon + 1 || *ValidatePtr != '\0' || Port <= 0 || Port > 65535)
+    {
+        EVSSendErr(SBN_UDP_CONFIG_EID, "invalid group port (Address=%s)", Address);
+        return SBN_ERROR;
+    } /* end if */
+
+    memset(&NetData->GroupAddr, 0, sizeof(NetData->GroupAddr));
+    NetData->GroupAddr.sin_family = AF_INET;
+    NetData->GroupAddr.sin_port   = htons((uint16)Port);
+
+    if (inet_pton(AF_INET, Host, &NetData->GroupAddr.sin_addr) != 1 ||
+        (ntohl(NetData->GroupAddr.sin_addr.s_addr) & 0xF0000000) != 0xE0000000)
+    {
+        EVSSendErr(SBN_UDP_CONFIG_EID, "not a multicast group (Address=%s)", Address);
+        return SBN_ERROR;
+    } /* end if */
+
+    /* join on the interface of the net's own address (ConfAddr checked it) */
+    HostLen = strchr(Address, ':') - Address;
+    memcpy(Host, Address, HostLen);
+    Host[HostLen] = '\0';
+
+    if (inet_pton(AF_INET, Host, &NetData->GroupIface) != 1)
+    {
+        NetData->GroupIface.s_addr = htonl(INADDR_ANY);
+    } /* end if */
+
+    NetData->Multicast = true;
+
+    return SBN_SUCCESS;
+} /* end ConfGroup() */
+
 static SBN_Status_t LoadNet(SBN_NetInterface_t *Net, const char *Address)
 {
     SBN_UDP_Net_t *NetData = (SBN_UDP_Net_t *)Net->ModulePvt;
 
     EVSSendInfo(SBN_UDP_CONFIG_EID, "configuring net (NetData=0x%lx, Address=%s)", (long unsigned int)NetData, Address);
 
+    if (Net->HeartbeatMS == 0)
+    {
+        Net->HeartbeatMS = SBN_UDP_PEER_HEARTBEAT * 1000;
+    } /* end if */
+
+    if (Net->TimeoutMS == 0)
+    {
+        Net->TimeoutMS = SBN_UDP_PEER_TIMEOUT * 1000;
+    } /* end if */
+
     SBN_Status_t Status = ConfAddr(&NetData->Addr, Address);
 
+    if (Status == SBN_SUCCESS)
+    {
+        Status = ConfGroup(NetData, Address);
+    } /* end if */
+
     if (Status == SBN_SUCCESS)
     {
         EVSSendInfo(SBN_UDP_CONFIG_EID, "configured (NetData=0x%lx)", (long unsigned int)NetData);
@@ -135,8 +470,29 @@ static SBN_Status_t LoadPeer(SBN_PeerInterface_t *Peer, const char *Address)
     EVSSendInfo(SBN_UDP_CONFIG_EID, "configuring peer (PeerData=0x%lx, Address=%s)", (long unsigned int)PeerData,
                 Address);
 
+    static int MutexCnt = 0;
+    char       MutexName[OS_MAX_API_NAME];
+
     SBN_Status_t Status = ConfAddr(&PeerData->Addr, Address);
 
+    snprintf(MutexName, sizeof(MutexName), "sbn_udp_rel_%d", MutexCnt++);
+    if (OS_MutSemCreate(&PeerData->RelMutex, MutexName, 0) != OS_SUCCESS)
+    {
+        EVSSendErr(SBN_UDP_CONFIG_EID, "unable to create mutex");
+        return SBN_ERROR;
+    } /* end if */
+
+    PeerData->RelMutexCreated = true;
+
+    /* retransmit buffers for reliable MID's, freed when the peer is unloaded */
+    PeerData->RelSlots = calloc(SBN_UDP_REL_WINDOW, sizeof(*PeerData->RelSlots));
+    if (PeerData->RelSlots == NULL)
+    {
+        EVSSendErr(SBN_UDP_CONFIG_EID, "unable to allocate retransmit buffers, reliable MID's will be best-effort");
+    } /* end if */
+
+    RelReset(PeerData);
+
     if (Status == SBN_SUCCESS)
     {
         EVSSendInfo(SBN_UDP_CONFIG_EID, "configured (PeerData=0x%lx)", (long unsigned int)PeerData);
@@ -145,25 +501,157 @@ static SBN_Status_t LoadPeer(SBN_PeerInterface_t *Peer, const char *Address)
     return Status;
 } /* end LoadPeer() */
 
+static SBN_Status_t SendFrame(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Payload)
+{
+    int32 BufSz = MsgSz + SBN_PACKED_HDR_SZ, SentSz = 0;
+    uint8 *Buf  = NULL;
+
+    SBN_UDP_Peer_t *    PeerData = (SBN_UDP_Peer_t *)Peer->ModulePvt;
+    SBN_NetInterface_t *Net      = Peer->Net;
+    SBN_UDP_Net_t *     NetData  = (SBN_UDP_Net_t *)Net->ModulePvt;
+
+    OS_SockAddr_t Addr;
+    if (OS_SocketAddrInit(&Addr, OS_SocketDomain_INET) != OS_SUCCESS)
+    {
+        EVSSendErr(SBN_UDP_SOCK_EID, "socket addr init failed");
+        return SBN_ERROR;
+    } /* end if */
+
+    Buf = SBN_GetBuf();
+    if (Buf == NULL)
+    {
+        EVSSendErr(SBN_UDP_SOCK_EID, "no buffer to send from");
+        return SBN_ERROR;
+    } /* end if */
+
+    SBN_PackMsg(Buf, MsgSz, MsgType, CFE_PSP_GetProcessorId(), Payload);
+
+    SentSz = OS_SocketSendTo(NetData->Socket, Buf, BufSz, &PeerData->Addr);
+
+    SBN_PutBuf(Buf);
+
+    if (SentSz < BufSz)
+    {
+        EVSSendErr(SBN_UDP_SOCK_EID, "incomplete socket send, tried to send %d bytes, returned %d", (int)BufSz,
+                   (int)SentSz);
+        return SBN_ERROR;
+    }
+    else
+    {
+        return SBN_SUCCESS;
+    } /* end if */
+} /* end SendFrame() */
+
+/**
+ * \brief Retransmit reliable messages that have not been ACK'd in time,
+ * giving up on them after SBN_UDP_REL_MAX_RETX attempts.
+ */
+static void RelRetransmit(SBN_PeerInterface_t *Peer, OS_time_t *CurrentTime)
+{
+    SBN_UDP_Peer_t *PeerData = (SBN_UDP_Peer_t *)Peer->ModulePvt;
+    uint16          Seq      = 0;
+
+    if (PeerData->RelSlots == NULL)
+    {
+        return;
+    } /* end if */
+
+    for (Seq = PeerData->SendBase; Seq != PeerData->SendSeq; Seq++)
+    {
+        SBN_UDP_RelSlot_t *Slot = &PeerData->RelSlots[Seq % SBN_UDP_REL_WINDOW];
+        uint8              Buf[SBN_UDP_REL_HDR_SZ + SBN_UDP_REL_SLOT_SZ];
+
+        if (!Slot->InUse || SBN_ElapsedMS(&Slot->SentTime, CurrentTime) < SBN_UDP_REL_RTO)
+        {
+            continue;
+        } /* end if */
+
+        if (Slot->RetxCnt >= SBN_UDP_REL_MAX_RETX)
+        {
+            Slot->InUse = false;
+            PeerData->LostCnt++;
+            continue;
+        } /* end if */
+
+        PackUInt16(Buf, PeerData->Epoch);
+        PackUInt16(Buf + 2, Slot->Seq);
+        PackUInt16(Buf + 4, PeerData->SendBase);
+        RelPackAck(Buf + 6, PeerData);
+        memcpy(Buf + SBN_UDP_REL_HDR_SZ, Slot->Msg, Slot->MsgSz);
+
+        Slot->RetxCnt++;
+        Slot->SentTime = *CurrentTime;
+        PeerData->RetxCnt++;
+
+        /* not through SBN_SendNetMsg(), SBN already counted the message when it was first sent */
+        SendFrame(Peer, SBN_UDP_RELDATA_MSG, SBN_UDP_REL_HDR_SZ + Slot->MsgSz, Buf);
+    } /* end for */
+
+    /* slide past anything given up on */
+    while (PeerData->SendBase != PeerData->SendSeq &&
+           !PeerData->RelSlots[PeerData->SendBase % SBN_UDP_REL_WINDOW].InUse)
+    {
+        PeerData->SendBase++;
+    } /* end while */
+} /* end RelRetransmit() */
+
 static SBN_Status_t PollPeer(SBN_PeerInterface_t *Peer)
 {
-    OS_time_t CurrentTime;
+    SBN_UDP_Peer_t *PeerData = (SBN_UDP_Peer_t *)Peer->ModulePvt;
+    OS_time_t       CurrentTime;
+    uint8           AckBuf[SBN_UDP_ACK_SZ];
+    uint32          DelayMS   = SBN_LivenessPollMS(Peer);
+    bool            Heartbeat = false, Ack = false;
+
     OS_GetLocalTime(&CurrentTime);
 
+    if (PeerData->RelSlots != NULL && SBN_UDP_REL_RTO / 2 < DelayMS)
+    {
+        /* retransmits and ACKs need checking well within the RTO */
+        DelayMS = SBN_UDP_REL_RTO / 2;
+    } /* end if */
+
+    SBN_SchedulePoll(Peer, DelayMS);
+
     if (Peer->Connected)
     {
-        if (CurrentTime.seconds - Peer->LastRecv.seconds > SBN_UDP_PEER_TIMEOUT)
+        if (SBN_PeerTimedOut(Peer))
         {
             EVSSendInfo(SBN_UDP_DEBUG_EID, "disconnected CPU %d", Peer->ProcessorID);
 
             SBN_Disconnected(Peer);
+
+            OS_MutSemTake(PeerData->RelMutex);
+            RelReset(PeerData);
+            OS_MutSemGive(PeerData->RelMutex);
+
             return SBN_SUCCESS;
         } /* end if */
 
-        if (CurrentTime.seconds - Peer->LastSend.seconds > SBN_UDP_PEER_HEARTBEAT)
+        OS_MutSemTake(PeerData->RelMutex);
+
+        RelRetransmit(Peer, &CurrentTime);
+
+        Heartbeat = SBN_HeartbeatDue(Peer);
+        Ack       = PeerData->AckPending;
+        if (Heartbeat || Ack)
+        {
+            RelPackAck(AckBuf, PeerData);
+        } /* end if */
+
+        /* SBN_SendNetMsg() may take SBN's send mutex, which is taken before mine when sending */
+        OS_MutSemGive(PeerData->RelMutex);
+
+        if (Heartbeat)
         {
             EVSSendInfo(SBN_UDP_DEBUG_EID, "heartbeat CPU %d", Peer->ProcessorID);
-            return SBN_SendNetMsg(SBN_UDP_HEARTBEAT_MSG, 0, NULL, Peer);
+            return SBN_SendNetMsg(SBN_UDP_HEARTBEAT_MSG, SBN_UDP_ACK_SZ, AckBuf, Peer);
+        } /* end if */
+
+        if (Ack)
+        {
+            /* nothing reliable went back to piggyback the ACK on */
+            return SBN_SendNetMsg(SBN_UDP_ACK_MSG, SBN_UDP_ACK_SZ, AckBuf, Peer);
         } /* end if */
     }
     else
@@ -179,48 +667,134 @@ static SBN_Status_t PollPeer(SBN_PeerInterface_t *Peer)
     return SBN_SUCCESS;
 } /* end PollPeer() */
 
+/**
+ * \brief Send a message on a reliable MID, buffering it for retransmission
+ * and piggybacking my ACK of the peer's reliable messages.
+ *
+ * @return SBN_IF_EMPTY if the window is full and the message was dropped,
+ *         otherwise the status of the send.
+ */
+static SBN_Status_t SendReliable(SBN_PeerInterface_t *Peer, SBN_MsgSz_t MsgSz, void *Payload)
+{
+    SBN_UDP_Peer_t *   PeerData = (SBN_UDP_Peer_t *)Peer->ModulePvt;
+    SBN_UDP_RelSlot_t *Slot     = NULL;
+    SBN_Status_t       Status   = SBN_SUCCESS;
+    uint8              Buf[SBN_UDP_REL_HDR_SZ + SBN_UDP_REL_SLOT_SZ];
+
+    OS_MutSemTake(PeerData->RelMutex);
+
+    if ((uint16)(PeerData->SendSeq - PeerData->SendBase) >= SBN_UDP_REL_WINDOW)
+    {
+        /* window full, the peer has not kept up (or is gone), not a reason to stop sending to it */
+        PeerData->LostCnt++;
+        OS_MutSemGive(PeerData->RelMutex);
+        return SBN_IF_EMPTY;
+    } /* end if */
+
+    Slot = &PeerData->RelSlots[PeerData->SendSeq % SBN_UDP_REL_WINDOW];
+
+    Slot->InUse   = true;
+    Slot->Seq     = PeerData->SendSeq++;
+    Slot->RetxCnt = 0;
+    Slot->MsgSz   = MsgSz;
+    memcpy(Slot->Msg, Payload, MsgSz);
+    OS_GetLocalTime(&Slot->SentTime);
+
+    PackUInt16(Buf, PeerData->Epoch);
+    PackUInt16(Buf + 2, Slot->Seq);
+    PackUInt16(Buf + 4, PeerData->SendBase);
+    RelPackAck(Buf + 6, PeerData);
+    memcpy(Buf + SBN_UDP_REL_HDR_SZ, Payload, MsgSz);
+
+    Status = SendFrame(Peer, SBN_UDP_RELDATA_MSG, SBN_UDP_REL_HDR_SZ + MsgSz, Buf);
+
+    OS_MutSemGive(PeerData->RelMutex);
+
+    return Status;
+} /* end SendReliable() */
+
 static SBN_Status_t Send(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Payload)
 {
-    int32 BufSz = MsgSz + SBN_PACKED_HDR_SZ, SentSz = 0;
-    uint8 Buf[BufSz];
+    SBN_UDP_Peer_t *PeerData = (SBN_UDP_Peer_t *)Peer->ModulePvt;
 
-    SBN_UDP_Peer_t *    PeerData = (SBN_UDP_Peer_t *)Peer->ModulePvt;
-    SBN_NetInterface_t *Net      = Peer->Net;
-    SBN_UDP_Net_t *     NetData  = (SBN_UDP_Net_t *)Net->ModulePvt;
+    /* best-effort MID's (and oversized messages) take the plain path */
+    if (MsgType == SBN_APP_MSG && PeerData->RelSlots != NULL && MsgSz <= SBN_UDP_REL_SLOT_SZ &&
+        IsReliable(Peer, CFE_SB_GetMsgId((CFE_SB_MsgPtr_t)Payload)))
+    {
+        return SendReliable(Peer, MsgSz, Payload);
+    } /* end if */
 
-    SBN_PackMsg(Buf, MsgSz, MsgType, CFE_PSP_GetProcessorId(), Payload);
+    return SendFrame(Peer, MsgType, MsgSz, Payload);
+} /* end Send() */
 
-    OS_SockAddr_t Addr;
-    if (OS_SocketAddrInit(&Addr, OS_SocketDomain_INET) != OS_SUCCESS)
+/**
+ * \brief Send a message once to the net's multicast group, for all the peers
+ * on the net. Peers that subscribed to it reliably need it from Send(), so
+ * the group is only used when none did.
+ */
+static SBN_Status_t SendToNet(SBN_NetInterface_t *Net, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Payload)
+{
+    SBN_UDP_Net_t *NetData = (SBN_UDP_Net_t *)Net->ModulePvt;
+    int32          BufSz = MsgSz + SBN_PACKED_HDR_SZ, SentSz = 0;
+    uint8 *        Buf     = NULL;
+    SBN_PeerIdx_t  PeerIdx = 0;
+
+    if (!NetData->Multicast)
     {
-        EVSSendErr(SBN_UDP_SOCK_EID, "socket addr init failed");
+        return SBN_NOT_IMPLEMENTED;
+    } /* end if */
+
+    if (MsgType == SBN_APP_MSG)
+    {
+        for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
+        {
+            SBN_PeerInterface_t *Peer     = &Net->Peers[PeerIdx];
+            SBN_UDP_Peer_t *     PeerData = (SBN_UDP_Peer_t *)Peer->ModulePvt;
+
+            if (Peer->Unused)
+            {
+                continue;
+            } /* end if */
+
+            if (PeerData->RelSlots != NULL && MsgSz <= SBN_UDP_REL_SLOT_SZ &&
+                IsReliable(Peer, CFE_SB_GetMsgId((CFE_SB_MsgPtr_t)Payload)))
+            {
+                return SBN_NOT_IMPLEMENTED;
+            } /* end if */
+        }     /* end for */
+    }         /* end if */
+
+    Buf = SBN_GetBuf();
+    if (Buf == NULL)
+    {
+        EVSSendErr(SBN_UDP_SOCK_EID, "no buffer to send from");
         return SBN_ERROR;
     } /* end if */
 
-    SentSz = OS_SocketSendTo(NetData->Socket, Buf, BufSz, &PeerData->Addr);
+    SBN_PackMsg(Buf, MsgSz, MsgType, CFE_PSP_GetProcessorId(), Payload);
+
+    SentSz = sendto(NetData->GroupSocket, Buf, BufSz, 0, (struct sockaddr *)&NetData->GroupAddr,
+                    sizeof(NetData->GroupAddr));
+
+    SBN_PutBuf(Buf);
 
     if (SentSz < BufSz)
     {
-        EVSSendErr(SBN_UDP_SOCK_EID, "incomplete socket send, tried to send %d bytes, returned %d", (int)BufSz,
+        EVSSendErr(SBN_UDP_SOCK_EID, "incomplete multicast send, tried to send %d bytes, returned %d", (int)BufSz,
                    (int)SentSz);
         return SBN_ERROR;
-    }
-    else
-    {
-        return SBN_SUCCESS;
     } /* end if */
-} /* end Send() */
 
-/* Note that this Recv function is indescriminate, packets will be received
- * from all peers but that's ok, I just inject them into the SB and all is
- * good!
+    return SBN_SUCCESS;
+} /* end SendToNet() */
+
+/**
+ * \brief Receive the next message on the net's own (unicast) socket.
  */
-static SBN_Status_t Recv(SBN_NetInterface_t *Net, SBN_MsgType_t *MsgTypePtr, SBN_MsgSz_t *MsgSzPtr,
-                         CFE_ProcessorID_t *ProcessorIDPtr, void *Payload)
+static SBN_Status_t RecvUnicast(SBN_UDP_Net_t *NetData, SBN_MsgType_t *MsgTypePtr, SBN_MsgSz_t *MsgSzPtr,
+                                CFE_ProcessorID_t *ProcessorIDPtr, void *Payload)
 {
-    uint8 RecvBuf[SBN_MAX_PACKED_MSG_SZ];
-
-    SBN_UDP_Net_t *NetData = (SBN_UDP_Net_t *)Net->ModulePvt;
+    uint8 *RecvBuf = NULL;
 
     /* task-based peer connections block on reads, otherwise use select */
 
@@ -233,41 +807,170 @@ static SBN_Status_t Recv(SBN_NetInterface_t *Net, SBN_MsgType_t *MsgTypePtr, SBN
         return SBN_IF_EMPTY;
     } /* end if */
 
-    int Received = OS_SocketRecvFrom(NetData->Socket, (char *)&RecvBuf, CFE_MISSION_SB_MAX_SB_MSG_SIZE, NULL, OS_PEND);
-
-    if (Received < 0)
+    RecvBuf = SBN_GetBuf();
+    if (RecvBuf == NULL)
     {
+        EVSSendErr(SBN_UDP_SOCK_EID, "no buffer to receive into");
         return SBN_ERROR;
     } /* end if */
 
+    int Received = OS_SocketRecvFrom(NetData->Socket, (char *)RecvBuf, CFE_MISSION_SB_MAX_SB_MSG_SIZE, NULL, OS_PEND);
+
     /* each UDP packet is a full SBN message */
 
-    if (SBN_UnpackMsg(&RecvBuf, MsgSzPtr, MsgTypePtr, ProcessorIDPtr, Payload) == false)
+    if (Received < 0 || SBN_UnpackMsg(RecvBuf, MsgSzPtr, MsgTypePtr, ProcessorIDPtr, Payload) == false)
     {
+        SBN_PutBuf(RecvBuf);
         return SBN_ERROR;
     } /* end if */
 
+    SBN_PutBuf(RecvBuf);
+
+    return SBN_SUCCESS;
+} /* end RecvUnicast() */
+
+/**
+ * \brief Receive the next message sent to the net's multicast group by
+ * another CPU, my own sends are looped back to me and skipped.
+ */
+static SBN_Status_t RecvGroup(SBN_UDP_Net_t *NetData, SBN_MsgType_t *MsgTypePtr, SBN_MsgSz_t *MsgSzPtr,
+                              CFE_ProcessorID_t *ProcessorIDPtr, void *Payload)
+{
+    SBN_Status_t Status   = SBN_IF_EMPTY;
+    uint8 *      RecvBuf  = NULL;
+    ssize_t      Received = 0;
+
+    RecvBuf = SBN_GetBuf();
+    if (RecvBuf == NULL)
+    {
+        EVSSendErr(SBN_UDP_SOCK_EID, "no buffer to receive into");
+        return SBN_ERROR;
+    } /* end if */
+
+    while ((Received = recv(NetData->GroupSocket, RecvBuf, CFE_MISSION_SB_MAX_SB_MSG_SIZE, MSG_DONTWAIT)) > 0)
+    {
+        if (SBN_UnpackMsg(RecvBuf, MsgSzPtr, MsgTypePtr, ProcessorIDPtr, Payload) == false)
+        {
+            Status = SBN_ERROR;
+            break;
+        } /* end if */
+
+        if (*ProcessorIDPtr != CFE_PSP_GetProcessorId())
+        {
+            Status = SBN_SUCCESS;
+            break;
+        } /* end if */
+    }     /* end while */
+
+    SBN_PutBuf(RecvBuf);
+
+    return Status;
+} /* end RecvGroup() */
+
+/* Note that this Recv function is indescriminate, packets will be received
+ * from all peers but that's ok, I just inject them into the SB and all is
+ * good!
+ */
+static SBN_Status_t Recv(SBN_NetInterface_t *Net, SBN_MsgType_t *MsgTypePtr, SBN_MsgSz_t *MsgSzPtr,
+                         CFE_ProcessorID_t *ProcessorIDPtr, void *Payload)
+{
+    SBN_UDP_Net_t *NetData = (SBN_UDP_Net_t *)Net->ModulePvt;
+
+    SBN_Status_t Status    = RecvUnicast(NetData, MsgTypePtr, MsgSzPtr, ProcessorIDPtr, Payload);
+    bool         FromGroup = false;
+
+    if (Status == SBN_IF_EMPTY && NetData->Multicast)
+    {
+        Status    = RecvGroup(NetData, MsgTypePtr, MsgSzPtr, ProcessorIDPtr, Payload);
+        FromGroup = true;
+    } /* end if */
+
+    if (Status != SBN_SUCCESS)
+    {
+        return Status;
+    } /* end if */
+
     SBN_PeerInterface_t *Peer = SBN_GetPeer(Net, *ProcessorIDPtr);
     if (Peer == NULL)
     {
         return SBN_ERROR;
     } /* end if */
 
+    SBN_UDP_Peer_t *PeerData = (SBN_UDP_Peer_t *)Peer->ModulePvt;
+    uint8 *         Buf      = (uint8 *)Payload;
+
+    bool New = true;
+
+    /* the mutex is not held across SBN_(Dis)Connected(), which may send */
     if (!Peer->Connected)
     {
+        OS_MutSemTake(PeerData->RelMutex);
+        RelReset(PeerData);
+        OS_MutSemGive(PeerData->RelMutex);
+
         SBN_Connected(Peer);
     } /* end if */
 
-    if (*MsgTypePtr == SBN_UDP_DISCONN_MSG)
+    switch (*MsgTypePtr)
     {
-        SBN_Disconnected(Peer);
-    }
+        case SBN_UDP_DISCONN_MSG:
+            SBN_Disconnected(Peer);
+
+            OS_MutSemTake(PeerData->RelMutex);
+            RelReset(PeerData);
+            OS_MutSemGive(PeerData->RelMutex);
+            break;
+        case SBN_UDP_HEARTBEAT_MSG:
+        case SBN_UDP_ACK_MSG:
+            if (*MsgSzPtr >= SBN_UDP_ACK_SZ)
+            {
+                OS_MutSemTake(PeerData->RelMutex);
+                RelProcessAck(PeerData, Buf);
+                OS_MutSemGive(PeerData->RelMutex);
+            } /* end if */
+            break;
+        case SBN_UDP_RELDATA_MSG:
+            if (*MsgSzPtr < SBN_UDP_REL_HDR_SZ)
+            {
+                return SBN_ERROR;
+            } /* end if */
+
+            OS_MutSemTake(PeerData->RelMutex);
+            RelProcessAck(PeerData, Buf + 6);
+            New = RelRecv(PeerData, UnpackUInt16(Buf), UnpackUInt16(Buf + 2), UnpackUInt16(Buf + 4));
+            OS_MutSemGive(PeerData->RelMutex);
+
+            if (!New)
+            {
+                /* duplicate, nothing for SBN to process */
+                *MsgTypePtr = SBN_NO_MSG;
+                *MsgSzPtr   = 0;
+                break;
+            } /* end if */
+
+            /* strip the reliable header, what remains is the SB message */
+            *MsgTypePtr = SBN_APP_MSG;
+            *MsgSzPtr -= SBN_UDP_REL_HDR_SZ;
+            memmove(Buf, Buf + SBN_UDP_REL_HDR_SZ, *MsgSzPtr);
+            break;
+        default:
+            break;
+    } /* end switch */
+
+    if (FromGroup && *MsgTypePtr == SBN_APP_MSG && !SBN_Subscribed(Net, CFE_SB_GetMsgId((CFE_SB_MsgPtr_t)Payload)))
+    {
+        /* sent to the group for other peers, what is sent to me alone is left to the receive filters */
+        *MsgTypePtr = SBN_NO_MSG;
+        *MsgSzPtr   = 0;
+    } /* end if */
 
     return SBN_SUCCESS;
 } /* end Recv() */
 
 static SBN_Status_t UnloadPeer(SBN_PeerInterface_t *Peer)
 {
+    SBN_UDP_Peer_t *PeerData = (SBN_UDP_Peer_t *)Peer->ModulePvt;
+
     if (Peer->Connected)
     {
         EVSSendInfo(SBN_UDP_DEBUG_EID, "peer%d - sending disconnect", Peer->ProcessorID);
@@ -275,6 +978,18 @@ static SBN_Status_t UnloadPeer(SBN_PeerInterface_t *Peer)
         SBN_Disconnected(Peer);
     } /* end if */
 
+    if (PeerData->RelMutexCreated)
+    {
+        /* the net's receive task may be processing an ACK from the peer */
+        OS_MutSemTake(PeerData->RelMutex);
+        free(PeerData->RelSlots);
+        PeerData->RelSlots = NULL;
+        OS_MutSemGive(PeerData->RelMutex);
+
+        OS_MutSemDelete(PeerData->RelMutex);
+        PeerData->RelMutexCreated = false;
+    } /* end if */
+
     return SBN_SUCCESS;
 } /* end UnloadPeer() */
 
@@ -284,14 +999,23 @@ static SBN_Status_t UnloadNet(SBN_NetInterface_t *Net)
 
     OS_close(NetData->Socket);
 
+    if (NetData->Multicast && NetData->GroupSocket >= 0)
+    {
+        close(NetData->GroupSocket);
+        NetData->GroupSocket = -1;
+    } /* end if */
+
     SBN_PeerIdx_t PeerIdx = 0;
     for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
     {
-        UnloadPeer(&Net->Peers[PeerIdx]);
-    } /* end if */
+        if (!Net->Peers[PeerIdx].Unused)
+        {
+            UnloadPeer(&Net->Peers[PeerIdx]);
+        } /* end if */
+    }     /* end for */
 
     return SBN_SUCCESS;
 } /* end UnloadNet() */
 
-SBN_IfOps_t SBN_UDP_Ops = {Init, InitNet, InitPeer, LoadNet,   LoadPeer,  PollPeer,
-                           Send, NULL,    Recv,     UnloadNet, UnloadPeer};
+SBN_IfOps_t SBN_UDP_Ops = {Init, InitNet, InitPeer,  LoadNet,    LoadPeer, PollPeer,
+                           Send, NULL,    Recv,      UnloadNet,  UnloadPeer, SendToNet};
@@ -16,16 +16,20 @@
 #define SBN_UDP_HEARTBEAT_MSG 0xA0
 #define SBN_UDP_ANNOUNCE_MSG  0xA1
 #define SBN_UDP_DISCONN_MSG   0xA2
+#define SBN_UDP_RELDATA_MSG   0xA3
+#define SBN_UDP_ACK_MSG       0xA4
 
 /**
  * \brief Number of seconds since last I've sent the peer a message when
- * I send an empty heartbeat message.
+ * I send an empty heartbeat message, for nets whose configuration leaves
+ * HeartbeatMS 0.
  */
 #define SBN_UDP_PEER_HEARTBEAT 5
 
 /**
  * \brief Number of seconds since I've last heard from the peer when I consider
- * the peer connection to be dropped.
+ * the peer connection to be dropped, for nets whose configuration leaves
+ * TimeoutMS 0. The failure detector may drop it sooner, see SBN_PeerTimedOut().
  */
 #define SBN_UDP_PEER_TIMEOUT 10
 
@@ -35,15 +39,108 @@
  */
 #define SBN_UDP_ANNOUNCE_TIMEOUT 10
 
+/**
+ * \brief Maximum number of unacknowledged reliable messages per peer, at most
+ * 32 as the selective ACK is a 32-bit mask.
+ */
+#define SBN_UDP_REL_WINDOW 16
+
+/**
+ * \brief Largest message (in bytes) that is buffered for retransmission,
+ * larger messages on reliable MID's are sent best-effort.
+ */
+#define SBN_UDP_REL_SLOT_SZ 1024
+
+/**
+ * \brief Number of milliseconds to wait for an ACK before retransmitting.
+ */
+#define SBN_UDP_REL_RTO 200
+
+/**
+ * \brief Number of times a reliable message is retransmitted before it is
+ * given up on.
+ */
+#define SBN_UDP_REL_MAX_RETX 5
+
+/**
+ * \brief An ACK block is the epoch being acknowledged (uint16), the next
+ * sequence number expected (uint16), and a selective ACK mask (uint32) where
+ * bit i is set if sequence number (next expected + i) has been received.
+ * It is the payload of SBN_UDP_ACK_MSG and SBN_UDP_HEARTBEAT_MSG.
+ */
+#define SBN_UDP_ACK_SZ 8
+
+/**
+ * \brief A SBN_UDP_RELDATA_MSG payload is the sender's epoch (uint16),
+ * sequence number (uint16) and oldest sequence number it has not given up on
+ * (uint16), a piggybacked ACK block, then the SB message. The receiver slides
+ * its window up to the oldest sequence number, past messages it will never get.
+ */
+#define SBN_UDP_REL_HDR_SZ (6 + SBN_UDP_ACK_SZ)
+
+/**
+ * \brief A reliable message sent but not yet acknowledged.
+ */
+typedef struct
+{
+    bool        InUse;
+    uint16      Seq;
+    uint8       RetxCnt;
+    OS_time_t   SentTime;
+    SBN_MsgSz_t MsgSz;
+    uint8       Msg[SBN_UDP_REL_SLOT_SZ];
+} SBN_UDP_RelSlot_t;
+
 typedef struct
 {
     OS_SockAddr_t Addr;
+
+    /**
+     * \brief Reliable delivery state, the epoch changes every time the
+     * connection is (re)established so stale sequence numbers and ACKs from
+     * a previous connection are not mistaken for current ones.
+     */
+    uint16 Epoch, SendSeq, SendBase;
+
+    /** \brief The peer's epoch, next sequence number expected and SACK mask. */
+    uint16 PeerEpoch, RecvBase;
+    uint32 RecvMask;
+
+    /** \brief Set when received reliable messages have not been ACK'd yet. */
+    bool AckPending;
+
+    /** \brief The SBN_UDP_REL_WINDOW retransmit buffers allocated when the peer was loaded, NULL if none. */
+    SBN_UDP_RelSlot_t *RelSlots;
+
+    /**
+     * \brief Serializes the reliable delivery state, which the send, receive
+     * and main tasks all update.
+     */
+    OS_MutexID_t RelMutex;
+    bool         RelMutexCreated;
+
+    uint32 RetxCnt, LostCnt;
 } SBN_UDP_Peer_t;
 
+/**
+ * \brief Multicast TTL (hop limit) of messages sent to a net's group.
+ */
+#define SBN_UDP_MCAST_TTL 1
+
 typedef struct
 {
     OS_SockAddr_t Addr;
     uint32        Socket;
+
+    /**
+     * \brief Set when the net's address names a multicast group after the
+     * host address ("host:port,group:port"), messages wanted by more than
+     * one peer on the net are then sent once, to the group.
+     */
+    bool               Multicast;
+    struct sockaddr_in GroupAddr;
+    struct in_addr     GroupIface;
+    int                GroupSocket;
 } SBN_UDP_Net_t;
 
 #endif /* _SBN_UDP_IF_H_ */
@@ -39,10 +39,18 @@
 #include "sbn_udp_if.h"
 #include "sbn_app.h"
 
+#include <stdlib.h>
+
 #define SBN_PROTOCOL_VERSION 5
 
 SBN_App_t SBN;
 
+/* SBN allocates these when it loads its configuration table */
+static SBN_NetInterface_t  Nets[1];
+static SBN_PeerInterface_t Peers[1];
+static SBN_Subs_t          PeerSubs[SBN_MAX_SUBS_PER_PEER + 1];
+static SBN_PeerInterface_t *PeerSlots[1];
+
 SBN_NetInterface_t * NetPtr;
 SBN_PeerInterface_t *PeerPtr;
 typedef struct
@@ -61,14 +69,31 @@ static void START_fn(const char *fn, int ln)
 {
     UT_ResetState(0);
     printf("Start item %s (%d)\n", fn, ln);
+
+    /* LoadPeer() allocates these, and UnloadPeer() frees them */
+    free(((SBN_UDP_Peer_t *)Peers[0].ModulePvt)->RelSlots);
+
     memset(&SBN, 0, sizeof(SBN));
+    memset(Nets, 0, sizeof(Nets));
+    memset(Peers, 0, sizeof(Peers));
+    memset(PeerSubs, 0, sizeof(PeerSubs));
+    SBN.Nets              = Nets;
+    SBN.Peers             = PeerSlots;
+    SBN.Peers[0]          = &Peers[0];
+    SBN.PeerSlots         = 1;
+    SBN.PeerCnt           = 1;
     SBN.NetCnt            = 1;
     NetPtr                = &SBN.Nets[0];
+    NetPtr->Peers         = Peers;
     PeerPtr               = &NetPtr->Peers[0];
+    PeerPtr->Subs         = PeerSubs;
+    PeerPtr->MaxSubs      = SBN_MAX_SUBS_PER_PEER;
     NetPtr->PeerCnt       = 1;
     PeerPtr->Net          = NetPtr;
     PeerPtr->ProcessorID  = 1;
     PeerPtr->SpacecraftID = 42;
+
+    ((SBN_UDP_Peer_t *)PeerPtr->ModulePvt)->RelSlots = calloc(SBN_UDP_REL_WINDOW, sizeof(SBN_UDP_RelSlot_t));
 } /* end START_fn() */
 
 extern SBN_IfOps_t SBN_UDP_Ops;
@@ -278,8 +303,50 @@ static void LoadNet_Nominal(void)
     UT_TEST_FUNCTION_RC(SBN_UDP_Ops.LoadNet(NetPtr, "localhost:1234"), SBN_SUCCESS);
 
     EVENT_CNT(1);
+
+    /* the configuration table left them 0 */
+    UtAssert_INT32_EQ(NetPtr->HeartbeatMS, SBN_UDP_PEER_HEARTBEAT * 1000);
+    UtAssert_INT32_EQ(NetPtr->TimeoutMS, SBN_UDP_PEER_TIMEOUT * 1000);
 } /* end LoadNet_Nominal() */
 
+static void LoadNet_GroupErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(&EventTest, SBN_UDP_CONFIG_EID, "not a multicast group (Address=");
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.LoadNet(NetPtr, "127.0.0.1:1234,10.0.0.1:2300"), SBN_ERROR);
+
+    EVENT_CNT(1);
+} /* end LoadNet_GroupErr() */
+
+static void LoadNet_GroupPortErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(&EventTest, SBN_UDP_CONFIG_EID, "invalid group port (Address=");
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.LoadNet(NetPtr, "127.0.0.1:1234,239.255.0.1:0"), SBN_ERROR);
+
+    EVENT_CNT(1);
+} /* end LoadNet_GroupPortErr() */
+
+static void LoadNet_Multicast(void)
+{
+    START();
+
+    SBN_UDP_Net_t *NetData = (SBN_UDP_Net_t *)NetPtr->ModulePvt;
+
+    UT_CheckEvent_Setup(&EventTest, SBN_UDP_CONFIG_EID, "configured (NetData=");
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.LoadNet(NetPtr, "127.0.0.1:1234,239.255.0.1:2300"), SBN_SUCCESS);
+
+    EVENT_CNT(1);
+    UtAssert_True(NetData->Multicast, "multicast net (%s)", __func__);
+    UtAssert_INT32_EQ(ntohs(NetData->GroupAddr.sin_port), 2300);
+    UtAssert_INT32_EQ(ntohl(NetData->GroupIface.s_addr), INADDR_LOOPBACK);
+} /* end LoadNet_Multicast() */
+
 void Test_SBN_UDP_LoadNet(void)
 {
     LoadNet_AddrErr();
@@ -288,6 +355,9 @@ void Test_SBN_UDP_LoadNet(void)
     LoadNet_HostErr();
     LoadNet_PortErr();
     LoadNet_Nominal();
+    LoadNet_GroupErr();
+    LoadNet_GroupPortErr();
+    LoadNet_Multicast();
 } /* end Test_SBN_UDP_LoadNet() */
 
 static void LoadPeer_Nominal(void)
@@ -318,9 +388,9 @@ static void PollPeer_ConnTimeout(void)
 
     UT_CheckEvent_Setup(&EventTest, SBN_UDP_DEBUG_EID, "disconnected CPU ");
 
-    tm.seconds = SBN_UDP_PEER_TIMEOUT + 1;
     UT_SetDataBuffer(UT_KEY(OS_GetLocalTime), &tm, sizeof(tm), false);
     UT_SetDeferredRetcode(UT_KEY(OS_GetLocalTime), 1, OS_SUCCESS);
+    UT_SetDeferredRetcode(UT_KEY(SBN_PeerTimedOut), 1, true);
 
     UT_TEST_FUNCTION_RC(SBN_UDP_Ops.PollPeer(PeerPtr), SBN_SUCCESS);
 
@@ -339,9 +409,9 @@ static void PollPeer_HeartbeatTimeout(void)
 
     UT_CheckEvent_Setup(&EventTest, SBN_UDP_DEBUG_EID, "heartbeat CPU ");
 
-    tm.seconds = SBN_UDP_PEER_HEARTBEAT + 1;
     UT_SetDataBuffer(UT_KEY(OS_GetLocalTime), &tm, sizeof(tm), false);
     UT_SetDeferredRetcode(UT_KEY(OS_GetLocalTime), 1, OS_SUCCESS);
+    UT_SetDeferredRetcode(UT_KEY(SBN_HeartbeatDue), 1, true);
 
     UT_SetDeferredRetcode(UT_KEY(SBN_SendNetMsg), 1, SBN_SUCCESS);
 
@@ -389,6 +459,7 @@ static void PollPeer_Nominal(void)
     UT_SetDeferredRetcode(UT_KEY(CFE_PSP_GetProcessorId), 1, 1);
 
     UT_TEST_FUNCTION_RC(SBN_UDP_Ops.PollPeer(PeerPtr), SBN_SUCCESS);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(SBN_SchedulePoll)), 1);
 } /* end PollPeer_Nominal() */
 
 void Test_SBN_UDP_PollPeer(void)
@@ -448,13 +519,176 @@ static void Send_Nominal(void)
     UT_TEST_FUNCTION_RC(SBN_UDP_Ops.Send(PeerPtr, SBN_APP_MSG, CFE_SB_TLM_HDR_SIZE, SBMsgPtr), SBN_SUCCESS);
 } /* end Send_Nominal() */
 
+static void Send_Reliable(void)
+{
+    START();
+    CFE_SB_MsgPtr_t           SBMsgPtr;
+    CFE_MSG_TelemetryHeader_t TlmPkt;
+    SBN_UDP_Peer_t *          PeerData = (SBN_UDP_Peer_t *)PeerPtr->ModulePvt;
+
+    SBMsgPtr = (CFE_SB_MsgPtr_t)&TlmPkt;
+    CFE_SB_InitMsg(SBMsgPtr, 0x1234, CFE_SB_TLM_HDR_SIZE, true);
+
+    PeerPtr->SubCnt                  = 1;
+    PeerPtr->Subs[0].MsgID           = 0x1234;
+    PeerPtr->Subs[0].LastMsgID       = 0x1234;
+    PeerPtr->Subs[0].QoS.Reliability = CFE_SB_QosReliability_HIGH;
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_GetMsgId), 1, 0x1234);
+
+    UT_SetDeferredRetcode(UT_KEY(OS_SocketAddrInit), 1, OS_SUCCESS);
+    UT_SetDeferredRetcode(UT_KEY(OS_SocketSendTo), 1, CFE_SB_TLM_HDR_SIZE + SBN_UDP_REL_HDR_SZ + SBN_PACKED_HDR_SZ);
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.Send(PeerPtr, SBN_APP_MSG, CFE_SB_TLM_HDR_SIZE, SBMsgPtr), SBN_SUCCESS);
+
+    /* buffered until ACK'd */
+    UtAssert_INT32_EQ(PeerData->SendSeq, 1);
+    UtAssert_INT32_EQ(PeerData->SendBase, 0);
+} /* end Send_Reliable() */
+
+static void Send_ReliableRange(void)
+{
+    START();
+    CFE_SB_MsgPtr_t           SBMsgPtr;
+    CFE_MSG_TelemetryHeader_t TlmPkt;
+    SBN_UDP_Peer_t *          PeerData = (SBN_UDP_Peer_t *)PeerPtr->ModulePvt;
+    int                       i        = 0;
+
+    SBMsgPtr = (CFE_SB_MsgPtr_t)&TlmPkt;
+    CFE_SB_InitMsg(SBMsgPtr, 0x1234, CFE_SB_TLM_HDR_SIZE, true);
+
+    /* ranges in message ID order, only the fourth reliable */
+    PeerPtr->SubCnt = 6;
+    for (i = 0; i < PeerPtr->SubCnt; i++)
+    {
+        PeerPtr->Subs[i].MsgID           = 0x1200 + i * 0x10;
+        PeerPtr->Subs[i].LastMsgID       = 0x1200 + i * 0x10 + 0x07;
+        PeerPtr->Subs[i].QoS.Reliability = CFE_SB_QosReliability_LOW;
+    } /* end for */
+    PeerPtr->Subs[3].QoS.Reliability = CFE_SB_QosReliability_HIGH;
+
+    /* between the third and fourth ranges, then in the fourth, then past the last */
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_GetMsgId), 1, 0x122A);
+    SBN_UDP_Ops.Send(PeerPtr, SBN_APP_MSG, CFE_SB_TLM_HDR_SIZE, SBMsgPtr);
+    UtAssert_INT32_EQ(PeerData->SendSeq, 0);
+
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_GetMsgId), 1, 0x1234);
+    SBN_UDP_Ops.Send(PeerPtr, SBN_APP_MSG, CFE_SB_TLM_HDR_SIZE, SBMsgPtr);
+    UtAssert_INT32_EQ(PeerData->SendSeq, 1);
+
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_GetMsgId), 1, 0x1300);
+    SBN_UDP_Ops.Send(PeerPtr, SBN_APP_MSG, CFE_SB_TLM_HDR_SIZE, SBMsgPtr);
+    UtAssert_INT32_EQ(PeerData->SendSeq, 1);
+} /* end Send_ReliableRange() */
+
+static void Send_WindowFull(void)
+{
+    START();
+    CFE_SB_MsgPtr_t           SBMsgPtr;
+    CFE_MSG_TelemetryHeader_t TlmPkt;
+    SBN_UDP_Peer_t *          PeerData = (SBN_UDP_Peer_t *)PeerPtr->ModulePvt;
+
+    SBMsgPtr = (CFE_SB_MsgPtr_t)&TlmPkt;
+    CFE_SB_InitMsg(SBMsgPtr, 0x1234, CFE_SB_TLM_HDR_SIZE, true);
+
+    PeerPtr->SubCnt                  = 1;
+    PeerPtr->Subs[0].MsgID           = 0x1234;
+    PeerPtr->Subs[0].LastMsgID       = 0x1234;
+    PeerPtr->Subs[0].QoS.Reliability = CFE_SB_QosReliability_HIGH;
+    PeerData->SendSeq                = SBN_UDP_REL_WINDOW;
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_GetMsgId), 1, 0x1234);
+
+    /* dropped, but not an error that would end the peer's send task */
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.Send(PeerPtr, SBN_APP_MSG, CFE_SB_TLM_HDR_SIZE, SBMsgPtr), SBN_IF_EMPTY);
+    UtAssert_INT32_EQ(PeerData->LostCnt, 1);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(OS_SocketSendTo)), 0);
+} /* end Send_WindowFull() */
+
+static void Send_Retransmit(void)
+{
+    START();
+    CFE_SB_MsgPtr_t           SBMsgPtr;
+    CFE_MSG_TelemetryHeader_t TlmPkt;
+    SBN_UDP_Peer_t *          PeerData = (SBN_UDP_Peer_t *)PeerPtr->ModulePvt;
+    OS_time_t                 tm[2];
+
+    SBMsgPtr = (CFE_SB_MsgPtr_t)&TlmPkt;
+    CFE_SB_InitMsg(SBMsgPtr, 0x1234, CFE_SB_TLM_HDR_SIZE, true);
+
+    PeerPtr->Connected               = true;
+    PeerPtr->SubCnt                  = 1;
+    PeerPtr->Subs[0].MsgID           = 0x1234;
+    PeerPtr->Subs[0].LastMsgID       = 0x1234;
+    PeerPtr->Subs[0].QoS.Reliability = CFE_SB_QosReliability_HIGH;
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_GetMsgId), 1, 0x1234);
+
+    /* sent, then polled a second later without an ACK */
+    memset(tm, 0, sizeof(tm));
+    tm[1].seconds = 1;
+    UT_SetDataBuffer(UT_KEY(OS_GetLocalTime), tm, sizeof(tm), false);
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.Send(PeerPtr, SBN_APP_MSG, CFE_SB_TLM_HDR_SIZE, SBMsgPtr), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.PollPeer(PeerPtr), SBN_SUCCESS);
+
+    /* retransmitted by the module, not counted by SBN as another send */
+    UtAssert_INT32_EQ(PeerData->RetxCnt, 1);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(OS_SocketSendTo)), 2);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(SBN_SendNetMsg)), 0);
+} /* end Send_Retransmit() */
+
 void Test_SBN_UDP_Send(void)
 {
     Send_AddrInitErr();
     Send_SendErr();
     Send_Nominal();
+    Send_Reliable();
+    Send_ReliableRange();
+    Send_WindowFull();
+    Send_Retransmit();
 } /* end Test_SBN_UDP_LoadNet() */
 
+static void SendToNet_Unicast(void)
+{
+    START();
+    CFE_SB_MsgPtr_t           SBMsgPtr;
+    CFE_MSG_TelemetryHeader_t TlmPkt;
+
+    SBMsgPtr = (CFE_SB_MsgPtr_t)&TlmPkt;
+    CFE_SB_InitMsg(SBMsgPtr, 0x1234, CFE_SB_TLM_HDR_SIZE, true);
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.SendToNet(NetPtr, SBN_APP_MSG, CFE_SB_TLM_HDR_SIZE, SBMsgPtr),
+                        SBN_NOT_IMPLEMENTED);
+} /* end SendToNet_Unicast() */
+
+static void SendToNet_Reliable(void)
+{
+    START();
+    CFE_SB_MsgPtr_t           SBMsgPtr;
+    CFE_MSG_TelemetryHeader_t TlmPkt;
+    SBN_UDP_Net_t *           NetData  = (SBN_UDP_Net_t *)NetPtr->ModulePvt;
+    SBN_UDP_Peer_t *          PeerData = (SBN_UDP_Peer_t *)PeerPtr->ModulePvt;
+
+    SBMsgPtr = (CFE_SB_MsgPtr_t)&TlmPkt;
+    CFE_SB_InitMsg(SBMsgPtr, 0x1234, CFE_SB_TLM_HDR_SIZE, true);
+
+    NetData->Multicast               = true;
+    PeerPtr->SubCnt                  = 1;
+    PeerPtr->Subs[0].MsgID           = 0x1234;
+    PeerPtr->Subs[0].LastMsgID       = 0x1234;
+    PeerPtr->Subs[0].QoS.Reliability = CFE_SB_QosReliability_HIGH;
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_GetMsgId), 1, 0x1234);
+
+    /* the group is best-effort, the peer gets it from Send() */
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.SendToNet(NetPtr, SBN_APP_MSG, CFE_SB_TLM_HDR_SIZE, SBMsgPtr),
+                        SBN_NOT_IMPLEMENTED);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(SBN_GetBuf)), 0);
+} /* end SendToNet_Reliable() */
+
+void Test_SBN_UDP_SendToNet(void)
+{
+    SendToNet_Unicast();
+    SendToNet_Reliable();
+} /* end Test_SBN_UDP_SendToNet() */
+
 static int32 NoDataHook(void *UserObj, int32 StubRetcode, uint32 CallCount, const UT_StubContext_t *Context)
 {
     *((uint32 *)Context->ArgPtr[1]) = 0;
@@ -488,6 +722,22 @@ static void Recv_SockRecvErr(void)
     UT_TEST_FUNCTION_RC(SBN_UDP_Ops.RecvFromNet(NetPtr, NULL, NULL, NULL, NULL), SBN_ERROR);
 } /* end Recv_SockRecvErr() */
 
+static void Recv_NoBuf(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(&EventTest, SBN_UDP_SOCK_EID, "no buffer to receive into");
+
+    UT_SetHookFunction(UT_KEY(OS_SelectSingle), DataHook, NULL);
+    UT_SetDeferredRetcode(UT_KEY(OS_SelectSingle), 1, OS_SUCCESS);
+    UT_SetDeferredRetcode(UT_KEY(SBN_GetBuf), 1, -1);
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.RecvFromNet(NetPtr, NULL, NULL, NULL, NULL), SBN_ERROR);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(OS_SocketRecvFrom)), 0);
+
+    EVENT_CNT(1);
+} /* end Recv_NoBuf() */
+
 static void Recv_UnpackErr(void)
 {
     START();
@@ -616,15 +866,134 @@ static void Recv_Nominal(void)
     UtAssert_INT32_EQ(ProcessorID, PeerPtr->ProcessorID);
 } /* end Recv_Nominal() */
 
+static void Recv_RelData(void)
+{
+    START();
+
+    SBN_MsgType_t     MsgType;
+    SBN_MsgSz_t       MsgSz;
+    CFE_ProcessorID_t ProcessorID;
+    uint8             PayloadBuffer[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
+    SBN_Unpack_Buf_t  UnpackBuf;
+    SBN_UDP_Peer_t *  PeerData = (SBN_UDP_Peer_t *)PeerPtr->ModulePvt;
+
+    PeerPtr->Connected = true;
+
+    memset(&UnpackBuf, 0, sizeof(UnpackBuf));
+    UnpackBuf.MsgSz       = SBN_UDP_REL_HDR_SZ + 16;
+    UnpackBuf.MsgType     = SBN_UDP_RELDATA_MSG;
+    UnpackBuf.ProcessorID = PeerPtr->ProcessorID;
+    UnpackBuf.MsgBuf[1]   = 7; /* epoch 7, seq 0, no ACK */
+    strncpy((char *)UnpackBuf.MsgBuf + SBN_UDP_REL_HDR_SZ, "deadbeef", 9);
+
+    UT_SetHookFunction(UT_KEY(OS_SelectSingle), DataHook, NULL);
+    UT_SetDeferredRetcode(UT_KEY(OS_SelectSingle), 1, OS_SUCCESS);
+    UT_SetDeferredRetcode(UT_KEY(OS_SocketRecvFrom), 1, 1);
+    UT_SetDataBuffer(UT_KEY(SBN_UnpackMsg), &UnpackBuf, sizeof(UnpackBuf), false);
+    UT_SetDataBuffer(UT_KEY(SBN_GetPeer), &PeerPtr, sizeof(PeerPtr), false);
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.RecvFromNet(NetPtr, &MsgType, &MsgSz, &ProcessorID, PayloadBuffer), CFE_SUCCESS);
+
+    UtAssert_INT32_EQ(MsgType, SBN_APP_MSG);
+    UtAssert_INT32_EQ(MsgSz, 16);
+    UtAssert_True(strcmp((char *)PayloadBuffer, "deadbeef") == 0, "reliable header stripped (%s)", __func__);
+    UtAssert_INT32_EQ(PeerData->RecvBase, 1);
+    UtAssert_True(PeerData->AckPending, "ACK pending (%s)", __func__);
+
+    /* the same message again is a duplicate */
+    UT_SetDeferredRetcode(UT_KEY(OS_SelectSingle), 1, OS_SUCCESS);
+    UT_SetDeferredRetcode(UT_KEY(OS_SocketRecvFrom), 1, 1);
+    UT_SetDataBuffer(UT_KEY(SBN_UnpackMsg), &UnpackBuf, sizeof(UnpackBuf), false);
+    UT_SetDataBuffer(UT_KEY(SBN_GetPeer), &PeerPtr, sizeof(PeerPtr), false);
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.RecvFromNet(NetPtr, &MsgType, &MsgSz, &ProcessorID, PayloadBuffer), CFE_SUCCESS);
+
+    UtAssert_INT32_EQ(MsgType, SBN_NO_MSG);
+    UtAssert_INT32_EQ(PeerData->RecvBase, 1);
+} /* end Recv_RelData() */
+
+static void Recv_RelGivenUp(void)
+{
+    START();
+
+    SBN_MsgType_t     MsgType;
+    SBN_MsgSz_t       MsgSz;
+    CFE_ProcessorID_t ProcessorID;
+    uint8             PayloadBuffer[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
+    SBN_Unpack_Buf_t  UnpackBuf;
+    SBN_UDP_Peer_t *  PeerData = (SBN_UDP_Peer_t *)PeerPtr->ModulePvt;
+
+    /* still waiting on seq 0, which the peer gave up on */
+    PeerPtr->Connected  = true;
+    PeerData->PeerEpoch = 7;
+
+    memset(&UnpackBuf, 0, sizeof(UnpackBuf));
+    UnpackBuf.MsgSz       = SBN_UDP_REL_HDR_SZ + 16;
+    UnpackBuf.MsgType     = SBN_UDP_RELDATA_MSG;
+    UnpackBuf.ProcessorID = PeerPtr->ProcessorID;
+    UnpackBuf.MsgBuf[1]   = 7;  /* epoch 7 */
+    UnpackBuf.MsgBuf[3]   = 40; /* seq 40, beyond the receive window */
+    UnpackBuf.MsgBuf[5]   = 40; /* the oldest seq the peer still retransmits */
+    strncpy((char *)UnpackBuf.MsgBuf + SBN_UDP_REL_HDR_SZ, "deadbeef", 9);
+
+    UT_SetHookFunction(UT_KEY(OS_SelectSingle), DataHook, NULL);
+    UT_SetDeferredRetcode(UT_KEY(OS_SelectSingle), 1, OS_SUCCESS);
+    UT_SetDeferredRetcode(UT_KEY(OS_SocketRecvFrom), 1, 1);
+    UT_SetDataBuffer(UT_KEY(SBN_UnpackMsg), &UnpackBuf, sizeof(UnpackBuf), false);
+    UT_SetDataBuffer(UT_KEY(SBN_GetPeer), &PeerPtr, sizeof(PeerPtr), false);
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.RecvFromNet(NetPtr, &MsgType, &MsgSz, &ProcessorID, PayloadBuffer), CFE_SUCCESS);
+
+    UtAssert_INT32_EQ(MsgType, SBN_APP_MSG);
+    UtAssert_INT32_EQ(PeerData->RecvBase, 41);
+} /* end Recv_RelGivenUp() */
+
+static void Recv_Multicast(void)
+{
+    START();
+
+    SBN_MsgType_t     MsgType;
+    SBN_MsgSz_t       MsgSz;
+    CFE_ProcessorID_t ProcessorID;
+    uint8             PayloadBuffer[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
+    SBN_Unpack_Buf_t  UnpackBuf;
+    SBN_UDP_Net_t *   NetData = (SBN_UDP_Net_t *)NetPtr->ModulePvt;
+
+    NetData->Multicast = true;
+    PeerPtr->Connected = true;
+
+    UnpackBuf.MsgSz       = 16;
+    UnpackBuf.MsgType     = SBN_APP_MSG;
+    UnpackBuf.ProcessorID = PeerPtr->ProcessorID;
+    strncpy((char *)UnpackBuf.MsgBuf, "deadbeef", 9);
+
+    UT_SetHookFunction(UT_KEY(OS_SelectSingle), DataHook, NULL);
+    UT_SetDeferredRetcode(UT_KEY(OS_SelectSingle), 1, OS_SUCCESS);
+    UT_SetDeferredRetcode(UT_KEY(OS_SocketRecvFrom), 1, 1);
+    UT_SetDataBuffer(UT_KEY(SBN_UnpackMsg), &UnpackBuf, sizeof(UnpackBuf), false);
+    UT_SetDataBuffer(UT_KEY(SBN_GetPeer), &PeerPtr, sizeof(PeerPtr), false);
+
+    /* sent to me alone, so kept for the receive filters even though no local app subscribed to it */
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.RecvFromNet(NetPtr, &MsgType, &MsgSz, &ProcessorID, PayloadBuffer), CFE_SUCCESS);
+
+    UtAssert_INT32_EQ(MsgType, SBN_APP_MSG);
+    UtAssert_INT32_EQ(MsgSz, 16);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(SBN_Subscribed)), 0);
+} /* end Recv_Multicast() */
+
 void Test_SBN_UDP_Recv(void)
 {
     Recv_NoData();
     Recv_SockRecvErr();
+    Recv_NoBuf();
     Recv_UnpackErr();
     Recv_GetPeerErr();
     Recv_NewConn();
     Recv_Disconn();
     Recv_Nominal();
+    Recv_RelData();
+    Recv_RelGivenUp();
+    Recv_Multicast();
 } /* end Test_SBN_UDP_Recv() */
 
 static void UnloadPeer_Disconn(void)
@@ -695,6 +1064,7 @@ void UtTest_Setup(void)
     ADD_TEST(SBN_UDP_LoadPeer);
     ADD_TEST(SBN_UDP_PollPeer);
     ADD_TEST(SBN_UDP_Send);
+    ADD_TEST(SBN_UDP_SendToNet);
     ADD_TEST(SBN_UDP_Recv);
     ADD_TEST(SBN_UDP_UnloadPeer);
     ADD_TEST(SBN_UDP_UnloadNet);
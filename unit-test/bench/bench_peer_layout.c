@@ -0,0 +1,134 @@
+/*
+** File: bench_peer_layout.c
+**
+** Purpose:
+** Host microbenchmark for false sharing in SBN_PeerInterface_t. For each
+** of SBN_MAX_PEER_CNT peers configured SBN_TASKS, a "send task" thread and a
+** "recv task" thread update the send-side and receive-side counters of the
+** same peer, as SBN_SendNetMsg() and the receive tasks do. This is timed once
+** against the peer structure and once against a copy of the layout before
+** the counters were split, where they share a cache line.
+**
+** Usage: bench_peer_layout [iterations [peers]]
+**
+** Run with no more peers than half the host's cores, otherwise the threads
+** time-slice and the difference disappears.
+*/
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "sbn_interfaces.h"
+
+/* the counters as they were laid out before being split by writer */
+typedef struct
+{
+    OS_time_t   LastSend, LastRecv;
+    SBN_HKTlm_t SendCnt, RecvCnt, SendErrCnt, RecvErrCnt, SubCnt;
+    SBN_HKTlm_t ReasmErrCnt;
+    uint16      NextFragID;
+    uint8       ModulePvt[128];
+} OldPeer_t;
+
+static SBN_PeerInterface_t Peers[SBN_MAX_PEER_CNT];
+static OldPeer_t           OldPeers[SBN_MAX_PEER_CNT];
+
+static long Iterations = 10000000;
+static int  PeerCnt    = SBN_MAX_PEER_CNT;
+
+typedef struct
+{
+    int  PeerIdx;
+    bool Old, Send;
+} Worker_t;
+
+static void *Run(void *Arg)
+{
+    Worker_t *W = (Worker_t *)Arg;
+    long      i = 0;
+
+    for (i = 0; i < Iterations; i++)
+    {
+        if (W->Old && W->Send)
+        {
+            volatile OldPeer_t *P = &OldPeers[W->PeerIdx];
+            P->SendCnt++;
+            P->LastSend.microsecs = i;
+        }
+        else if (W->Old)
+        {
+            volatile OldPeer_t *P = &OldPeers[W->PeerIdx];
+            P->RecvCnt++;
+            P->LastRecv.microsecs = i;
+        }
+        else if (W->Send)
+        {
+            volatile SBN_PeerInterface_t *P = &Peers[W->PeerIdx];
+            P->SendCnt++;
+            P->LastSend.microsecs = i;
+        }
+        else
+        {
+            volatile SBN_PeerInterface_t *P = &Peers[W->PeerIdx];
+            P->RecvCnt++;
+            P->LastRecv.microsecs = i;
+        } /* end if */
+    }     /* end for */
+
+    return NULL;
+} /* end Run() */
+
+static double Bench(bool Old)
+{
+    pthread_t       Threads[SBN_MAX_PEER_CNT * 2];
+    Worker_t        Workers[SBN_MAX_PEER_CNT * 2];
+    struct timespec Start, End;
+    int             i = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &Start);
+
+    for (i = 0; i < PeerCnt * 2; i++)
+    {
+        Workers[i].PeerIdx = i / 2;
+        Workers[i].Old     = Old;
+        Workers[i].Send    = (i % 2) == 0;
+        pthread_create(&Threads[i], NULL, Run, &Workers[i]);
+    } /* end for */
+
+    for (i = 0; i < PeerCnt * 2; i++)
+    {
+        pthread_join(Threads[i], NULL);
+    } /* end for */
+
+    clock_gettime(CLOCK_MONOTONIC, &End);
+
+    return ((End.tv_sec - Start.tv_sec) * 1e9 + (End.tv_nsec - Start.tv_nsec)) / Iterations;
+} /* end Bench() */
+
+int main(int argc, char *argv[])
+{
+    double OldNS = 0, NewNS = 0;
+
+    if (argc > 1)
+    {
+        Iterations = atol(argv[1]);
+    } /* end if */
+
+    if (argc > 2 && atoi(argv[2]) > 0 && atoi(argv[2]) <= SBN_MAX_PEER_CNT)
+    {
+        PeerCnt = atoi(argv[2]);
+    } /* end if */
+
+    OldNS = Bench(true);
+    NewNS = Bench(false);
+
+    printf("%d peers x (send + recv) threads, %ld updates each\n", PeerCnt, Iterations);
+    printf("shared counters: %.2f ns/update\n", OldNS);
+    printf("split counters:  %.2f ns/update (%.1fx)\n", NewNS, OldNS / NewNS);
+
+    return 0;
+} /* end main() */
@@ -3,6 +3,7 @@
 #include "cfe_msgids.h"
 #include "cfe_sb_events.h"
 #include "sbn_pack.h"
+#include <stddef.h>
 
 /* #define STUB_TASKID 1073807361 *//* TODO: should be replaced with a call to a stub util fn */
 CFE_SB_MsgId_t MsgID = 0x1818;
@@ -294,6 +295,62 @@ static void LoadConf_TooManyNets(void)
     EVENT_CNT(1);
 } /* end LoadConf_TooManyNets() */
 
+static void LoadConf_MaxSubsErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_TBL_EID, "MaxSubs 257 too large for CPU 1235");
+
+    UT_SetDeferredRetcode(UT_KEY(OS_MutSemCreate), 1, -1); /* fail just after LoadConfTbl() */
+
+    NominalTblPtr->Peers[1].MaxSubs = SBN_MAX_SUBS_PER_PEER + 1;
+
+    SBN_AppMain();
+
+    NominalTblPtr->Peers[1].MaxSubs = 0;
+
+    EVENT_CNT(1);
+} /* end LoadConf_MaxSubsErr() */
+
+static void LoadConf_PeerMaxSubs(void)
+{
+    START();
+
+    UT_SetDeferredRetcode(UT_KEY(OS_MutSemCreate), 1, -1); /* fail just after LoadConfTbl() */
+
+    NominalTblPtr->Peers[1].MaxSubs = 8;
+
+    SBN_AppMain();
+
+    NominalTblPtr->Peers[1].MaxSubs = 0;
+
+    UtAssert_INT32_EQ(SBN.PeerCnt, 1);
+    UtAssert_INT32_EQ(SBN.Nets[0].PeerCnt, 1);
+    UtAssert_INT32_EQ(SBN.Nets[0].Peers[0].MaxSubs, 8);
+    UtAssert_True(SBN.Nets[0].Peers[0].Subs == (SBN_Subs_t *)(void *)&SBN.Nets[0].Peers[1], "peer subs allocated");
+    UtAssert_True(SBN.Peers[SBN.Nets[0].Peers[0].Slot] == &SBN.Nets[0].Peers[0], "peer slot assigned");
+} /* end LoadConf_PeerMaxSubs() */
+
+static void LoadConf_TaskConf(void)
+{
+    START();
+
+    UT_SetDeferredRetcode(UT_KEY(OS_MutSemCreate), 1, -1); /* fail just after LoadConfTbl() */
+
+    NominalTblPtr->Peers[0].RecvTask.Priority = 40;
+    NominalTblPtr->Peers[1].SendTask.Priority = 50;
+    NominalTblPtr->Peers[1].RecvTask.StackSz  = 16384;
+
+    SBN_AppMain();
+
+    memset(&NominalTblPtr->Peers[0].RecvTask, 0, sizeof(SBN_TaskConf_t));
+    memset(&NominalTblPtr->Peers[1].SendTask, 0, sizeof(SBN_TaskConf_t) * 2);
+
+    UtAssert_INT32_EQ(SBN.Nets[0].RecvTask.Priority, 40);
+    UtAssert_INT32_EQ(SBN.Nets[0].Peers[0].SendTask.Priority, 50);
+    UtAssert_INT32_EQ(SBN.Nets[0].Peers[0].RecvTask.StackSz, 16384);
+} /* end LoadConf_TaskConf() */
+
 static void LoadConf_ReleaseAddrErr(void)
 {
     START();
@@ -341,6 +398,9 @@ static void Test_LoadConf(void)
     LoadConf_ProtoNameErr();
     LoadConf_FiltNameErr();
     LoadConf_TooManyNets();
+    LoadConf_MaxSubsErr();
+    LoadConf_PeerMaxSubs();
+    LoadConf_TaskConf();
     LoadConf_ReleaseAddrErr();
     LoadConf_NetCntInc();
     LoadConf_Nominal();
@@ -1178,6 +1238,89 @@ static void ProcessNetMsg_ProtoMsg_Nominal(void)
     EVENT_CNT(1);
 } /* end ProcessNetMsg_ProtoMsg_Nominal() */
 
+static void ProcessNetMsg_ProtoMsg_Caps(void)
+{
+    uint8  Buf[SBN_PACKED_PROTO_SZ];
+    Pack_t Pack;
+
+    START();
+
+    NetPtr->MTU = 1000;
+
+    UT_CheckEvent_Setup(SBN_PROTO_EID, "negotiated with ProcessorID ");
+
+    /* peer supports more than we do, with a smaller frame */
+    Pack_Init(&Pack, Buf, sizeof(Buf), true);
+    Pack_UInt8(&Pack, SBN_PROTO_VER);
+    Pack_UInt32(&Pack, SBN_FEAT_FRAG | SBN_FEAT_COMPRESS);
+    Pack_UInt32(&Pack, 500);
+    Pack_UInt16(&Pack, 8);
+    Pack_UInt8(&Pack, 2);
+
+    UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_PROTO_MSG, ProcessorID, sizeof(Buf), Buf), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(PeerPtr->Features, SBN_FEAT_FRAG);
+    UtAssert_INT32_EQ(PeerPtr->MTU, 500);
+    UtAssert_INT32_EQ(PeerPtr->MaxBatch, 1);
+    EVENT_CNT(1);
+} /* end ProcessNetMsg_ProtoMsg_Caps() */
+
+static void ProcessNetMsg_ProtoMsg_OldPeer(void)
+{
+    uint8 ver = SBN_PROTO_VER_CAPS - 1;
+
+    START();
+
+    NetPtr->MTU       = 1000;
+    PeerPtr->Features = SBN_FEAT_FRAG;
+
+    UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_PROTO_MSG, ProcessorID, sizeof(ver), &ver), SBN_SUCCESS);
+
+    /* base protocol only */
+    UtAssert_INT32_EQ(PeerPtr->Features, 0);
+    UtAssert_INT32_EQ(PeerPtr->MTU, 1000);
+} /* end ProcessNetMsg_ProtoMsg_OldPeer() */
+
+static void ProcessNetMsg_ProtoMsg_SendsSubs(void)
+{
+    uint8  Buf[SBN_PACKED_PROTO_SZ];
+    Pack_t Pack;
+
+    START();
+
+    PeerPtr->Connected = 1;
+    IfOpsPtr->Send     = Send_Err;
+
+    Pack_Init(&Pack, Buf, sizeof(Buf), true);
+    Pack_UInt8(&Pack, SBN_PROTO_VER);
+    Pack_UInt32(&Pack, SBN_FEAT_SUBRANGE);
+    Pack_UInt32(&Pack, 0);
+    Pack_UInt16(&Pack, 0);
+    Pack_UInt8(&Pack, 0);
+
+    /* once ranges are negotiated, the local subscriptions are resent */
+    UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_PROTO_MSG, ProcessorID, sizeof(Buf), Buf), SBN_ERROR);
+    UtAssert_INT32_EQ(PeerPtr->SendErrCnt, 1);
+
+    IfOpsPtr->Send = Send_Nominal;
+} /* end ProcessNetMsg_ProtoMsg_SendsSubs() */
+
+static void ProcessNetMsg_ProtoMsg_BaseNoResend(void)
+{
+    uint8 ver = SBN_PROTO_VER;
+
+    START();
+
+    PeerPtr->Connected = 1;
+    IfOpsPtr->Send     = Send_Err;
+
+    /* the base format was already sent on connect */
+    UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_PROTO_MSG, ProcessorID, sizeof(ver), &ver), SBN_SUCCESS);
+    UtAssert_INT32_EQ(PeerPtr->SendErrCnt, 0);
+
+    IfOpsPtr->Send = Send_Nominal;
+} /* end ProcessNetMsg_ProtoMsg_BaseNoResend() */
+
 static SBN_Status_t RecvFilter_Err(void *Data, SBN_Filter_Ctx_t *CtxPtr)
 {
     return SBN_ERROR;
@@ -1337,6 +1480,10 @@ static void Test_SBN_ProcessNetMsg(void)
     ProcessNetMsg_SubMsg_Nominal();
     ProcessNetMsg_UnSubMsg_Nominal();
     ProcessNetMsg_ProtoMsg_Nominal();
+    ProcessNetMsg_ProtoMsg_Caps();
+    ProcessNetMsg_ProtoMsg_OldPeer();
+    ProcessNetMsg_ProtoMsg_SendsSubs();
+    ProcessNetMsg_ProtoMsg_BaseNoResend();
     ProcessNetMsg_NoMsg_Nominal();
 } /* end Test_SBN_ProcessNetMsg() */
 
@@ -1388,6 +1535,39 @@ static void Connected_CrPipeErr(void)
     EVENT_CNT(1);
 } /* end Connected_CrPipeErr() */
 
+static SBN_MsgType_t ProtoDrop_Types[4];
+static int           ProtoDrop_Cnt;
+
+static SBN_Status_t Send_DropProto(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Payload)
+{
+    if (ProtoDrop_Cnt < 4)
+    {
+        ProtoDrop_Types[ProtoDrop_Cnt] = MsgType;
+    } /* end if */
+    ProtoDrop_Cnt++;
+
+    /* the SBN_PROTO_MSG is lost on the way, as a UDP datagram can be */
+    return SBN_SUCCESS;
+} /* end Send_DropProto() */
+
+static void Connected_ProtoDropped(void)
+{
+    START();
+
+    ProtoDrop_Cnt  = 0;
+    IfOpsPtr->Send = Send_DropProto;
+
+    UtAssert_INT32_EQ(SBN_Connected(PeerPtr), SBN_SUCCESS);
+
+    /* no SBN_PROTO_MSG comes back, yet the subscriptions went out in the base format */
+    UtAssert_True(ProtoDrop_Cnt >= 2, "PROTO and subscriptions sent (%d)", ProtoDrop_Cnt);
+    UtAssert_INT32_EQ(ProtoDrop_Types[0], SBN_PROTO_MSG);
+    UtAssert_INT32_EQ(ProtoDrop_Types[1], SBN_SUB_MSG);
+    UtAssert_INT32_EQ(PeerPtr->Features, 0);
+
+    IfOpsPtr->Send = Send_Nominal;
+} /* end Connected_ProtoDropped() */
+
 static void Connected_Nominal(void)
 {
     START();
@@ -1403,6 +1583,7 @@ static void Test_SBN_Connected(void)
     Connected_CrPipeErr();
     Connected_PipeOptErr();
     Connected_SendErr();
+    Connected_ProtoDropped();
     Connected_Nominal();
 } /* end Test_SBN_Connected() */
 
@@ -1514,6 +1695,333 @@ static void ReloadConfTbl_Nominal(void)
     UtAssert_INT32_EQ(SBN_ReloadConfTbl(), SBN_SUCCESS);
 } /* end ReloadConfTbl_Nominal() */
 
+/* the table's other buffer, which a reload loads into */
+static SBN_ConfTbl_t  ReloadTbl;
+static SBN_ConfTbl_t *ReloadTblPtr = &ReloadTbl;
+
+/* loads NominalTbl, so that the next reload, of ReloadTbl, has a table to compare against */
+static void Reload_Setup(void)
+{
+    START();
+
+    SBN_ReloadConfTbl();
+
+    ReloadTbl = *NominalTblPtr;
+    UT_SetDataBuffer(UT_KEY(CFE_TBL_GetAddress), &ReloadTblPtr, sizeof(ReloadTblPtr), false);
+
+    PeerPtr            = &SBN.Nets[0].Peers[0];
+    PeerPtr->Connected = 1;
+} /* end Reload_Setup() */
+
+static void ReloadConfTbl_Unchanged(void)
+{
+    SBN_PeerInterface_t *Peer = NULL;
+
+    Reload_Setup();
+    Peer = PeerPtr;
+
+    UT_CheckEvent_Setup(SBN_TBL_EID, "conf tbl reloaded, 0 nets and 0 peers changed");
+
+    UtAssert_INT32_EQ(SBN_ReloadConfTbl(), SBN_SUCCESS);
+
+    UtAssert_True(SBN.Nets[0].Peers == Peer, "net not reloaded");
+    UtAssert_INT32_EQ(Peer->Connected, 1);
+    EVENT_CNT(1);
+} /* end ReloadConfTbl_Unchanged() */
+
+static void ReloadConfTbl_PeerChanged(void)
+{
+    SBN_PeerInterface_t *Peer = NULL;
+    SBN_PeerIdx_t        Slot = 0;
+
+    Reload_Setup();
+    Peer = PeerPtr;
+    Slot = Peer->Slot;
+
+    UT_CheckEvent_Setup(SBN_TBL_EID, "conf tbl reloaded, 0 nets and 1 peers changed");
+
+    ReloadTblPtr->Peers[1].Address[0] = '2';
+
+    UtAssert_INT32_EQ(SBN_ReloadConfTbl(), SBN_SUCCESS);
+
+    UtAssert_True(SBN.Nets[0].Peers == Peer, "peer reloaded in place");
+    UtAssert_INT32_EQ(Peer->Connected, 0);
+    UtAssert_INT32_EQ(Peer->Slot, Slot);
+    UtAssert_True(SBN_GetPeer(&SBN.Nets[0], 1235) == Peer, "peer indexed");
+    EVENT_CNT(1);
+} /* end ReloadConfTbl_PeerChanged() */
+
+static void ReloadConfTbl_TaskChanged(void)
+{
+    SBN_PeerInterface_t *Peer = NULL;
+
+    Reload_Setup();
+    Peer = PeerPtr;
+
+    UT_CheckEvent_Setup(SBN_TBL_EID, "conf tbl reloaded, 0 nets and 1 peers changed");
+
+    ReloadTblPtr->Peers[1].SendTask.Priority = 50;
+
+    UtAssert_INT32_EQ(SBN_ReloadConfTbl(), SBN_SUCCESS);
+
+    UtAssert_True(SBN.Nets[0].Peers == Peer, "peer reloaded in place");
+    UtAssert_INT32_EQ(Peer->SendTask.Priority, 50);
+    UtAssert_INT32_EQ(Peer->Connected, 0);
+    EVENT_CNT(1);
+} /* end ReloadConfTbl_TaskChanged() */
+
+/* how many tasks had been deleted when the module was asked to unload */
+static uint32 DeletedAtUnload;
+
+static SBN_Status_t UnloadNet_CountTasks(SBN_NetInterface_t *Net)
+{
+    DeletedAtUnload = UT_GetStubCount(UT_KEY(CFE_ES_DeleteChildTask));
+    return SBN_SUCCESS;
+} /* end UnloadNet_CountTasks() */
+
+static SBN_Status_t UnloadPeer_CountTasks(SBN_PeerInterface_t *Peer)
+{
+    DeletedAtUnload = UT_GetStubCount(UT_KEY(CFE_ES_DeleteChildTask));
+    return SBN_SUCCESS;
+} /* end UnloadPeer_CountTasks() */
+
+static void ReloadConfTbl_NetTasksFirst(void)
+{
+    Reload_Setup();
+
+    IfOpsPtr->UnloadNet    = UnloadNet_CountTasks;
+    SBN.Nets[0].RecvTaskID = 1;
+    PeerPtr->RecvTaskID    = 2;
+    DeletedAtUnload        = 0;
+    UT_ResetState(UT_KEY(CFE_ES_DeleteChildTask));
+
+    /* this CPU's entry changed, the net is reloaded */
+    ReloadTblPtr->Peers[0].MTU = 500;
+
+    UtAssert_INT32_EQ(SBN_ReloadConfTbl(), SBN_SUCCESS);
+
+    /* the net's and the peer's receive tasks were stopped before the module freed their state */
+    UtAssert_INT32_EQ(DeletedAtUnload, 2);
+
+    IfOpsPtr->UnloadNet = UnloadNet_Nominal;
+} /* end ReloadConfTbl_NetTasksFirst() */
+
+static void ReloadConfTbl_PeerTasksFirst(void)
+{
+    Reload_Setup();
+
+    IfOpsPtr->UnloadPeer = UnloadPeer_CountTasks;
+    PeerPtr->RecvTaskID  = 2;
+    DeletedAtUnload      = 0;
+    UT_ResetState(UT_KEY(CFE_ES_DeleteChildTask));
+
+    ReloadTblPtr->Peers[1].Address[0] = '2';
+
+    UtAssert_INT32_EQ(SBN_ReloadConfTbl(), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(DeletedAtUnload, 1);
+
+    IfOpsPtr->UnloadPeer = UnloadPeer_Nominal;
+} /* end ReloadConfTbl_PeerTasksFirst() */
+
+static void ReloadConfTbl_FiltersChanged(void)
+{
+    Reload_Setup();
+
+    UT_CheckEvent_Setup(SBN_TBL_EID, "conf tbl reloaded, 0 nets and 0 peers changed");
+
+    ReloadTblPtr->Peers[1].Filters[0][0] = 'X';
+
+    UtAssert_INT32_EQ(SBN_ReloadConfTbl(), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(PeerPtr->FilterCnt, 0);
+    UtAssert_INT32_EQ(PeerPtr->Connected, 1);
+    EVENT_CNT(1);
+} /* end ReloadConfTbl_FiltersChanged() */
+
+static void ReloadConfTbl_NetAdded(void)
+{
+    Reload_Setup();
+
+    /* only the nets of the last full load were allocated */
+    UT_CheckEvent_Setup(SBN_TBL_EID, "nets added, reloading all nets");
+
+    ReloadTblPtr->Peers[2]        = ReloadTblPtr->Peers[0];
+    ReloadTblPtr->Peers[2].NetNum = 1;
+    ReloadTblPtr->Peers[3]        = ReloadTblPtr->Peers[1];
+    ReloadTblPtr->Peers[3].NetNum = 1;
+    ReloadTblPtr->PeerCnt         = 4;
+
+    UtAssert_INT32_EQ(SBN_ReloadConfTbl(), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(SBN.NetCnt, 2);
+    UtAssert_INT32_EQ(SBN.NetSlots, 2);
+    UtAssert_INT32_EQ(SBN.PeerCnt, 2);
+    UtAssert_INT32_EQ(SBN.Nets[1].PeerCnt, 1);
+    UtAssert_True(SBN.Conf == ReloadTblPtr, "reloaded table applied");
+    UtAssert_True(SBN_GetPeer(&SBN.Nets[1], 1235) == &SBN.Nets[1].Peers[0], "new peer indexed");
+    EVENT_CNT(1);
+} /* end ReloadConfTbl_NetAdded() */
+
+static void ReloadConfTbl_PeerAdded(void)
+{
+    SBN_PeerInterface_t *Peer = NULL;
+
+    Reload_Setup();
+    Peer = PeerPtr;
+
+    UT_CheckEvent_Setup(SBN_TBL_EID, "conf tbl reloaded, 0 nets and 1 peers changed");
+
+    ReloadTblPtr->Peers[2]             = ReloadTblPtr->Peers[1];
+    ReloadTblPtr->Peers[2].ProcessorID = 1236;
+    ReloadTblPtr->PeerCnt              = 3;
+
+    UtAssert_INT32_EQ(SBN_ReloadConfTbl(), SBN_SUCCESS);
+
+    /* loaded into a spare entry, the other peer untouched */
+    UtAssert_True(SBN.Nets[0].Peers == Peer, "net not reloaded");
+    UtAssert_INT32_EQ(Peer->Connected, 1);
+    UtAssert_INT32_EQ(SBN.Nets[0].PeerCnt, 2);
+    UtAssert_INT32_EQ(SBN.PeerCnt, 2);
+    UtAssert_True(!SBN.Nets[0].Peers[1].Unused, "spare entry used");
+    UtAssert_True(SBN_GetPeer(&SBN.Nets[0], 1236) == &SBN.Nets[0].Peers[1], "new peer indexed");
+    EVENT_CNT(1);
+} /* end ReloadConfTbl_PeerAdded() */
+
+static void ReloadConfTbl_PeerAddedNoRoom(void)
+{
+    SBN_PeerIdx_t PeerIdx = 0;
+
+    /* a second net, whose spare slots leave room for more peers on the first */
+    NominalTblPtr->Peers[2]        = NominalTblPtr->Peers[0];
+    NominalTblPtr->Peers[2].NetNum = 1;
+    NominalTblPtr->Peers[3]        = NominalTblPtr->Peers[1];
+    NominalTblPtr->Peers[3].NetNum = 1;
+    NominalTblPtr->PeerCnt         = 4;
+    Reload_Setup();
+
+    /* two fit in the spare entries, the third reloads the net */
+    UT_CheckEvent_Setup(SBN_TBL_EID, "conf tbl reloaded, 1 nets and 2 peers changed");
+
+    for (PeerIdx = 4; PeerIdx < 5 + SBN_SPARE_PEERS_PER_NET; PeerIdx++)
+    {
+        ReloadTblPtr->Peers[PeerIdx]             = ReloadTblPtr->Peers[1];
+        ReloadTblPtr->Peers[PeerIdx].ProcessorID = 1232 + PeerIdx;
+    } /* end for */
+    ReloadTblPtr->PeerCnt = 5 + SBN_SPARE_PEERS_PER_NET;
+
+    UtAssert_INT32_EQ(SBN_ReloadConfTbl(), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(SBN.Nets[0].PeerCnt, 2 + SBN_SPARE_PEERS_PER_NET);
+    UtAssert_INT32_EQ(SBN.Nets[0].PeerSlots, 2 + 2 * SBN_SPARE_PEERS_PER_NET);
+    UtAssert_True(SBN_GetPeer(&SBN.Nets[0], 1236 + SBN_SPARE_PEERS_PER_NET) != NULL, "last peer indexed");
+    EVENT_CNT(1);
+
+    NominalTblPtr->PeerCnt = 2;
+    memset(&NominalTblPtr->Peers[2], 0, 2 * sizeof(NominalTblPtr->Peers[2]));
+} /* end ReloadConfTbl_PeerAddedNoRoom() */
+
+static void ReloadConfTbl_PeerSlotsFull(void)
+{
+    SBN_PeerIdx_t PeerIdx = 0;
+
+    Reload_Setup();
+
+    /* more entries than the peer slots allocated at the last full load */
+    UT_CheckEvent_Setup(SBN_TBL_EID, "peers added, reloading all nets");
+
+    for (PeerIdx = 2; PeerIdx <= SBN.PeerSlots; PeerIdx++)
+    {
+        ReloadTblPtr->Peers[PeerIdx]             = ReloadTblPtr->Peers[1];
+        ReloadTblPtr->Peers[PeerIdx].ProcessorID = 1234 + PeerIdx;
+    } /* end for */
+    ReloadTblPtr->PeerCnt = PeerIdx;
+
+    UtAssert_INT32_EQ(SBN_ReloadConfTbl(), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(SBN.PeerSlots, PeerIdx + SBN_SPARE_PEERS_PER_NET);
+    UtAssert_INT32_EQ(SBN.PeerCnt, PeerIdx - 1);
+    UtAssert_True(SBN.Conf == ReloadTblPtr, "reloaded table applied");
+    EVENT_CNT(1);
+} /* end ReloadConfTbl_PeerSlotsFull() */
+
+static void ReloadConfTbl_PeerRemoved(void)
+{
+    SBN_PeerInterface_t *Peer = NULL;
+
+    Reload_Setup();
+    Peer = PeerPtr;
+
+    UT_CheckEvent_Setup(SBN_TBL_EID, "conf tbl reloaded, 0 nets and 1 peers changed");
+
+    ReloadTblPtr->PeerCnt = 1;
+
+    UtAssert_INT32_EQ(SBN_ReloadConfTbl(), SBN_SUCCESS);
+
+    /* its entry is left for a peer added later */
+    UtAssert_True(SBN.Nets[0].Peers == Peer, "net not reloaded");
+    UtAssert_True(Peer->Unused, "entry unused");
+    UtAssert_INT32_EQ(Peer->Connected, 0);
+    UtAssert_INT32_EQ(SBN.Nets[0].PeerCnt, 0);
+    UtAssert_INT32_EQ(SBN.PeerCnt, 0);
+    UtAssert_True(SBN_GetPeer(&SBN.Nets[0], 1235) == NULL, "peer unindexed");
+    EVENT_CNT(1);
+} /* end ReloadConfTbl_PeerRemoved() */
+
+static void ReloadConfTbl_MaxSubsShrunk(void)
+{
+    SBN_PeerInterface_t *Peer = NULL;
+
+    NominalTblPtr->Peers[1].MaxSubs = 8;
+    Reload_Setup();
+    Peer = PeerPtr;
+
+    UT_CheckEvent_Setup(SBN_TBL_EID, "conf tbl reloaded, 0 nets and 1 peers changed");
+
+    ReloadTblPtr->Peers[1].MaxSubs = 4;
+
+    UtAssert_INT32_EQ(SBN_ReloadConfTbl(), SBN_SUCCESS);
+
+    UtAssert_True(SBN.Nets[0].Peers == Peer, "peer reloaded in place");
+    UtAssert_INT32_EQ(Peer->MaxSubs, 4);
+    EVENT_CNT(1);
+
+    NominalTblPtr->Peers[1].MaxSubs = 0;
+} /* end ReloadConfTbl_MaxSubsShrunk() */
+
+static void ReloadConfTbl_MaxSubsGrown(void)
+{
+    NominalTblPtr->Peers[1].MaxSubs = 8;
+    Reload_Setup();
+
+    /* more than its entry has room for */
+    UT_CheckEvent_Setup(SBN_TBL_EID, "conf tbl reloaded, 1 nets and 0 peers changed");
+
+    ReloadTblPtr->Peers[1].MaxSubs = 0;
+
+    UtAssert_INT32_EQ(SBN_ReloadConfTbl(), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(SBN.Nets[0].Peers[0].MaxSubs, SBN_MAX_SUBS_PER_PEER);
+    UtAssert_INT32_EQ(SBN.Nets[0].Peers[0].Connected, 0);
+    EVENT_CNT(1);
+
+    NominalTblPtr->Peers[1].MaxSubs = 0;
+} /* end ReloadConfTbl_MaxSubsGrown() */
+
+static void ReloadConfTbl_ModulesChanged(void)
+{
+    Reload_Setup();
+
+    UT_CheckEvent_Setup(SBN_TBL_EID, "modules changed, reloading all nets");
+
+    ReloadTblPtr->ProtocolModules[0].BaseEID++;
+
+    UtAssert_INT32_EQ(SBN_ReloadConfTbl(), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(SBN.Nets[0].Peers[0].Connected, 0);
+    EVENT_CNT(1);
+} /* end ReloadConfTbl_ModulesChanged() */
+
 static void Test_SBN_ReloadConfTbl(void)
 {
     ReloadConfTbl_UnloadNetErr();
@@ -1521,6 +2029,20 @@ static void Test_SBN_ReloadConfTbl(void)
     ReloadConfTbl_FiltUnloadErr();
     ReloadConfTbl_TblUpdErr();
     ReloadConfTbl_Nominal();
+    ReloadConfTbl_Unchanged();
+    ReloadConfTbl_PeerChanged();
+    ReloadConfTbl_TaskChanged();
+    ReloadConfTbl_NetTasksFirst();
+    ReloadConfTbl_PeerTasksFirst();
+    ReloadConfTbl_FiltersChanged();
+    ReloadConfTbl_NetAdded();
+    ReloadConfTbl_PeerAdded();
+    ReloadConfTbl_PeerAddedNoRoom();
+    ReloadConfTbl_PeerSlotsFull();
+    ReloadConfTbl_PeerRemoved();
+    ReloadConfTbl_MaxSubsShrunk();
+    ReloadConfTbl_MaxSubsGrown();
+    ReloadConfTbl_ModulesChanged();
 } /* end Test_SBN_ReloadConfTbl() */
 
 static void Unpack_Empty(void)
@@ -1649,13 +2171,70 @@ void RecvNetMsgs_Nominal(void)
     UtAssert_INT32_EQ(SBN_RecvNetMsgs(), SBN_SUCCESS);
 } /* end RecvNetMsgs_Nominal() */
 
+#ifdef SBN_RECV_WORKERS
+void RecvNetMsgs_CtrlQueue(void)
+{
+    SBN_CtrlMsg_t CtrlMsg;
+
+    START();
+
+    memset(&CtrlMsg, 0, sizeof(CtrlMsg));
+    CtrlMsg.ProcessorID = ProcessorID;
+    CtrlMsg.MsgType     = SBN_NO_MSG;
+
+    UT_SetDataBuffer(UT_KEY(OS_QueueGet), &CtrlMsg, sizeof(CtrlMsg), false);
+    UT_SetDeferredRetcode(UT_KEY(OS_QueueGet), 2, OS_QUEUE_EMPTY);
+
+    UtAssert_INT32_EQ(SBN_RecvNetMsgs(), SBN_SUCCESS);
+
+    /* one message processed, then the queue is empty */
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(OS_QueueGet)), 2);
+} /* end RecvNetMsgs_CtrlQueue() */
+
+static void RecvWorkerTask_RegChildErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_PEERTASK_EID, "unable to register child task");
+
+    UT_SetDeferredRetcode(UT_KEY(CFE_ES_RegisterChildTask), 1, -1);
+
+    SBN_RecvWorkerTask();
+
+    EVENT_CNT(1);
+} /* end RecvWorkerTask_RegChildErr() */
+
+static void RecvWorkerTask_WorkerErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_PEERTASK_EID, "unable to connect task to receive worker");
+
+    UT_SetDeferredRetcode(UT_KEY(OS_TaskGetId), 1, 1234);
+
+    SBN_RecvWorkerTask();
+
+    EVENT_CNT(1);
+} /* end RecvWorkerTask_WorkerErr() */
+
+void Test_SBN_RecvWorkerTask(void)
+{
+    RecvWorkerTask_RegChildErr();
+    RecvWorkerTask_WorkerErr();
+} /* end Test_SBN_RecvWorkerTask() */
+#endif /* SBN_RECV_WORKERS */
+
 void Test_SBN_RecvNetMsgs(void)
 {
+#ifdef SBN_RECV_WORKERS
+    RecvNetMsgs_CtrlQueue();
+#else  /* !SBN_RECV_WORKERS */
     RecvNetMsgs_NetEmpty();
     RecvNetMsgs_TaskRecv();
     RecvNetMsgs_PeerRecv();
     RecvNetMsgs_NoRecv();
     RecvNetMsgs_Nominal();
+#endif /* SBN_RECV_WORKERS */
 } /* end Test_SBN_RecvNetMsgs() */
 
 static void RecvPeerTask_RegChildErr(void)
@@ -1734,10 +2313,33 @@ static void RecvPeerTask_Nominal(void)
     IfOpsPtr->RecvFromPeer = NULL;
 } /* end RecvPeerTask_Nominal() */
 
+static void RecvPeerTask_NoBuf(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_PEERTASK_EID, "no buffer for receive task");
+
+    IfOpsPtr->RecvFromNet  = NULL;
+    IfOpsPtr->RecvFromPeer = RecvFromPeer_One;
+
+    OS_TaskCreate(&PeerPtr->RecvTaskID, "coverage", test_osal_task_entry, NULL, 0, 0, 0);
+
+    SBN.FreeBufs = NULL; /* pool exhausted */
+
+    SBN_RecvPeerTask();
+
+    UtAssert_INT32_EQ(PeerPtr->RecvTaskID, 0);
+    EVENT_CNT(1);
+
+    IfOpsPtr->RecvFromNet  = RecvFromNet_Nominal;
+    IfOpsPtr->RecvFromPeer = NULL;
+} /* end RecvPeerTask_NoBuf() */
+
 static void Test_SBN_RecvPeerTask(void)
 {
     RecvPeerTask_RegChildErr();
     RecvPeerTask_NetConfErr();
+    RecvPeerTask_NoBuf();
     RecvPeerTask_Empty();
     RecvPeerTask_Nominal();
 } /* end Test_SBN_RecvPeerTask() */
@@ -1991,6 +2593,45 @@ static void SendTask_Nominal(void)
     SBN_SendTask();
 } /* end SendTask_Nominal() */
 
+static void SendTask_LaneTimeOut(void)
+{
+    START();
+
+    PeerPtr->Connected = true;
+    OS_TaskCreate(&PeerPtr->SendTaskID, "coverage", test_osal_task_entry, NULL, 0, 0, 0);
+
+    /* both lanes empty, a slice of the pend on the high lane times out, then pipe error when polled again */
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_RcvMsg), 1, CFE_SB_NO_MESSAGE);
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_RcvMsg), 1, CFE_SB_NO_MESSAGE);
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_RcvMsg), 1, CFE_SB_TIME_OUT);
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_RcvMsg), 1, -1);
+
+    SBN_SendTask();
+
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(CFE_SB_RcvMsg)), 4);
+} /* end SendTask_LaneTimeOut() */
+
+static void SendTask_LowLaneWhilePending(void)
+{
+    START();
+
+    PeerPtr->Connected = true;
+    OS_TaskCreate(&PeerPtr->SendTaskID, "coverage", test_osal_task_entry, NULL, 0, 0, 0);
+
+    /* both lanes empty, a message arrives on the low lane during the first slice of the pend */
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_RcvMsg), 1, CFE_SB_NO_MESSAGE);
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_RcvMsg), 1, CFE_SB_NO_MESSAGE);
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_RcvMsg), 1, CFE_SB_TIME_OUT);
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_RcvMsg), 1, CFE_SB_NO_MESSAGE);
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_RcvMsg), 1, CFE_SUCCESS);
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_RcvMsg), 1, -1);
+
+    SBN_SendTask();
+
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(CFE_SB_RcvMsg)), 6);
+    UtAssert_INT32_EQ(PeerPtr->SendCnt, 1);
+} /* end SendTask_LowLaneWhilePending() */
+
 static void Test_SBN_SendTask(void)
 {
     SendTask_RegChildErr();
@@ -1999,9 +2640,45 @@ static void Test_SBN_SendTask(void)
     SendTask_FiltErr();
     SendTask_Filters();
     SendTask_SendNetMsgErr();
+    SendTask_LaneTimeOut();
+    SendTask_LowLaneWhilePending();
     SendTask_Nominal();
 } /* end Test_SBN_SendTask() */
 
+#ifdef SBN_SEND_WORKERS
+static void SendWorkerTask_RegChildErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_PEERTASK_EID, "unable to register child task");
+
+    UT_SetDeferredRetcode(UT_KEY(CFE_ES_RegisterChildTask), 1, -1);
+
+    SBN_SendWorkerTask();
+
+    EVENT_CNT(1);
+} /* end SendWorkerTask_RegChildErr() */
+
+static void SendWorkerTask_WorkerErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_PEERTASK_EID, "unable to connect task to send worker");
+
+    UT_SetDeferredRetcode(UT_KEY(OS_TaskGetId), 1, 1234);
+
+    SBN_SendWorkerTask();
+
+    EVENT_CNT(1);
+} /* end SendWorkerTask_WorkerErr() */
+
+void Test_SBN_SendWorkerTask(void)
+{
+    SendWorkerTask_RegChildErr();
+    SendWorkerTask_WorkerErr();
+} /* end Test_SBN_SendWorkerTask() */
+#endif /* SBN_SEND_WORKERS */
+
 void SendNetMsg_MutexTakeErr(void)
 {
     START();
@@ -2047,13 +2724,386 @@ void SendNetMsg_SendErr(void)
     UtAssert_INT32_EQ(PeerPtr->SendErrCnt, 1);
 } /* end SendNetMsg_SendErr() */
 
+void SendNetMsg_SendErrMutex(void)
+{
+    START();
+
+    OS_TaskCreate(&PeerPtr->SendTaskID, "coverage", test_osal_task_entry, NULL, 0, 0, 0);
+
+    IfOpsPtr->Send = Send_Err;
+    UtAssert_INT32_EQ(SBN_SendNetMsg(0, 0, NULL, PeerPtr), SBN_ERROR);
+
+    /* the mutex is released even though the send failed */
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(OS_MutSemGive)), UT_GetStubCount(UT_KEY(OS_MutSemTake)));
+
+    IfOpsPtr->Send = Send_Nominal;
+} /* end SendNetMsg_SendErrMutex() */
+
 void Test_SBN_SendNetMsg(void)
 {
     SendNetMsg_MutexTakeErr();
     SendNetMsg_MutexGiveErr();
     SendNetMsg_SendErr();
+    SendNetMsg_SendErrMutex();
 } /* end Test_SBN_SendNetMsg() */
 
+static void GetPeer_Hashed(void)
+{
+    START();
+
+    /* lands in the same bucket as PeerPtr */
+    NetPtr->PeerCnt               = 2;
+    NetPtr->Peers[1].ProcessorID  = ProcessorID + SBN_PEER_HASH_SZ;
+    NetPtr->Peers[1].Net          = NetPtr;
+    NetPtr->Peers[1].SpacecraftID = SpacecraftID;
+    SBN_IndexPeers();
+
+    UtAssert_True(SBN_GetPeer(NetPtr, ProcessorID) == PeerPtr, "peer found");
+    UtAssert_True(SBN_GetPeer(NetPtr, ProcessorID + SBN_PEER_HASH_SZ) == &NetPtr->Peers[1], "chained peer found");
+    UtAssert_True(SBN_GetPeer(NetPtr, ProcessorID + 1) == NULL, "unknown peer not found");
+} /* end GetPeer_Hashed() */
+
+static void GetPeer_OtherNet(void)
+{
+    SBN_NetInterface_t OtherNet;
+
+    START();
+
+    memset(&OtherNet, 0, sizeof(OtherNet));
+
+    UtAssert_True(SBN_GetPeer(&OtherNet, ProcessorID) == NULL, "peer on another net not found");
+} /* end GetPeer_OtherNet() */
+
+void Test_SBN_GetPeer(void)
+{
+    GetPeer_Hashed();
+    GetPeer_OtherNet();
+} /* end Test_SBN_GetPeer() */
+
+static void SchedulePoll_IndexedDue(void)
+{
+    START();
+
+    /* every peer is due on the first wakeup after the tables are indexed */
+    UtAssert_True(SBN.PollWheel[SBN.PollTick % SBN_POLL_WHEEL_SLOTS] == PeerPtr, "peer due");
+
+    SBN_SchedulePoll(PeerPtr, 1000);
+    UtAssert_INT32_EQ(PeerPtr->PollDelayMS, 1000);
+} /* end SchedulePoll_IndexedDue() */
+
+void Test_SBN_SchedulePoll(void)
+{
+    SchedulePoll_IndexedDue();
+} /* end Test_SBN_SchedulePoll() */
+
+static void SnapshotPeer_Nominal(void)
+{
+    SBN_PeerStats_t Stats;
+
+    START();
+
+    SBN_SendNetMsg(0, 0, NULL, PeerPtr);
+    UtAssert_INT32_EQ(PeerPtr->SendSeq, 2);
+
+    PeerPtr->LastRecv   = (OS_time_t) {5, 6};
+    PeerPtr->RecvCnt    = 4;
+    PeerPtr->RecvErrCnt = 1;
+
+    UtAssert_True(SBN_SnapshotPeer(PeerPtr, &Stats), "snapshot consistent");
+    UtAssert_INT32_EQ(Stats.SendCnt, 1);
+    UtAssert_INT32_EQ(Stats.RecvCnt, 4);
+    UtAssert_INT32_EQ(Stats.RecvErrCnt, 1);
+    UtAssert_INT32_EQ(Stats.LastRecv.seconds, 5);
+    UtAssert_INT32_EQ(Stats.LastRecv.microsecs, 6);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(OS_TaskDelay)), 0);
+} /* end SnapshotPeer_Nominal() */
+
+static void SnapshotPeer_Torn(void)
+{
+    SBN_PeerStats_t Stats;
+
+    START();
+
+    /* the receive side is stuck part way through an update */
+    PeerPtr->RecvSeq = 1;
+
+    UtAssert_True(!SBN_SnapshotPeer(PeerPtr, &Stats), "snapshot inconsistent");
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(OS_TaskDelay)), SBN_HK_SNAPSHOT_TRIES - 1);
+} /* end SnapshotPeer_Torn() */
+
+static void SnapshotPeer_Reset(void)
+{
+    SBN_PeerStats_t Stats;
+
+    START();
+
+    SBN_SendNetMsg(0, 0, NULL, PeerPtr);
+    PeerPtr->LastRecv = (OS_time_t) {5, 6};
+    PeerPtr->RecvCnt  = 4;
+
+    SBN_ResetStamps(PeerPtr);
+
+    /* the reset is a write of its own on each side */
+    UtAssert_INT32_EQ(PeerPtr->SendSeq, 4);
+    UtAssert_INT32_EQ(PeerPtr->RecvSeq, 2);
+
+    UtAssert_True(SBN_SnapshotPeer(PeerPtr, &Stats), "snapshot consistent");
+    UtAssert_INT32_EQ(Stats.SendCnt, 0);
+    UtAssert_INT32_EQ(Stats.RecvCnt, 0);
+    UtAssert_INT32_EQ(Stats.LastSend.seconds, 0);
+    UtAssert_INT32_EQ(Stats.LastRecv.seconds, 0);
+    UtAssert_INT32_EQ(Stats.LastRecv.microsecs, 0);
+} /* end SnapshotPeer_Reset() */
+
+void Test_SBN_SnapshotPeer(void)
+{
+    SnapshotPeer_Nominal();
+    SnapshotPeer_Torn();
+    SnapshotPeer_Reset();
+} /* end Test_SBN_SnapshotPeer() */
+
+#ifdef SBN_SHARED_PIPE
+static int             SharedNetSendCnt, SharedPeerSendCnt[2];
+static uint8           SharedMsg[16];
+static CFE_SB_MsgPtr_t SharedMsgPtr = (CFE_SB_MsgPtr_t)(void *)SharedMsg;
+
+static SBN_Status_t SendToNet_Count(SBN_NetInterface_t *Net, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Payload)
+{
+    SharedNetSendCnt++;
+    return SBN_SUCCESS;
+} /* end SendToNet_Count() */
+
+static SBN_Status_t Send_CountShared(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz,
+                                     void *Payload)
+{
+    SharedPeerSendCnt[Peer - NetPtr->Peers]++;
+    return SBN_SUCCESS;
+} /* end Send_CountShared() */
+
+static SBN_Status_t FilterSend_Pass(void *MsgBuf, SBN_Filter_Ctx_t *Context)
+{
+    return SBN_SUCCESS;
+} /* end FilterSend_Pass() */
+
+static void SharedPipe_Subscribe(SBN_PeerInterface_t *Peer)
+{
+    Peer->SubCnt            = 1;
+    Peer->Subs[0].MsgID     = MsgID;
+    Peer->Subs[0].LastMsgID = MsgID;
+} /* end SharedPipe_Subscribe() */
+
+/* two connected peers on net 0 subscribed on the shared pipe, which has one message queued */
+static SBN_PeerInterface_t *SharedPipe_Setup(void)
+{
+    SBN_PeerInterface_t *PeerB = NULL;
+    SBN_SharedSub_t *    Sub   = NULL;
+
+    START();
+
+    NetPtr->PeerCnt     = 2;
+    PeerB               = &NetPtr->Peers[1];
+    PeerB->ProcessorID  = ProcessorID + 1;
+    PeerB->SpacecraftID = SpacecraftID;
+    PeerB->Net          = NetPtr;
+    SBN_IndexPeers();
+
+    PeerPtr->Connected = 1;
+    PeerB->Connected   = 1;
+    SharedPipe_Subscribe(PeerPtr);
+    SharedPipe_Subscribe(PeerB);
+
+    Sub              = &SBN.SharedSubs[0];
+    Sub->MsgID       = MsgID;
+    Sub->PeerCnt     = 2;
+    Sub->PeerMask[0] = (1U << PeerPtr->Slot) | (1U << PeerB->Slot);
+
+    SBN.SharedSubIdx[MsgID] = 1;
+    SBN.SharedSubCnt        = 1;
+
+    SharedNetSendCnt = 0;
+    memset(SharedPeerSendCnt, 0, sizeof(SharedPeerSendCnt));
+    IfOpsPtr->SendToNet = SendToNet_Count;
+    IfOpsPtr->Send      = Send_CountShared;
+
+    /* the high priority pipe is empty, the message comes from the shared pipe, then both are empty */
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_RcvMsg), 1, CFE_SB_NO_MESSAGE);
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_RcvMsg), 1, CFE_SUCCESS);
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_RcvMsg), 1, CFE_SB_NO_MESSAGE);
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_RcvMsg), 1, CFE_SB_NO_MESSAGE);
+    UT_SetDataBuffer(UT_KEY(CFE_SB_RcvMsg), &SharedMsgPtr, sizeof(SharedMsgPtr), false);
+    UT_SetDataBuffer(UT_KEY(CFE_SB_GetMsgId), &MsgID, sizeof(MsgID), false);
+
+    return PeerB;
+} /* end SharedPipe_Setup() */
+
+static void CheckSharedPipe_NetSend(void)
+{
+    SharedPipe_Setup();
+
+    UtAssert_INT32_EQ(SBN_CheckSharedPipe(), SBN_SUCCESS);
+
+    /* one send to the net reaches both */
+    UtAssert_INT32_EQ(SharedNetSendCnt, 1);
+    UtAssert_INT32_EQ(SharedPeerSendCnt[0], 0);
+    UtAssert_INT32_EQ(SharedPeerSendCnt[1], 0);
+
+    IfOpsPtr->SendToNet = NULL;
+    IfOpsPtr->Send      = Send_Nominal;
+} /* end CheckSharedPipe_NetSend() */
+
+static void CheckSharedPipe_FilteredPeer(void)
+{
+    SBN_FilterInterface_t Filter;
+    SBN_PeerInterface_t * PeerB    = SharedPipe_Setup();
+    SBN_BufSlot_t *       FreeBufs = SBN.FreeBufs;
+
+    memset(&Filter, 0, sizeof(Filter));
+    Filter.FilterSend = FilterSend_Pass;
+    PeerB->Filters[0] = &Filter;
+    PeerB->FilterCnt  = 1;
+
+    UtAssert_INT32_EQ(SBN_CheckSharedPipe(), SBN_SUCCESS);
+
+    /* a send to the net would reach the filtered peer unfiltered, so each peer is sent its own copy */
+    UtAssert_INT32_EQ(SharedNetSendCnt, 0);
+    UtAssert_INT32_EQ(SharedPeerSendCnt[0], 1);
+    UtAssert_INT32_EQ(SharedPeerSendCnt[1], 1);
+    UtAssert_True(SBN.FreeBufs == FreeBufs, "filter copy returned to the pool");
+
+    IfOpsPtr->SendToNet = NULL;
+    IfOpsPtr->Send      = Send_Nominal;
+} /* end CheckSharedPipe_FilteredPeer() */
+
+static void CheckSharedPipe_TaskSendPeer(void)
+{
+    SBN_PeerInterface_t *PeerC = NULL;
+
+    SharedPipe_Setup();
+
+    /* a third peer on the net, with its own send task and pipe, subscribed too */
+    NetPtr->PeerCnt     = 3;
+    PeerC               = &NetPtr->Peers[2];
+    PeerC->ProcessorID  = ProcessorID + 2;
+    PeerC->SpacecraftID = SpacecraftID;
+    PeerC->Net          = NetPtr;
+    PeerC->TaskFlags    = SBN_TASK_SEND;
+    PeerC->Connected    = 1;
+    SharedPipe_Subscribe(PeerC);
+
+    UtAssert_INT32_EQ(SBN_CheckSharedPipe(), SBN_SUCCESS);
+
+    /* it would get a send to the net as well as its own copy, so the shared peers are sent theirs */
+    UtAssert_INT32_EQ(SharedNetSendCnt, 0);
+    UtAssert_INT32_EQ(SharedPeerSendCnt[0], 1);
+    UtAssert_INT32_EQ(SharedPeerSendCnt[1], 1);
+
+    IfOpsPtr->SendToNet = NULL;
+    IfOpsPtr->Send      = Send_Nominal;
+} /* end CheckSharedPipe_TaskSendPeer() */
+
+void Test_SBN_CheckSharedPipe(void)
+{
+    CheckSharedPipe_NetSend();
+    CheckSharedPipe_FilteredPeer();
+    CheckSharedPipe_TaskSendPeer();
+} /* end Test_SBN_CheckSharedPipe() */
+#endif /* SBN_SHARED_PIPE */
+
+#ifdef SBN_MID_STATS
+static void CountMid_Nominal(void)
+{
+    uint8           Msg[16] = {0};
+    SBN_MidStats_t *Mid     = NULL;
+
+    START();
+
+    UT_SetDataBuffer(UT_KEY(CFE_SB_GetMsgId), &MsgID, sizeof(MsgID), false);
+
+    SBN_SendNetMsg(SBN_APP_MSG, sizeof(Msg), Msg, PeerPtr);
+
+    Mid = &SBN.MidStats[0].Send[SBN_MID_HASH(MsgID)];
+    UtAssert_True(Mid->InUse && Mid->MsgID == MsgID, "message ID counted");
+    UtAssert_INT32_EQ(Mid->MsgCnt, 1);
+    UtAssert_INT32_EQ(Mid->Bytes, sizeof(Msg));
+} /* end CountMid_Nominal() */
+
+static void CountMid_Collision(void)
+{
+    uint8 Msg[16] = {0};
+    int   i       = 0;
+
+    START();
+
+    /* every entry taken by another message ID */
+    for (i = 0; i < SBN_MID_STATS_SZ; i++)
+    {
+        SBN.MidStats[0].Send[i].InUse = true;
+        SBN.MidStats[0].Send[i].MsgID = MsgID + 1;
+    } /* end for */
+
+    UT_SetDataBuffer(UT_KEY(CFE_SB_GetMsgId), &MsgID, sizeof(MsgID), false);
+
+    SBN_SendNetMsg(SBN_APP_MSG, sizeof(Msg), Msg, PeerPtr);
+
+    for (i = 0; i < SBN_MID_STATS_SZ; i++)
+    {
+        UtAssert_INT32_EQ(SBN.MidStats[0].Send[i].MsgCnt, 0);
+    } /* end for */
+} /* end CountMid_Collision() */
+
+void Test_SBN_CountMid(void)
+{
+    CountMid_Nominal();
+    CountMid_Collision();
+} /* end Test_SBN_CountMid() */
+#endif /* SBN_MID_STATS */
+
+static void PeerLayout_Split(void)
+{
+    size_t IdentEnd  = offsetof(SBN_PeerInterface_t, Connected) + sizeof(bool);
+    size_t SendStart = offsetof(SBN_PeerInterface_t, SendSeq);
+    size_t SendEnd   = offsetof(SBN_PeerInterface_t, NextFragID) + sizeof(uint16);
+    size_t RecvStart = offsetof(SBN_PeerInterface_t, RecvSeq);
+    size_t RecvEnd   = offsetof(SBN_PeerInterface_t, ReasmErrCnt) + sizeof(SBN_HKTlm_t);
+    size_t ColdStart = offsetof(SBN_PeerInterface_t, ModulePvt);
+
+    START();
+
+    /* state written by different tasks never shares a cache line */
+    UtAssert_True(SendStart >= IdentEnd + SBN_CACHE_LINE_SZ, "send state apart from identity");
+    UtAssert_True(RecvStart >= SendEnd + SBN_CACHE_LINE_SZ, "recv state apart from send state");
+    UtAssert_True(ColdStart >= RecvEnd + SBN_CACHE_LINE_SZ, "module state apart from recv state");
+} /* end PeerLayout_Split() */
+
+void Test_PeerLayout(void)
+{
+    PeerLayout_Split();
+} /* end Test_PeerLayout() */
+
+static void PerfIDs_Ranges(void)
+{
+    uint32 LastPeer = SBN_PERF_PEER_CNT - 1;
+
+    START();
+
+    /* per-net and per-peer ranges follow the stage ID's without overlapping */
+    UtAssert_True(SBN_PERF_NET_MIN_ID > SBN_PERF_POLL_ID, "net ID's after stage ID's");
+    UtAssert_True(SBN_PERF_PEER_ID(0, SBN_PERF_SEND_ID) >= SBN_PERF_NET_ID(SBN_MAX_NETS - 1) + 1,
+                  "peer ID's after net ID's");
+    UtAssert_INT32_EQ(SBN_PERF_PEER_ID(1, SBN_PERF_SEND_ID), SBN_PERF_PEER_ID(0, SBN_PERF_POLL_ID) + 1);
+    UtAssert_True(SBN_PERF_PEER_ID(LastPeer, SBN_PERF_POLL_ID) < SBN_PERF_MAX_ID, "peer ID's below max");
+    UtAssert_True(SBN_PERF_PEER_CNT <= SBN_MAX_PEER_CNT, "no ranges for slots that cannot exist");
+
+    /* peers beyond the ranges share the stage ID's */
+    UtAssert_INT32_EQ(SBN_PERF_PEER_ID(SBN_PERF_PEER_CNT, SBN_PERF_PIPE_ID), SBN_PERF_PIPE_ID);
+    UtAssert_INT32_EQ(SBN_PEER_PERF_ID(PeerPtr, SBN_PERF_SEND_ID), SBN_PERF_PEER_ID(0, SBN_PERF_SEND_ID));
+} /* end PerfIDs_Ranges() */
+
+void Test_PerfIDs(void)
+{
+    PerfIDs_Ranges();
+} /* end Test_PerfIDs() */
+
 void UT_Setup(void) {} /* end UT_Setup() */
 
 void UT_TearDown(void) {} /* end UT_TearDown() */
@@ -2069,6 +3119,23 @@ void UtTest_Setup(void)
     ADD_TEST(SBN_RecvNetMsgs);
     ADD_TEST(SBN_RecvPeerTask);
     ADD_TEST(SBN_RecvNetTask);
+#ifdef SBN_RECV_WORKERS
+    ADD_TEST(SBN_RecvWorkerTask);
+#endif /* SBN_RECV_WORKERS */
     ADD_TEST(SBN_SendTask);
+#ifdef SBN_SEND_WORKERS
+    ADD_TEST(SBN_SendWorkerTask);
+#endif /* SBN_SEND_WORKERS */
     ADD_TEST(SBN_SendNetMsg);
+    ADD_TEST(SBN_GetPeer);
+    ADD_TEST(SBN_SchedulePoll);
+    ADD_TEST(SBN_SnapshotPeer);
+#ifdef SBN_SHARED_PIPE
+    ADD_TEST(SBN_CheckSharedPipe);
+#endif /* SBN_SHARED_PIPE */
+#ifdef SBN_MID_STATS
+    ADD_TEST(SBN_CountMid);
+#endif /* SBN_MID_STATS */
+    ADD_TEST(PeerLayout);
+    ADD_TEST(PerfIDs);
 }
@@ -0,0 +1,173 @@
+#include "sbn_coveragetest_common.h"
+
+#ifdef SBN_BONDING
+
+#define PEER_ID  1111
+#define OTHER_ID 2222
+#define BOND_MID 0x0801
+
+SBN_PeerInterface_t *PathB = NULL;
+
+/* the CPU is reachable as PeerPtr on net 0 and as PathB on net 1 */
+static void Bond_Setup(void)
+{
+    START();
+
+    UT_CaptureSends(NetPtr);
+
+    PeerPtr->ProcessorID = PEER_ID;
+    PeerPtr->Connected   = 1;
+    PeerPtr->Features    = SBN_FEAT_FRAG;
+
+    PathB             = UT_AddNet(PEER_ID);
+    PathB->Net->IfOps = &UT_CaptureOps;
+    PathB->Connected  = 1;
+    PathB->Features   = SBN_FEAT_FRAG;
+
+    SBN_LinkBonds();
+} /* end Bond_Setup() */
+
+static void LinkBonds_Nominal(void)
+{
+    SBN_PeerInterface_t *Other = NULL, *PathC = NULL;
+
+    Bond_Setup();
+
+    Other = UT_AddNet(OTHER_ID);
+    PathC = UT_AddNet(PEER_ID);
+    SBN_LinkBonds();
+
+    UtAssert_True(PeerPtr->BondFirst == PeerPtr, "net 0 is the preferred path");
+    UtAssert_True(PeerPtr->BondNext == PathB, "then net 1");
+    UtAssert_True(PathB->BondFirst == PeerPtr && PathB->BondNext == PathC, "then net 3");
+    UtAssert_True(PathC->BondFirst == PeerPtr && PathC->BondNext == NULL, "net 3 is the last path");
+    UtAssert_True(Other->BondFirst == NULL && Other->BondNext == NULL, "a CPU on one net is not bonded");
+} /* end LinkBonds_Nominal() */
+
+void Test_SBN_LinkBonds(void)
+{
+    LinkBonds_Nominal();
+} /* end Test_SBN_LinkBonds() */
+
+static void BondSends_Failover(void)
+{
+    UT_Msg_t Msg;
+
+    Bond_Setup();
+    UT_InitMsg(&Msg, BOND_MID, 0);
+
+    UtAssert_True(SBN_BondSends(PeerPtr, UT_MSG_SZ, &Msg), "the preferred path sends");
+    UtAssert_True(!SBN_BondSends(PathB, UT_MSG_SZ, &Msg), "the other path does not");
+
+    PeerPtr->Connected = 0;
+
+    UtAssert_True(SBN_BondSends(PathB, UT_MSG_SZ, &Msg), "failed over to the other path");
+
+    PathB->Connected = 0;
+
+    UtAssert_True(SBN_BondSends(PeerPtr, UT_MSG_SZ, &Msg), "with no path up, each path is left to itself");
+    UtAssert_True(SBN_BondSends(PathB, UT_MSG_SZ, &Msg), "with no path up, each path is left to itself");
+} /* end BondSends_Failover() */
+
+static void BondSends_Stripe(void)
+{
+#if SBN_BOND_STRIPE_SZ != 0
+    UT_Msg_t Msg;
+
+    Bond_Setup();
+
+    /* only the header is read, so the size can be claimed */
+    UT_InitMsg(&Msg, BOND_MID, 0);
+    UtAssert_True(SBN_BondSends(PathB, SBN_BOND_STRIPE_SZ, &Msg), "odd message ID on the second path");
+    UtAssert_True(!SBN_BondSends(PeerPtr, SBN_BOND_STRIPE_SZ, &Msg), "odd message ID on the second path");
+
+    UT_InitMsg(&Msg, BOND_MID + 1, 0);
+    UtAssert_True(SBN_BondSends(PeerPtr, SBN_BOND_STRIPE_SZ, &Msg), "even message ID on the first path");
+    UtAssert_True(!SBN_BondSends(PathB, SBN_BOND_STRIPE_SZ, &Msg), "even message ID on the first path");
+
+    PeerPtr->Connected = 0;
+
+    UtAssert_True(SBN_BondSends(PathB, SBN_BOND_STRIPE_SZ, &Msg), "striped over the paths left");
+#endif /* SBN_BOND_STRIPE_SZ */
+} /* end BondSends_Stripe() */
+
+static void BondSends_SendNetMsg(void)
+{
+    UT_Msg_t Msg;
+
+    Bond_Setup();
+    UT_InitMsg(&Msg, BOND_MID, 0);
+
+    UtAssert_INT32_EQ(SBN_SendNetMsg(SBN_APP_MSG, UT_MSG_SZ, &Msg, PeerPtr), SBN_SUCCESS);
+    UtAssert_INT32_EQ(SBN_SendNetMsg(SBN_APP_MSG, UT_MSG_SZ, &Msg, PathB), SBN_IF_EMPTY);
+    UtAssert_INT32_EQ(UT_Sent.Cnt, 1);
+    UtAssert_True(UT_LastSent()->Peer == PeerPtr, "sent over the preferred path");
+
+    /* protocol messages keep each path alive */
+    UtAssert_INT32_EQ(SBN_SendNetMsg(SBN_NO_MSG, 0, &Msg, PathB), SBN_SUCCESS);
+    UtAssert_INT32_EQ(UT_Sent.Cnt, 2);
+    UtAssert_True(UT_LastSent()->Peer == PathB, "sent over the other path");
+} /* end BondSends_SendNetMsg() */
+
+void Test_SBN_BondSends(void)
+{
+    BondSends_Failover();
+    BondSends_Stripe();
+    BondSends_SendNetMsg();
+} /* end Test_SBN_BondSends() */
+
+static void BondRecv_Dedup(void)
+{
+    UT_Msg_t Msg;
+
+    Bond_Setup();
+
+    UT_InitMsg(&Msg, BOND_MID, 7);
+    UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_APP_MSG, PEER_ID, UT_MSG_SZ, &Msg), SBN_SUCCESS);
+
+    UT_InitMsg(&Msg, BOND_MID, 7);
+    UtAssert_INT32_EQ(SBN_ProcessNetMsg(PathB->Net, SBN_APP_MSG, PEER_ID, UT_MSG_SZ, &Msg), SBN_SUCCESS);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(CFE_SB_PassMsg)), 1);
+
+    UT_InitMsg(&Msg, BOND_MID, 8);
+    UtAssert_INT32_EQ(SBN_ProcessNetMsg(PathB->Net, SBN_APP_MSG, PEER_ID, UT_MSG_SZ, &Msg), SBN_SUCCESS);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(CFE_SB_PassMsg)), 2);
+    UtAssert_INT32_EQ(SBN.DupCnt, 1);
+} /* end BondRecv_Dedup() */
+
+void Test_SBN_BondRecv(void)
+{
+    BondRecv_Dedup();
+} /* end Test_SBN_BondRecv() */
+
+static void BondPathDown_Nominal(void)
+{
+    Bond_Setup();
+
+    UT_CheckEvent_Setup(SBN_PEER_EID, "CPU 1111 path on net 1 down, 1 of 2 paths left");
+
+    PathB->Connected = 0;
+    SBN_BondPathDown(PathB);
+    EVENT_CNT(1);
+} /* end BondPathDown_Nominal() */
+
+void Test_SBN_BondPathDown(void)
+{
+    BondPathDown_Nominal();
+} /* end Test_SBN_BondPathDown() */
+
+#endif /* SBN_BONDING */
+
+void UT_Setup(void) {} /* end UT_Setup() */
+
+void UT_TearDown(void) {} /* end UT_TearDown() */
+
+void UtTest_Setup(void)
+{
+#ifdef SBN_BONDING
+    ADD_TEST(SBN_LinkBonds);
+    ADD_TEST(SBN_BondSends);
+    ADD_TEST(SBN_BondRecv);
+    ADD_TEST(SBN_BondPathDown);
+#endif /* SBN_BONDING */
+}
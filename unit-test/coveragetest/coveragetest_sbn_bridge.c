@@ -0,0 +1,366 @@
+#include "sbn_coveragetest_common.h"
+#include "sbn_pack.h"
+
+#ifdef SBN_BRIDGE
+
+#define PEER_A_ID  1111
+#define PEER_B_ID  2222
+#define BRIDGE_MID 0x0801
+#define BRIDGE_CMD 0x1801
+
+/* a test message with room for the relay trailer */
+typedef struct
+{
+    UT_Msg_t Msg;
+    uint8    Relay[SBN_PACKED_RELAY_SZ];
+} BridgeMsg_t;
+
+SBN_PeerInterface_t *PeerB = NULL;
+
+/* peer A on net 0, peer B on net 1, B subscribed to BRIDGE_MID */
+static void Bridge_Setup(void)
+{
+    START();
+
+    UT_CaptureSends(NetPtr);
+
+    PeerPtr->ProcessorID = PEER_A_ID;
+    PeerPtr->Connected   = 1;
+    PeerPtr->Features    = SBN_LOCAL_FEATURES;
+
+    PeerB                    = UT_AddNet(PEER_B_ID);
+    PeerB->Net->IfOps        = &UT_CaptureOps;
+    PeerB->Connected         = 1;
+    PeerB->Features          = SBN_LOCAL_FEATURES;
+    PeerB->Subs[0].MsgID     = BRIDGE_MID;
+    PeerB->Subs[0].LastMsgID = BRIDGE_MID;
+    PeerB->SubCnt            = 1;
+} /* end Bridge_Setup() */
+
+static void Bridge_Msg(BridgeMsg_t *Msg, CFE_SB_MsgId_t MsgID, uint16 Seq)
+{
+    memset(Msg, 0, sizeof(*Msg));
+    UT_InitMsg(&Msg->Msg, MsgID, Seq);
+} /* end Bridge_Msg() */
+
+/* adds the relay trailer, returns the size of the SBN_RELAY_MSG payload */
+static SBN_MsgSz_t Bridge_Relay(BridgeMsg_t *Msg, CFE_ProcessorID_t Origin, uint8 Hops)
+{
+    Pack_t Pack;
+
+    Pack_Init(&Pack, Msg->Relay, SBN_PACKED_RELAY_SZ, false);
+    Pack_UInt32(&Pack, Origin);
+    Pack_UInt8(&Pack, Hops);
+
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_GetTotalMsgLength), 1, UT_MSG_SZ);
+
+    return UT_MSG_SZ + SBN_PACKED_RELAY_SZ;
+} /* end Bridge_Relay() */
+
+static void RelayMsg_Nominal(void)
+{
+    BridgeMsg_t Msg;
+    uint32      Origin = 0;
+    uint8       Hops   = 0;
+    Pack_t      Pack;
+
+    Bridge_Setup();
+    Bridge_Msg(&Msg, BRIDGE_MID, 1);
+
+    UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_APP_MSG, PEER_A_ID, UT_MSG_SZ, &Msg), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(CFE_SB_PassMsg)), 1);
+    UtAssert_INT32_EQ(UT_Sent.Cnt, 1);
+    UtAssert_True(UT_LastSent()->Peer == PeerB, "relayed to the peer on the other net");
+    UtAssert_INT32_EQ(UT_LastSent()->Type, SBN_RELAY_MSG);
+    UtAssert_INT32_EQ(UT_LastSent()->Sz, UT_MSG_SZ + SBN_PACKED_RELAY_SZ);
+
+    Pack_Init(&Pack, UT_LastSent()->Buf + UT_MSG_SZ, SBN_PACKED_RELAY_SZ, false);
+    Unpack_UInt32(&Pack, &Origin);
+    Unpack_UInt8(&Pack, &Hops);
+    UtAssert_INT32_EQ(Origin, PEER_A_ID);
+    UtAssert_INT32_EQ(Hops, 1);
+    UtAssert_INT32_EQ(SBN.RelayCnt, 1);
+} /* end RelayMsg_Nominal() */
+
+static void RelayMsg_NotSubscribed(void)
+{
+    BridgeMsg_t Msg;
+
+    Bridge_Setup();
+    PeerB->SubCnt = 0;
+    Bridge_Msg(&Msg, BRIDGE_MID, 1);
+
+    UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_APP_MSG, PEER_A_ID, UT_MSG_SZ, &Msg), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(CFE_SB_PassMsg)), 1);
+    UtAssert_INT32_EQ(UT_Sent.Cnt, 0);
+} /* end RelayMsg_NotSubscribed() */
+
+static void RelayMsg_NoRelayFeature(void)
+{
+    BridgeMsg_t Msg;
+
+    Bridge_Setup();
+    PeerB->Features = SBN_FEAT_FRAG;
+    Bridge_Msg(&Msg, BRIDGE_MID, 1);
+
+    UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_APP_MSG, PEER_A_ID, UT_MSG_SZ, &Msg), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(UT_Sent.Cnt, 1);
+    UtAssert_INT32_EQ(UT_LastSent()->Type, SBN_APP_MSG);
+    UtAssert_INT32_EQ(UT_LastSent()->Sz, UT_MSG_SZ);
+} /* end RelayMsg_NoRelayFeature() */
+
+static void RelayMsg_HopLimit(void)
+{
+    BridgeMsg_t Msg;
+    SBN_MsgSz_t MsgSz = 0;
+
+    Bridge_Setup();
+    Bridge_Msg(&Msg, BRIDGE_MID, 1);
+    MsgSz = Bridge_Relay(&Msg, 7777, SBN_BRIDGE_MAX_HOPS);
+
+    UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_RELAY_MSG, PEER_A_ID, MsgSz, &Msg), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(CFE_SB_PassMsg)), 1);
+    UtAssert_INT32_EQ(UT_Sent.Cnt, 0);
+} /* end RelayMsg_HopLimit() */
+
+static void RelayMsg_NotToOrigin(void)
+{
+    BridgeMsg_t Msg;
+    SBN_MsgSz_t MsgSz = 0;
+
+    Bridge_Setup();
+    Bridge_Msg(&Msg, BRIDGE_MID, 1);
+    MsgSz = Bridge_Relay(&Msg, PEER_B_ID, 1);
+
+    UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_RELAY_MSG, PEER_A_ID, MsgSz, &Msg), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(CFE_SB_PassMsg)), 1);
+    UtAssert_INT32_EQ(UT_Sent.Cnt, 0);
+} /* end RelayMsg_NotToOrigin() */
+
+static void RelayMsg_Invalid(void)
+{
+    BridgeMsg_t Msg;
+
+    Bridge_Setup();
+    Bridge_Msg(&Msg, BRIDGE_MID, 1);
+
+    UT_CheckEvent_Setup(SBN_MSG_EID, "invalid relayed message from ProcessorID 1111");
+
+    /* the SB message claims to be longer than what came before the trailer */
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_GetTotalMsgLength), 1, UT_MSG_SZ + 2);
+
+    UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_RELAY_MSG, PEER_A_ID, UT_MSG_SZ + SBN_PACKED_RELAY_SZ, &Msg),
+                      SBN_ERROR);
+
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(CFE_SB_PassMsg)), 0);
+    UtAssert_INT32_EQ(PeerPtr->RecvErrCnt, 1);
+    EVENT_CNT(1);
+} /* end RelayMsg_Invalid() */
+
+static void RelayMsg_Short(void)
+{
+    BridgeMsg_t Msg;
+
+    Bridge_Setup();
+    Bridge_Msg(&Msg, BRIDGE_MID, 1);
+
+    UT_CheckEvent_Setup(SBN_MSG_EID, "invalid relayed message from ProcessorID 1111");
+
+    UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_RELAY_MSG, PEER_A_ID, SBN_PACKED_RELAY_SZ, &Msg), SBN_ERROR);
+
+    UtAssert_INT32_EQ(PeerPtr->RecvErrCnt, 1);
+    EVENT_CNT(1);
+} /* end RelayMsg_Short() */
+
+void Test_SBN_RelayMsg(void)
+{
+    RelayMsg_Nominal();
+    RelayMsg_NotSubscribed();
+    RelayMsg_NoRelayFeature();
+    RelayMsg_HopLimit();
+    RelayMsg_NotToOrigin();
+    RelayMsg_Invalid();
+    RelayMsg_Short();
+} /* end Test_SBN_RelayMsg() */
+
+static void SeenMsg_Window(void)
+{
+    BridgeMsg_t Msg;
+
+    Bridge_Setup();
+
+    Bridge_Msg(&Msg, BRIDGE_MID, 1);
+    SBN_ProcessNetMsg(NetPtr, SBN_APP_MSG, PEER_A_ID, UT_MSG_SZ, &Msg);
+    SBN_ProcessNetMsg(NetPtr, SBN_APP_MSG, PEER_A_ID, UT_MSG_SZ, &Msg);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(CFE_SB_PassMsg)), 1);
+    UtAssert_INT32_EQ(SBN.DupCnt, 1);
+
+    /* a newer count, then one that arrived late */
+    Bridge_Msg(&Msg, BRIDGE_MID, 3);
+    SBN_ProcessNetMsg(NetPtr, SBN_APP_MSG, PEER_A_ID, UT_MSG_SZ, &Msg);
+    Bridge_Msg(&Msg, BRIDGE_MID, 2);
+    SBN_ProcessNetMsg(NetPtr, SBN_APP_MSG, PEER_A_ID, UT_MSG_SZ, &Msg);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(CFE_SB_PassMsg)), 3);
+
+    SBN_ProcessNetMsg(NetPtr, SBN_APP_MSG, PEER_A_ID, UT_MSG_SZ, &Msg);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(CFE_SB_PassMsg)), 3);
+    UtAssert_INT32_EQ(SBN.DupCnt, 2);
+
+    /* the count wraps, on a message ID of its own */
+    Bridge_Msg(&Msg, BRIDGE_MID + 1, 0x3FFF);
+    SBN_ProcessNetMsg(NetPtr, SBN_APP_MSG, PEER_A_ID, UT_MSG_SZ, &Msg);
+    Bridge_Msg(&Msg, BRIDGE_MID + 1, 0);
+    SBN_ProcessNetMsg(NetPtr, SBN_APP_MSG, PEER_A_ID, UT_MSG_SZ, &Msg);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(CFE_SB_PassMsg)), 5);
+
+    Bridge_Msg(&Msg, BRIDGE_MID + 1, 0x3FFF);
+    SBN_ProcessNetMsg(NetPtr, SBN_APP_MSG, PEER_A_ID, UT_MSG_SZ, &Msg);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(CFE_SB_PassMsg)), 5);
+    UtAssert_INT32_EQ(SBN.DupCnt, 3);
+} /* end SeenMsg_Window() */
+
+static void SeenMsg_OtherPath(void)
+{
+    BridgeMsg_t Msg;
+    SBN_MsgSz_t MsgSz = 0;
+
+    Bridge_Setup();
+
+    /* from A directly, then relayed by a bridge on net 1 */
+    Bridge_Msg(&Msg, BRIDGE_MID, 5);
+    SBN_ProcessNetMsg(NetPtr, SBN_APP_MSG, PEER_A_ID, UT_MSG_SZ, &Msg);
+    MsgSz = Bridge_Relay(&Msg, PEER_A_ID, 1);
+    SBN_ProcessNetMsg(PeerB->Net, SBN_RELAY_MSG, PEER_B_ID, MsgSz, &Msg);
+
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(CFE_SB_PassMsg)), 1);
+    UtAssert_INT32_EQ(SBN.DupCnt, 1);
+} /* end SeenMsg_OtherPath() */
+
+static void SeenMsg_Own(void)
+{
+    BridgeMsg_t Msg;
+    SBN_MsgSz_t MsgSz = 0;
+
+    Bridge_Setup();
+    Bridge_Msg(&Msg, BRIDGE_MID, 1);
+    MsgSz = Bridge_Relay(&Msg, ProcessorID, 2);
+
+    UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_RELAY_MSG, PEER_A_ID, MsgSz, &Msg), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(CFE_SB_PassMsg)), 0);
+    UtAssert_INT32_EQ(UT_Sent.Cnt, 0);
+    UtAssert_INT32_EQ(SBN.DupCnt, 1);
+} /* end SeenMsg_Own() */
+
+static void SeenMsg_Command(void)
+{
+    BridgeMsg_t Msg;
+
+    Bridge_Setup();
+    Bridge_Msg(&Msg, BRIDGE_CMD, 0);
+
+    SBN_ProcessNetMsg(NetPtr, SBN_APP_MSG, PEER_A_ID, UT_MSG_SZ, &Msg);
+    SBN_ProcessNetMsg(NetPtr, SBN_APP_MSG, PEER_A_ID, UT_MSG_SZ, &Msg);
+
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(CFE_SB_PassMsg)), 2);
+    UtAssert_INT32_EQ(SBN.DupCnt, 0);
+} /* end SeenMsg_Command() */
+
+void Test_SBN_SeenMsg(void)
+{
+    SeenMsg_Window();
+    SeenMsg_OtherPath();
+    SeenMsg_Own();
+    SeenMsg_Command();
+} /* end Test_SBN_SeenMsg() */
+
+static void BridgeSubs_Sub(void)
+{
+    uint8        Buf[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
+    CFE_SB_Qos_t QoS = {0};
+    Pack_t       Pack;
+
+    Bridge_Setup();
+
+    Pack_Init(&Pack, &Buf, sizeof(Buf), 0);
+    Pack_Data(&Pack, (void *)SBN_IDENT, SBN_IDENT_LEN);
+    Pack_UInt16(&Pack, 1);
+    Pack_MsgID(&Pack, BRIDGE_MID + 1);
+    Pack_Data(&Pack, (void *)&QoS, sizeof(QoS));
+
+    UtAssert_INT32_EQ(SBN_ProcessSubsFromPeer(PeerB, Buf), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(UT_Sent.Cnt, 1);
+    UtAssert_True(UT_LastSent()->Peer == PeerPtr, "subscription passed on to the other net");
+    UtAssert_INT32_EQ(UT_LastSent()->Type, SBN_SUB_MSG);
+} /* end BridgeSubs_Sub() */
+
+static void BridgeSubs_Unsub(void)
+{
+    uint8        Buf[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
+    CFE_SB_Qos_t QoS = {0};
+    Pack_t       Pack;
+
+    Bridge_Setup();
+
+    Pack_Init(&Pack, &Buf, sizeof(Buf), 0);
+    Pack_Data(&Pack, (void *)SBN_IDENT, SBN_IDENT_LEN);
+    Pack_UInt16(&Pack, 1);
+    Pack_MsgID(&Pack, BRIDGE_MID);
+    Pack_Data(&Pack, (void *)&QoS, sizeof(QoS));
+
+    UtAssert_INT32_EQ(SBN_ProcessUnsubsFromPeer(PeerB, Buf), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(PeerB->SubCnt, 0);
+    UtAssert_INT32_EQ(UT_Sent.Cnt, 1);
+    UtAssert_True(UT_LastSent()->Peer == PeerPtr, "unsubscription passed on to the other net");
+    UtAssert_INT32_EQ(UT_LastSent()->Type, SBN_UNSUB_MSG);
+} /* end BridgeSubs_Unsub() */
+
+static void BridgeSubs_OnConnect(void)
+{
+    uint16         SubCnt = 0;
+    CFE_SB_MsgId_t MsgID  = 0;
+    Pack_t         Pack;
+
+    Bridge_Setup();
+
+    UtAssert_INT32_EQ(SBN_SendLocalSubsToPeer(PeerPtr), SBN_SUCCESS);
+
+    /* the (empty) local subscriptions, then those of peer B */
+    UtAssert_INT32_EQ(UT_Sent.Cnt, 2);
+    UtAssert_INT32_EQ(UT_LastSent()->Type, SBN_SUB_MSG);
+
+    Pack_Init(&Pack, UT_LastSent()->Buf + SBN_IDENT_LEN, UT_LastSent()->Sz - SBN_IDENT_LEN, false);
+    Unpack_UInt16(&Pack, &SubCnt);
+    Unpack_MsgID(&Pack, &MsgID);
+    UtAssert_INT32_EQ(SubCnt, 1);
+    UtAssert_INT32_EQ(MsgID, BRIDGE_MID);
+} /* end BridgeSubs_OnConnect() */
+
+void Test_SBN_BridgeSubs(void)
+{
+    BridgeSubs_Sub();
+    BridgeSubs_Unsub();
+    BridgeSubs_OnConnect();
+} /* end Test_SBN_BridgeSubs() */
+
+#endif /* SBN_BRIDGE */
+
+void UT_Setup(void) {} /* end UT_Setup() */
+
+void UT_TearDown(void) {} /* end UT_TearDown() */
+
+void UtTest_Setup(void)
+{
+#ifdef SBN_BRIDGE
+    ADD_TEST(SBN_RelayMsg);
+    ADD_TEST(SBN_SeenMsg);
+    ADD_TEST(SBN_BridgeSubs);
+#endif /* SBN_BRIDGE */
+}
@@ -0,0 +1,94 @@
+#include <stdlib.h>
+#include "sbn_coveragetest_common.h"
+
+static void InitBufPool_MutexErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_INIT_EID, "error creating mutex for buffer pool");
+
+    UT_SetDeferredRetcode(UT_KEY(OS_MutSemCreate), 1, -1);
+
+    UtAssert_INT32_EQ(SBN_InitBufPool(), SBN_ERROR);
+
+    EVENT_CNT(1);
+} /* end InitBufPool_MutexErr() */
+
+static void InitBufPool_TblCnt(void)
+{
+    SBN_ConfTbl_t Tbl;
+
+    START();
+
+    memset(&Tbl, 0, sizeof(Tbl));
+    Tbl.BufCnt = 2;
+
+    free(SBN.Bufs);
+    SBN.Conf = &Tbl;
+
+    UtAssert_INT32_EQ(SBN_InitBufPool(), SBN_SUCCESS);
+    UtAssert_INT32_EQ(SBN.BufCnt, 2);
+
+    UtAssert_True(SBN_GetBuf() != NULL, "first buffer");
+    UtAssert_True(SBN_GetBuf() != NULL, "second buffer");
+    UtAssert_True(SBN_GetBuf() == NULL, "pool sized from the table");
+
+    SBN.Conf = NULL;
+} /* end InitBufPool_TblCnt() */
+
+void Test_SBN_InitBufPool(void)
+{
+    InitBufPool_MutexErr();
+    InitBufPool_TblCnt();
+} /* end Test_SBN_InitBufPool() */
+
+static void GetBuf_Exhausted(void)
+{
+    void *Bufs[SBN_BUF_POOL_CNT];
+    int   i = 0;
+
+    START();
+
+    for (i = 0; i < SBN.BufCnt; i++)
+    {
+        Bufs[i] = SBN_GetBuf();
+        UtAssert_True(Bufs[i] != NULL, "buffer %d allocated", i);
+    } /* end for */
+
+    UtAssert_True(Bufs[0] != Bufs[1], "buffers are distinct");
+    UtAssert_True(SBN_GetBuf() == NULL, "pool exhausted");
+    UtAssert_INT32_EQ(SBN.BufEmptyCnt, 1);
+
+    SBN_PutBuf(Bufs[1]);
+    UtAssert_True(SBN_GetBuf() == Bufs[1], "returned buffer reused");
+
+    for (i = 0; i < SBN.BufCnt; i++)
+    {
+        SBN_PutBuf(Bufs[i]);
+    } /* end for */
+} /* end GetBuf_Exhausted() */
+
+static void PutBuf_Null(void)
+{
+    START();
+
+    SBN_PutBuf(NULL);
+
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(OS_MutSemTake)), 0);
+} /* end PutBuf_Null() */
+
+void Test_SBN_GetBuf(void)
+{
+    GetBuf_Exhausted();
+    PutBuf_Null();
+} /* end Test_SBN_GetBuf() */
+
+void UT_Setup(void) {} /* end UT_Setup() */
+
+void UT_TearDown(void) {} /* end UT_TearDown() */
+
+void UtTest_Setup(void)
+{
+    ADD_TEST(SBN_InitBufPool);
+    ADD_TEST(SBN_GetBuf);
+}
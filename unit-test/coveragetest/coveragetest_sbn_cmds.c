@@ -601,6 +601,66 @@ static void HK_Nominal(void)
     EVENT_CNT(1);
 } /* end HK_Nominal() */
 
+#ifdef SBN_MID_STATS
+static void HKPeerMids_PeerIdErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_CMD_EID, "Invalid PeerIdx");
+
+    memset(Buffer, 0, sizeof(Buffer));
+
+    MSGINIT(CmdPktPtr, SBN_CMD_MID, SBN_CMD_PEER_LEN, false);
+
+    /* NetIdx 0, PeerIdx 1 */
+    Buffer[CFE_SB_CMD_HDR_SIZE + 1] = 1;
+
+    uint32 mid = SBN_CMD_MID;
+    UT_SetDataBuffer(UT_KEY(CFE_SB_GetMsgId), &mid, sizeof(mid), false);
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_GetCmdCode), 1, SBN_HK_PEERMIDS_CC);
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_GetTotalMsgLength), 1, SBN_CMD_PEER_LEN);
+
+    SBN_HandleCommand((CFE_SB_MsgPtr_t)CmdPktPtr);
+
+    EVENT_CNT(1);
+} /* end HKPeerMids_PeerIdErr() */
+
+static void HKPeerMids_Nominal(void)
+{
+    SBN_MidStats_t *Mid = NULL;
+
+    START();
+
+    UT_CheckEvent_Setup(SBN_CMD_EID, "hk mids command, net=");
+
+    memset(Buffer, 0, sizeof(Buffer));
+
+    Mid             = &SBN.MidStats[0].Recv[3];
+    Mid->InUse      = true;
+    Mid->MsgID      = 0x1818;
+    Mid->MsgCnt     = 10;
+    Mid->Bytes      = 1000;
+    Mid->BaseMsgCnt = 4;
+    Mid->BaseBytes  = 400;
+
+    MSGINIT(CmdPktPtr, SBN_CMD_MID, SBN_CMD_PEER_LEN, false);
+
+    uint32 mid = SBN_CMD_MID;
+    UT_SetDataBuffer(UT_KEY(CFE_SB_GetMsgId), &mid, sizeof(mid), false);
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_GetCmdCode), 1, SBN_HK_PEERMIDS_CC);
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_GetTotalMsgLength), 1, SBN_CMD_PEER_LEN);
+
+    SBN_HandleCommand((CFE_SB_MsgPtr_t)CmdPktPtr);
+
+    EVENT_CNT(1);
+
+    /* the next report starts from these counts */
+    UtAssert_INT32_EQ(Mid->BaseMsgCnt, 10);
+    UtAssert_INT32_EQ(Mid->BaseBytes, 1000);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(CFE_SB_SendMsg)), 1);
+} /* end HKPeerMids_Nominal() */
+#endif /* SBN_MID_STATS */
+
 static void Test_SBN_Cmds(void)
 {
     NOOP_MsgLenErr();
@@ -624,6 +684,10 @@ static void Test_SBN_Cmds(void)
     HKResetPeer_NetIdErr();
     HKResetPeer_PeerIdErr();
     HKResetPeer_Nominal();
+#ifdef SBN_MID_STATS
+    HKPeerMids_PeerIdErr();
+    HKPeerMids_Nominal();
+#endif /* SBN_MID_STATS */
     SCH_Nominal();
     TBL_MsgLenErr();
     TBL_Nominal();
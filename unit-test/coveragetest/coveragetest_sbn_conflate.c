@@ -0,0 +1,211 @@
+#include "sbn_coveragetest_common.h"
+
+#define HK_MID    0x0801
+#define STATE_MID 0x0802
+#define OTHER_MID 0x0803
+
+UT_Msg_t        Msgs[4];
+CFE_SB_MsgPtr_t MsgPtrs[4];
+int             RcvLeft = 0;
+SBN_MsgSz_t     RcvSz   = UT_MSG_SZ;
+
+/* CFE_SB_RcvMsg() succeeds RcvLeft times, taking its messages from MsgPtrs, then the pipe is empty */
+static int32 RcvMsg_Hook(void *UserObj, int32 StubRetcode, uint32 CallCount, const UT_StubContext_t *Context)
+{
+    if (RcvLeft == 0)
+    {
+        return CFE_SB_NO_MESSAGE;
+    } /* end if */
+
+    RcvLeft--;
+    return CFE_SUCCESS;
+} /* end RcvMsg_Hook() */
+
+static int32 MsgLen_Hook(void *UserObj, int32 StubRetcode, uint32 CallCount, const UT_StubContext_t *Context)
+{
+    return RcvSz;
+} /* end MsgLen_Hook() */
+
+static void Conflate_Setup(void)
+{
+    CFE_SB_MsgId_t MsgIDs[SBN_MAX_CONFLATE_PER_PEER] = {HK_MID, STATE_MID};
+
+    START();
+
+    SBN_LoadConflate(PeerPtr, MsgIDs);
+
+    RcvLeft = 0;
+    RcvSz   = UT_MSG_SZ;
+    UT_SetHookFunction(UT_KEY(CFE_SB_RcvMsg), RcvMsg_Hook, NULL);
+    UT_SetHookFunction(UT_KEY(CFE_SB_GetTotalMsgLength), MsgLen_Hook, NULL);
+} /* end Conflate_Setup() */
+
+/* queues the messages on the pipe, in order */
+static void Conflate_Queue(int Cnt)
+{
+    int i = 0;
+
+    for (i = 0; i < Cnt; i++)
+    {
+        MsgPtrs[i] = (CFE_SB_MsgPtr_t)(void *)&Msgs[i];
+    } /* end for */
+
+    UT_SetDataBuffer(UT_KEY(CFE_SB_RcvMsg), MsgPtrs, Cnt * sizeof(MsgPtrs[0]), false);
+    RcvLeft = Cnt;
+} /* end Conflate_Queue() */
+
+static void LoadConflate_Nominal(void)
+{
+    CFE_SB_MsgId_t MsgIDs[SBN_MAX_CONFLATE_PER_PEER] = {HK_MID, 0, HK_MID, STATE_MID};
+
+    START();
+
+    SBN_LoadConflate(PeerPtr, MsgIDs);
+
+    UtAssert_INT32_EQ(PeerPtr->ConflateCnt, 2);
+    UtAssert_True(SBN_Conflated(PeerPtr, HK_MID), "HK_MID conflated");
+    UtAssert_True(SBN_Conflated(PeerPtr, STATE_MID), "STATE_MID conflated");
+    UtAssert_True(!SBN_Conflated(PeerPtr, OTHER_MID), "OTHER_MID not conflated");
+} /* end LoadConflate_Nominal() */
+
+void Test_SBN_LoadConflate(void)
+{
+    LoadConflate_Nominal();
+} /* end Test_SBN_LoadConflate() */
+
+static void NextConflated_Latest(void)
+{
+    CFE_SB_MsgPtr_t SBMsgPtr = NULL;
+
+    Conflate_Setup();
+
+    UT_InitMsg(&Msgs[0], HK_MID, 1);
+    UT_InitMsg(&Msgs[1], STATE_MID, 1);
+    UT_InitMsg(&Msgs[2], HK_MID, 2);
+    Conflate_Queue(3);
+
+    UtAssert_INT32_EQ(SBN_NextConflated(&SBMsgPtr, PeerPtr), CFE_SUCCESS);
+    UtAssert_INT32_EQ(CFE_SB_GetMsgId(SBMsgPtr), HK_MID);
+    UtAssert_INT32_EQ(CCSDS_RD_SEQ(SBMsgPtr->Hdr), 2);
+    UtAssert_INT32_EQ(PeerPtr->ConflatedCnt, 1);
+
+    UtAssert_INT32_EQ(SBN_NextConflated(&SBMsgPtr, PeerPtr), CFE_SUCCESS);
+    UtAssert_INT32_EQ(CFE_SB_GetMsgId(SBMsgPtr), STATE_MID);
+
+    UtAssert_INT32_EQ(SBN_NextConflated(&SBMsgPtr, PeerPtr), CFE_SB_NO_MESSAGE);
+} /* end NextConflated_Latest() */
+
+static void NextConflated_RoundRobin(void)
+{
+    CFE_SB_MsgPtr_t SBMsgPtr = NULL;
+
+    Conflate_Setup();
+
+    UT_InitMsg(&Msgs[0], HK_MID, 1);
+    UT_InitMsg(&Msgs[1], STATE_MID, 1);
+    Conflate_Queue(2);
+
+    UtAssert_INT32_EQ(SBN_NextConflated(&SBMsgPtr, PeerPtr), CFE_SUCCESS);
+    UtAssert_INT32_EQ(CFE_SB_GetMsgId(SBMsgPtr), HK_MID);
+
+    /* a fresh HK_MID waits its turn behind STATE_MID */
+    UT_InitMsg(&Msgs[0], HK_MID, 2);
+    Conflate_Queue(1);
+
+    UtAssert_INT32_EQ(SBN_NextConflated(&SBMsgPtr, PeerPtr), CFE_SUCCESS);
+    UtAssert_INT32_EQ(CFE_SB_GetMsgId(SBMsgPtr), STATE_MID);
+
+    UtAssert_INT32_EQ(SBN_NextConflated(&SBMsgPtr, PeerPtr), CFE_SUCCESS);
+    UtAssert_INT32_EQ(CFE_SB_GetMsgId(SBMsgPtr), HK_MID);
+    UtAssert_INT32_EQ(PeerPtr->ConflatedCnt, 0);
+} /* end NextConflated_RoundRobin() */
+
+static void NextConflated_TooLarge(void)
+{
+    CFE_SB_MsgPtr_t SBMsgPtr = NULL;
+
+    Conflate_Setup();
+
+    UT_InitMsg(&Msgs[0], HK_MID, 1);
+    Conflate_Queue(1);
+    RcvSz = SBN_CONFLATE_MSG_SZ + 1;
+
+    UtAssert_INT32_EQ(SBN_NextConflated(&SBMsgPtr, PeerPtr), CFE_SUCCESS);
+    UtAssert_True(SBMsgPtr == MsgPtrs[0], "sent as it was read");
+    UtAssert_True(!PeerPtr->Conflate[0].Pending, "not kept");
+} /* end NextConflated_TooLarge() */
+
+static void NextConflated_None(void)
+{
+    CFE_SB_MsgPtr_t SBMsgPtr = NULL;
+
+    START();
+
+    UtAssert_INT32_EQ(SBN_NextConflated(&SBMsgPtr, PeerPtr), CFE_SB_NO_MESSAGE);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(CFE_SB_RcvMsg)), 0);
+} /* end NextConflated_None() */
+
+void Test_SBN_NextConflated(void)
+{
+    NextConflated_Latest();
+    NextConflated_RoundRobin();
+    NextConflated_TooLarge();
+    NextConflated_None();
+} /* end Test_SBN_NextConflated() */
+
+static void DrainConflated_Held(void)
+{
+    CFE_SB_MsgPtr_t SBMsgPtr = NULL;
+
+    Conflate_Setup();
+
+    UT_InitMsg(&Msgs[0], HK_MID, 1);
+    UT_InitMsg(&Msgs[1], HK_MID, 2);
+    Conflate_Queue(2);
+
+    SBN_DrainConflated(PeerPtr);
+    UtAssert_INT32_EQ(PeerPtr->ConflatedCnt, 1);
+
+    UT_InitMsg(&Msgs[0], HK_MID, 3);
+    Conflate_Queue(1);
+    RcvSz = SBN_CONFLATE_MSG_SZ + 1;
+
+    /* nothing can be sent, so the large one is dropped and the slot kept */
+    SBN_DrainConflated(PeerPtr);
+    UtAssert_INT32_EQ(PeerPtr->ConflatedCnt, 2);
+
+    UtAssert_INT32_EQ(SBN_NextConflated(&SBMsgPtr, PeerPtr), CFE_SUCCESS);
+    UtAssert_INT32_EQ(CCSDS_RD_SEQ(SBMsgPtr->Hdr), 2);
+} /* end DrainConflated_Held() */
+
+static void DrainConflated_Reset(void)
+{
+    CFE_SB_MsgPtr_t SBMsgPtr = NULL;
+
+    Conflate_Setup();
+
+    UT_InitMsg(&Msgs[0], STATE_MID, 1);
+    Conflate_Queue(1);
+
+    SBN_DrainConflated(PeerPtr);
+    SBN_ResetConflated(PeerPtr);
+
+    UtAssert_INT32_EQ(SBN_NextConflated(&SBMsgPtr, PeerPtr), CFE_SB_NO_MESSAGE);
+} /* end DrainConflated_Reset() */
+
+void Test_SBN_DrainConflated(void)
+{
+    DrainConflated_Held();
+    DrainConflated_Reset();
+} /* end Test_SBN_DrainConflated() */
+
+void UT_Setup(void) {} /* end UT_Setup() */
+
+void UT_TearDown(void) {} /* end UT_TearDown() */
+
+void UtTest_Setup(void)
+{
+    ADD_TEST(SBN_LoadConflate);
+    ADD_TEST(SBN_NextConflated);
+    ADD_TEST(SBN_DrainConflated);
+}
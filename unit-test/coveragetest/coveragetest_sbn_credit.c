@@ -0,0 +1,293 @@
+#include "sbn_coveragetest_common.h"
+#include "sbn_pack.h"
+
+#ifdef SBN_CREDITS
+
+#define PEER_ID    1111
+#define CREDIT_MID 0x0801
+
+static void Credit_Setup(void)
+{
+    START();
+
+    UT_CaptureSends(NetPtr);
+
+    PeerPtr->ProcessorID = PEER_ID;
+    PeerPtr->Connected   = 1;
+    PeerPtr->Features    = SBN_LOCAL_FEATURES;
+} /* end Credit_Setup() */
+
+static void Credit_Recv(int Cnt)
+{
+    UT_Msg_t Msg;
+    int      i;
+
+    UT_InitMsg(&Msg, CREDIT_MID, 0);
+
+    for (i = 0; i < Cnt; i++)
+    {
+        SBN_ProcessNetMsg(NetPtr, SBN_APP_MSG, PEER_ID, UT_MSG_SZ, &Msg);
+    } /* end for */
+} /* end Credit_Recv() */
+
+static SBN_Status_t Credit_Grant(uint16 Window)
+{
+    uint8  Buf[SBN_PACKED_CREDIT_SZ];
+    Pack_t Pack;
+
+    Pack_Init(&Pack, Buf, sizeof(Buf), true);
+    Pack_UInt16(&Pack, Window);
+
+    return SBN_ProcessNetMsg(NetPtr, SBN_CREDIT_MSG, PEER_ID, sizeof(Buf), Buf);
+} /* end Credit_Grant() */
+
+static void GrantCredit_HalfWindow(void)
+{
+    uint16 Window = 0;
+    Pack_t Pack;
+
+    Credit_Setup();
+
+    Credit_Recv(SBN_CREDIT_WINDOW / 2 - 1);
+    UtAssert_INT32_EQ(UT_Sent.TypeCnt[SBN_CREDIT_MSG], 0);
+
+    Credit_Recv(1);
+    UtAssert_INT32_EQ(UT_Sent.TypeCnt[SBN_CREDIT_MSG], 1);
+    UtAssert_INT32_EQ(UT_LastSent()->Type, SBN_CREDIT_MSG);
+
+    Pack_Init(&Pack, UT_LastSent()->Buf, SBN_PACKED_CREDIT_SZ, false);
+    Unpack_UInt16(&Pack, &Window);
+    UtAssert_INT32_EQ(Window, SBN_CREDIT_WINDOW);
+
+    Credit_Recv(SBN_CREDIT_WINDOW / 2);
+    UtAssert_INT32_EQ(UT_Sent.TypeCnt[SBN_CREDIT_MSG], 2);
+} /* end GrantCredit_HalfWindow() */
+
+static void GrantCredit_Withheld(void)
+{
+    Credit_Setup();
+
+    /* SB would not take one of them, so the peer must send one more */
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_PassMsg), 1, -1);
+
+    Credit_Recv(SBN_CREDIT_WINDOW / 2);
+    UtAssert_INT32_EQ(UT_Sent.TypeCnt[SBN_CREDIT_MSG], 0);
+
+    Credit_Recv(1);
+    UtAssert_INT32_EQ(UT_Sent.TypeCnt[SBN_CREDIT_MSG], 1);
+} /* end GrantCredit_Withheld() */
+
+static void GrantCredit_NotNegotiated(void)
+{
+    Credit_Setup();
+    PeerPtr->Features = SBN_FEAT_FRAG;
+
+    Credit_Recv(SBN_CREDIT_WINDOW);
+    UtAssert_INT32_EQ(UT_Sent.TypeCnt[SBN_CREDIT_MSG], 0);
+} /* end GrantCredit_NotNegotiated() */
+
+void Test_SBN_GrantCredit(void)
+{
+    GrantCredit_HalfWindow();
+    GrantCredit_Withheld();
+    GrantCredit_NotNegotiated();
+} /* end Test_SBN_GrantCredit() */
+
+static void ProcessCreditMsg_Nominal(void)
+{
+    Credit_Setup();
+
+    UtAssert_True(!SBN_HasCredit(PeerPtr), "no credit before a grant");
+
+    PeerPtr->CreditSent = 10;
+    UtAssert_INT32_EQ(Credit_Grant(2), SBN_SUCCESS);
+    UtAssert_INT32_EQ(PeerPtr->CreditLimit, 12);
+    UtAssert_True(SBN_HasCredit(PeerPtr), "credit after a grant");
+
+    PeerPtr->CreditSent = 12;
+    UtAssert_True(!SBN_HasCredit(PeerPtr), "credit used up");
+} /* end ProcessCreditMsg_Nominal() */
+
+static void ProcessCreditMsg_NotNegotiated(void)
+{
+    Credit_Setup();
+    PeerPtr->Features = SBN_FEAT_FRAG;
+
+    UT_CheckEvent_Setup(SBN_PROTO_EID, "unexpected credit message from ProcessorID 1111 (MsgSz=2)");
+
+    UtAssert_INT32_EQ(Credit_Grant(2), SBN_ERROR);
+    UtAssert_True(SBN_HasCredit(PeerPtr), "a peer without the feature is never out of credit");
+    EVENT_CNT(1);
+} /* end ProcessCreditMsg_NotNegotiated() */
+
+static void ProcessCreditMsg_Short(void)
+{
+    uint8 Buf[1] = {0};
+
+    Credit_Setup();
+
+    UT_CheckEvent_Setup(SBN_PROTO_EID, "unexpected credit message from ProcessorID 1111 (MsgSz=1)");
+
+    UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_CREDIT_MSG, PEER_ID, sizeof(Buf), Buf), SBN_ERROR);
+    EVENT_CNT(1);
+} /* end ProcessCreditMsg_Short() */
+
+void Test_SBN_ProcessCreditMsg(void)
+{
+    ProcessCreditMsg_Nominal();
+    ProcessCreditMsg_NotNegotiated();
+    ProcessCreditMsg_Short();
+} /* end Test_SBN_ProcessCreditMsg() */
+
+static void SendCredit_Hold(void)
+{
+    UT_Msg_t Msg;
+    int      i;
+
+    Credit_Setup();
+    UT_InitMsg(&Msg, CREDIT_MID, 0);
+
+    /* from the shared pipe or a bridge, held until the peer grants credit */
+    for (i = 0; i < SBN_CREDIT_HOLD_DEPTH; i++)
+    {
+        Msg.Data[0] = (uint8)i;
+        UtAssert_INT32_EQ(SBN_SendNetMsg(SBN_APP_MSG, UT_MSG_SZ, &Msg, PeerPtr), SBN_SUCCESS);
+    } /* end for */
+
+    UtAssert_INT32_EQ(UT_Sent.Cnt, 0);
+    UtAssert_INT32_EQ(PeerPtr->HeldCnt, SBN_CREDIT_HOLD_DEPTH);
+
+    UtAssert_INT32_EQ(SBN_SendNetMsg(SBN_APP_MSG, UT_MSG_SZ, &Msg, PeerPtr), SBN_IF_EMPTY);
+    UtAssert_INT32_EQ(PeerPtr->CreditDropCnt, 1);
+
+    Credit_Grant(1);
+
+    UtAssert_INT32_EQ(UT_Sent.Cnt, 1);
+    UtAssert_INT32_EQ(UT_Sent.Msgs[0].Buf[sizeof(CCSDS_PriHdr_t)], 0);
+    UtAssert_True(SBN_HoldForCredit(PeerPtr), "the pipes wait for the held messages");
+
+    /* a newer message queues behind the held ones, even with credit */
+    PeerPtr->CreditLimit = PeerPtr->CreditSent + 1;
+    Msg.Data[0] = SBN_CREDIT_HOLD_DEPTH;
+    UtAssert_INT32_EQ(SBN_SendNetMsg(SBN_APP_MSG, UT_MSG_SZ, &Msg, PeerPtr), SBN_SUCCESS);
+
+    Credit_Grant(SBN_CREDIT_HOLD_DEPTH);
+
+    UtAssert_INT32_EQ(UT_Sent.Cnt, SBN_CREDIT_HOLD_DEPTH + 1);
+    for (i = 0; i <= SBN_CREDIT_HOLD_DEPTH; i++)
+    {
+        UtAssert_INT32_EQ(UT_Sent.Msgs[i].Buf[sizeof(CCSDS_PriHdr_t)], i);
+    } /* end for */
+
+    UtAssert_INT32_EQ(PeerPtr->HeldCnt, 0);
+    UtAssert_INT32_EQ(SBN.HeldBufCnt, 0);
+    UtAssert_INT32_EQ(PeerPtr->CreditSent, SBN_CREDIT_HOLD_DEPTH + 1);
+
+    /* protocol messages are not paced */
+    PeerPtr->CreditLimit = PeerPtr->CreditSent;
+    UtAssert_INT32_EQ(SBN_SendNetMsg(SBN_NO_MSG, 0, &Msg, PeerPtr), SBN_SUCCESS);
+    UtAssert_INT32_EQ(UT_Sent.Cnt, SBN_CREDIT_HOLD_DEPTH + 2);
+} /* end SendCredit_Hold() */
+
+static void SendCredit_DropHeld(void)
+{
+    UT_Msg_t Msg;
+
+    Credit_Setup();
+    UT_InitMsg(&Msg, CREDIT_MID, 0);
+
+    SBN_SendNetMsg(SBN_APP_MSG, UT_MSG_SZ, &Msg, PeerPtr);
+    SBN_SendNetMsg(SBN_APP_MSG, UT_MSG_SZ, &Msg, PeerPtr);
+    UtAssert_INT32_EQ(SBN.HeldBufCnt, 2);
+
+    SBN_Disconnected(PeerPtr);
+
+    UtAssert_INT32_EQ(PeerPtr->HeldCnt, 0);
+    UtAssert_INT32_EQ(SBN.HeldBufCnt, 0);
+    UtAssert_INT32_EQ(UT_Sent.Cnt, 0);
+} /* end SendCredit_DropHeld() */
+
+static void SendCredit_Stall(void)
+{
+    OS_time_t Then = {100, 0}, Now = {101, 500000};
+
+    Credit_Setup();
+
+    UT_SetLocalTime(&Then);
+    UtAssert_True(SBN_HoldForCredit(PeerPtr), "held without credit");
+    UtAssert_True(SBN_HoldForCredit(PeerPtr), "still held");
+    UtAssert_INT32_EQ(PeerPtr->StallCnt, 1);
+
+    Credit_Grant(1);
+
+    UT_SetLocalTime(&Now);
+    UtAssert_True(!SBN_HoldForCredit(PeerPtr), "released by the grant");
+    UtAssert_INT32_EQ(PeerPtr->StallMS, 1500);
+} /* end SendCredit_Stall() */
+
+void Test_SBN_SendCredit(void)
+{
+    SendCredit_Hold();
+    SendCredit_DropHeld();
+    SendCredit_Stall();
+} /* end Test_SBN_SendCredit() */
+
+static void CheckCredits_Regrant(void)
+{
+    OS_time_t Then = {100, 0}, Later = {100, 500000}, Now = {101, 0};
+
+    Credit_Setup();
+
+    UT_SetLocalTime(&Then);
+    SBN_CheckCredits();
+    UtAssert_INT32_EQ(UT_Sent.TypeCnt[SBN_CREDIT_MSG], 1);
+
+    /* messages are arriving, so the grants are earned by them */
+    Credit_Recv(1);
+    UT_SetLocalTime(&Later);
+    SBN_CheckCredits();
+    UtAssert_INT32_EQ(UT_Sent.TypeCnt[SBN_CREDIT_MSG], 1);
+
+    UT_SetLocalTime(&Now);
+    SBN_CheckCredits();
+    UtAssert_INT32_EQ(UT_Sent.TypeCnt[SBN_CREDIT_MSG], 1);
+
+    Now.seconds += SBN_CREDIT_REGRANT_TIME / 1000;
+    UT_SetLocalTime(&Now);
+    SBN_CheckCredits();
+    UtAssert_INT32_EQ(UT_Sent.TypeCnt[SBN_CREDIT_MSG], 2);
+} /* end CheckCredits_Regrant() */
+
+static void CheckCredits_NotConnected(void)
+{
+    OS_time_t Now = {100 + SBN_CREDIT_REGRANT_TIME / 1000, 0};
+
+    Credit_Setup();
+    PeerPtr->Connected = 0;
+
+    UT_SetLocalTime(&Now);
+    SBN_CheckCredits();
+    UtAssert_INT32_EQ(UT_Sent.TypeCnt[SBN_CREDIT_MSG], 0);
+} /* end CheckCredits_NotConnected() */
+
+void Test_SBN_CheckCredits(void)
+{
+    CheckCredits_Regrant();
+    CheckCredits_NotConnected();
+} /* end Test_SBN_CheckCredits() */
+
+#endif /* SBN_CREDITS */
+
+void UT_Setup(void) {} /* end UT_Setup() */
+
+void UT_TearDown(void) {} /* end UT_TearDown() */
+
+void UtTest_Setup(void)
+{
+#ifdef SBN_CREDITS
+    ADD_TEST(SBN_GrantCredit);
+    ADD_TEST(SBN_ProcessCreditMsg);
+    ADD_TEST(SBN_SendCredit);
+    ADD_TEST(SBN_CheckCredits);
+#endif /* SBN_CREDITS */
+}
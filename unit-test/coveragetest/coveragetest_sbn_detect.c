@@ -0,0 +1,210 @@
+#include "sbn_coveragetest_common.h"
+
+#define PEER_ID 1111
+
+static void Detect_Setup(uint32 HeartbeatMS, uint32 TimeoutMS)
+{
+    START();
+
+    PeerPtr->ProcessorID = PEER_ID;
+    PeerPtr->Connected   = 1;
+    NetPtr->HeartbeatMS  = HeartbeatMS;
+    NetPtr->TimeoutMS    = TimeoutMS;
+} /* end Detect_Setup() */
+
+/* messages from the peer every IntervalUS, the last at 100 seconds */
+static void Detect_Arrivals(uint32 IntervalUS, int Cnt)
+{
+    OS_time_t Prev = {0, 0}, Now = {100, 0};
+    int       i    = 0;
+
+    for (i = 0; i < Cnt; i++)
+    {
+        Prev.seconds   = 100 - (IntervalUS / 1000000) - 1;
+        Prev.microsecs = 1000000 - IntervalUS % 1000000;
+        SBN_RecordArrival(PeerPtr, &Prev, &Now);
+    } /* end for */
+
+    PeerPtr->LastRecv = Now;
+} /* end Detect_Arrivals() */
+
+static void RecordArrival_Nominal(void)
+{
+    OS_time_t Prev = {10, 0}, Now = {10, 800000};
+
+    Detect_Setup(100, 1000);
+
+    SBN_RecordArrival(PeerPtr, &Prev, &Now);
+    UtAssert_INT32_EQ(PeerPtr->ArrivalMeanUS, 800000);
+    UtAssert_INT32_EQ(PeerPtr->ArrivalDevUS, 400000);
+    UtAssert_INT32_EQ(PeerPtr->ArrivalCnt, 1);
+
+    Now.microsecs = 0;
+    SBN_RecordArrival(PeerPtr, &Prev, &Now);
+    UtAssert_INT32_EQ(PeerPtr->ArrivalMeanUS, 700000);
+    UtAssert_INT32_EQ(PeerPtr->ArrivalDevUS, 500000);
+
+    Detect_Arrivals(100000, SBN_FD_MIN_SAMPLES * 2);
+    UtAssert_INT32_EQ(PeerPtr->ArrivalCnt, SBN_FD_MIN_SAMPLES);
+
+    SBN_ResetArrivals(PeerPtr);
+    UtAssert_INT32_EQ(PeerPtr->ArrivalCnt, 0);
+} /* end RecordArrival_Nominal() */
+
+static void RecordArrival_Backwards(void)
+{
+    OS_time_t Prev = {10, 0}, Now = {9, 0};
+
+    Detect_Setup(100, 1000);
+
+    /* the clock was set back */
+    SBN_RecordArrival(PeerPtr, &Prev, &Now);
+    UtAssert_INT32_EQ(PeerPtr->ArrivalMeanUS, 0);
+} /* end RecordArrival_Backwards() */
+
+void Test_SBN_RecordArrival(void)
+{
+    RecordArrival_Nominal();
+    RecordArrival_Backwards();
+} /* end Test_SBN_RecordArrival() */
+
+static void PeerTimedOut_NoTimeout(void)
+{
+    OS_time_t Now = {1000, 0};
+
+    Detect_Setup(0, 0);
+    UT_SetLocalTime(&Now);
+
+    UtAssert_True(!SBN_PeerTimedOut(PeerPtr), "never with no timeout");
+} /* end PeerTimedOut_NoTimeout() */
+
+static void PeerTimedOut_Samples(void)
+{
+    OS_time_t Now = {100, 500000};
+
+    Detect_Setup(100, 1000);
+    Detect_Arrivals(100000, SBN_FD_MIN_SAMPLES - 1);
+
+    /* too few samples to go by, only TimeoutMS */
+    UT_SetLocalTime(&Now);
+    UtAssert_True(!SBN_PeerTimedOut(PeerPtr), "not before TimeoutMS");
+
+    Now.seconds = 101;
+    UT_SetLocalTime(&Now);
+    UtAssert_True(SBN_PeerTimedOut(PeerPtr), "at TimeoutMS");
+} /* end PeerTimedOut_Samples() */
+
+static void PeerTimedOut_Steady(void)
+{
+    OS_time_t Now = {100, 150000};
+
+    Detect_Setup(100, 1000);
+    Detect_Arrivals(100000, SBN_FD_MIN_SAMPLES * 8);
+
+    UT_SetLocalTime(&Now);
+    UtAssert_True(!SBN_PeerTimedOut(PeerPtr), "not within two heartbeats");
+
+    UT_CheckEvent_Setup(SBN_PEER_EID, "CPU 1111 silent for 250 ms (limit 200 ms, mean interval 100 ms)");
+
+    Now.microsecs = 250000;
+    UT_SetLocalTime(&Now);
+    UtAssert_True(SBN_PeerTimedOut(PeerPtr), "well within TimeoutMS");
+    EVENT_CNT(1);
+} /* end PeerTimedOut_Steady() */
+
+static void PeerTimedOut_Jitter(void)
+{
+    OS_time_t Now = {100, 250000}, Prev = {99, 900000}, Last = {100, 0};
+    int       i   = 0;
+
+    Detect_Setup(100, 1000);
+
+    /* alternately 190 and 10 ms apart, a mean of about 100 and a deviation of about 96 */
+    for (i = 0; i < SBN_FD_MIN_SAMPLES * 8; i++)
+    {
+        Prev.microsecs = i % 2 ? 990000 : 810000;
+        SBN_RecordArrival(PeerPtr, &Prev, &Last);
+    } /* end for */
+
+    PeerPtr->LastRecv = Last;
+
+    UT_SetLocalTime(&Now);
+    UtAssert_True(!SBN_PeerTimedOut(PeerPtr), "given longer on a jittery link");
+
+    Now.microsecs = 500000;
+    UT_SetLocalTime(&Now);
+    UtAssert_True(SBN_PeerTimedOut(PeerPtr), "past the mean by the threshold");
+} /* end PeerTimedOut_Jitter() */
+
+static void PeerTimedOut_NoHeartbeats(void)
+{
+    OS_time_t Now = {100, 500000};
+
+    Detect_Setup(0, 1000);
+    Detect_Arrivals(100000, SBN_FD_MIN_SAMPLES * 8);
+
+    UT_SetLocalTime(&Now);
+    UtAssert_True(!SBN_PeerTimedOut(PeerPtr), "a quiet peer is not suspected without heartbeats");
+} /* end PeerTimedOut_NoHeartbeats() */
+
+void Test_SBN_PeerTimedOut(void)
+{
+    PeerTimedOut_NoTimeout();
+    PeerTimedOut_Samples();
+    PeerTimedOut_Steady();
+    PeerTimedOut_Jitter();
+    PeerTimedOut_NoHeartbeats();
+} /* end Test_SBN_PeerTimedOut() */
+
+static void HeartbeatDue_Nominal(void)
+{
+    OS_time_t Now = {100, 50000};
+
+    Detect_Setup(100, 1000);
+    PeerPtr->LastSend = (OS_time_t) {100, 0};
+
+    UT_SetLocalTime(&Now);
+    UtAssert_True(!SBN_HeartbeatDue(PeerPtr), "sent to lately");
+
+    Now.microsecs = 100000;
+    UT_SetLocalTime(&Now);
+    UtAssert_True(SBN_HeartbeatDue(PeerPtr), "due after HeartbeatMS");
+
+    NetPtr->HeartbeatMS = 0;
+    UT_SetLocalTime(&Now);
+    UtAssert_True(!SBN_HeartbeatDue(PeerPtr), "never with no heartbeats");
+} /* end HeartbeatDue_Nominal() */
+
+void Test_SBN_HeartbeatDue(void)
+{
+    HeartbeatDue_Nominal();
+} /* end Test_SBN_HeartbeatDue() */
+
+static void LivenessPollMS_Nominal(void)
+{
+    Detect_Setup(5000, 10000);
+    UtAssert_INT32_EQ(SBN_LivenessPollMS(PeerPtr), 1000);
+
+    Detect_Setup(100, 1000);
+    UtAssert_INT32_EQ(SBN_LivenessPollMS(PeerPtr), 25);
+
+    Detect_Setup(0, 400);
+    UtAssert_INT32_EQ(SBN_LivenessPollMS(PeerPtr), 100);
+} /* end LivenessPollMS_Nominal() */
+
+void Test_SBN_LivenessPollMS(void)
+{
+    LivenessPollMS_Nominal();
+} /* end Test_SBN_LivenessPollMS() */
+
+void UT_Setup(void) {} /* end UT_Setup() */
+
+void UT_TearDown(void) {} /* end UT_TearDown() */
+
+void UtTest_Setup(void)
+{
+    ADD_TEST(SBN_RecordArrival);
+    ADD_TEST(SBN_PeerTimedOut);
+    ADD_TEST(SBN_HeartbeatDue);
+    ADD_TEST(SBN_LivenessPollMS);
+}
@@ -0,0 +1,285 @@
+#include "sbn_coveragetest_common.h"
+#include "sbn_pack.h"
+
+#define FRAG_DATA_SZ 8
+#define FRAG_MTU     (SBN_PACKED_HDR_SZ + SBN_PACKED_FRAG_HDR_SZ + FRAG_DATA_SZ)
+
+static void Frag_Setup(void)
+{
+    START();
+
+    UT_CaptureSends(NetPtr);
+    NetPtr->MTU       = FRAG_MTU;
+    PeerPtr->MTU      = FRAG_MTU;
+    PeerPtr->Features = SBN_FEAT_FRAG;
+} /* end Frag_Setup() */
+
+static void SendNetMsg_Fragmented(void)
+{
+    uint8 Msg[FRAG_DATA_SZ * 2 + 4];
+    int   i = 0;
+
+    Frag_Setup();
+
+    for (i = 0; i < sizeof(Msg); i++)
+    {
+        Msg[i] = (uint8)i;
+    } /* end for */
+
+    UtAssert_INT32_EQ(SBN_SendNetMsg(SBN_APP_MSG, sizeof(Msg), Msg, PeerPtr), SBN_SUCCESS);
+    UtAssert_INT32_EQ(UT_Sent.TypeCnt[SBN_FRAG_MSG], 3);
+    UtAssert_INT32_EQ(UT_Sent.Msgs[2].Sz, SBN_PACKED_FRAG_HDR_SZ + 4);
+
+    for (i = 0; i < UT_Sent.Cnt; i++)
+    {
+        UtAssert_True(UT_Sent.Msgs[i].Sz + SBN_PACKED_HDR_SZ <= FRAG_MTU, "fragment fits in MTU");
+    } /* end for */
+
+    UtAssert_INT32_EQ(PeerPtr->SendCnt, 3);
+    UtAssert_INT32_EQ(PeerPtr->NextFragID, 1);
+} /* end SendNetMsg_Fragmented() */
+
+static void SendNetMsg_NotFragmented(void)
+{
+    uint8 Msg[FRAG_DATA_SZ];
+
+    Frag_Setup();
+    NetPtr->IfOps = IfOpsPtr;
+
+    UtAssert_INT32_EQ(SBN_SendNetMsg(SBN_APP_MSG, sizeof(Msg), Msg, PeerPtr), SBN_SUCCESS);
+    UtAssert_INT32_EQ(PeerPtr->NextFragID, 0);
+} /* end SendNetMsg_NotFragmented() */
+
+static void SendFragmented_TooLarge(void)
+{
+    uint8 Msg[FRAG_DATA_SZ * (SBN_MAX_FRAGS + 1)];
+
+    Frag_Setup();
+
+    UT_CheckEvent_Setup(SBN_MSG_EID, "message too large to fragment");
+
+    UtAssert_INT32_EQ(SBN_SendFragmented(sizeof(Msg), Msg, PeerPtr), SBN_ERROR);
+    UtAssert_INT32_EQ(UT_Sent.Cnt, 0);
+    UtAssert_INT32_EQ(PeerPtr->SendErrCnt, 1);
+    EVENT_CNT(1);
+} /* end SendFragmented_TooLarge() */
+
+static void SendFragmented_NotNegotiated(void)
+{
+    uint8 Msg[FRAG_DATA_SZ * 2];
+
+    Frag_Setup();
+    PeerPtr->Features = 0;
+
+    UT_CheckEvent_Setup(SBN_MSG_EID, "ProcessorID 1234 cannot reassemble");
+
+    UtAssert_INT32_EQ(SBN_SendNetMsg(SBN_APP_MSG, sizeof(Msg), Msg, PeerPtr), SBN_ERROR);
+    UtAssert_INT32_EQ(UT_Sent.Cnt, 0);
+    EVENT_CNT(1);
+} /* end SendFragmented_NotNegotiated() */
+
+static void SendFragmented_MTUTooSmall(void)
+{
+    uint8 Msg[FRAG_DATA_SZ * 2];
+
+    Frag_Setup();
+    PeerPtr->MTU = SBN_PACKED_HDR_SZ + SBN_PACKED_FRAG_HDR_SZ;
+
+    UT_CheckEvent_Setup(SBN_MSG_EID, "MTU");
+
+    UtAssert_INT32_EQ(SBN_SendFragmented(sizeof(Msg), Msg, PeerPtr), SBN_ERROR);
+    UtAssert_INT32_EQ(UT_Sent.Cnt, 0);
+    UtAssert_INT32_EQ(PeerPtr->SendErrCnt, 1);
+    EVENT_CNT(1);
+} /* end SendFragmented_MTUTooSmall() */
+
+static void SendFragmented_NoBuf(void)
+{
+    uint8 Msg[FRAG_DATA_SZ * 2];
+
+    Frag_Setup();
+    SBN.FreeBufs = NULL; /* pool exhausted */
+
+    UT_CheckEvent_Setup(SBN_MSG_EID, "no buffer to fragment into");
+
+    UtAssert_INT32_EQ(SBN_SendFragmented(sizeof(Msg), Msg, PeerPtr), SBN_ERROR);
+    UtAssert_INT32_EQ(UT_Sent.Cnt, 0);
+    UtAssert_INT32_EQ(PeerPtr->NextFragID, 0);
+    EVENT_CNT(1);
+} /* end SendFragmented_NoBuf() */
+
+void Test_SBN_SendFragmented(void)
+{
+    SendNetMsg_Fragmented();
+    SendNetMsg_NotFragmented();
+    SendFragmented_TooLarge();
+    SendFragmented_NotNegotiated();
+    SendFragmented_MTUTooSmall();
+    SendFragmented_NoBuf();
+} /* end Test_SBN_SendFragmented() */
+
+static void ProcessFrag_Reassembled(void)
+{
+    uint8         Msg[FRAG_DATA_SZ * 2 + 4];
+    UT_SentMsg_t *Frags = UT_Sent.Msgs;
+    int           i     = 0;
+
+    Frag_Setup();
+
+    for (i = 0; i < sizeof(Msg); i++)
+    {
+        Msg[i] = (uint8)i;
+    } /* end for */
+
+    SBN_SendFragmented(sizeof(Msg), Msg, PeerPtr);
+
+    /* out of order, with a duplicate */
+    UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_FRAG_MSG, ProcessorID, Frags[2].Sz, Frags[2].Buf), SBN_SUCCESS);
+    UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_FRAG_MSG, ProcessorID, Frags[0].Sz, Frags[0].Buf), SBN_SUCCESS);
+    UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_FRAG_MSG, ProcessorID, Frags[0].Sz, Frags[0].Buf), SBN_SUCCESS);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(CFE_SB_PassMsg)), 0);
+
+    UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_FRAG_MSG, ProcessorID, Frags[1].Sz, Frags[1].Buf), SBN_SUCCESS);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(CFE_SB_PassMsg)), 1);
+
+    UtAssert_True(memcmp(SBN.Reasm[0].Buf, Msg, sizeof(Msg)) == 0, "message reassembled");
+    UtAssert_True(SBN.Reasm[0].Peer == NULL, "buffer released");
+    UtAssert_INT32_EQ(PeerPtr->ReasmErrCnt, 0);
+} /* end ProcessFrag_Reassembled() */
+
+static void ProcessFrag_Invalid(void)
+{
+    uint8  Frag[SBN_PACKED_FRAG_HDR_SZ + FRAG_DATA_SZ];
+    Pack_t Pack;
+
+    Frag_Setup();
+
+    UT_CheckEvent_Setup(SBN_MSG_EID, "invalid fragment from ProcessorID");
+
+    /* data runs past the end of the message */
+    Pack_Init(&Pack, Frag, sizeof(Frag), true);
+    Pack_UInt16(&Pack, 0);
+    Pack_UInt16(&Pack, 0);
+    Pack_UInt16(&Pack, 1);
+    Pack_UInt32(&Pack, 0);
+    Pack_UInt32(&Pack, FRAG_DATA_SZ - 1);
+
+    UtAssert_INT32_EQ(SBN_ProcessFragFromPeer(PeerPtr, sizeof(Frag), Frag), SBN_ERROR);
+    UtAssert_INT32_EQ(PeerPtr->ReasmErrCnt, 1);
+    EVENT_CNT(1);
+} /* end ProcessFrag_Invalid() */
+
+static void ProcessFrag_TooLarge(void)
+{
+    uint8  Frag[SBN_PACKED_FRAG_HDR_SZ + FRAG_DATA_SZ] = {0};
+    Pack_t Pack;
+
+    Frag_Setup();
+
+    UT_CheckEvent_Setup(SBN_MSG_EID, "invalid fragment from ProcessorID");
+
+    /* the largest total an SBN_MsgSz_t can hold starts a reassembly... */
+    Pack_Init(&Pack, Frag, sizeof(Frag), true);
+    Pack_UInt16(&Pack, 0);
+    Pack_UInt16(&Pack, 0);
+    Pack_UInt16(&Pack, SBN_MAX_FRAGS);
+    Pack_UInt32(&Pack, 0);
+    Pack_UInt32(&Pack, SBN_MSGSZ_MAX);
+
+    UtAssert_INT32_EQ(SBN_ProcessFragFromPeer(PeerPtr, sizeof(Frag), Frag), SBN_SUCCESS);
+    UtAssert_INT32_EQ(PeerPtr->ReasmErrCnt, 0);
+
+    /* ...one more byte does not */
+    Pack_Init(&Pack, Frag, sizeof(Frag), true);
+    Pack_UInt16(&Pack, 1);
+    Pack_UInt16(&Pack, 0);
+    Pack_UInt16(&Pack, SBN_MAX_FRAGS);
+    Pack_UInt32(&Pack, 0);
+    Pack_UInt32(&Pack, SBN_MSGSZ_MAX + 1);
+
+    UtAssert_INT32_EQ(SBN_ProcessFragFromPeer(PeerPtr, sizeof(Frag), Frag), SBN_ERROR);
+    UtAssert_INT32_EQ(PeerPtr->ReasmErrCnt, 1);
+    EVENT_CNT(1);
+} /* end ProcessFrag_TooLarge() */
+
+static void ProcessFrag_Short(void)
+{
+    uint8 Frag[4] = {0};
+
+    Frag_Setup();
+
+    UT_CheckEvent_Setup(SBN_MSG_EID, "short fragment from ProcessorID");
+
+    UtAssert_INT32_EQ(SBN_ProcessFragFromPeer(PeerPtr, sizeof(Frag), Frag), SBN_ERROR);
+    UtAssert_INT32_EQ(PeerPtr->ReasmErrCnt, 1);
+    EVENT_CNT(1);
+} /* end ProcessFrag_Short() */
+
+static void ProcessFrag_Evict(void)
+{
+    uint8         Msg[FRAG_DATA_SZ * 2];
+    UT_SentMsg_t *Frags = UT_Sent.Msgs;
+    int           i     = 0;
+
+    Frag_Setup();
+
+    /* start more partial messages than there are buffers */
+    for (i = 0; i <= SBN.ReasmCnt; i++)
+    {
+        UT_Sent.Cnt = 0;
+        SBN_SendFragmented(sizeof(Msg), Msg, PeerPtr);
+        SBN_ProcessFragFromPeer(PeerPtr, Frags[0].Sz, Frags[0].Buf);
+    } /* end for */
+
+    UtAssert_INT32_EQ(PeerPtr->ReasmErrCnt, 1);
+} /* end ProcessFrag_Evict() */
+
+void Test_SBN_ProcessFragFromPeer(void)
+{
+    ProcessFrag_Reassembled();
+    ProcessFrag_Invalid();
+    ProcessFrag_TooLarge();
+    ProcessFrag_Short();
+    ProcessFrag_Evict();
+} /* end Test_SBN_ProcessFragFromPeer() */
+
+static void CheckReasmTimeouts_Nominal(void)
+{
+    OS_time_t Now = {SBN_REASM_TIMEOUT / 1000 + 1, 0};
+
+    Frag_Setup();
+
+    SBN.Reasm[0].Peer    = PeerPtr;
+    SBN.Reasm[0].FragCnt = 2;
+    SBN.Reasm[0].RecvCnt = 1;
+    SBN.Reasm[0].Started = (OS_time_t) {0, 0};
+
+    SBN.Reasm[1].Peer    = PeerPtr;
+    SBN.Reasm[1].FragCnt = 2;
+    SBN.Reasm[1].RecvCnt = 1;
+    SBN.Reasm[1].Started = Now;
+
+    UT_SetDataBuffer(UT_KEY(OS_GetLocalTime), &Now, sizeof(Now), false);
+
+    SBN_CheckReasmTimeouts();
+
+    UtAssert_True(SBN.Reasm[0].Peer == NULL, "timed out buffer released");
+    UtAssert_True(SBN.Reasm[1].Peer == PeerPtr, "recent buffer kept");
+    UtAssert_INT32_EQ(PeerPtr->ReasmErrCnt, 1);
+} /* end CheckReasmTimeouts_Nominal() */
+
+void Test_SBN_CheckReasmTimeouts(void)
+{
+    CheckReasmTimeouts_Nominal();
+} /* end Test_SBN_CheckReasmTimeouts() */
+
+void UT_Setup(void) {} /* end UT_Setup() */
+
+void UT_TearDown(void) {} /* end UT_TearDown() */
+
+void UtTest_Setup(void)
+{
+    ADD_TEST(SBN_SendFragmented);
+    ADD_TEST(SBN_ProcessFragFromPeer);
+    ADD_TEST(SBN_CheckReasmTimeouts);
+}
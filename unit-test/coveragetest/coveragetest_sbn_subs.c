@@ -50,9 +50,65 @@ static void SLS2P_SendNetMsgErr(void)
     IfOpsPtr->Send = Send_Nominal;
 } /* end SLS2P_SendNetMsgErr() */
 
+static void SLS2P_Ranges(void)
+{
+    CFE_SB_MsgId_t Sub = 0, LastSub = 0;
+    uint16         Cnt = 0;
+    Pack_t         Pack;
+
+    START();
+
+    UT_CaptureSends(NetPtr);
+    PeerPtr->Features = SBN_FEAT_SUBRANGE;
+
+    /* 0x0800-0x0802 coalesce, out of order, 0x0900 does not */
+    SBN.SubCnt        = 4;
+    SBN.Subs[0].MsgID = 0x0802;
+    SBN.Subs[1].MsgID = 0x0900;
+    SBN.Subs[2].MsgID = 0x0800;
+    SBN.Subs[3].MsgID = 0x0801;
+
+    UtAssert_INT32_EQ(SBN_SendLocalSubsToPeer(PeerPtr), SBN_SUCCESS);
+    UtAssert_INT32_EQ(UT_Sent.Cnt, 2);
+
+    UtAssert_INT32_EQ(UT_Sent.Msgs[0].Type, SBN_SUB_MSG);
+    Pack_Init(&Pack, UT_Sent.Msgs[0].Buf + SBN_IDENT_LEN, UT_Sent.Msgs[0].Sz - SBN_IDENT_LEN, false);
+    Unpack_UInt16(&Pack, &Cnt);
+    Unpack_MsgID(&Pack, &Sub);
+    UtAssert_INT32_EQ(Cnt, 1);
+    UtAssert_INT32_EQ(Sub, 0x0900);
+
+    UtAssert_INT32_EQ(UT_Sent.Msgs[1].Type, SBN_SUBRANGE_MSG);
+    Pack_Init(&Pack, UT_Sent.Msgs[1].Buf + SBN_IDENT_LEN, UT_Sent.Msgs[1].Sz - SBN_IDENT_LEN, false);
+    Unpack_UInt16(&Pack, &Cnt);
+    Unpack_MsgID(&Pack, &Sub);
+    Unpack_MsgID(&Pack, &LastSub);
+    UtAssert_INT32_EQ(Cnt, 1);
+    UtAssert_INT32_EQ(Sub, 0x0800);
+    UtAssert_INT32_EQ(LastSub, 0x0802);
+} /* end SLS2P_Ranges() */
+
+static void SLS2P_NoRanges(void)
+{
+    START();
+
+    UT_CaptureSends(NetPtr);
+
+    SBN.SubCnt        = 2;
+    SBN.Subs[0].MsgID = 0x0800;
+    SBN.Subs[1].MsgID = 0x0801;
+
+    /* the peer did not advertise SBN_FEAT_SUBRANGE */
+    UtAssert_INT32_EQ(SBN_SendLocalSubsToPeer(PeerPtr), SBN_SUCCESS);
+    UtAssert_INT32_EQ(UT_Sent.Cnt, 1);
+    UtAssert_INT32_EQ(UT_Sent.Msgs[0].Type, SBN_SUB_MSG);
+} /* end SLS2P_NoRanges() */
+
 void Test_SBN_SendLocalSubsToPeer(void)
 {
     SLS2P_SendNetMsgErr();
+    SLS2P_Ranges();
+    SLS2P_NoRanges();
 } /* end Test_SBN_SendLocalSubsToPeer() */
 
 static void CSP_PLS_MaxSubsErr(void)
@@ -164,6 +220,38 @@ static void CSP_PLS_SbnMsg(void)
     IfOpsPtr->Send = Send_Nominal;
 } /* end CSP_PLS_EvtMsg() */
 
+static void CSP_PLS_SubMap(void)
+{
+    START();
+
+    CFE_SB_MsgId_t SubMID = 0x0802;
+
+    CFE_SB_SingleSubscriptionTlm_t Msg, *MsgPtr;
+    MsgPtr = &Msg;
+    memset(MsgPtr, 0, sizeof(Msg));
+    Msg.Payload.SubType = CFE_SB_SUBSCRIPTION;
+    Msg.Payload.MsgId   = SubMID;
+    UT_SetDataBuffer(UT_KEY(CFE_SB_RcvMsg), &MsgPtr, sizeof(MsgPtr), false);
+
+    CFE_SB_MsgId_t mid = CFE_SB_ONESUB_TLM_MID;
+    UT_SetDataBuffer(UT_KEY(CFE_SB_GetMsgId), &mid, sizeof(mid), false);
+
+    UtAssert_True(!SBN_Subscribed(NetPtr, SubMID), "not subscribed before");
+
+    UtAssert_INT32_EQ(SBN_CheckSubscriptionPipe(), SBN_SUCCESS);
+
+    UtAssert_True(SBN_Subscribed(NetPtr, SubMID), "subscribed after sub");
+
+    Msg.Payload.SubType = CFE_SB_UNSUBSCRIPTION;
+    UT_SetDataBuffer(UT_KEY(CFE_SB_RcvMsg), &MsgPtr, sizeof(MsgPtr), false);
+    UT_SetDataBuffer(UT_KEY(CFE_SB_GetMsgId), &mid, sizeof(mid), false);
+
+    UtAssert_INT32_EQ(SBN_CheckSubscriptionPipe(), SBN_SUCCESS);
+
+    UtAssert_True(!SBN_Subscribed(NetPtr, SubMID), "not subscribed after unsub");
+    UtAssert_True(!SBN_Subscribed(NetPtr, MsgID), "out of range message ID");
+} /* end CSP_PLS_SubMap() */
+
 static void CSP_PLU_NotSub(void)
 {
     START();
@@ -361,6 +449,7 @@ void Test_SBN_CheckSubscriptionPipe(void)
     CSP_PLS_SendErr();
     CSP_PLS_EvtMsg();
     CSP_PLS_SbnMsg();
+    CSP_PLS_SubMap();
     CSP_PLU_NotSub();
     CSP_PLU_OtherSub();
     CSP_PLU_SLS2PErr();
@@ -407,8 +496,9 @@ static void PSFP_PFP_AlreadySub(void)
 {
     START();
 
-    PeerPtr->SubCnt        = 1;
-    PeerPtr->Subs[0].MsgID = MsgID;
+    PeerPtr->SubCnt            = 1;
+    PeerPtr->Subs[0].MsgID     = MsgID;
+    PeerPtr->Subs[0].LastMsgID = MsgID;
 
     uint8  Buf[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
     Pack_t Pack;
@@ -454,9 +544,10 @@ static void PSFP_PFP_MaxSubsErr(void)
 {
     START();
 
-    UT_CheckEvent_Setup(SBN_SUB_EID, "cannot process subscription from ProcessorID ");
+    UT_CheckEvent_Setup(SBN_SUB_EID, "cannot process subscription from ProcessorID 1234, max (4) met");
 
-    PeerPtr->SubCnt = SBN_MAX_SUBS_PER_PEER;
+    PeerPtr->MaxSubs = 4; /* limit from the peer's table entry */
+    PeerPtr->SubCnt  = 4;
 
     uint8  Buf[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
     Pack_t Pack;
@@ -469,7 +560,7 @@ static void PSFP_PFP_MaxSubsErr(void)
 
     UtAssert_INT32_EQ(SBN_ProcessSubsFromPeer(PeerPtr, Buf), SBN_ERROR);
 
-    UtAssert_INT32_EQ(PeerPtr->SubCnt, SBN_MAX_SUBS_PER_PEER);
+    UtAssert_INT32_EQ(PeerPtr->SubCnt, 4);
 
     EVENT_CNT(1);
 } /* end PSFP_PFP_MaxSubsErr() */
@@ -516,6 +607,52 @@ static void PSFP_Nominal(void)
     UtAssert_INT32_EQ(PeerPtr->SubCnt, 1);
 } /* end PSFP_Nominal() */
 
+static void PSFP_HiPriority(void)
+{
+    START();
+
+    uint8  Buf[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
+    Pack_t Pack;
+    Pack_Init(&Pack, &Buf, CFE_MISSION_SB_MAX_SB_MSG_SIZE, 0);
+    Pack_Data(&Pack, (void *)SBN_IDENT, SBN_IDENT_LEN);
+    Pack_UInt16(&Pack, 1);
+    Pack_MsgID(&Pack, MsgID);
+    CFE_SB_Qos_t QoS = {CFE_SB_QosPriority_HIGH, 0};
+    Pack_Data(&Pack, (void *)&QoS, sizeof(QoS));
+
+    PeerPtr->Pipe   = 1;
+    PeerPtr->HiPipe = 2;
+
+    UtAssert_INT32_EQ(SBN_ProcessSubsFromPeer(PeerPtr, Buf), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(PeerPtr->SubCnt, 1);
+    UtAssert_INT32_EQ(PeerPtr->Subs[0].QoS.Priority, CFE_SB_QosPriority_HIGH);
+} /* end PSFP_HiPriority() */
+
+#ifdef SBN_SHARED_PIPE
+static void PSFP_Shared(void)
+{
+    START();
+
+    uint8  Buf[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
+    Pack_t Pack;
+    Pack_Init(&Pack, &Buf, CFE_MISSION_SB_MAX_SB_MSG_SIZE, 0);
+    Pack_Data(&Pack, (void *)SBN_IDENT, SBN_IDENT_LEN);
+    Pack_UInt16(&Pack, 1);
+    Pack_MsgID(&Pack, MsgID);
+    CFE_SB_Qos_t QoS = {0};
+    Pack_Data(&Pack, (void *)&QoS, sizeof(QoS));
+
+    UtAssert_INT32_EQ(SBN_ProcessSubsFromPeer(PeerPtr, Buf), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(PeerPtr->SubCnt, 1);
+    UtAssert_INT32_EQ(SBN.SharedSubCnt, 1);
+    UtAssert_INT32_EQ(SBN.SharedSubIdx[MsgID], 1);
+    UtAssert_INT32_EQ(SBN.SharedSubs[0].PeerCnt, 1);
+    UtAssert_True(SBN.SharedSubs[0].PeerMask[0] & 1, "peer bit set");
+} /* end PSFP_Shared() */
+#endif /* SBN_SHARED_PIPE */
+
 void Test_SBN_ProcessSubsFromPeer(void)
 {
     PSFP_PFP_FiltErr();
@@ -524,15 +661,151 @@ void Test_SBN_ProcessSubsFromPeer(void)
     PSFP_PFP_MaxSubsErr();
     PSFP_IdentErr();
     PSFP_Nominal();
+    PSFP_HiPriority();
+#ifdef SBN_SHARED_PIPE
+    PSFP_Shared();
+#endif /* SBN_SHARED_PIPE */
 } /* end Test_SBN_ProcessSubsFromPeer() */
 
+static void Range_Setup(void)
+{
+    START();
+
+    /* on the peer's own pipes, so even with SBN_SHARED_PIPE each MID is (un)subscribed */
+    PeerPtr->TaskFlags = SBN_TASK_SEND;
+} /* end Range_Setup() */
+
+static void PackRange(uint8 *Buf, CFE_SB_MsgId_t First, CFE_SB_MsgId_t Last, CFE_SB_Qos_t QoS)
+{
+    Pack_t Pack;
+
+    Pack_Init(&Pack, Buf, CFE_MISSION_SB_MAX_SB_MSG_SIZE, 0);
+    Pack_Data(&Pack, (void *)SBN_IDENT, SBN_IDENT_LEN);
+    Pack_UInt16(&Pack, 1);
+    Pack_MsgID(&Pack, First);
+    Pack_MsgID(&Pack, Last);
+    Pack_Data(&Pack, (void *)&QoS, sizeof(QoS));
+} /* end PackRange() */
+
+static void PSRFP_Nominal(void)
+{
+    uint8        Buf[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
+    CFE_SB_Qos_t QoS = {0};
+
+    Range_Setup();
+
+    PackRange(Buf, 0x0800, 0x0803, QoS);
+
+    UtAssert_INT32_EQ(SBN_ProcessSubRangesFromPeer(PeerPtr, Buf), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(PeerPtr->SubCnt, 1);
+    UtAssert_INT32_EQ(PeerPtr->Subs[0].MsgID, 0x0800);
+    UtAssert_INT32_EQ(PeerPtr->Subs[0].LastMsgID, 0x0803);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(CFE_SB_SubscribeLocal)), 4);
+} /* end PSRFP_Nominal() */
+
+static void PSRFP_Merge(void)
+{
+    uint8        Buf[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
+    CFE_SB_Qos_t QoS = {0};
+
+    Range_Setup();
+
+    PeerPtr->SubCnt            = 2;
+    PeerPtr->Subs[0].MsgID     = 0x0800;
+    PeerPtr->Subs[0].LastMsgID = 0x0801;
+    PeerPtr->Subs[1].MsgID     = 0x0804;
+    PeerPtr->Subs[1].LastMsgID = 0x0804;
+
+    /* filling the gap joins the ranges either side */
+    PackRange(Buf, 0x0802, 0x0803, QoS);
+
+    UtAssert_INT32_EQ(SBN_ProcessSubRangesFromPeer(PeerPtr, Buf), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(PeerPtr->SubCnt, 1);
+    UtAssert_INT32_EQ(PeerPtr->Subs[0].MsgID, 0x0800);
+    UtAssert_INT32_EQ(PeerPtr->Subs[0].LastMsgID, 0x0804);
+} /* end PSRFP_Merge() */
+
+static void PSRFP_Overlap(void)
+{
+    uint8        Buf[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
+    CFE_SB_Qos_t QoS = {0};
+
+    Range_Setup();
+
+    PeerPtr->SubCnt               = 1;
+    PeerPtr->Subs[0].MsgID        = 0x0802;
+    PeerPtr->Subs[0].LastMsgID    = 0x0802;
+    PeerPtr->Subs[0].QoS.Priority = CFE_SB_QosPriority_HIGH;
+
+    PackRange(Buf, 0x0800, 0x0805, QoS);
+
+    UtAssert_INT32_EQ(SBN_ProcessSubRangesFromPeer(PeerPtr, Buf), SBN_SUCCESS);
+
+    /* the MID already subscribed keeps its QoS */
+    UtAssert_INT32_EQ(PeerPtr->SubCnt, 3);
+    UtAssert_INT32_EQ(PeerPtr->Subs[0].LastMsgID, 0x0801);
+    UtAssert_INT32_EQ(PeerPtr->Subs[1].QoS.Priority, CFE_SB_QosPriority_HIGH);
+    UtAssert_INT32_EQ(PeerPtr->Subs[2].MsgID, 0x0803);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(CFE_SB_SubscribeLocal)), 5);
+} /* end PSRFP_Overlap() */
+
+static void PSRFP_SubErr(void)
+{
+    uint8        Buf[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
+    CFE_SB_Qos_t QoS = {0};
+
+    Range_Setup();
+
+    UT_CheckEvent_Setup(SBN_SUB_EID, "unable to subscribe to MID 0x0802");
+
+    PackRange(Buf, 0x0800, 0x0803, QoS);
+
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_SubscribeLocal), 3, -1);
+
+    UtAssert_INT32_EQ(SBN_ProcessSubRangesFromPeer(PeerPtr, Buf), SBN_ERROR);
+
+    /* the MID's subscribed before the failure are unsubscribed */
+    UtAssert_INT32_EQ(PeerPtr->SubCnt, 0);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(CFE_SB_UnsubscribeLocal)), 2);
+    EVENT_CNT(1);
+} /* end PSRFP_SubErr() */
+
+static void PSRFP_Invalid(void)
+{
+    uint8        Buf[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
+    CFE_SB_Qos_t QoS = {0};
+
+    Range_Setup();
+
+    UT_CheckEvent_Setup(SBN_SUB_EID, "invalid MID range 0x0803-0x0800 from ProcessorID 1234");
+
+    PackRange(Buf, 0x0803, 0x0800, QoS);
+
+    UtAssert_INT32_EQ(SBN_ProcessSubRangesFromPeer(PeerPtr, Buf), SBN_ERROR);
+
+    UtAssert_INT32_EQ(PeerPtr->SubCnt, 0);
+    EVENT_CNT(1);
+} /* end PSRFP_Invalid() */
+
+void Test_SBN_ProcessSubRangesFromPeer(void)
+{
+    PSRFP_Nominal();
+    PSRFP_Merge();
+    PSRFP_Overlap();
+    PSRFP_SubErr();
+    PSRFP_Invalid();
+} /* end Test_SBN_ProcessSubRangesFromPeer() */
+
 static void PUSFP_PUFP_FiltErr(void)
 {
     START();
 
-    PeerPtr->SubCnt        = 1;
-    PeerPtr->Subs[0].MsgID = MsgID;
-    PeerPtr->FilterCnt     = 2;
+    PeerPtr->SubCnt            = 1;
+    PeerPtr->Subs[0].MsgID     = MsgID;
+    PeerPtr->Subs[0].LastMsgID = MsgID;
+    PeerPtr->FilterCnt         = 2;
     SBN_FilterInterface_t Filter1, Filter2;
     memset(&Filter1, 0, sizeof(Filter1));
     memset(&Filter2, 0, sizeof(Filter2));
@@ -583,8 +856,9 @@ static void PUSFP_PUFP_UnsubErr(void)
 
     UT_CheckEvent_Setup(SBN_SUB_EID, "unable to unsubscribe from MID 0x");
 
-    PeerPtr->SubCnt        = 1;
-    PeerPtr->Subs[0].MsgID = MsgID;
+    PeerPtr->SubCnt            = 1;
+    PeerPtr->Subs[0].MsgID     = MsgID;
+    PeerPtr->Subs[0].LastMsgID = MsgID;
 
     uint8  Buf[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
     Pack_t Pack;
@@ -610,8 +884,9 @@ static void PUSFP_IdentWarn(void)
 
     UT_CheckEvent_Setup(SBN_PROTO_EID, "version number mismatch with peer CpuID ");
 
-    PeerPtr->SubCnt        = 1;
-    PeerPtr->Subs[0].MsgID = MsgID;
+    PeerPtr->SubCnt            = 1;
+    PeerPtr->Subs[0].MsgID     = MsgID;
+    PeerPtr->Subs[0].LastMsgID = MsgID;
 
     uint8 Buf[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
     char  tmpident[SBN_IDENT_LEN];
@@ -635,8 +910,9 @@ static void PUSFP_Nominal(void)
 {
     START();
 
-    PeerPtr->SubCnt        = 1;
-    PeerPtr->Subs[0].MsgID = MsgID;
+    PeerPtr->SubCnt            = 1;
+    PeerPtr->Subs[0].MsgID     = MsgID;
+    PeerPtr->Subs[0].LastMsgID = MsgID;
 
     uint8  Buf[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
     Pack_t Pack;
@@ -652,6 +928,74 @@ static void PUSFP_Nominal(void)
     UtAssert_INT32_EQ(PeerPtr->SubCnt, 0);
 } /* end PUSFP_Nominal() */
 
+#ifdef SBN_SHARED_PIPE
+static void PUSFP_Shared(void)
+{
+    START();
+
+    PeerPtr->SubCnt               = 1;
+    PeerPtr->Subs[0].MsgID        = MsgID;
+    PeerPtr->Subs[0].LastMsgID    = MsgID;
+    SBN.SharedSubCnt              = 1;
+    SBN.SharedSubIdx[MsgID]       = 1;
+    SBN.SharedSubs[0].MsgID       = MsgID;
+    SBN.SharedSubs[0].PeerCnt     = 1;
+    SBN.SharedSubs[0].PeerMask[0] = 1;
+
+    uint8  Buf[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
+    Pack_t Pack;
+    Pack_Init(&Pack, &Buf, CFE_MISSION_SB_MAX_SB_MSG_SIZE, 0);
+    Pack_Data(&Pack, (void *)SBN_IDENT, SBN_IDENT_LEN);
+    Pack_UInt16(&Pack, 1);
+    Pack_MsgID(&Pack, MsgID);
+    CFE_SB_Qos_t QoS = {0};
+    Pack_Data(&Pack, (void *)&QoS, sizeof(QoS));
+
+    UtAssert_INT32_EQ(SBN_ProcessUnsubsFromPeer(PeerPtr, Buf), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(PeerPtr->SubCnt, 0);
+    UtAssert_INT32_EQ(SBN.SharedSubCnt, 0);
+    UtAssert_INT32_EQ(SBN.SharedSubIdx[MsgID], 0);
+} /* end PUSFP_Shared() */
+
+static void PUSFP_SharedMoved(void)
+{
+    START();
+
+    /* another peer's subscription to the next message ID is in the last entry */
+    PeerPtr->SubCnt               = 1;
+    PeerPtr->Subs[0].MsgID        = MsgID;
+    PeerPtr->Subs[0].LastMsgID    = MsgID;
+    SBN.SharedSubCnt              = 2;
+    SBN.SharedSubIdx[MsgID]       = 1;
+    SBN.SharedSubIdx[MsgID + 1]   = 2;
+    SBN.SharedSubs[0].MsgID       = MsgID;
+    SBN.SharedSubs[0].PeerCnt     = 1;
+    SBN.SharedSubs[0].PeerMask[0] = 1;
+    SBN.SharedSubs[1].MsgID       = MsgID + 1;
+    SBN.SharedSubs[1].PeerCnt     = 1;
+    SBN.SharedSubs[1].PeerMask[0] = 2;
+
+    uint8  Buf[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
+    Pack_t Pack;
+    Pack_Init(&Pack, &Buf, CFE_MISSION_SB_MAX_SB_MSG_SIZE, 0);
+    Pack_Data(&Pack, (void *)SBN_IDENT, SBN_IDENT_LEN);
+    Pack_UInt16(&Pack, 1);
+    Pack_MsgID(&Pack, MsgID);
+    CFE_SB_Qos_t QoS = {0};
+    Pack_Data(&Pack, (void *)&QoS, sizeof(QoS));
+
+    UtAssert_INT32_EQ(SBN_ProcessUnsubsFromPeer(PeerPtr, Buf), SBN_SUCCESS);
+
+    /* the last entry fills the gap, its bits copied into the first entry's mask */
+    UtAssert_INT32_EQ(SBN.SharedSubCnt, 1);
+    UtAssert_INT32_EQ(SBN.SharedSubIdx[MsgID + 1], 1);
+    UtAssert_INT32_EQ(SBN.SharedSubs[0].MsgID, MsgID + 1);
+    UtAssert_True(SBN.SharedSubs[0].PeerMask == SBN.SharedMasks, "mask kept with the entry");
+    UtAssert_INT32_EQ(SBN.SharedSubs[0].PeerMask[0], 2);
+} /* end PUSFP_SharedMoved() */
+#endif /* SBN_SHARED_PIPE */
+
 void Test_SBN_ProcessUnsubsFromPeer(void)
 {
     PUSFP_PUFP_FiltErr();
@@ -659,16 +1003,100 @@ void Test_SBN_ProcessUnsubsFromPeer(void)
     PUSFP_PUFP_UnsubErr();
     PUSFP_IdentWarn();
     PUSFP_Nominal();
+#ifdef SBN_SHARED_PIPE
+    PUSFP_Shared();
+    PUSFP_SharedMoved();
+#endif /* SBN_SHARED_PIPE */
 } /* end Test_SBN_ProcessUnsubsFromPeer() */
 
+static void PUSRFP_Split(void)
+{
+    uint8        Buf[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
+    CFE_SB_Qos_t QoS = {0};
+
+    Range_Setup();
+
+    PeerPtr->SubCnt            = 1;
+    PeerPtr->Subs[0].MsgID     = 0x0800;
+    PeerPtr->Subs[0].LastMsgID = 0x0805;
+
+    PackRange(Buf, 0x0802, 0x0803, QoS);
+
+    UtAssert_INT32_EQ(SBN_ProcessUnsubRangesFromPeer(PeerPtr, Buf), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(PeerPtr->SubCnt, 2);
+    UtAssert_INT32_EQ(PeerPtr->Subs[0].LastMsgID, 0x0801);
+    UtAssert_INT32_EQ(PeerPtr->Subs[1].MsgID, 0x0804);
+    UtAssert_INT32_EQ(PeerPtr->Subs[1].LastMsgID, 0x0805);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(CFE_SB_UnsubscribeLocal)), 2);
+} /* end PUSRFP_Split() */
+
+static void PUSRFP_SplitFull(void)
+{
+    uint8        Buf[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
+    CFE_SB_Qos_t QoS = {0};
+
+    Range_Setup();
+
+    UT_CheckEvent_Setup(SBN_SUB_EID, "cannot split subscription from ProcessorID 1234, max (1) met");
+
+    PeerPtr->MaxSubs           = 1;
+    PeerPtr->SubCnt            = 1;
+    PeerPtr->Subs[0].MsgID     = 0x0800;
+    PeerPtr->Subs[0].LastMsgID = 0x0805;
+
+    PackRange(Buf, 0x0802, 0x0802, QoS);
+
+    UtAssert_INT32_EQ(SBN_ProcessUnsubRangesFromPeer(PeerPtr, Buf), SBN_SUCCESS);
+
+    /* no room for the top of the range, so it goes too */
+    UtAssert_INT32_EQ(PeerPtr->SubCnt, 1);
+    UtAssert_INT32_EQ(PeerPtr->Subs[0].LastMsgID, 0x0801);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(CFE_SB_UnsubscribeLocal)), 4);
+    EVENT_CNT(1);
+} /* end PUSRFP_SplitFull() */
+
+static void PUSRFP_Span(void)
+{
+    uint8        Buf[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
+    CFE_SB_Qos_t QoS = {0};
+
+    Range_Setup();
+
+    PeerPtr->SubCnt            = 3;
+    PeerPtr->Subs[0].MsgID     = 0x0800;
+    PeerPtr->Subs[0].LastMsgID = 0x0803;
+    PeerPtr->Subs[1].MsgID     = 0x0805;
+    PeerPtr->Subs[1].LastMsgID = 0x0805;
+    PeerPtr->Subs[2].MsgID     = 0x0807;
+    PeerPtr->Subs[2].LastMsgID = 0x0809;
+
+    PackRange(Buf, 0x0802, 0x0807, QoS);
+
+    UtAssert_INT32_EQ(SBN_ProcessUnsubRangesFromPeer(PeerPtr, Buf), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(PeerPtr->SubCnt, 2);
+    UtAssert_INT32_EQ(PeerPtr->Subs[0].LastMsgID, 0x0801);
+    UtAssert_INT32_EQ(PeerPtr->Subs[1].MsgID, 0x0808);
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(CFE_SB_UnsubscribeLocal)), 4);
+} /* end PUSRFP_Span() */
+
+void Test_SBN_ProcessUnsubRangesFromPeer(void)
+{
+    PUSRFP_Split();
+    PUSRFP_SplitFull();
+    PUSRFP_Span();
+} /* end Test_SBN_ProcessUnsubRangesFromPeer() */
+
 static void RASFP_UnsubErr(void)
 {
     START();
 
     UT_CheckEvent_Setup(SBN_SUB_EID, "unable to unsubscribe from message id 0x");
 
-    PeerPtr->SubCnt        = 1;
-    PeerPtr->Subs[0].MsgID = MsgID;
+    PeerPtr->SubCnt            = 1;
+    PeerPtr->Subs[0].MsgID     = MsgID;
+    PeerPtr->Subs[0].LastMsgID = MsgID;
 
     UT_SetDeferredRetcode(UT_KEY(CFE_SB_UnsubscribeLocal), 1, -1);
 
@@ -684,18 +1112,37 @@ static void RASFP_Nominal(void)
 
     UT_CheckEvent_Setup(SBN_SUB_EID, "unsubscribed 1 message id's from ProcessorID ");
 
-    PeerPtr->SubCnt        = 1;
-    PeerPtr->Subs[0].MsgID = MsgID;
+    PeerPtr->SubCnt            = 1;
+    PeerPtr->Subs[0].MsgID     = MsgID;
+    PeerPtr->Subs[0].LastMsgID = MsgID;
 
     UtAssert_INT32_EQ(SBN_RemoveAllSubsFromPeer(PeerPtr), SBN_SUCCESS);
 
     EVENT_CNT(1);
 } /* end RASFP_Nominal() */
 
+static void RASFP_Range(void)
+{
+    Range_Setup();
+
+    UT_CheckEvent_Setup(SBN_SUB_EID, "unsubscribed 6 message id's from ProcessorID ");
+
+    PeerPtr->SubCnt            = 1;
+    PeerPtr->Subs[0].MsgID     = 0x0800;
+    PeerPtr->Subs[0].LastMsgID = 0x0805;
+
+    UtAssert_INT32_EQ(SBN_RemoveAllSubsFromPeer(PeerPtr), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(CFE_SB_UnsubscribeLocal)), 6);
+    UtAssert_INT32_EQ(PeerPtr->SubCnt, 0);
+    EVENT_CNT(1);
+} /* end RASFP_Range() */
+
 void Test_SBN_RemoveAllSubsFromPeer(void)
 {
     RASFP_UnsubErr();
     RASFP_Nominal();
+    RASFP_Range();
 } /* end Test_SBN_RemoveAllSubsFromPeer() */
 
 void UT_Setup(void) {} /* end UT_Setup() */
@@ -708,6 +1155,8 @@ void UtTest_Setup(void)
     ADD_TEST(SBN_SendLocalSubsToPeer);
     ADD_TEST(SBN_CheckSubscriptionPipe);
     ADD_TEST(SBN_ProcessSubsFromPeer);
+    ADD_TEST(SBN_ProcessSubRangesFromPeer);
     ADD_TEST(SBN_ProcessUnsubsFromPeer);
+    ADD_TEST(SBN_ProcessUnsubRangesFromPeer);
     ADD_TEST(SBN_RemoveAllSubsFromPeer);
 }
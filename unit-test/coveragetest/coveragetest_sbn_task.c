@@ -0,0 +1,72 @@
+#include "sbn_coveragetest_common.h"
+
+uint32 CreatedStackSz = 0, CreatedPriority = 0;
+
+static int32 CreateChildTask_Hook(void *UserObj, int32 StubRetcode, uint32 CallCount, const UT_StubContext_t *Context)
+{
+    if (Context->ArgCount > 0)
+    {
+        CreatedStackSz  = UT_Hook_GetArgValueByName(Context, "StackSize", uint32);
+        CreatedPriority = UT_Hook_GetArgValueByName(Context, "Priority", uint32);
+    } /* end if */
+
+    return StubRetcode;
+} /* end CreateChildTask_Hook() */
+
+static void Task_Main(void) {} /* end Task_Main() */
+
+static void CreateTask_Nominal(void)
+{
+    SBN_TaskConf_t Conf   = {50, 32768, 0x2};
+    OS_TaskID_t    TaskID = 0;
+
+    START();
+
+    UT_SetHookFunction(UT_KEY(CFE_ES_CreateChildTask), CreateChildTask_Hook, NULL);
+
+    UtAssert_INT32_EQ(SBN_CreateTask(&TaskID, "sbn_t", Task_Main, &Conf, 100), CFE_SUCCESS);
+    UtAssert_INT32_EQ(CreatedStackSz, 32768);
+    UtAssert_INT32_EQ(CreatedPriority, 50);
+} /* end CreateTask_Nominal() */
+
+static void CreateTask_DefaultStack(void)
+{
+    SBN_TaskConf_t Conf   = {0, 0, 0};
+    OS_TaskID_t    TaskID = 0;
+
+    START();
+
+    UT_SetHookFunction(UT_KEY(CFE_ES_CreateChildTask), CreateChildTask_Hook, NULL);
+
+    UtAssert_INT32_EQ(SBN_CreateTask(&TaskID, "sbn_t", Task_Main, &Conf, 100), CFE_SUCCESS);
+    UtAssert_INT32_EQ(CreatedStackSz, CFE_PLATFORM_ES_DEFAULT_STACK_SIZE + 200);
+    UtAssert_INT32_EQ(CreatedPriority, 0);
+} /* end CreateTask_DefaultStack() */
+
+static void CreateTask_Err(void)
+{
+    SBN_TaskConf_t Conf   = {0, 0, 0};
+    OS_TaskID_t    TaskID = 0;
+
+    START();
+
+    UT_SetDeferredRetcode(UT_KEY(CFE_ES_CreateChildTask), 1, -1);
+
+    UtAssert_INT32_EQ(SBN_CreateTask(&TaskID, "sbn_t", Task_Main, &Conf, 100), -1);
+} /* end CreateTask_Err() */
+
+void Test_SBN_CreateTask(void)
+{
+    CreateTask_Nominal();
+    CreateTask_DefaultStack();
+    CreateTask_Err();
+} /* end Test_SBN_CreateTask() */
+
+void UT_Setup(void) {} /* end UT_Setup() */
+
+void UT_TearDown(void) {} /* end UT_TearDown() */
+
+void UtTest_Setup(void)
+{
+    ADD_TEST(SBN_CreateTask);
+}
@@ -0,0 +1,125 @@
+#include "sbn_coveragetest_common.h"
+
+#define TTL_MID   0x0801
+#define OTHER_MID 0x0802
+#define TTL_MS    100
+
+UT_Msg_t Msg;
+
+SBN_ConfTbl_t TTLTbl;
+
+static void TTL_Setup(CFE_SB_MsgId_t MsgID)
+{
+    START();
+
+    memset(&TTLTbl, 0, sizeof(TTLTbl));
+    TTLTbl.TTLs[0].MsgID = OTHER_MID;
+    TTLTbl.TTLs[0].TTLMS = 0;
+    TTLTbl.TTLs[1].MsgID = TTL_MID;
+    TTLTbl.TTLs[1].TTLMS = TTL_MS;
+    TTLTbl.TTLCnt        = 2;
+    SBN.Conf             = &TTLTbl;
+
+    UT_InitMsg(&Msg, MsgID, 0);
+} /* end TTL_Setup() */
+
+/* the time in the message's secondary header and the time it is read */
+static void TTL_SetTimes(CFE_TIME_SysTime_t *MsgTime, CFE_TIME_SysTime_t *Now)
+{
+    UT_SetDataBuffer(UT_KEY(CFE_SB_GetMsgTime), MsgTime, sizeof(*MsgTime), false);
+    UT_SetDataBuffer(UT_KEY(CFE_TIME_GetTime), Now, sizeof(*Now), false);
+} /* end TTL_SetTimes() */
+
+static bool TTL_Expired(CFE_TIME_SysTime_t MsgTime, CFE_TIME_SysTime_t Now)
+{
+    UT_ResetState(UT_KEY(CFE_SB_GetMsgTime));
+    UT_ResetState(UT_KEY(CFE_TIME_GetTime));
+    TTL_SetTimes(&MsgTime, &Now);
+
+    return SBN_MsgExpired((CFE_SB_MsgPtr_t)(void *)&Msg);
+} /* end TTL_Expired() */
+
+static void MsgExpired_Nominal(void)
+{
+    CFE_TIME_SysTime_t MsgTime = {100, 0x80000000}, Fresh = {100, 0x90000000}, Stale = {101, 0x80000000};
+
+    TTL_Setup(TTL_MID);
+
+    /* 62.5 ms old */
+    UtAssert_True(!TTL_Expired(MsgTime, Fresh), "fresh message kept");
+
+    /* a second old */
+    UtAssert_True(TTL_Expired(MsgTime, Stale), "stale message dropped");
+
+    /* the subseconds borrow from the seconds, 101.0 - 100.5 s */
+    Stale.Subseconds = 0;
+    UtAssert_True(TTL_Expired(MsgTime, Stale), "half a second old");
+
+    /* 101.05 - 101.0 s */
+    MsgTime.Seconds    = 101;
+    MsgTime.Subseconds = 0;
+    Fresh.Seconds      = 101;
+    Fresh.Subseconds   = 0x0CCCCCCD;
+    UtAssert_True(!TTL_Expired(MsgTime, Fresh), "within the TTL");
+} /* end MsgExpired_Nominal() */
+
+static void MsgExpired_Future(void)
+{
+    CFE_TIME_SysTime_t MsgTime = {200, 0}, Now = {100, 0};
+
+    TTL_Setup(TTL_MID);
+
+    UtAssert_True(!TTL_Expired(MsgTime, Now), "a message from the future is not stale");
+} /* end MsgExpired_Future() */
+
+static void MsgExpired_Untimed(void)
+{
+    CFE_TIME_SysTime_t MsgTime = {0, 0}, Now = {100, 0};
+
+    TTL_Setup(TTL_MID);
+
+    UtAssert_True(!TTL_Expired(MsgTime, Now), "a message without a time never expires");
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(CFE_TIME_GetTime)), 0);
+} /* end MsgExpired_Untimed() */
+
+static void MsgExpired_NoTTL(void)
+{
+    CFE_TIME_SysTime_t MsgTime = {100, 0}, Now = {200, 0};
+
+    /* configured with a TTL of 0 */
+    TTL_Setup(OTHER_MID);
+    UtAssert_True(!TTL_Expired(MsgTime, Now), "TTL of 0 never expires");
+
+    /* not in the table */
+    TTL_Setup(TTL_MID + 2);
+    UtAssert_True(!TTL_Expired(MsgTime, Now), "no TTL configured");
+
+    /* no table at all, not even looked up */
+    TTL_Setup(TTL_MID);
+    TTLTbl.TTLCnt = 0;
+    UtAssert_True(!TTL_Expired(MsgTime, Now), "no TTLs configured");
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(CFE_SB_GetMsgTime)), 0);
+
+    /* no table applied */
+    TTL_Setup(TTL_MID);
+    SBN.Conf = NULL;
+    UtAssert_True(!TTL_Expired(MsgTime, Now), "no table");
+    UtAssert_INT32_EQ(UT_GetStubCount(UT_KEY(CFE_SB_GetMsgTime)), 0);
+} /* end MsgExpired_NoTTL() */
+
+void Test_SBN_MsgExpired(void)
+{
+    MsgExpired_Nominal();
+    MsgExpired_Future();
+    MsgExpired_Untimed();
+    MsgExpired_NoTTL();
+} /* end Test_SBN_MsgExpired() */
+
+void UT_Setup(void) {} /* end UT_Setup() */
+
+void UT_TearDown(void) {} /* end UT_TearDown() */
+
+void UtTest_Setup(void)
+{
+    ADD_TEST(SBN_MsgExpired);
+}
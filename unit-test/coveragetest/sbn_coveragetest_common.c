@@ -1,3 +1,5 @@
+#include <stdlib.h>
+
 #include "sbn_coveragetest_common.h"
 
 int32 UT_CheckEvent_Hook(void *UserObj, int32 StubRetcode, uint32 CallCount, const UT_StubContext_t *Context,
@@ -225,10 +227,75 @@ int32 SymLookHook(void *UserObj, int32 StubRetcode, uint32 CallCount, const UT_S
 
 void START_fn(const char *func, int line)
 {
+    int i = 0;
+
     UT_ResetState(0);
     printf("Start item %s (%d)\n", func, line);
+
+    /* LoadConf() may have reallocated the tables in the last test */
+#ifdef SBN_MID_STATS
+    free(SBN.MidStats);
+#endif /* SBN_MID_STATS */
+#ifdef SBN_SEND_WORKERS
+    free(SBN.SendWorkerPeers[0]);
+#endif /* SBN_SEND_WORKERS */
+#ifdef SBN_SHARED_PIPE
+    free(SBN.SharedMasks);
+#endif /* SBN_SHARED_PIPE */
+    free(SBN.Peers);
+    free(SBN.ReadyPeers);
+    for (i = 0; SBN.Nets != NULL && i < SBN.NetSlots; i++)
+    {
+        free(SBN.Nets[i].Peers);
+    } /* end for */
+    free(SBN.Nets);
+    free(SBN.Bufs);
+    free(SBN.Reasm);
     memset(&SBN, 0, sizeof(SBN));
 
+    /* like LoadConf_Net(), the net's peers are followed by their subscription tables */
+    SBN.NetSlots      = SBN_MAX_NETS;
+    SBN.Nets          = calloc(SBN_MAX_NETS, sizeof(*SBN.Nets));
+    SBN.Nets[0].Peers = calloc(1, UT_PEER_CNT * (sizeof(SBN_PeerInterface_t) +
+                                                 (SBN_MAX_SUBS_PER_PEER + 1) * sizeof(SBN_Subs_t)));
+    SBN.PeerCnt       = UT_PEER_CNT;
+
+    /* like AllocTables(), a slot for each entry the table can hold */
+    SBN.PeerSlots  = SBN_MAX_PEER_CNT;
+    SBN.Peers      = calloc(SBN.PeerSlots, sizeof(*SBN.Peers));
+    SBN.ReadyPeers = calloc(SBN.PeerSlots, sizeof(*SBN.ReadyPeers));
+#ifdef SBN_MID_STATS
+    SBN.MidStats = calloc(SBN.PeerSlots, sizeof(*SBN.MidStats));
+#endif /* SBN_MID_STATS */
+#ifdef SBN_SEND_WORKERS
+    SBN.SendWorkerPeers[0] = calloc(SBN_SEND_WORKERS * SBN.PeerSlots, sizeof(*SBN.SendWorkerPeers[0]));
+    for (i = 1; i < SBN_SEND_WORKERS; i++)
+    {
+        SBN.SendWorkerPeers[i] = SBN.SendWorkerPeers[0] + i * SBN.PeerSlots;
+    } /* end for */
+#endif /* SBN_SEND_WORKERS */
+#ifdef SBN_SHARED_PIPE
+    SBN.PeerMaskWords = (SBN.PeerSlots + 31) / 32;
+    SBN.SharedMasks   = calloc((SBN_MAX_SHARED_SUBS + 2) * SBN.PeerMaskWords, sizeof(*SBN.SharedMasks));
+    SBN.SentMask      = &SBN.SharedMasks[SBN_MAX_SHARED_SUBS * SBN.PeerMaskWords];
+    SBN.ShareMask     = SBN.SentMask + SBN.PeerMaskWords;
+
+    /* as SharedSubAdd() gives each entry its mask, for the tests that fill in entries themselves */
+    for (i = 0; i < SBN_MAX_SHARED_SUBS; i++)
+    {
+        SBN.SharedSubs[i].PeerMask = &SBN.SharedMasks[i * SBN.PeerMaskWords];
+    } /* end for */
+#endif /* SBN_SHARED_PIPE */
+    for (i = 0; i < UT_PEER_CNT; i++)
+    {
+        SBN_PeerInterface_t *Peer = &SBN.Nets[0].Peers[i];
+
+        Peer->Slot    = i;
+        Peer->MaxSubs = SBN_MAX_SUBS_PER_PEER;
+        Peer->Subs    = (SBN_Subs_t *)(void *)&SBN.Nets[0].Peers[UT_PEER_CNT] + i * (SBN_MAX_SUBS_PER_PEER + 1);
+        SBN.Peers[i]  = Peer;
+    } /* end for */
+
     NetPtr                = &SBN.Nets[0];
     SBN.NetCnt            = 1;
     NetPtr->PeerCnt       = 1;
@@ -239,6 +306,10 @@ void START_fn(const char *func, int line)
     PeerPtr->Net          = NetPtr;
     NetPtr->IfOps         = &IfOps;
 
+    SBN_InitBufPool();
+    SBN_InitReasm();
+    SBN_IndexPeers();
+
     UT_SetHookFunction(UT_KEY(OS_SymbolLookup), SymLookHook, NULL);
 
     UT_SetDataBuffer(UT_KEY(CFE_TBL_GetAddress), &NominalTblPtr, sizeof(NominalTblPtr), false);
@@ -256,3 +327,80 @@ void START_fn(const char *func, int line)
     UT_SetDeferredRetcode(UT_KEY(CFE_PSP_GetSpacecraftId), 1, SpacecraftID);
     UT_SetDeferredRetcode(UT_KEY(CFE_PSP_GetSpacecraftId), 1, SpacecraftID);
 } /* end START_fn() */
+
+SBN_PeerInterface_t *UT_AddNet(CFE_ProcessorID_t PeerProcessorID)
+{
+    SBN_NetInterface_t * Net  = &SBN.Nets[SBN.NetCnt];
+    SBN_PeerInterface_t *Peer = NULL;
+
+    /* freed by the next START(), like the peers of the first net */
+    Net->Peers      = calloc(1, sizeof(SBN_PeerInterface_t) + (SBN_MAX_SUBS_PER_PEER + 1) * sizeof(SBN_Subs_t));
+    Net->PeerCnt    = 1;
+    Net->Configured = 1;
+    Net->IfOps      = &IfOps;
+
+    Peer               = &Net->Peers[0];
+    Peer->Slot         = UT_PEER_CNT + SBN.NetCnt - 1;
+    Peer->MaxSubs      = SBN_MAX_SUBS_PER_PEER;
+    Peer->Subs         = (SBN_Subs_t *)(void *)&Net->Peers[1];
+    Peer->ProcessorID  = PeerProcessorID;
+    Peer->SpacecraftID = SpacecraftID;
+    Peer->Net          = Net;
+
+    SBN.Peers[Peer->Slot] = Peer;
+    SBN.NetCnt++;
+
+    SBN_IndexPeers();
+
+    return Peer;
+} /* end UT_AddNet() */
+
+void UT_InitMsg(UT_Msg_t *Msg, CFE_SB_MsgId_t MsgID, uint16 Seq)
+{
+    memset(Msg, 0, sizeof(*Msg));
+    CCSDS_WR_SID(Msg->Hdr, MsgID);
+    CCSDS_WR_SEQ(Msg->Hdr, Seq);
+} /* end UT_InitMsg() */
+
+UT_Sent_t   UT_Sent;
+SBN_IfOps_t UT_CaptureOps;
+
+SBN_Status_t UT_Send_Capture(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Payload)
+{
+    UT_SentMsg_t *Sent = &UT_Sent.Msgs[UT_Sent.Cnt < UT_SENT_MAX ? UT_Sent.Cnt : UT_SENT_MAX - 1];
+
+    Sent->Peer = Peer;
+    Sent->Type = MsgType;
+    Sent->Sz   = MsgSz;
+    memcpy(Sent->Buf, Payload, MsgSz);
+
+    UT_Sent.Cnt++;
+    UT_Sent.TypeCnt[MsgType]++;
+
+    return SBN_SUCCESS;
+} /* end UT_Send_Capture() */
+
+void UT_CaptureSends(SBN_NetInterface_t *Net)
+{
+    UT_CaptureOps      = *IfOpsPtr;
+    UT_CaptureOps.Send = UT_Send_Capture;
+    Net->IfOps         = &UT_CaptureOps;
+
+    memset(&UT_Sent, 0, sizeof(UT_Sent));
+} /* end UT_CaptureSends() */
+
+UT_SentMsg_t *UT_LastSent(void)
+{
+    if (UT_Sent.Cnt == 0)
+    {
+        return &UT_Sent.Msgs[0];
+    } /* end if */
+
+    return &UT_Sent.Msgs[UT_Sent.Cnt < UT_SENT_MAX ? UT_Sent.Cnt - 1 : UT_SENT_MAX - 1];
+} /* end UT_LastSent() */
+
+void UT_SetLocalTime(OS_time_t *Now)
+{
+    UT_ResetState(UT_KEY(OS_GetLocalTime));
+    UT_SetDataBuffer(UT_KEY(OS_GetLocalTime), Now, sizeof(*Now), false);
+} /* end UT_SetLocalTime() */
@@ -47,6 +47,11 @@ void UT_Setup(void);
  */
 void UT_TearDown(void);
 
+/*
+ * Number of peers START() allocates on the test net, only the first is counted in the net's PeerCnt
+ */
+#define UT_PEER_CNT 4
+
 #define EVENT_CNT(EVTCNT) UtAssert_True(EventTest.MatchCount == (EVTCNT), "EID generated (%d)", EventTest.MatchCount)
 
 typedef struct
@@ -97,4 +102,65 @@ extern SBN_PeerInterface_t *  PeerPtr;
 #define START() START_fn(__func__, __LINE__)
 void START_fn(const char *func, int line);
 
+/*
+ * Adds a net after those START() set up, with one peer, and returns the peer
+ */
+SBN_PeerInterface_t *UT_AddNet(CFE_ProcessorID_t PeerProcessorID);
+
+/*
+ * An app message for the tests to send and receive, a primary header and a few bytes of data
+ */
+typedef struct
+{
+    CCSDS_PriHdr_t Hdr;
+    uint8          Data[8];
+} UT_Msg_t;
+
+#define UT_MSG_SZ (sizeof(CCSDS_PriHdr_t) + 8)
+
+/*
+ * Clears the message and sets its message ID and sequence count
+ */
+void UT_InitMsg(UT_Msg_t *Msg, CFE_SB_MsgId_t MsgID, uint16 Seq);
+
+/*
+ * Sends UT_Send_Capture() saw, the first UT_SENT_MAX are kept, later ones replace the last
+ */
+#define UT_SENT_MAX 8
+
+typedef struct
+{
+    SBN_PeerInterface_t *Peer;
+    SBN_MsgType_t        Type;
+    SBN_MsgSz_t          Sz;
+    uint8                Buf[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
+} UT_SentMsg_t;
+
+typedef struct
+{
+    int          Cnt;
+    int          TypeCnt[256];
+    UT_SentMsg_t Msgs[UT_SENT_MAX];
+} UT_Sent_t;
+
+extern UT_Sent_t   UT_Sent;
+extern SBN_IfOps_t UT_CaptureOps;
+
+SBN_Status_t UT_Send_Capture(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Payload);
+
+/*
+ * Points the net at UT_CaptureOps, the nominal ops with UT_Send_Capture() to send, and clears UT_Sent
+ */
+void UT_CaptureSends(SBN_NetInterface_t *Net);
+
+/*
+ * The last send UT_Send_Capture() kept
+ */
+UT_SentMsg_t *UT_LastSent(void);
+
+/*
+ * Each call replaces the time the OS_GetLocalTime stub returns
+ */
+void UT_SetLocalTime(OS_time_t *Now);
+
 #endif /* _sbn_coveragetest_common_h_ */
@@ -63,6 +63,23 @@ bool SBN_UnpackMsg(void *SBNBuf, SBN_MsgSz_t *MsgSzPtr, SBN_MsgType_t *MsgTypePt
     return true;
 } /* end SBN_UnpackMsg() */
 
+void *SBN_GetBuf(void)
+{
+    static uint8 Buf[SBN_MAX_PACKED_MSG_SZ];
+
+    if (UT_DEFAULT_IMPL(SBN_GetBuf) != 0)
+    {
+        return NULL;
+    }
+
+    return Buf;
+} /* end SBN_GetBuf() */
+
+void SBN_PutBuf(void *Buf)
+{
+    UT_DEFAULT_IMPL(SBN_PutBuf);
+} /* end SBN_PutBuf() */
+
 SBN_Status_t SBN_Connected(SBN_PeerInterface_t *Peer)
 {
     SBN_Status_t status;
@@ -113,3 +130,36 @@ SBN_PeerInterface_t *SBN_GetPeer(SBN_NetInterface_t *Net, CFE_ProcessorID_t Proc
 
     return p;
 } /* end SBN_GetPeer() */
+
+bool SBN_Subscribed(SBN_NetInterface_t *Net, CFE_SB_MsgId_t MsgID)
+{
+    return UT_DEFAULT_IMPL(SBN_Subscribed) != 0;
+} /* end SBN_Subscribed() */
+
+void SBN_SchedulePoll(SBN_PeerInterface_t *Peer, uint32 DelayMS)
+{
+    UT_DEFAULT_IMPL(SBN_SchedulePoll);
+} /* end SBN_SchedulePoll() */
+
+bool SBN_HeartbeatDue(SBN_PeerInterface_t *Peer)
+{
+    return UT_DEFAULT_IMPL(SBN_HeartbeatDue) != 0;
+} /* end SBN_HeartbeatDue() */
+
+bool SBN_PeerTimedOut(SBN_PeerInterface_t *Peer)
+{
+    return UT_DEFAULT_IMPL(SBN_PeerTimedOut) != 0;
+} /* end SBN_PeerTimedOut() */
+
+uint32 SBN_LivenessPollMS(SBN_PeerInterface_t *Peer)
+{
+    return UT_DEFAULT_IMPL(SBN_LivenessPollMS);
+} /* end SBN_LivenessPollMS() */
+
+int32 SBN_ElapsedMS(OS_time_t *Then, OS_time_t *Now)
+{
+    UT_DEFAULT_IMPL(SBN_ElapsedMS);
+
+    /* modules time with it, so this is the real thing */
+    return (int32)(Now->seconds - Then->seconds) * 1000 + ((int32)Now->microsecs - (int32)Then->microsecs) / 1000;
+} /* end SBN_ElapsedMS() */